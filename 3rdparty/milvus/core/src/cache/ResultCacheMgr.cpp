@@ -0,0 +1,92 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/ResultCacheMgr.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "config/Config.h"
+#include "metrics/Metrics.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace cache {
+
+namespace {
+constexpr int64_t unit = 1024 * 1024;
+}
+
+ResultCacheMgr::ResultCacheMgr() {
+    server::Config& config = server::Config::GetInstance();
+
+    int64_t capacity;
+    config.GetCacheConfigResultCacheCapacity(capacity);
+    enabled_ = capacity > 0;
+    cache_ = std::make_shared<Cache<DataObjPtr>>(capacity * unit, 1UL << 32, "[CACHE RESULT]");
+
+    SetIdentity("ResultCacheMgr");
+    AddResultCacheCapacityListener();
+}
+
+ResultCacheMgr*
+ResultCacheMgr::GetInstance() {
+    static ResultCacheMgr s_mgr;
+    return &s_mgr;
+}
+
+std::string
+ResultCacheMgr::MakeKey(const std::string& collection_id, uint64_t version,
+                        const std::vector<std::string>& partition_tags, const std::string& params, int64_t topk,
+                        const std::string& query) {
+    // the order partition tags are given in doesn't change the result
+    std::vector<std::string> tags = partition_tags;
+    std::sort(tags.begin(), tags.end());
+
+    std::string key = collection_id + "#" + std::to_string(version) + "#" + std::to_string(topk) + "#" + params;
+    for (auto& tag : tags) {
+        key += "#" + tag;
+    }
+    key += "#" + std::to_string(query.size()) + ":" + std::to_string(std::hash<std::string>()(query));
+    return key;
+}
+
+SearchResultObjPtr
+ResultCacheMgr::GetResult(const std::string& key, const std::string& query) {
+    auto result = std::static_pointer_cast<SearchResultObj>(GetItem(key));
+    bool hit = (result != nullptr && result->Query() == query);
+    server::Metrics::GetInstance().ResultCacheAccessTotalIncrement(hit);
+    return hit ? result : nullptr;
+}
+
+void
+ResultCacheMgr::InsertResult(const std::string& key, const SearchResultObjPtr& result) {
+    if (result->Size() > CacheCapacity()) {
+        return;
+    }
+    InsertItem(key, result);
+    server::Metrics::GetInstance().ResultCacheUsageGaugeSet(CacheUsage());
+}
+
+void
+ResultCacheMgr::OnResultCacheCapacityChanged(int64_t value) {
+    enabled_ = value > 0;
+    if (enabled_) {
+        SetCapacity(value * unit);
+    } else {
+        ClearCache();
+    }
+    server::Metrics::GetInstance().ResultCacheUsageGaugeSet(CacheUsage());
+}
+
+}  // namespace cache
+}  // namespace milvus
@@ -0,0 +1,102 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cache/CacheMgr.h"
+#include "cache/DataObj.h"
+#include "config/handler/CacheConfigHandler.h"
+
+namespace milvus {
+namespace cache {
+
+// Top k results of one search. The query vectors are kept to tell apart searches whose keys collide.
+class SearchResultObj : public DataObj {
+ public:
+    SearchResultObj(std::string query, int64_t row_num, std::vector<int64_t> ids, std::vector<float> distances)
+        : query_(std::move(query)), row_num_(row_num), ids_(std::move(ids)), distances_(std::move(distances)) {
+    }
+
+    int64_t
+    Size() override {
+        return query_.size() + ids_.size() * sizeof(int64_t) + distances_.size() * sizeof(float);
+    }
+
+    const std::string&
+    Query() const {
+        return query_;
+    }
+
+    int64_t
+    RowNum() const {
+        return row_num_;
+    }
+
+    const std::vector<int64_t>&
+    Ids() const {
+        return ids_;
+    }
+
+    const std::vector<float>&
+    Distances() const {
+        return distances_;
+    }
+
+ private:
+    std::string query_;
+    int64_t row_num_;
+    std::vector<int64_t> ids_;
+    std::vector<float> distances_;
+};
+
+using SearchResultObjPtr = std::shared_ptr<SearchResultObj>;
+
+// Caches search results of repeated queries, sized by cache_config.result_cache_capacity (MiB).
+// Keys carry the data version of the collection, so results of older versions are never hit and age out.
+class ResultCacheMgr : public CacheMgr<DataObjPtr>, public server::CacheConfigHandler {
+ private:
+    ResultCacheMgr();
+
+ public:
+    static ResultCacheMgr*
+    GetInstance();
+
+    bool
+    Enabled() const {
+        return enabled_;
+    }
+
+    // key of a search, query is the raw bytes of the query vectors
+    static std::string
+    MakeKey(const std::string& collection_id, uint64_t version, const std::vector<std::string>& partition_tags,
+            const std::string& params, int64_t topk, const std::string& query);
+
+    SearchResultObjPtr
+    GetResult(const std::string& key, const std::string& query);
+
+    void
+    InsertResult(const std::string& key, const SearchResultObjPtr& result);
+
+ protected:
+    void
+    OnResultCacheCapacityChanged(int64_t value) override;
+
+ private:
+    std::atomic<bool> enabled_{false};
+};
+
+}  // namespace cache
+}  // namespace milvus
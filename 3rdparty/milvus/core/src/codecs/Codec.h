@@ -45,6 +45,9 @@ class Codec {
     virtual IdBloomFilterFormatPtr
     GetIdBloomFilterFormat() = 0;
 
+    virtual IdIndexFormatPtr
+    GetIdIndexFormat() = 0;
+
     // TODO(zhiru)
     /*
     virtual AttrsFormat
@@ -53,9 +56,6 @@ class Codec {
     virtual AttrsIndexFormat
     GetAttrsIndexFormat() = 0;
 
-    virtual IdIndexFormat
-    GetIdIndexFormat() = 0;
-
     */
 };
 
@@ -20,6 +20,7 @@
 #include <memory>
 #include <vector>
 
+#include "segment/DeletedDocs.h"
 #include "segment/Vectors.h"
 #include "storage/FSHandler.h"
 
@@ -40,6 +41,11 @@ class VectorsFormat {
     virtual void
     read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
                  std::vector<uint8_t>& raw_vectors) = 0;
+
+    // the vectors at the given offsets, in one pass over the file, offsets must be ascending
+    virtual void
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::vector<segment::offset_t>& offsets,
+                 size_t single_vector_bytes, std::vector<uint8_t>& raw_vectors) = 0;
 };
 
 using VectorsFormatPtr = std::shared_ptr<VectorsFormat>;
@@ -22,6 +22,7 @@
 #include "DefaultAttrsFormat.h"
 #include "DefaultDeletedDocsFormat.h"
 #include "DefaultIdBloomFilterFormat.h"
+#include "DefaultIdIndexFormat.h"
 #include "DefaultVectorIndexFormat.h"
 #include "DefaultVectorsFormat.h"
 
@@ -34,6 +35,7 @@ DefaultCodec::DefaultCodec() {
     vector_index_format_ptr_ = std::make_shared<DefaultVectorIndexFormat>();
     deleted_docs_format_ptr_ = std::make_shared<DefaultDeletedDocsFormat>();
     id_bloom_filter_format_ptr_ = std::make_shared<DefaultIdBloomFilterFormat>();
+    id_index_format_ptr_ = std::make_shared<DefaultIdIndexFormat>();
 }
 
 VectorsFormatPtr
@@ -61,5 +63,10 @@ DefaultCodec::GetIdBloomFilterFormat() {
     return id_bloom_filter_format_ptr_;
 }
 
+IdIndexFormatPtr
+DefaultCodec::GetIdIndexFormat() {
+    return id_index_format_ptr_;
+}
+
 }  // namespace codec
 }  // namespace milvus
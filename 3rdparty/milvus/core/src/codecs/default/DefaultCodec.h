@@ -41,12 +41,16 @@ class DefaultCodec : public Codec {
     IdBloomFilterFormatPtr
     GetIdBloomFilterFormat() override;
 
+    IdIndexFormatPtr
+    GetIdIndexFormat() override;
+
  private:
     VectorsFormatPtr vectors_format_ptr_;
     AttrsFormatPtr attrs_format_ptr_;
     VectorIndexFormatPtr vector_index_format_ptr_;
     DeletedDocsFormatPtr deleted_docs_format_ptr_;
     IdBloomFilterFormatPtr id_bloom_filter_format_ptr_;
+    IdIndexFormatPtr id_index_format_ptr_;
 };
 
 }  // namespace codec
@@ -0,0 +1,86 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/default/DefaultIdIndexFormat.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+void
+DefaultIdIndexFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::IdIndexPtr& id_index_ptr) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string id_index_file_path = dir_path + "/" + id_index_filename_;
+
+    // segments written before the id index was introduced
+    id_index_ptr = nullptr;
+    if (!boost::filesystem::exists(id_index_file_path)) {
+        return;
+    }
+
+    if (!fs_ptr->reader_ptr_->open(id_index_file_path)) {
+        std::string err_msg = "Failed to open file: " + id_index_file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+
+    size_t count;
+    fs_ptr->reader_ptr_->read(&count, sizeof(size_t));
+
+    std::vector<segment::doc_id_t> uids(count);
+    std::vector<segment::offset_t> offsets(count);
+    fs_ptr->reader_ptr_->read(uids.data(), count * sizeof(segment::doc_id_t));
+    fs_ptr->reader_ptr_->read(offsets.data(), count * sizeof(segment::offset_t));
+
+    fs_ptr->reader_ptr_->close();
+
+    id_index_ptr = std::make_shared<segment::IdIndex>(std::move(uids), std::move(offsets));
+}
+
+void
+DefaultIdIndexFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::IdIndexPtr& id_index_ptr) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string id_index_file_path = dir_path + "/" + id_index_filename_;
+
+    if (!fs_ptr->writer_ptr_->open(id_index_file_path)) {
+        std::string err_msg = "Failed to open file: " + id_index_file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    size_t count = id_index_ptr->GetCount();
+    fs_ptr->writer_ptr_->write(&count, sizeof(size_t));
+    fs_ptr->writer_ptr_->write((void*)id_index_ptr->GetUids().data(), count * sizeof(segment::doc_id_t));
+    fs_ptr->writer_ptr_->write((void*)id_index_ptr->GetOffsets().data(), count * sizeof(segment::offset_t));
+    fs_ptr->writer_ptr_->close();
+}
+
+}  // namespace codec
+}  // namespace milvus
@@ -20,9 +20,11 @@
 
 #include "codecs/default/DefaultVectorIndexFormat.h"
 #include "knowhere/common/BinarySet.h"
+#include "knowhere/index/vector_index/IndexAnnoy.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 #include "knowhere/index/vector_index/VecIndexFactory.h"
 #include "segment/VectorIndex.h"
+#include "storage/disk/DiskIOReader.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
@@ -55,6 +57,12 @@ DefaultVectorIndexFormat::read_internal(const storage::FSHandlerPtr& fs_ptr, con
     rp += sizeof(current_type);
     fs_ptr->reader_ptr_->seekg(rp);
 
+    // the annoy trees of a local file are mapped rather than read, see IndexAnnoy::LoadMapped
+    auto index_type = knowhere::OldIndexTypeToStr(current_type);
+    bool map_annoy = index_type == knowhere::IndexEnum::INDEX_ANNOY &&
+                     std::dynamic_pointer_cast<storage::DiskIOReader>(fs_ptr->reader_ptr_) != nullptr;
+    int64_t annoy_offset = -1, annoy_length = 0;
+
     LOG_ENGINE_DEBUG_ << "Start to read_index(" << path << ") length: " << length << " bytes";
     while (rp < length) {
         size_t meta_length;
@@ -72,6 +80,15 @@ DefaultVectorIndexFormat::read_internal(const storage::FSHandlerPtr& fs_ptr, con
         rp += sizeof(bin_length);
         fs_ptr->reader_ptr_->seekg(rp);
 
+        if (map_annoy && std::string(meta, meta_length) == "annoy_index_data") {
+            annoy_offset = rp;
+            annoy_length = bin_length;
+            rp += bin_length;
+            fs_ptr->reader_ptr_->seekg(rp);
+            delete[] meta;
+            continue;
+        }
+
         auto bin = new uint8_t[bin_length];
         fs_ptr->reader_ptr_->read(bin, bin_length);
         rp += bin_length;
@@ -88,10 +105,14 @@ DefaultVectorIndexFormat::read_internal(const storage::FSHandlerPtr& fs_ptr, con
     LOG_ENGINE_DEBUG_ << "read_index(" << path << ") rate " << rate << "MB/s";
 
     knowhere::VecIndexFactory& vec_index_factory = knowhere::VecIndexFactory::GetInstance();
-    auto index =
-        vec_index_factory.CreateVecIndex(knowhere::OldIndexTypeToStr(current_type), knowhere::IndexMode::MODE_CPU);
+    auto index = vec_index_factory.CreateVecIndex(index_type, knowhere::IndexMode::MODE_CPU);
     if (index != nullptr) {
-        index->Load(load_data_list);
+        if (annoy_offset >= 0) {
+            auto annoy_index = std::static_pointer_cast<knowhere::IndexAnnoy>(index);
+            annoy_index->LoadMapped(load_data_list, path, annoy_offset, annoy_length);
+        } else {
+            index->Load(load_data_list);
+        }
         index->SetIndexSize(length);
     } else {
         LOG_ENGINE_ERROR_ << "Fail to create vector index: " << path;
@@ -53,6 +53,44 @@ DefaultVectorsFormat::read_vectors_internal(const storage::FSHandlerPtr& fs_ptr,
     fs_ptr->reader_ptr_->close();
 }
 
+void
+DefaultVectorsFormat::read_vectors_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                                            const std::vector<segment::offset_t>& offsets, size_t single_vector_bytes,
+                                            std::vector<uint8_t>& raw_vectors) {
+    if (!fs_ptr->reader_ptr_->open(file_path.c_str())) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_CANNOT_OPEN_FILE, err_msg);
+    }
+
+    size_t num_bytes;
+    fs_ptr->reader_ptr_->read(&num_bytes, sizeof(size_t));
+    size_t count = num_bytes / single_vector_bytes;
+
+    raw_vectors.resize(offsets.size() * single_vector_bytes);
+
+    // runs of consecutive offsets are read at once
+    size_t i = 0;
+    while (i < offsets.size()) {
+        size_t run = 1;
+        while (i + run < offsets.size() && offsets[i + run] == offsets[i] + run) {
+            ++run;
+        }
+        if (offsets[i] < 0 || offsets[i] + run > count) {
+            fs_ptr->reader_ptr_->close();
+            std::string err_msg = "Offset " + std::to_string(offsets[i]) + " out of range of file: " + file_path;
+            LOG_ENGINE_ERROR_ << err_msg;
+            throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+        }
+
+        fs_ptr->reader_ptr_->seekg(sizeof(size_t) + offsets[i] * single_vector_bytes);
+        fs_ptr->reader_ptr_->read(raw_vectors.data() + i * single_vector_bytes, run * single_vector_bytes);
+        i += run;
+    }
+
+    fs_ptr->reader_ptr_->close();
+}
+
 void
 DefaultVectorsFormat::read_uids_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
                                          std::vector<segment::doc_id_t>& uids) {
@@ -186,5 +224,29 @@ DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t of
     }
 }
 
+void
+DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::vector<segment::offset_t>& offsets,
+                                   size_t single_vector_bytes, std::vector<uint8_t>& raw_vectors) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    if (!boost::filesystem::is_directory(dir_path)) {
+        std::string err_msg = "Directory: " + dir_path + "does not exist";
+        LOG_ENGINE_ERROR_ << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    boost::filesystem::path target_path(dir_path);
+    typedef boost::filesystem::directory_iterator d_it;
+    d_it it_end;
+    d_it it(target_path);
+    for (; it != it_end; ++it) {
+        const auto& path = it->path();
+        if (path.extension().string() == raw_vector_extension_) {
+            read_vectors_internal(fs_ptr, path.string(), offsets, single_vector_bytes, raw_vectors);
+        }
+    }
+}
+
 }  // namespace codec
 }  // namespace milvus
@@ -44,6 +44,10 @@ class DefaultVectorsFormat : public VectorsFormat {
     read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
                  std::vector<uint8_t>& raw_vectors) override;
 
+    void
+    read_vectors(const storage::FSHandlerPtr& fs_ptr, const std::vector<segment::offset_t>& offsets,
+                 size_t single_vector_bytes, std::vector<uint8_t>& raw_vectors) override;
+
     // No copy and move
     DefaultVectorsFormat(const DefaultVectorsFormat&) = delete;
     DefaultVectorsFormat(DefaultVectorsFormat&&) = delete;
@@ -58,6 +62,11 @@ class DefaultVectorsFormat : public VectorsFormat {
     read_vectors_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path, off_t offset, size_t num,
                           std::vector<uint8_t>& raw_vectors);
 
+    void
+    read_vectors_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
+                          const std::vector<segment::offset_t>& offsets, size_t single_vector_bytes,
+                          std::vector<uint8_t>& raw_vectors);
+
     void
     read_uids_internal(const storage::FSHandlerPtr& fs_ptr, const std::string& file_path,
                        std::vector<segment::doc_id_t>& uids);
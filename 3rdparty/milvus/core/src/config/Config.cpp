@@ -16,6 +16,7 @@
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <regex>
 #include <string>
 #include <thread>
@@ -67,6 +68,10 @@ const char* CONFIG_DB_PRELOAD_COLLECTION = "preload_collection";
 const char* CONFIG_DB_PRELOAD_COLLECTION_DEFAULT = "";
 const char* CONFIG_DB_AUTO_FLUSH_INTERVAL = "auto_flush_interval";
 const char* CONFIG_DB_AUTO_FLUSH_INTERVAL_DEFAULT = "1";
+const char* CONFIG_DB_AUTO_COMPACT_RATIO = "auto_compact_ratio";
+const char* CONFIG_DB_AUTO_COMPACT_RATIO_DEFAULT = "0";
+const char* CONFIG_DB_AUTO_COMPACT_RATE = "auto_compact_rate";
+const char* CONFIG_DB_AUTO_COMPACT_RATE_DEFAULT = "1024";
 
 /* storage config */
 const char* CONFIG_STORAGE = "storage_config";
@@ -99,6 +104,8 @@ const char* CONFIG_CACHE_INSERT_BUFFER_SIZE = "insert_buffer_size";
 const char* CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT = "1";
 const char* CONFIG_CACHE_CACHE_INSERT_DATA = "cache_insert_data";
 const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT = "false";
+const char* CONFIG_CACHE_RESULT_CACHE_CAPACITY = "result_cache_capacity";
+const char* CONFIG_CACHE_RESULT_CACHE_CAPACITY_DEFAULT = "0";
 
 /* metric config */
 const char* CONFIG_METRIC = "metric_config";
@@ -117,6 +124,20 @@ const char* CONFIG_ENGINE_OMP_THREAD_NUM = "omp_thread_num";
 const char* CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT = "0";
 const char* CONFIG_ENGINE_SIMD_TYPE = "simd_type";
 const char* CONFIG_ENGINE_SIMD_TYPE_DEFAULT = "auto";
+const char* CONFIG_ENGINE_SLOW_QUERY_THRESHOLD = "slow_query_threshold";
+const char* CONFIG_ENGINE_SLOW_QUERY_THRESHOLD_DEFAULT = "0";
+const char* CONFIG_ENGINE_MEMORY_BUDGET = "memory_budget";
+const char* CONFIG_ENGINE_MEMORY_BUDGET_DEFAULT = "0";
+const char* CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA = "collection_memory_quota";
+const char* CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA_DEFAULT = "0";
+const char* CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS = "collection_memory_quotas";
+const char* CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS_DEFAULT = "";
+const char* CONFIG_ENGINE_IVF_LISTS_ON_DISK = "ivf_lists_on_disk";
+const char* CONFIG_ENGINE_IVF_LISTS_ON_DISK_DEFAULT = "false";
+const char* CONFIG_ENGINE_SEARCH_EXECUTOR_NUM = "search_executor_num";
+const char* CONFIG_ENGINE_SEARCH_EXECUTOR_NUM_DEFAULT = "1";
+const char* CONFIG_ENGINE_SEARCH_LOADER_NUM = "search_loader_num";
+const char* CONFIG_ENGINE_SEARCH_LOADER_NUM_DEFAULT = "1";
 const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD = "gpu_search_threshold";
 const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD_DEFAULT = "1000";
 
@@ -180,7 +201,10 @@ const char* CONFIG_LOGS_DELETE_EXCEEDS_DEFAULT = "10";
 const int64_t CONFIG_LOGS_DELETE_EXCEEDS_MAX = 4096;
 const int64_t CONFIG_LOGS_DELETE_EXCEEDS_MIN = 1;
 
+constexpr int64_t MB = 1UL << 20;
 constexpr int64_t GB = 1UL << 30;
+// sizes in GB are bounded before they are counted in bytes, so that neither a size nor the sum of two overflows
+constexpr int64_t MAX_SIZE_IN_GB = std::numeric_limits<int64_t>::max() / GB / 2;
 constexpr int32_t PORT_NUMBER_MIN = 1024;
 constexpr int32_t PORT_NUMBER_MAX = 65535;
 
@@ -201,10 +225,23 @@ Config::Config() {
     std::string node_cache_insert_data = std::string(CONFIG_CACHE) + "." + CONFIG_CACHE_CACHE_INSERT_DATA;
     config_callback_[node_cache_insert_data] = empty_map;
 
+    std::string node_result_cache_capacity = std::string(CONFIG_CACHE) + "." + CONFIG_CACHE_RESULT_CACHE_CAPACITY;
+    config_callback_[node_result_cache_capacity] = empty_map;
+
     // engine config
     std::string node_blas_threshold = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_USE_BLAS_THRESHOLD;
     config_callback_[node_blas_threshold] = empty_map;
 
+    std::string node_memory_budget = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_MEMORY_BUDGET;
+    config_callback_[node_memory_budget] = empty_map;
+
+    std::string node_collection_memory_quota = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA;
+    config_callback_[node_collection_memory_quota] = empty_map;
+
+    std::string node_collection_memory_quotas =
+        std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS;
+    config_callback_[node_collection_memory_quotas] = empty_map;
+
     // gpu resources config
     std::string node_gpu_search_threshold = std::string(CONFIG_ENGINE) + "." + CONFIG_ENGINE_GPU_SEARCH_THRESHOLD;
     config_callback_[node_gpu_search_threshold] = empty_map;
@@ -289,6 +326,12 @@ Config::ValidateConfig() {
     int64_t auto_flush_interval;
     STATUS_CHECK(GetDBConfigAutoFlushInterval(auto_flush_interval));
 
+    float auto_compact_ratio;
+    STATUS_CHECK(GetDBConfigAutoCompactRatio(auto_compact_ratio));
+
+    int64_t auto_compact_rate;
+    STATUS_CHECK(GetDBConfigAutoCompactRate(auto_compact_rate));
+
     /* storage config */
     std::string storage_primary_path;
     STATUS_CHECK(GetStorageConfigPrimaryPath(storage_primary_path));
@@ -338,6 +381,9 @@ Config::ValidateConfig() {
     bool cache_insert_data;
     STATUS_CHECK(GetCacheConfigCacheInsertData(cache_insert_data));
 
+    int64_t cache_result_cache_capacity;
+    STATUS_CHECK(GetCacheConfigResultCacheCapacity(cache_result_cache_capacity));
+
     /* engine config */
     int64_t engine_use_blas_threshold;
     STATUS_CHECK(GetEngineConfigUseBlasThreshold(engine_use_blas_threshold));
@@ -348,6 +394,27 @@ Config::ValidateConfig() {
     std::string engine_simd_type;
     STATUS_CHECK(GetEngineConfigSimdType(engine_simd_type));
 
+    int64_t engine_slow_query_threshold;
+    STATUS_CHECK(GetEngineConfigSlowQueryThreshold(engine_slow_query_threshold));
+
+    int64_t engine_memory_budget;
+    STATUS_CHECK(GetEngineConfigMemoryBudget(engine_memory_budget));
+
+    int64_t engine_collection_memory_quota;
+    STATUS_CHECK(GetEngineConfigCollectionMemoryQuota(engine_collection_memory_quota));
+
+    std::unordered_map<std::string, int64_t> engine_collection_memory_quotas;
+    STATUS_CHECK(GetEngineConfigCollectionMemoryQuotas(engine_collection_memory_quotas));
+
+    bool engine_ivf_lists_on_disk;
+    STATUS_CHECK(GetEngineConfigIvfListsOnDisk(engine_ivf_lists_on_disk));
+
+    int64_t engine_search_executor_num;
+    STATUS_CHECK(GetEngineConfigSearchExecutorNum(engine_search_executor_num));
+
+    int64_t engine_search_loader_num;
+    STATUS_CHECK(GetEngineConfigSearchLoaderNum(engine_search_loader_num));
+
 #ifdef MILVUS_GPU_VERSION
     int64_t engine_gpu_search_threshold;
     STATUS_CHECK(GetEngineConfigGpuSearchThreshold(engine_gpu_search_threshold));
@@ -438,6 +505,8 @@ Config::ResetDefaultConfig() {
     STATUS_CHECK(SetDBConfigArchiveDiskThreshold(CONFIG_DB_ARCHIVE_DISK_THRESHOLD_DEFAULT));
     STATUS_CHECK(SetDBConfigArchiveDaysThreshold(CONFIG_DB_ARCHIVE_DAYS_THRESHOLD_DEFAULT));
     STATUS_CHECK(SetDBConfigAutoFlushInterval(CONFIG_DB_AUTO_FLUSH_INTERVAL_DEFAULT));
+    STATUS_CHECK(SetDBConfigAutoCompactRatio(CONFIG_DB_AUTO_COMPACT_RATIO_DEFAULT));
+    STATUS_CHECK(SetDBConfigAutoCompactRate(CONFIG_DB_AUTO_COMPACT_RATE_DEFAULT));
 
     /* storage config */
     STATUS_CHECK(SetStorageConfigPrimaryPath(CONFIG_STORAGE_PRIMARY_PATH_DEFAULT));
@@ -460,11 +529,19 @@ Config::ResetDefaultConfig() {
     STATUS_CHECK(SetCacheConfigCpuCacheThreshold(CONFIG_CACHE_CPU_CACHE_THRESHOLD_DEFAULT));
     STATUS_CHECK(SetCacheConfigInsertBufferSize(CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT));
     STATUS_CHECK(SetCacheConfigCacheInsertData(CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT));
+    STATUS_CHECK(SetCacheConfigResultCacheCapacity(CONFIG_CACHE_RESULT_CACHE_CAPACITY_DEFAULT));
 
     /* engine config */
     STATUS_CHECK(SetEngineConfigUseBlasThreshold(CONFIG_ENGINE_USE_BLAS_THRESHOLD_DEFAULT));
     STATUS_CHECK(SetEngineConfigOmpThreadNum(CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT));
     STATUS_CHECK(SetEngineConfigSimdType(CONFIG_ENGINE_SIMD_TYPE_DEFAULT));
+    STATUS_CHECK(SetEngineConfigSlowQueryThreshold(CONFIG_ENGINE_SLOW_QUERY_THRESHOLD_DEFAULT));
+    STATUS_CHECK(SetEngineConfigMemoryBudget(CONFIG_ENGINE_MEMORY_BUDGET_DEFAULT));
+    STATUS_CHECK(SetEngineConfigCollectionMemoryQuota(CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA_DEFAULT));
+    STATUS_CHECK(SetEngineConfigCollectionMemoryQuotas(CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS_DEFAULT));
+    STATUS_CHECK(SetEngineConfigIvfListsOnDisk(CONFIG_ENGINE_IVF_LISTS_ON_DISK_DEFAULT));
+    STATUS_CHECK(SetEngineConfigSearchExecutorNum(CONFIG_ENGINE_SEARCH_EXECUTOR_NUM_DEFAULT));
+    STATUS_CHECK(SetEngineConfigSearchLoaderNum(CONFIG_ENGINE_SEARCH_LOADER_NUM_DEFAULT));
 #ifdef MILVUS_GPU_VERSION
     STATUS_CHECK(SetEngineConfigGpuSearchThreshold(CONFIG_ENGINE_GPU_SEARCH_THRESHOLD_DEFAULT));
 #endif
@@ -542,6 +619,10 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetDBConfigPreloadCollection(value);
         } else if (child_key == CONFIG_DB_AUTO_FLUSH_INTERVAL) {
             status = SetDBConfigAutoFlushInterval(value);
+        } else if (child_key == CONFIG_DB_AUTO_COMPACT_RATIO) {
+            status = SetDBConfigAutoCompactRatio(value);
+        } else if (child_key == CONFIG_DB_AUTO_COMPACT_RATE) {
+            status = SetDBConfigAutoCompactRate(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -584,6 +665,8 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetCacheConfigCacheInsertData(value);
         } else if (child_key == CONFIG_CACHE_INSERT_BUFFER_SIZE) {
             status = SetCacheConfigInsertBufferSize(value);
+        } else if (child_key == CONFIG_CACHE_RESULT_CACHE_CAPACITY) {
+            status = SetCacheConfigResultCacheCapacity(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -594,6 +677,20 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetEngineConfigOmpThreadNum(value);
         } else if (child_key == CONFIG_ENGINE_SIMD_TYPE) {
             status = SetEngineConfigSimdType(value);
+        } else if (child_key == CONFIG_ENGINE_SLOW_QUERY_THRESHOLD) {
+            status = SetEngineConfigSlowQueryThreshold(value);
+        } else if (child_key == CONFIG_ENGINE_MEMORY_BUDGET) {
+            status = SetEngineConfigMemoryBudget(value);
+        } else if (child_key == CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA) {
+            status = SetEngineConfigCollectionMemoryQuota(value);
+        } else if (child_key == CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS) {
+            status = SetEngineConfigCollectionMemoryQuotas(value);
+        } else if (child_key == CONFIG_ENGINE_IVF_LISTS_ON_DISK) {
+            status = SetEngineConfigIvfListsOnDisk(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_EXECUTOR_NUM) {
+            status = SetEngineConfigSearchExecutorNum(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_LOADER_NUM) {
+            status = SetEngineConfigSearchLoaderNum(value);
 #ifdef MILVUS_GPU_VERSION
         } else if (child_key == CONFIG_ENGINE_GPU_SEARCH_THRESHOLD) {
             status = SetEngineConfigGpuSearchThreshold(value);
@@ -1043,6 +1140,34 @@ Config::CheckDBConfigAutoFlushInterval(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckDBConfigAutoCompactRatio(const std::string& value) {
+    fiu_return_on("check_config_auto_compact_ratio_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string msg = "Invalid db configuration auto_compact_ratio: " + value +
+                      ". Possible reason: db_config.auto_compact_ratio is not in range [0.0, 1.0).";
+    if (!ValidationUtil::ValidateStringIsFloat(value).ok()) {
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    float threshold = std::stof(value);
+    if (threshold < 0.0 || threshold >= 1.0) {
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckDBConfigAutoCompactRate(const std::string& value) {
+    fiu_return_on("check_config_auto_compact_rate_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok() || std::stoll(value) == 0) {
+        std::string msg = "Invalid db configuration auto_compact_rate: " + value +
+                          ". Possible reason: db_config.auto_compact_rate is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* storage config */
 Status
 Config::CheckStorageConfigPrimaryPath(const std::string& value) {
@@ -1225,6 +1350,10 @@ Config::CheckCacheConfigCpuCacheCapacity(const std::string& value) {
         std::string msg = "Invalid cpu cache capacity: " + value +
                           ". Possible reason: cache_config.cpu_cache_capacity is not a positive integer.";
         return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else if (std::stoll(value) > MAX_SIZE_IN_GB) {
+        std::string msg = "Invalid cpu cache capacity: " + value +
+                          ". Possible reason: cache_config.cpu_cache_capacity exceeds system memory.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
     } else {
         int64_t cpu_cache_capacity = std::stoll(value) * GB;
         if (cpu_cache_capacity <= 0) {
@@ -1244,7 +1373,7 @@ Config::CheckCacheConfigCpuCacheCapacity(const std::string& value) {
         }
 
         std::string str = GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_INSERT_BUFFER_SIZE, "0");
-        int64_t buffer_value = std::stoll(str);
+        int64_t buffer_value = std::min<int64_t>(std::stoll(str), MAX_SIZE_IN_GB);
 
         int64_t insert_buffer_size = buffer_value * GB;
         fiu_do_on("Config.CheckCacheConfigCpuCacheCapacity.large_insert_buffer", insert_buffer_size = total_mem + 1);
@@ -1284,6 +1413,10 @@ Config::CheckCacheConfigInsertBufferSize(const std::string& value) {
         std::string msg = "Invalid insert buffer size: " + value +
                           ". Possible reason: cache_config.insert_buffer_size is not a positive integer.";
         return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else if (std::stoll(value) > MAX_SIZE_IN_GB) {
+        std::string msg = "Invalid insert buffer size: " + value +
+                          ". Possible reason: cache_config.insert_buffer_size exceeds system memory.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
     } else {
         int64_t buffer_size = std::stoll(value) * GB;
         if (buffer_size <= 0) {
@@ -1293,7 +1426,7 @@ Config::CheckCacheConfigInsertBufferSize(const std::string& value) {
         }
 
         std::string str = GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_CAPACITY, "0");
-        int64_t cache_size = std::stoll(str) * GB;
+        int64_t cache_size = std::min<int64_t>(std::stoll(str), MAX_SIZE_IN_GB) * GB;
 
         uint64_t total_mem = 0, free_mem = 0;
         CommonUtil::GetSystemMemInfo(total_mem, free_mem);
@@ -1318,6 +1451,27 @@ Config::CheckCacheConfigCacheInsertData(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckCacheConfigResultCacheCapacity(const std::string& value) {
+    fiu_return_on("check_config_result_cache_capacity_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid result cache capacity: " + value +
+                          ". Possible reason: cache_config.result_cache_capacity is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t capacity = std::stoll(value) * MB;
+    uint64_t total_mem = 0, free_mem = 0;
+    CommonUtil::GetSystemMemInfo(total_mem, free_mem);
+    if (static_cast<uint64_t>(capacity) >= total_mem) {
+        std::string msg = "Invalid result cache capacity: " + value +
+                          ". Possible reason: cache_config.result_cache_capacity exceeds system memory.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::CheckEngineConfigUseBlasThreshold(const std::string& value) {
@@ -1363,6 +1517,147 @@ Config::CheckEngineConfigSimdType(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckEngineConfigSlowQueryThreshold(const std::string& value) {
+    fiu_return_on("check_config_slow_query_threshold_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid slow query threshold: " + value +
+                          ". Possible reason: engine_config.slow_query_threshold is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigMemoryBudget(const std::string& value) {
+    fiu_return_on("check_config_memory_budget_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid memory budget: " + value +
+                          ". Possible reason: engine_config.memory_budget is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    uint64_t total_mem = 0, free_mem = 0;
+    CommonUtil::GetSystemMemInfo(total_mem, free_mem);
+    if (std::stoll(value) > MAX_SIZE_IN_GB || static_cast<uint64_t>(std::stoll(value) * GB) > total_mem) {
+        std::string msg = "Invalid memory budget: " + value +
+                          ". Possible reason: engine_config.memory_budget exceeds system memory.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigCollectionMemoryQuota(const std::string& value) {
+    fiu_return_on("check_config_collection_memory_quota_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid collection memory quota: " + value +
+                          ". Possible reason: engine_config.collection_memory_quota is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else if (std::stoll(value) > MAX_SIZE_IN_GB) {
+        std::string msg = "Invalid collection memory quota: " + value +
+                          ". Possible reason: engine_config.collection_memory_quota is too large.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigCollectionMemoryQuotas(const std::string& value) {
+    fiu_return_on("check_config_collection_memory_quotas_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (value.empty()) {
+        return Status::OK();
+    }
+
+    std::vector<std::string> quotas;
+    StringHelpFunctions::SplitStringByDelimeter(value, ",", quotas);
+
+    std::unordered_set<std::string> collection_set;
+    for (auto& quota : quotas) {
+        std::vector<std::string> pair;
+        StringHelpFunctions::SplitStringByDelimeter(quota, ":", pair);
+        if (pair.size() != 2) {
+            std::string msg = "Invalid collection memory quotas: " + value +
+                              ". Possible reason: engine_config.collection_memory_quotas is not in format "
+                              "'collection:quota,collection:quota'.";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+        StringHelpFunctions::TrimStringBlank(pair[0]);
+        StringHelpFunctions::TrimStringBlank(pair[1]);
+        if (!ValidationUtil::ValidateCollectionName(pair[0]).ok()) {
+            return Status(SERVER_INVALID_ARGUMENT, "Invalid collection name: " + pair[0]);
+        }
+        if (!ValidationUtil::ValidateStringIsNumber(pair[1]).ok()) {
+            std::string msg = "Invalid collection memory quota: " + pair[1] +
+                              ". Possible reason: quota of collection " + pair[0] + " is not a positive integer.";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        } else if (std::stoll(pair[1]) > MAX_SIZE_IN_GB) {
+            std::string msg = "Invalid collection memory quota: " + pair[1] +
+                              ". Possible reason: quota of collection " + pair[0] + " is too large.";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+        collection_set.insert(pair[0]);
+    }
+
+    if (collection_set.size() != quotas.size()) {
+        return Status(SERVER_INVALID_ARGUMENT, "Collection memory quota is duplicated");
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigIvfListsOnDisk(const std::string& value) {
+    auto exist_error = !ValidationUtil::ValidateStringIsBool(value).ok();
+    fiu_do_on("check_config_ivf_lists_on_disk_fail", exist_error = true);
+
+    if (exist_error) {
+        std::string msg =
+            "Invalid engine config: " + value + ". Possible reason: engine_config.ivf_lists_on_disk is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchExecutorNum(const std::string& value) {
+    fiu_return_on("check_config_search_executor_num_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string msg = "Invalid search executor num: " + value +
+                      ". Possible reason: engine_config.search_executor_num is not in range [1, cpu cores].";
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    int64_t executor_num = std::stoll(value);
+    int64_t sys_thread_cnt = 8;
+    CommonUtil::GetSystemAvailableThreads(sys_thread_cnt);
+    if (executor_num < 1 || executor_num > sys_thread_cnt) {
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchLoaderNum(const std::string& value) {
+    fiu_return_on("check_config_search_loader_num_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string msg = "Invalid search loader num: " + value +
+                      ". Possible reason: engine_config.search_loader_num is not in range [1, cpu cores].";
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    int64_t loader_num = std::stoll(value);
+    int64_t sys_thread_cnt = 8;
+    CommonUtil::GetSystemAvailableThreads(sys_thread_cnt);
+    if (loader_num < 1 || loader_num > sys_thread_cnt) {
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 #ifdef MILVUS_GPU_VERSION
 
 Status
@@ -1398,6 +1693,10 @@ Config::CheckGpuResourceConfigCacheCapacity(const std::string& value) {
         std::string msg = "Invalid gpu cache capacity: " + value +
                           ". Possible reason: gpu_resource_config.cache_capacity is not a positive integer.";
         return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else if (std::stoll(value) > MAX_SIZE_IN_GB) {
+        std::string msg = "Invalid gpu cache capacity: " + value +
+                          ". Possible reason: gpu_resource_config.cache_capacity exceeds GPU memory.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
     } else {
         int64_t gpu_cache_capacity = std::stoll(value) * GB;
         std::vector<int64_t> gpu_ids;
@@ -1864,6 +2163,22 @@ Config::GetDBConfigAutoFlushInterval(int64_t& value) {
     return Status::OK();
 }
 
+Status
+Config::GetDBConfigAutoCompactRatio(float& value) {
+    std::string str = GetConfigStr(CONFIG_DB, CONFIG_DB_AUTO_COMPACT_RATIO, CONFIG_DB_AUTO_COMPACT_RATIO_DEFAULT);
+    STATUS_CHECK(CheckDBConfigAutoCompactRatio(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
+Status
+Config::GetDBConfigAutoCompactRate(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_DB, CONFIG_DB_AUTO_COMPACT_RATE, CONFIG_DB_AUTO_COMPACT_RATE_DEFAULT);
+    STATUS_CHECK(CheckDBConfigAutoCompactRate(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* storage config */
 Status
 Config::GetStorageConfigPrimaryPath(std::string& value) {
@@ -1983,6 +2298,15 @@ Config::GetCacheConfigCacheInsertData(bool& value) {
     return Status::OK();
 }
 
+Status
+Config::GetCacheConfigResultCacheCapacity(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_RESULT_CACHE_CAPACITY, CONFIG_CACHE_RESULT_CACHE_CAPACITY_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigResultCacheCapacity(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::GetEngineConfigUseBlasThreshold(int64_t& value) {
@@ -2007,6 +2331,81 @@ Config::GetEngineConfigSimdType(std::string& value) {
     return CheckEngineConfigSimdType(value);
 }
 
+Status
+Config::GetEngineConfigSlowQueryThreshold(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SLOW_QUERY_THRESHOLD, CONFIG_ENGINE_SLOW_QUERY_THRESHOLD_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigSlowQueryThreshold(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigMemoryBudget(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_MEMORY_BUDGET, CONFIG_ENGINE_MEMORY_BUDGET_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigMemoryBudget(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigCollectionMemoryQuota(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA,
+                                   CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigCollectionMemoryQuota(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigCollectionMemoryQuotas(std::unordered_map<std::string, int64_t>& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS,
+                                   CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigCollectionMemoryQuotas(str));
+
+    value.clear();
+    if (str.empty()) {
+        return Status::OK();
+    }
+
+    std::vector<std::string> quotas;
+    StringHelpFunctions::SplitStringByDelimeter(str, ",", quotas);
+    for (auto& quota : quotas) {
+        std::vector<std::string> pair;
+        StringHelpFunctions::SplitStringByDelimeter(quota, ":", pair);
+        StringHelpFunctions::TrimStringBlank(pair[0]);
+        StringHelpFunctions::TrimStringBlank(pair[1]);
+        value[pair[0]] = std::stoll(pair[1]);
+    }
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigIvfListsOnDisk(bool& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_IVF_LISTS_ON_DISK, CONFIG_ENGINE_IVF_LISTS_ON_DISK_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigIvfListsOnDisk(str));
+    return StringHelpFunctions::ConvertToBoolean(str, value);
+}
+
+Status
+Config::GetEngineConfigSearchExecutorNum(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_EXECUTOR_NUM, CONFIG_ENGINE_SEARCH_EXECUTOR_NUM_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigSearchExecutorNum(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSearchLoaderNum(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_LOADER_NUM, CONFIG_ENGINE_SEARCH_LOADER_NUM_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigSearchLoaderNum(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 #ifdef MILVUS_GPU_VERSION
 Status
 Config::GetEngineConfigGpuSearchThreshold(int64_t& value) {
@@ -2324,6 +2723,18 @@ Config::SetDBConfigAutoFlushInterval(const std::string& value) {
     return SetConfigValueInMem(CONFIG_DB, CONFIG_DB_AUTO_FLUSH_INTERVAL, value);
 }
 
+Status
+Config::SetDBConfigAutoCompactRatio(const std::string& value) {
+    STATUS_CHECK(CheckDBConfigAutoCompactRatio(value));
+    return SetConfigValueInMem(CONFIG_DB, CONFIG_DB_AUTO_COMPACT_RATIO, value);
+}
+
+Status
+Config::SetDBConfigAutoCompactRate(const std::string& value) {
+    STATUS_CHECK(CheckDBConfigAutoCompactRate(value));
+    return SetConfigValueInMem(CONFIG_DB, CONFIG_DB_AUTO_COMPACT_RATE, value);
+}
+
 /* storage config */
 Status
 Config::SetStorageConfigPrimaryPath(const std::string& value) {
@@ -2426,6 +2837,13 @@ Config::SetCacheConfigCacheInsertData(const std::string& value) {
     return ExecCallBacks(CONFIG_CACHE, CONFIG_CACHE_CACHE_INSERT_DATA, value);
 }
 
+Status
+Config::SetCacheConfigResultCacheCapacity(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigResultCacheCapacity(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_RESULT_CACHE_CAPACITY, value));
+    return ExecCallBacks(CONFIG_CACHE, CONFIG_CACHE_RESULT_CACHE_CAPACITY, value);
+}
+
 /* engine config */
 Status
 Config::SetEngineConfigUseBlasThreshold(const std::string& value) {
@@ -2446,6 +2864,51 @@ Config::SetEngineConfigSimdType(const std::string& value) {
     return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SIMD_TYPE, value);
 }
 
+Status
+Config::SetEngineConfigSlowQueryThreshold(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigSlowQueryThreshold(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SLOW_QUERY_THRESHOLD, value);
+}
+
+Status
+Config::SetEngineConfigMemoryBudget(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigMemoryBudget(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_MEMORY_BUDGET, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_MEMORY_BUDGET, value);
+}
+
+Status
+Config::SetEngineConfigCollectionMemoryQuota(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigCollectionMemoryQuota(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA, value);
+}
+
+Status
+Config::SetEngineConfigCollectionMemoryQuotas(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigCollectionMemoryQuotas(value));
+    STATUS_CHECK(SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS, value));
+    return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS, value);
+}
+
+Status
+Config::SetEngineConfigIvfListsOnDisk(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigIvfListsOnDisk(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_IVF_LISTS_ON_DISK, value);
+}
+
+Status
+Config::SetEngineConfigSearchExecutorNum(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigSearchExecutorNum(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_EXECUTOR_NUM, value);
+}
+
+Status
+Config::SetEngineConfigSearchLoaderNum(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigSearchLoaderNum(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_LOADER_NUM, value);
+}
+
 #ifdef MILVUS_GPU_VERSION
 Status
 Config::SetEngineConfigGpuSearchThreshold(const std::string& value) {
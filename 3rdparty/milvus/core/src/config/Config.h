@@ -55,6 +55,10 @@ extern const char* CONFIG_DB_PRELOAD_COLLECTION;
 extern const char* CONFIG_DB_PRELOAD_COLLECTION_DEFAULT;
 extern const char* CONFIG_DB_AUTO_FLUSH_INTERVAL;
 extern const char* CONFIG_DB_AUTO_FLUSH_INTERVAL_DEFAULT;
+extern const char* CONFIG_DB_AUTO_COMPACT_RATIO;
+extern const char* CONFIG_DB_AUTO_COMPACT_RATIO_DEFAULT;
+extern const char* CONFIG_DB_AUTO_COMPACT_RATE;
+extern const char* CONFIG_DB_AUTO_COMPACT_RATE_DEFAULT;
 
 /* storage config */
 extern const char* CONFIG_STORAGE;
@@ -86,6 +90,8 @@ extern const char* CONFIG_CACHE_INSERT_BUFFER_SIZE;
 extern const char* CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT;
 extern const char* CONFIG_CACHE_CACHE_INSERT_DATA;
 extern const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT;
+extern const char* CONFIG_CACHE_RESULT_CACHE_CAPACITY;
+extern const char* CONFIG_CACHE_RESULT_CACHE_CAPACITY_DEFAULT;
 
 /* metric config */
 extern const char* CONFIG_METRIC;
@@ -104,6 +110,20 @@ extern const char* CONFIG_ENGINE_OMP_THREAD_NUM;
 extern const char* CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT;
 extern const char* CONFIG_ENGINE_SIMD_TYPE;
 extern const char* CONFIG_ENGINE_SIMD_TYPE_DEFAULT;
+extern const char* CONFIG_ENGINE_SLOW_QUERY_THRESHOLD;
+extern const char* CONFIG_ENGINE_SLOW_QUERY_THRESHOLD_DEFAULT;
+extern const char* CONFIG_ENGINE_MEMORY_BUDGET;
+extern const char* CONFIG_ENGINE_MEMORY_BUDGET_DEFAULT;
+extern const char* CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA;
+extern const char* CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA_DEFAULT;
+extern const char* CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS;
+extern const char* CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS_DEFAULT;
+extern const char* CONFIG_ENGINE_IVF_LISTS_ON_DISK;
+extern const char* CONFIG_ENGINE_IVF_LISTS_ON_DISK_DEFAULT;
+extern const char* CONFIG_ENGINE_SEARCH_EXECUTOR_NUM;
+extern const char* CONFIG_ENGINE_SEARCH_EXECUTOR_NUM_DEFAULT;
+extern const char* CONFIG_ENGINE_SEARCH_LOADER_NUM;
+extern const char* CONFIG_ENGINE_SEARCH_LOADER_NUM_DEFAULT;
 extern const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD;
 extern const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD_DEFAULT;
 
@@ -238,6 +258,10 @@ class Config {
     CheckDBConfigArchiveDaysThreshold(const std::string& value);
     Status
     CheckDBConfigAutoFlushInterval(const std::string& value);
+    Status
+    CheckDBConfigAutoCompactRatio(const std::string& value);
+    Status
+    CheckDBConfigAutoCompactRate(const std::string& value);
 
     /* storage config */
     Status
@@ -276,6 +300,8 @@ class Config {
     CheckCacheConfigInsertBufferSize(const std::string& value);
     Status
     CheckCacheConfigCacheInsertData(const std::string& value);
+    Status
+    CheckCacheConfigResultCacheCapacity(const std::string& value);
 
     /* engine config */
     Status
@@ -284,6 +310,20 @@ class Config {
     CheckEngineConfigOmpThreadNum(const std::string& value);
     Status
     CheckEngineConfigSimdType(const std::string& value);
+    Status
+    CheckEngineConfigSlowQueryThreshold(const std::string& value);
+    Status
+    CheckEngineConfigMemoryBudget(const std::string& value);
+    Status
+    CheckEngineConfigCollectionMemoryQuota(const std::string& value);
+    Status
+    CheckEngineConfigCollectionMemoryQuotas(const std::string& value);
+    Status
+    CheckEngineConfigIvfListsOnDisk(const std::string& value);
+    Status
+    CheckEngineConfigSearchExecutorNum(const std::string& value);
+    Status
+    CheckEngineConfigSearchLoaderNum(const std::string& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -373,6 +413,10 @@ class Config {
     GetDBConfigPreloadCollection(std::string& value);
     Status
     GetDBConfigAutoFlushInterval(int64_t& value);
+    Status
+    GetDBConfigAutoCompactRatio(float& value);
+    Status
+    GetDBConfigAutoCompactRate(int64_t& value);
 
     /* storage config */
     Status
@@ -411,6 +455,8 @@ class Config {
     GetCacheConfigInsertBufferSize(int64_t& value);
     Status
     GetCacheConfigCacheInsertData(bool& value);
+    Status
+    GetCacheConfigResultCacheCapacity(int64_t& value);
 
     /* engine config */
     Status
@@ -419,6 +465,20 @@ class Config {
     GetEngineConfigOmpThreadNum(int64_t& value);
     Status
     GetEngineConfigSimdType(std::string& value);
+    Status
+    GetEngineConfigSlowQueryThreshold(int64_t& value);
+    Status
+    GetEngineConfigMemoryBudget(int64_t& value);
+    Status
+    GetEngineConfigCollectionMemoryQuota(int64_t& value);
+    Status
+    GetEngineConfigCollectionMemoryQuotas(std::unordered_map<std::string, int64_t>& value);
+    Status
+    GetEngineConfigIvfListsOnDisk(bool& value);
+    Status
+    GetEngineConfigSearchExecutorNum(int64_t& value);
+    Status
+    GetEngineConfigSearchLoaderNum(int64_t& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -500,6 +560,10 @@ class Config {
     SetDBConfigArchiveDaysThreshold(const std::string& value);
     Status
     SetDBConfigAutoFlushInterval(const std::string& value);
+    Status
+    SetDBConfigAutoCompactRatio(const std::string& value);
+    Status
+    SetDBConfigAutoCompactRate(const std::string& value);
 
     /* storage config */
     Status
@@ -538,6 +602,8 @@ class Config {
     SetCacheConfigInsertBufferSize(const std::string& value);
     Status
     SetCacheConfigCacheInsertData(const std::string& value);
+    Status
+    SetCacheConfigResultCacheCapacity(const std::string& value);
 
     /* engine config */
     Status
@@ -546,6 +612,20 @@ class Config {
     SetEngineConfigOmpThreadNum(const std::string& value);
     Status
     SetEngineConfigSimdType(const std::string& value);
+    Status
+    SetEngineConfigSlowQueryThreshold(const std::string& value);
+    Status
+    SetEngineConfigMemoryBudget(const std::string& value);
+    Status
+    SetEngineConfigCollectionMemoryQuota(const std::string& value);
+    Status
+    SetEngineConfigCollectionMemoryQuotas(const std::string& value);
+    Status
+    SetEngineConfigIvfListsOnDisk(const std::string& value);
+    Status
+    SetEngineConfigSearchExecutorNum(const std::string& value);
+    Status
+    SetEngineConfigSearchLoaderNum(const std::string& value);
 #ifdef MILVUS_GPU_VERSION
     Status
     SetEngineConfigGpuSearchThreshold(const std::string& value);
@@ -19,10 +19,16 @@ namespace server {
 EngineConfigHandler::EngineConfigHandler() {
     auto& config = Config::GetInstance();
     config.GetEngineConfigUseBlasThreshold(use_blas_threshold_);
+    config.GetEngineConfigMemoryBudget(memory_budget_);
+    config.GetEngineConfigCollectionMemoryQuota(collection_memory_quota_);
+    config.GetEngineConfigCollectionMemoryQuotas(collection_memory_quotas_);
 }
 
 EngineConfigHandler::~EngineConfigHandler() {
     RemoveUseBlasThresholdListener();
+    RemoveMemoryBudgetListener();
+    RemoveCollectionMemoryQuotaListener();
+    RemoveCollectionMemoryQuotasListener();
 }
 
 //////////////////////////// Listener methods //////////////////////////////////
@@ -42,11 +48,77 @@ EngineConfigHandler::AddUseBlasThresholdListener() {
     config.RegisterCallBack(CONFIG_ENGINE, CONFIG_ENGINE_USE_BLAS_THRESHOLD, identity_, lambda);
 }
 
+void
+EngineConfigHandler::AddMemoryBudgetListener() {
+    ConfigCallBackF lambda = [this](const std::string& value) -> Status {
+        auto& config = server::Config::GetInstance();
+        auto status = config.GetEngineConfigMemoryBudget(memory_budget_);
+        if (status.ok()) {
+            OnMemoryBudgetChanged(memory_budget_);
+        }
+
+        return status;
+    };
+
+    auto& config = Config::GetInstance();
+    config.RegisterCallBack(CONFIG_ENGINE, CONFIG_ENGINE_MEMORY_BUDGET, identity_, lambda);
+}
+
+void
+EngineConfigHandler::AddCollectionMemoryQuotaListener() {
+    ConfigCallBackF lambda = [this](const std::string& value) -> Status {
+        auto& config = server::Config::GetInstance();
+        auto status = config.GetEngineConfigCollectionMemoryQuota(collection_memory_quota_);
+        if (status.ok()) {
+            OnCollectionMemoryQuotaChanged(collection_memory_quota_);
+        }
+
+        return status;
+    };
+
+    auto& config = Config::GetInstance();
+    config.RegisterCallBack(CONFIG_ENGINE, CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA, identity_, lambda);
+}
+
+void
+EngineConfigHandler::AddCollectionMemoryQuotasListener() {
+    ConfigCallBackF lambda = [this](const std::string& value) -> Status {
+        auto& config = server::Config::GetInstance();
+        auto status = config.GetEngineConfigCollectionMemoryQuotas(collection_memory_quotas_);
+        if (status.ok()) {
+            OnCollectionMemoryQuotasChanged(collection_memory_quotas_);
+        }
+
+        return status;
+    };
+
+    auto& config = Config::GetInstance();
+    config.RegisterCallBack(CONFIG_ENGINE, CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS, identity_, lambda);
+}
+
 void
 EngineConfigHandler::RemoveUseBlasThresholdListener() {
     auto& config = Config::GetInstance();
     config.CancelCallBack(CONFIG_ENGINE, CONFIG_ENGINE_USE_BLAS_THRESHOLD, identity_);
 }
 
+void
+EngineConfigHandler::RemoveMemoryBudgetListener() {
+    auto& config = Config::GetInstance();
+    config.CancelCallBack(CONFIG_ENGINE, CONFIG_ENGINE_MEMORY_BUDGET, identity_);
+}
+
+void
+EngineConfigHandler::RemoveCollectionMemoryQuotaListener() {
+    auto& config = Config::GetInstance();
+    config.CancelCallBack(CONFIG_ENGINE, CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA, identity_);
+}
+
+void
+EngineConfigHandler::RemoveCollectionMemoryQuotasListener() {
+    auto& config = Config::GetInstance();
+    config.CancelCallBack(CONFIG_ENGINE, CONFIG_ENGINE_COLLECTION_MEMORY_QUOTAS, identity_);
+}
+
 }  // namespace server
 }  // namespace milvus
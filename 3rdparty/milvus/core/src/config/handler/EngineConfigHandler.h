@@ -11,6 +11,9 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
+
 #include "config/Config.h"
 #include "config/handler/ConfigHandler.h"
 
@@ -28,16 +31,49 @@ class EngineConfigHandler : virtual public ConfigHandler {
     OnUseBlasThresholdChanged(int64_t threshold) {
     }
 
+    virtual void
+    OnMemoryBudgetChanged(int64_t budget) {
+    }
+
+    virtual void
+    OnCollectionMemoryQuotaChanged(int64_t quota) {
+    }
+
+    virtual void
+    OnCollectionMemoryQuotasChanged(const std::unordered_map<std::string, int64_t>& quotas) {
+    }
+
  protected:
     void
     AddUseBlasThresholdListener();
 
+    void
+    AddMemoryBudgetListener();
+
+    void
+    AddCollectionMemoryQuotaListener();
+
+    void
+    AddCollectionMemoryQuotasListener();
+
  protected:
     void
     RemoveUseBlasThresholdListener();
 
+    void
+    RemoveMemoryBudgetListener();
+
+    void
+    RemoveCollectionMemoryQuotaListener();
+
+    void
+    RemoveCollectionMemoryQuotasListener();
+
  protected:
     int64_t use_blas_threshold_ = std::stoll(CONFIG_ENGINE_USE_BLAS_THRESHOLD_DEFAULT);
+    int64_t memory_budget_ = std::stoll(CONFIG_ENGINE_MEMORY_BUDGET_DEFAULT);
+    int64_t collection_memory_quota_ = std::stoll(CONFIG_ENGINE_COLLECTION_MEMORY_QUOTA_DEFAULT);
+    std::unordered_map<std::string, int64_t> collection_memory_quotas_;
 };
 
 }  // namespace server
@@ -70,6 +70,10 @@ class DB {
     virtual Status
     GetCollectionRowCount(const std::string& collection_id, uint64_t& row_count) = 0;
 
+    // data version of a collection, changes whenever the result of a search on the collection may change
+    virtual Status
+    GetCollectionVersion(const std::string& collection_id, uint64_t& version) = 0;
+
     virtual Status
     PreloadCollection(const std::string& collection_id) = 0;
 
@@ -130,6 +134,14 @@ class DB {
           const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
           const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) = 0;
 
+    // search several collections at once and merge into one top k, result_collections holds the position in
+    // collection_ids of each hit, -1 where there is no hit
+    virtual Status
+    QueryCollections(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& collection_ids,
+                     const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
+                     const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances,
+                     std::vector<int64_t>& result_collections) = 0;
+
     virtual Status
     QueryByFileID(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& file_ids, uint64_t k,
                   const milvus::json& extra_params, const VectorsData& vectors, ResultIds& result_ids,
@@ -138,6 +150,11 @@ class DB {
     virtual Status
     Size(uint64_t& result) = 0;
 
+    // position of a read replica in the wal of the writable node: applied_lsn, written_lsn and lag_ms, the time
+    // since the replica last applied all the written records
+    virtual Status
+    GetReplicationStatus(milvus::json& replication_status) = 0;
+
     virtual Status
     CreateIndex(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
                 const CollectionIndex& index) = 0;
@@ -148,6 +165,13 @@ class DB {
     virtual Status
     DropIndex(const std::string& collection_id) = 0;
 
+    // search a sample of the indexed segments with increasing nprobe (IVF) or ef (HNSW) and compare with the exact
+    // top k, the cheapest value reaching target_recall is kept with the collection index and used by searches that
+    // do not give it. vectors are the queries to measure with, empty to sample vectors of the segments
+    virtual Status
+    TuneSearchParams(const std::string& collection_id, uint64_t k, double target_recall, const VectorsData& vectors,
+                     milvus::json& tune_result) = 0;
+
     virtual Status
     DropAll() = 0;
 
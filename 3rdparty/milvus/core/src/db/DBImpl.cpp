@@ -23,9 +23,11 @@
 #include <limits>
 #include <mutex>
 #include <queue>
+#include <random>
 #include <set>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "Utils.h"
@@ -35,6 +37,7 @@
 #include "db/merge/MergeManagerFactory.h"
 #include "engine/EngineFactory.h"
 #include "index/knowhere/knowhere/index/vector_index/helpers/BuilderSuspend.h"
+#include "index/knowhere/knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "index/thirdparty/faiss/utils/distances.h"
 #include "insert/MemManagerFactory.h"
 #include "meta/MetaConsts.h"
@@ -46,6 +49,7 @@
 #include "scheduler/job/BuildIndexJob.h"
 #include "scheduler/job/DeleteJob.h"
 #include "scheduler/job/SearchJob.h"
+#include "scheduler/task/SearchTask.h"
 #include "segment/SegmentReader.h"
 #include "segment/SegmentWriter.h"
 #include "utils/Exception.h"
@@ -64,6 +68,13 @@ namespace {
 constexpr uint64_t BACKGROUND_METRIC_INTERVAL = 1;
 constexpr uint64_t BACKGROUND_INDEX_INTERVAL = 1;
 constexpr uint64_t WAIT_BUILD_INDEX_INTERVAL = 5;
+constexpr uint64_t BACKGROUND_REPLICA_INTERVAL = 100;  // milliseconds
+constexpr int64_t REPLICA_APPLY_BATCH = 1000;
+
+constexpr size_t TUNE_SAMPLE_SEGMENTS = 4;
+constexpr int64_t TUNE_SAMPLE_NQ = 100;
+constexpr int64_t TUNE_MAX_EF = 4096;
+constexpr uint32_t TUNE_SAMPLE_SEED = 20200611;
 
 constexpr const char* JSON_ROW_COUNT = "row_count";
 constexpr const char* JSON_PARTITIONS = "partitions";
@@ -72,9 +83,51 @@ constexpr const char* JSON_SEGMENTS = "segments";
 constexpr const char* JSON_SEGMENT_NAME = "name";
 constexpr const char* JSON_INDEX_NAME = "index_name";
 constexpr const char* JSON_DATA_SIZE = "data_size";
+constexpr const char* JSON_APPLIED_LSN = "applied_lsn";
+constexpr const char* JSON_WRITTEN_LSN = "written_lsn";
+constexpr const char* JSON_LAG_MS = "lag_ms";
 
 static const Status SHUTDOWN_ERROR = Status(DB_ERROR, "Milvus server is shutdown!");
 
+// reduce the top k lists of several collections into one, result_collections tells where each hit comes from
+void
+MergeCollectionHits(const std::vector<ResultIds>& ids_list, const std::vector<ResultDistances>& distances_list,
+                    uint64_t nq, uint64_t k, bool ascending, ResultIds& result_ids, ResultDistances& result_distances,
+                    std::vector<int64_t>& result_collections) {
+    float worst = ascending ? std::numeric_limits<float>::max() : std::numeric_limits<float>::lowest();
+    result_ids.assign(nq * k, -1);
+    result_distances.assign(nq * k, worst);
+    result_collections.assign(nq * k, -1);
+
+    std::vector<uint64_t> pos(ids_list.size());
+    for (uint64_t i = 0; i < nq; ++i) {
+        std::fill(pos.begin(), pos.end(), 0);
+        for (uint64_t j = 0; j < k; ++j) {
+            int64_t best = -1;
+            uint64_t best_idx = 0;
+            for (size_t c = 0; c < ids_list.size(); ++c) {
+                uint64_t src_k = ids_list[c].size() / nq;
+                uint64_t idx = i * src_k + pos[c];
+                if (pos[c] >= src_k || ids_list[c][idx] == -1) {
+                    continue;  // no hit left, the padding comes last
+                }
+                if (best == -1 || (ascending && distances_list[c][idx] < distances_list[best][best_idx]) ||
+                    (!ascending && distances_list[c][idx] > distances_list[best][best_idx])) {
+                    best = c;
+                    best_idx = idx;
+                }
+            }
+            if (best == -1) {
+                break;
+            }
+            result_ids[i * k + j] = ids_list[best][best_idx];
+            result_distances[i * k + j] = distances_list[best][best_idx];
+            result_collections[i * k + j] = best;
+            ++pos[best];
+        }
+    }
+}
+
 }  // namespace
 
 DBImpl::DBImpl(const DBOptions& options)
@@ -83,7 +136,11 @@ DBImpl::DBImpl(const DBOptions& options)
     mem_mgr_ = MemManagerFactory::Build(meta_ptr_, options_);
     merge_mgr_ptr_ = MergeManagerFactory::Build(meta_ptr_, options_);
 
-    if (options_.wal_enable_) {
+    if (options_.wal_enable_ && options_.mode_ == DBOptions::MODE::CLUSTER_READONLY) {
+        // read replica: the wal of the writable node is followed, never recovered or written
+        replica_tailer_ = std::make_shared<wal::MXLogTailer>(options_.mxlog_path_);
+        options_.wal_enable_ = false;
+    } else if (options_.wal_enable_) {
         wal::MXLogConfiguration mxlog_config;
         mxlog_config.recovery_error_ignore = options_.recovery_error_ignore_;
         // 2 buffers in the WAL
@@ -116,7 +173,9 @@ DBImpl::Start() {
     initialized_.store(true, std::memory_order_release);
 
     // wal
-    if (options_.wal_enable_) {
+    if (replica_tailer_ != nullptr) {
+        bg_replica_thread_ = std::thread(&DBImpl::BackgroundReplicaThread, this);
+    } else if (options_.wal_enable_) {
         auto error_code = DB_ERROR;
         if (wal_mgr_ != nullptr) {
             error_code = wal_mgr_->Init(meta_ptr_);
@@ -155,6 +214,11 @@ DBImpl::Start() {
     if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
         // background build index thread
         bg_index_thread_ = std::thread(&DBImpl::BackgroundIndexThread, this);
+
+        // background compact thread
+        if (options_.auto_compact_ratio_ > 0.0) {
+            bg_compact_thread_ = std::thread(&DBImpl::BackgroundCompactThread, this);
+        }
     }
 
     // background metric thread
@@ -189,12 +253,22 @@ DBImpl::Stop() {
 
         WaitMergeFileFinish();
 
+        if (bg_compact_thread_.joinable()) {
+            swn_compact_.Notify();
+            bg_compact_thread_.join();
+        }
+
         swn_index_.Notify();
         bg_index_thread_.join();
 
         meta_ptr_->CleanUpShadowFiles();
     }
 
+    if (bg_replica_thread_.joinable()) {
+        swn_replica_.Notify();
+        bg_replica_thread_.join();
+    }
+
     // wait metric thread exit
     swn_metric_.Notify();
     bg_metric_thread_.join();
@@ -259,7 +333,9 @@ DBImpl::DropCollection(const std::string& collection_id) {
         wal_mgr_->DropCollection(collection_id);
     }
 
-    return DropCollectionRecursively(collection_id);
+    auto status = DropCollectionRecursively(collection_id);
+    BumpCollectionVersion(collection_id);
+    return status;
 }
 
 Status
@@ -479,6 +555,18 @@ DBImpl::GetCollectionRowCount(const std::string& collection_id, uint64_t& row_co
     return GetCollectionRowCountRecursively(collection_id, row_count);
 }
 
+Status
+DBImpl::GetCollectionVersion(const std::string& collection_id, uint64_t& version) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    std::lock_guard<std::mutex> lock(collection_versions_mutex_);
+    auto iter = collection_versions_.find(collection_id);
+    version = (iter == collection_versions_.end()) ? 0 : iter->second;
+    return Status::OK();
+}
+
 Status
 DBImpl::CreatePartition(const std::string& collection_id, const std::string& partition_name,
                         const std::string& partition_tag) {
@@ -516,12 +604,18 @@ DBImpl::DropPartition(const std::string& partition_name) {
         return SHUTDOWN_ERROR;
     }
 
+    // the owner can't be looked up once the partition is gone
+    meta::CollectionSchema partition_schema;
+    partition_schema.collection_id_ = partition_name;
+    meta_ptr_->DescribeCollection(partition_schema);
+
     mem_mgr_->EraseMemVector(partition_name);                // not allow insert
     auto status = meta_ptr_->DropPartition(partition_name);  // soft delete collection
     if (!status.ok()) {
         LOG_ENGINE_ERROR_ << status.message();
         return status;
     }
+    BumpCollectionVersion(partition_schema.owner_collection_, true);
 
     // scheduler will determine when to delete collection files
     auto nres = scheduler::ResMgrInst::GetInstance()->GetNumOfComputeResource();
@@ -736,6 +830,53 @@ CopyToAttr(std::vector<uint8_t>& record, uint64_t row_num, const std::vector<std
     return Status::OK();
 }
 
+// one row for each vector of the entities, the rows of an entity share its id and attribute values
+Status
+ExpandEntityVectors(const Entity& entity, const std::vector<int64_t>& vector_lengths,
+                    const std::vector<std::string>& field_names,
+                    std::unordered_map<std::string, meta::hybrid::DataType>& attr_types, IDNumbers& row_ids,
+                    std::vector<uint8_t>& row_attrs) {
+    uint64_t row_num = 0;
+    for (auto length : vector_lengths) {
+        row_num += length;
+    }
+    if (vector_lengths.size() != entity.entity_count_ || entity.id_array_.size() != entity.entity_count_) {
+        return Status(DB_ERROR, "The vector lengths do not match the entities");
+    }
+
+    row_ids.clear();
+    row_ids.reserve(row_num);
+    for (uint64_t i = 0; i < entity.entity_count_; ++i) {
+        row_ids.insert(row_ids.end(), vector_lengths[i], entity.id_array_[i]);
+    }
+
+    // the attributes are passed field by field, a value takes 8 bytes whatever the type
+    constexpr size_t value_size = sizeof(int64_t);
+    uint64_t field_num = 0;
+    for (auto& name : field_names) {
+        if (attr_types.at(name) != meta::hybrid::DataType::VECTOR) {
+            ++field_num;
+        }
+    }
+    if (entity.attr_value_.size() < field_num * entity.entity_count_ * value_size) {
+        return Status(DB_ERROR, "The attribute values do not match the entities");
+    }
+
+    row_attrs.resize(field_num * row_num * value_size);
+    auto src = entity.attr_value_.data();
+    auto dst = row_attrs.data();
+    for (uint64_t field = 0; field < field_num; ++field) {
+        for (uint64_t i = 0; i < entity.entity_count_; ++i) {
+            for (int64_t j = 0; j < vector_lengths[i]; ++j) {
+                memcpy(dst, src, value_size);
+                dst += value_size;
+            }
+            src += value_size;
+        }
+    }
+    return Status::OK();
+}
+
 Status
 DBImpl::InsertEntities(const std::string& collection_id, const std::string& partition_tag,
                        const std::vector<std::string>& field_names, Entity& entity,
@@ -754,11 +895,29 @@ DBImpl::InsertEntities(const std::string& collection_id, const std::string& part
     }
 
     Status status;
+    auto vector_it = entity.vector_data_.begin();
+
+    // entities of several vectors are inserted as a row per vector
+    IDNumbers* row_ids = &entity.id_array_;
+    std::vector<uint8_t>* row_attrs = &entity.attr_value_;
+    uint64_t row_num = entity.entity_count_;
+    IDNumbers expanded_ids;
+    std::vector<uint8_t> expanded_attrs;
+    auto& vector_lengths = vector_it->second.vector_lengths_;
+    if (!vector_lengths.empty()) {
+        status = ExpandEntityVectors(entity, vector_lengths, field_names, attr_types, expanded_ids, expanded_attrs);
+        if (!status.ok()) {
+            return status;
+        }
+        row_ids = &expanded_ids;
+        row_attrs = &expanded_attrs;
+        row_num = expanded_ids.size();
+    }
+
     std::unordered_map<std::string, std::vector<uint8_t>> attr_data;
     std::unordered_map<std::string, uint64_t> attr_nbytes;
     std::unordered_map<std::string, uint64_t> attr_data_size;
-    status = CopyToAttr(entity.attr_value_, entity.entity_count_, field_names, attr_types, attr_data, attr_nbytes,
-                        attr_data_size);
+    status = CopyToAttr(*row_attrs, row_num, field_names, attr_types, attr_data, attr_nbytes, attr_data_size);
     if (!status.ok()) {
         return status;
     }
@@ -767,10 +926,9 @@ DBImpl::InsertEntities(const std::string& collection_id, const std::string& part
     record.lsn = 0;
     record.collection_id = collection_id;
     record.partition_tag = partition_tag;
-    record.ids = entity.id_array_.data();
-    record.length = entity.entity_count_;
+    record.ids = row_ids->data();
+    record.length = row_num;
 
-    auto vector_it = entity.vector_data_.begin();
     if (vector_it->second.binary_data_.empty()) {
         record.type = wal::MXLogType::Entity;
         record.data = vector_it->second.float_data_.data();
@@ -1267,72 +1425,99 @@ DBImpl::GetVectorsByIdHelper(const std::string& collection_id, const IDNumbers&
 
     vectors.clear();
 
-    IDNumbers temp_ids = id_array;
+    // the ids are looked up in the id index of each segment, the vectors found in a segment are read at once
+    std::set<int64_t> ids_to_find(id_array.begin(), id_array.end());
     for (auto& file : files) {
-        // Load bloom filter
+        if (ids_to_find.empty()) {
+            files_holder.UnmarkFile(file);
+            continue;
+        }
+
         std::string segment_dir;
         engine::utils::GetParentPath(file.location_, segment_dir);
         segment::SegmentReader segment_reader(segment_dir);
-        segment::IdBloomFilterPtr id_bloom_filter_ptr;
-        segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
-
-        for (IDNumbers::iterator it = temp_ids.begin(); it != temp_ids.end();) {
-            int64_t vector_id = *it;
-            // each id must has a VectorsData
-            // if vector not found for an id, its VectorsData's vector_count = 0, else 1
-            VectorsData& vector_ref = map_id2vector[vector_id];
-
-            // Check if the id is present in bloom filter.
-            if (id_bloom_filter_ptr->Check(vector_id)) {
-                // Load uids and check if the id is indeed present. If yes, find its offset.
-                std::vector<segment::doc_id_t> uids;
-                auto status = segment_reader.LoadUids(uids);
-                if (!status.ok()) {
-                    return status;
+
+        // unless its id index is cached, the bloom filter skips a segment without any of the ids
+        segment::IdIndexPtr id_index_ptr;
+        segment_reader.LoadIdIndex(id_index_ptr, true);
+        std::vector<int64_t> candidate_ids;
+        if (id_index_ptr == nullptr) {
+            segment::IdBloomFilterPtr id_bloom_filter_ptr;
+            auto status = segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
+            if (!status.ok()) {
+                return status;
+            }
+            for (auto vector_id : ids_to_find) {
+                if (id_bloom_filter_ptr->Check(vector_id)) {
+                    candidate_ids.emplace_back(vector_id);
                 }
+            }
+            if (candidate_ids.empty()) {
+                files_holder.UnmarkFile(file);
+                continue;
+            }
+
+            status = segment_reader.LoadIdIndex(id_index_ptr);
+            if (!status.ok()) {
+                return status;
+            }
+        } else {
+            candidate_ids.assign(ids_to_find.begin(), ids_to_find.end());
+        }
 
-                auto found = std::find(uids.begin(), uids.end(), vector_id);
-                if (found != uids.end()) {
-                    auto offset = std::distance(uids.begin(), found);
+        std::vector<std::pair<segment::offset_t, int64_t>> found;  // offset and id
+        for (auto vector_id : candidate_ids) {
+            segment::offset_t offset;
+            if (id_index_ptr->Lookup(vector_id, offset)) {
+                found.emplace_back(offset, vector_id);
+            }
+        }
 
-                    // Check whether the id has been deleted
-                    segment::DeletedDocsPtr deleted_docs_ptr;
-                    status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
-                    if (!status.ok()) {
-                        LOG_ENGINE_ERROR_ << status.message();
-                        return status;
-                    }
-                    auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
-
-                    auto deleted = std::find(deleted_docs.begin(), deleted_docs.end(), offset);
-                    if (deleted == deleted_docs.end()) {
-                        // Load raw vector
-                        bool is_binary = utils::IsBinaryMetricType(file.metric_type_);
-                        size_t single_vector_bytes = is_binary ? file.dimension_ / 8 : file.dimension_ * sizeof(float);
-                        std::vector<uint8_t> raw_vector;
-                        status =
-                            segment_reader.LoadVectors(offset * single_vector_bytes, single_vector_bytes, raw_vector);
-                        if (!status.ok()) {
-                            LOG_ENGINE_ERROR_ << status.message();
-                            return status;
-                        }
-
-                        vector_ref.vector_count_ = 1;
-                        if (is_binary) {
-                            vector_ref.binary_data_.swap(raw_vector);
-                        } else {
-                            std::vector<float> float_vector;
-                            float_vector.resize(file.dimension_);
-                            memcpy(float_vector.data(), raw_vector.data(), single_vector_bytes);
-                            vector_ref.float_data_.swap(float_vector);
-                        }
-                        temp_ids.erase(it);
-                        continue;
-                    }
-                }
+        if (!found.empty()) {
+            // Check whether the ids have been deleted
+            segment::DeletedDocsPtr deleted_docs_ptr;
+            auto status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
+            if (!status.ok()) {
+                LOG_ENGINE_ERROR_ << status.message();
+                return status;
+            }
+            std::vector<segment::offset_t> deleted_docs = deleted_docs_ptr->GetDeletedDocs();
+            std::sort(deleted_docs.begin(), deleted_docs.end());
+            auto is_deleted = [&](const std::pair<segment::offset_t, int64_t>& item) {
+                return std::binary_search(deleted_docs.begin(), deleted_docs.end(), item.first);
+            };
+            found.erase(std::remove_if(found.begin(), found.end(), is_deleted), found.end());
+            std::sort(found.begin(), found.end());
+        }
+
+        if (!found.empty()) {
+            // Load raw vectors
+            bool is_binary = utils::IsBinaryMetricType(file.metric_type_);
+            size_t single_vector_bytes = is_binary ? file.dimension_ / 8 : file.dimension_ * sizeof(float);
+            std::vector<segment::offset_t> offsets;
+            for (auto& item : found) {
+                offsets.emplace_back(item.first);
+            }
+            std::vector<uint8_t> raw_vectors;
+            auto status = segment_reader.LoadVectors(offsets, single_vector_bytes, raw_vectors);
+            if (!status.ok()) {
+                LOG_ENGINE_ERROR_ << status.message();
+                return status;
             }
 
-            it++;
+            for (size_t i = 0; i < found.size(); ++i) {
+                // if vector not found for an id, its VectorsData's vector_count = 0, else 1
+                VectorsData& vector_ref = map_id2vector[found[i].second];
+                vector_ref.vector_count_ = 1;
+                const uint8_t* raw_vector = raw_vectors.data() + i * single_vector_bytes;
+                if (is_binary) {
+                    vector_ref.binary_data_.assign(raw_vector, raw_vector + single_vector_bytes);
+                } else {
+                    vector_ref.float_data_.resize(file.dimension_);
+                    memcpy(vector_ref.float_data_.data(), raw_vector, single_vector_bytes);
+                }
+                ids_to_find.erase(found[i].second);
+            }
         }
 
         // unmark file, allow the file to be deleted
@@ -1420,7 +1605,250 @@ DBImpl::DropIndex(const std::string& collection_id) {
     }
 
     LOG_ENGINE_DEBUG_ << "Drop index for collection: " << collection_id;
-    return DropCollectionIndexRecursively(collection_id);
+    auto status = DropCollectionIndexRecursively(collection_id);
+    BumpCollectionVersion(collection_id);
+    return status;
+}
+
+Status
+DBImpl::TuneSearchParams(const std::string& collection_id, uint64_t k, double target_recall,
+                         const VectorsData& vectors, milvus::json& tune_result) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    meta::CollectionSchema collection_schema;
+    collection_schema.collection_id_ = collection_id;
+    auto status = meta_ptr_->DescribeCollection(collection_schema);
+    if (!status.ok()) {
+        return status;
+    }
+
+    milvus::json index_params;
+    try {
+        index_params = milvus::json::parse(collection_schema.index_params_);
+    } catch (std::exception& e) {
+        return Status(DB_ERROR, "Invalid index params of collection " + collection_id);
+    }
+
+    // the values to try, cheapest first
+    std::string param_name;
+    std::vector<int64_t> candidates;
+    switch ((EngineType)collection_schema.engine_type_) {
+        case EngineType::FAISS_IVFFLAT:
+        case EngineType::FAISS_IVFSQ8:
+        case EngineType::FAISS_IVFSQ8H:
+        case EngineType::FAISS_PQ:
+        case EngineType::FAISS_PQ_FASTSCAN: {
+            param_name = knowhere::IndexParams::nprobe;
+            int64_t nlist = index_params.value(knowhere::IndexParams::nlist, (int64_t)1);
+            for (int64_t nprobe = 1; nprobe < nlist; nprobe *= 2) {
+                candidates.push_back(nprobe);
+            }
+            candidates.push_back(nlist);
+            break;
+        }
+        case EngineType::HNSW: {
+            param_name = knowhere::IndexParams::ef;
+            for (int64_t ef = std::max<int64_t>(k, 16); ef < TUNE_MAX_EF; ef *= 2) {
+                candidates.push_back(ef);
+            }
+            candidates.push_back(TUNE_MAX_EF);
+            break;
+        }
+        default:
+            return Status(DB_ERROR, "Search params can only be tuned for IVF_FLAT, IVF_SQ8, IVF_SQ8H, IVF_PQ, "
+                                    "IVF_PQ_FASTSCAN and HNSW");
+    }
+    if (vectors.vector_count_ > 0 && vectors.float_data_.empty()) {
+        return Status(DB_ERROR, "Search params can only be tuned with float vectors");
+    }
+
+    // measure on the largest indexed segments
+    std::vector<meta::CollectionSchema> partition_array;
+    status = meta_ptr_->ShowPartitions(collection_id, partition_array);
+    if (!status.ok()) {
+        return status;
+    }
+    std::vector<std::string> collection_ids{collection_id};
+    for (auto& schema : partition_array) {
+        collection_ids.push_back(schema.collection_id_);
+    }
+    std::vector<int> file_types{meta::SegmentSchema::FILE_TYPE::INDEX};
+    meta::FilesHolder files_holder;
+    for (auto& id : collection_ids) {
+        status = meta_ptr_->FilesByType(id, file_types, files_holder);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    meta::SegmentsSchema files = files_holder.HoldFiles();
+    std::sort(files.begin(), files.end(), [](const meta::SegmentSchema& a, const meta::SegmentSchema& b) {
+        return a.row_count_ > b.row_count_;
+    });
+    if (files.size() > TUNE_SAMPLE_SEGMENTS) {
+        files.resize(TUNE_SAMPLE_SEGMENTS);
+    }
+    if (files.empty()) {
+        return Status(DB_ERROR, "Collection " + collection_id + " has no indexed segment to tune on");
+    }
+
+    std::vector<int64_t> hits(candidates.size(), 0);
+    std::vector<double> search_ms(candidates.size(), 0.0);
+    int64_t expected = 0;
+    std::vector<float> queries = vectors.float_data_;
+    int64_t nq = vectors.vector_count_;
+    // ids of the sampled queries, they are held out of both the exact and the approximate top k
+    std::vector<int64_t> query_ids;
+    try {
+        for (auto& file : files) {
+            auto metric_type = (MetricType)file.metric_type_;
+            milvus::json file_params;
+            if (!file.index_params_.empty()) {
+                file_params = milvus::json::parse(file.index_params_);
+            }
+
+            // the raw vectors of the segment give the exact top k, they are loaded aside and not cached.
+            // The tuner does not cache the index either; an index already in the cache is shared, which is safe
+            // since queries pass their nprobe or ef per call
+            std::string segment_dir;
+            utils::GetParentPath(file.location_, segment_dir);
+            auto exact_engine = EngineFactory::Build(file.dimension_, segment_dir + "/tune", EngineType::FAISS_IDMAP,
+                                                     metric_type, milvus::json());
+            auto index_engine = EngineFactory::Build(file.dimension_, file.location_, (EngineType)file.engine_type_,
+                                                     metric_type, file_params);
+            if (exact_engine == nullptr || index_engine == nullptr) {
+                return Status(DB_ERROR, "Failed to create engine for segment " + file.segment_id_);
+            }
+            status = exact_engine->Load(false);
+            if (!status.ok()) {
+                return status;
+            }
+            status = index_engine->Load(false);
+            if (!status.ok()) {
+                return status;
+            }
+
+            // without query vectors, query with vectors of the largest segment which are not deleted
+            if (nq == 0) {
+                segment::SegmentReader segment_reader(segment_dir);
+                std::vector<segment::doc_id_t> uids;
+                segment::DeletedDocsPtr deleted_docs_ptr;
+                STATUS_CHECK(segment_reader.LoadUids(uids));
+                STATUS_CHECK(segment_reader.LoadDeletedDocs(deleted_docs_ptr));
+                auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
+                std::unordered_set<segment::offset_t> deleted(deleted_docs.begin(), deleted_docs.end());
+
+                std::vector<size_t> offsets;
+                for (size_t offset = 0; offset < uids.size(); ++offset) {
+                    if (deleted.find((segment::offset_t)offset) == deleted.end()) {
+                        offsets.push_back(offset);
+                    }
+                }
+                std::shuffle(offsets.begin(), offsets.end(), std::mt19937(TUNE_SAMPLE_SEED));
+                size_t vector_bytes = file.dimension_ * sizeof(float);
+                for (size_t i = 0; i < offsets.size() && nq < TUNE_SAMPLE_NQ; ++i, ++nq) {
+                    std::vector<uint8_t> raw_vector;
+                    STATUS_CHECK(segment_reader.LoadVectors(offsets[i] * vector_bytes, vector_bytes, raw_vector));
+                    auto vector = reinterpret_cast<const float*>(raw_vector.data());
+                    queries.insert(queries.end(), vector, vector + file.dimension_);
+                    query_ids.push_back(uids[offsets[i]]);
+                }
+                if (nq == 0) {
+                    return Status(DB_ERROR, "No vector to tune with in segment " + file.segment_id_);
+                }
+            }
+
+            // a sampled query finds itself in its own segment, whatever the params, one more hit makes up for it
+            int64_t search_k = query_ids.empty() ? k : k + 1;
+            auto held_out_hits = [&](const std::vector<int64_t>& result_ids, int64_t i) {
+                std::vector<int64_t> row_ids;
+                for (int64_t j = i * search_k; j < (i + 1) * search_k && row_ids.size() < k; ++j) {
+                    if (result_ids[j] >= 0 && (query_ids.empty() || result_ids[j] != query_ids[i])) {
+                        row_ids.push_back(result_ids[j]);
+                    }
+                }
+                return row_ids;
+            };
+
+            std::vector<float> exact_distances(nq * search_k), distances(nq * search_k);
+            std::vector<int64_t> exact_ids(nq * search_k), ids(nq * search_k);
+            status = exact_engine->Search(nq, queries.data(), search_k, milvus::json(), exact_distances.data(),
+                                          exact_ids.data(), false);
+            if (!status.ok()) {
+                return status;
+            }
+            std::vector<std::unordered_set<int64_t>> exact_sets(nq);
+            for (int64_t i = 0; i < nq; ++i) {
+                auto row_ids = held_out_hits(exact_ids, i);
+                exact_sets[i].insert(row_ids.begin(), row_ids.end());
+                expected += row_ids.size();
+            }
+
+            for (size_t c = 0; c < candidates.size(); ++c) {
+                milvus::json search_params = {{param_name, candidates[c]}};
+                auto start = std::chrono::steady_clock::now();
+                status = index_engine->Search(nq, queries.data(), search_k, search_params, distances.data(),
+                                              ids.data(), false);
+                auto end = std::chrono::steady_clock::now();
+                if (!status.ok()) {
+                    return status;
+                }
+                search_ms[c] += std::chrono::duration<double, std::milli>(end - start).count();
+                for (int64_t i = 0; i < nq; ++i) {
+                    for (auto id : held_out_hits(ids, i)) {
+                        hits[c] += exact_sets[i].count(id);
+                    }
+                }
+            }
+        }
+    } catch (std::exception& e) {
+        return Status(DB_ERROR, std::string("Failed to tune search params: ") + e.what());
+    }
+    files_holder.ReleaseFiles();
+
+    // the cheapest value reaching the target, or the most exact one
+    milvus::json json_candidates;
+    size_t chosen = candidates.size() - 1;
+    bool reached = false;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        double recall = expected > 0 ? (double)hits[c] / expected : 1.0;
+        milvus::json json_candidate;
+        json_candidate[param_name] = candidates[c];
+        json_candidate["recall"] = recall;
+        json_candidate["latency_ms"] = search_ms[c] / files.size();
+        json_candidates.push_back(json_candidate);
+        if (!reached && recall >= target_recall) {
+            chosen = c;
+            reached = true;
+        }
+    }
+    milvus::json search_params = {{param_name, candidates[chosen]}};
+    LOG_ENGINE_DEBUG_ << "Tuned search params of collection " << collection_id << ": " << search_params.dump()
+                      << ", recall " << json_candidates[chosen]["recall"] << (reached ? "" : ", target not reached");
+
+    // the index may have been changed meanwhile, the tuned params belong to the index they were measured on
+    meta::CollectionSchema latest_schema;
+    latest_schema.collection_id_ = collection_id;
+    status = meta_ptr_->DescribeCollection(latest_schema);
+    if (!status.ok()) {
+        return status;
+    }
+    if (latest_schema.engine_type_ != collection_schema.engine_type_ ||
+        latest_schema.index_params_ != collection_schema.index_params_) {
+        return Status(DB_ERROR, "Index of collection " + collection_id + " changed while tuning search params");
+    }
+    index_params[utils::TUNED_SEARCH_PARAMS] = search_params;
+    status = meta_ptr_->UpdateCollectionIndexParams(collection_id, index_params.dump());
+    if (!status.ok()) {
+        return status;
+    }
+
+    tune_result[utils::TUNED_SEARCH_PARAMS] = search_params;
+    tune_result["recall"] = json_candidates[chosen]["recall"];
+    tune_result["target_reached"] = reached;
+    tune_result["candidates"] = json_candidates;
+    return Status::OK();
 }
 
 Status
@@ -1627,47 +2055,192 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
         return SHUTDOWN_ERROR;
     }
 
-    Status status;
+    server::QueryProfilePtr profile = context ? context->GetQueryProfile() : nullptr;
+    server::QueryProfileScope meta_scope(profile, server::QueryStage::kMeta);
+
+    std::set<std::string> search_collection_ids;
+    auto status = GetCollectionsToSearch(collection_id, partition_tags, search_collection_ids);
+    if (!status.ok()) {
+        return status;
+    }
+    meta_scope.Finish();
+
+    // search the insert buffer before listing the segments: a flush in between makes its rows visible in both,
+    // the duplicates are dropped below, while the other order would miss them in both
+    ResultIds mem_ids;
+    ResultDistances mem_distances;
+    bool ascending = true;
+    {
+        server::QueryProfileScope buffer_scope(profile, server::QueryStage::kInsertBuffer);
+        status = mem_mgr_->Search(search_collection_ids, k, vectors, mem_ids, mem_distances, ascending);
+    }
+    if (!status.ok()) {
+        return status;
+    }
+
+    fiu_do_on("DBImpl.Query.flush_after_buffer_search", Flush(collection_id));
+
     meta::FilesHolder files_holder;
-    if (partition_tags.empty()) {
-        // no partition tag specified, means search in whole collection
-        // get all collection files from parent collection
-        status = meta_ptr_->FilesToSearch(collection_id, files_holder);
+    {
+        server::QueryProfileScope files_scope(profile, server::QueryStage::kMeta);
+        status = GetFilesToSearch(collection_id, search_collection_ids, files_holder);
+    }
+    if (!status.ok()) {
+        return status;
+    }
+
+    if (files_holder.HoldFiles().empty() && mem_ids.empty()) {
+        return Status::OK();  // no files to search
+    }
+
+    if (!files_holder.HoldFiles().empty()) {
+        cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+        status = QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_ids, result_distances);
+        cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
         if (!status.ok()) {
             return status;
         }
+    }
 
-        std::vector<meta::CollectionSchema> partition_array;
-        status = meta_ptr_->ShowPartitions(collection_id, partition_array);
-        for (auto& schema : partition_array) {
-            status = meta_ptr_->FilesToSearch(schema.collection_id_, files_holder);
-        }
+    if (!mem_ids.empty()) {
+        server::QueryProfileScope merge_scope(profile, server::QueryStage::kMerge);
+        auto nq = vectors.vector_count_;
+        scheduler::XSearchTask::MergeTopkToResultSet(mem_ids, mem_distances, k, nq, k, ascending, result_ids,
+                                                     result_distances, true);
+    }
 
-        if (files_holder.HoldFiles().empty()) {
-            return Status::OK();  // no files to search
+    return status;
+}
+
+Status
+DBImpl::QueryCollections(const std::shared_ptr<server::Context>& context,
+                         const std::vector<std::string>& collection_ids, const std::vector<std::string>& partition_tags,
+                         uint64_t k, const milvus::json& extra_params, const VectorsData& vectors,
+                         ResultIds& result_ids, ResultDistances& result_distances,
+                         std::vector<int64_t>& result_collections) {
+    milvus::server::ContextChild tracer(context, "Query collections");
+
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    server::QueryProfilePtr profile = context ? context->GetQueryProfile() : nullptr;
+    server::QueryProfileScope meta_scope(profile, server::QueryStage::kMeta);
+
+    // the hits of all collections are reduced together, they must rank distances the same way
+    bool ascending = true;
+    for (size_t i = 0; i < collection_ids.size(); ++i) {
+        meta::CollectionSchema collection_schema;
+        collection_schema.collection_id_ = collection_ids[i];
+        auto status = DescribeCollection(collection_schema);
+        if (!status.ok()) {
+            return status;
         }
-    } else {
-        // get files from specified partitions
-        std::set<std::string> partition_name_array;
-        status = GetPartitionsByTags(collection_id, partition_tags, partition_name_array);
+        bool collection_ascending = !utils::IsSimilarityMetricType(collection_schema.metric_type_);
+        if (i > 0 && collection_ascending != ascending) {
+            return Status(DB_ERROR, "Collections searched together must order distances the same way");
+        }
+        ascending = collection_ascending;
+    }
+
+    size_t count = collection_ids.size();
+    std::vector<std::set<std::string>> search_collection_ids(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto status = GetCollectionsToSearch(collection_ids[i], partition_tags, search_collection_ids[i]);
         if (!status.ok()) {
-            return status;  // didn't match any partition.
+            return status;
         }
+    }
+    meta_scope.Finish();
 
-        for (auto& partition_name : partition_name_array) {
-            status = meta_ptr_->FilesToSearch(partition_name, files_holder);
+    // search the insert buffers before listing the segments, see Query
+    std::vector<ResultIds> mem_ids(count);
+    std::vector<ResultDistances> mem_distances(count);
+    {
+        server::QueryProfileScope buffer_scope(profile, server::QueryStage::kInsertBuffer);
+        for (size_t i = 0; i < count; ++i) {
+            bool mem_ascending = true;
+            auto status =
+                mem_mgr_->Search(search_collection_ids[i], k, vectors, mem_ids[i], mem_distances[i], mem_ascending);
+            if (!status.ok()) {
+                return status;
+            }
         }
+    }
 
-        if (files_holder.HoldFiles().empty()) {
-            return Status::OK();  // no files to search
+    size_t file_count = 0;
+    std::vector<std::shared_ptr<meta::FilesHolder>> files_holders(count);
+    {
+        server::QueryProfileScope files_scope(profile, server::QueryStage::kMeta);
+        for (size_t i = 0; i < count; ++i) {
+            files_holders[i] = std::make_shared<meta::FilesHolder>();
+            auto status = GetFilesToSearch(collection_ids[i], search_collection_ids[i], *files_holders[i]);
+            if (!status.ok()) {
+                return status;
+            }
+            file_count += files_holders[i]->HoldFiles().size();
         }
     }
+    if (file_count > milvus::scheduler::TASK_TABLE_MAX_COUNT) {
+        std::string msg =
+            "Search files count exceed scheduler limit: " + std::to_string(milvus::scheduler::TASK_TABLE_MAX_COUNT);
+        LOG_ENGINE_ERROR_ << msg;
+        return Status(DB_ERROR, msg);
+    }
 
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_ids, result_distances);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+    // put the jobs of all collections to the scheduler before waiting for any, so that their tasks run together
+    // and the search costs about the slowest collection rather than the sum of them
+    server::CollectQueryMetrics metrics(vectors.vector_count_);
+    LOG_ENGINE_DEBUG_ << LogOut("Engine query of %ld collections begin, index file count: %ld", count, file_count);
+    std::vector<scheduler::SearchJobPtr> jobs(count);
+    SuspendIfFirst();
+    for (size_t i = 0; i < count; ++i) {
+        if (files_holders[i]->HoldFiles().empty()) {
+            continue;
+        }
+        jobs[i] = std::make_shared<scheduler::SearchJob>(tracer.Context(), k, extra_params, vectors);
+        for (auto& file : files_holders[i]->HoldFiles()) {
+            jobs[i]->AddIndexFile(std::make_shared<meta::SegmentSchema>(file));
+        }
+        scheduler::JobMgrInst::GetInstance()->Put(jobs[i]);
+    }
+    for (auto& job : jobs) {
+        if (job != nullptr) {
+            job->WaitResult();
+        }
+    }
+    ResumeIfLast();
 
-    return status;
+    for (auto& files_holder : files_holders) {
+        files_holder->ReleaseFiles();
+    }
+
+    server::QueryProfileScope merge_scope(profile, server::QueryStage::kMerge);
+    auto nq = vectors.vector_count_;
+    std::vector<ResultIds> ids_list(count);
+    std::vector<ResultDistances> distances_list(count);
+    bool empty = true;
+    for (size_t i = 0; i < count; ++i) {
+        if (jobs[i] != nullptr) {
+            if (!jobs[i]->GetStatus().ok()) {
+                return jobs[i]->GetStatus();
+            }
+            ids_list[i] = jobs[i]->GetResultIds();
+            distances_list[i] = jobs[i]->GetResultDistances();
+        }
+        if (!mem_ids[i].empty()) {
+            scheduler::XSearchTask::MergeTopkToResultSet(mem_ids[i], mem_distances[i], k, nq, k, ascending,
+                                                         ids_list[i], distances_list[i], true);
+        }
+        empty = empty && ids_list[i].empty();
+    }
+
+    if (empty) {
+        return Status::OK();  // nothing to search
+    }
+    MergeCollectionHits(ids_list, distances_list, nq, k, ascending, result_ids, result_distances, result_collections);
+
+    return Status::OK();
 }
 
 Status
@@ -1714,6 +2287,30 @@ DBImpl::Size(uint64_t& result) {
     return meta_ptr_->Size(result);
 }
 
+Status
+DBImpl::GetReplicationStatus(milvus::json& replication_status) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    if (replica_tailer_ == nullptr) {
+        return Status(DB_ERROR, "Not a read replica, set deploy_mode to cluster_readonly and enable wal");
+    }
+
+    std::lock_guard<std::mutex> lck(replica_status_mutex_);
+    int64_t lag_ms = 0;
+    if (replica_applied_lsn_ < replica_written_lsn_) {
+        lag_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                       replica_caught_up_time_)
+                     .count();
+    }
+    replication_status[JSON_APPLIED_LSN] = replica_applied_lsn_;
+    replication_status[JSON_WRITTEN_LSN] = replica_written_lsn_;
+    replication_status[JSON_LAG_MS] = lag_ms;
+
+    return Status::OK();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // internal methods
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2043,6 +2640,7 @@ DBImpl::BackgroundMerge(std::set<std::string> collection_ids) {
             LOG_ENGINE_ERROR_ << "Failed to get merge files for collection: " << collection_id
                               << " reason:" << status.message();
         }
+        BumpCollectionVersion(collection_id);
 
         if (!initialized_.load(std::memory_order_acquire)) {
             LOG_ENGINE_DEBUG_ << "Server will shutdown, skip merge action for collection: " << collection_id;
@@ -2119,6 +2717,7 @@ DBImpl::BackgroundBuildIndex() {
                 LOG_ENGINE_DEBUG_ << "Building index job " << job->id() << " succeed.";
 
                 index_failed_checker_.MarkSucceedIndexFile(file_schema);
+                BumpCollectionVersion(file_schema.collection_id_);
             }
             status = files_holder.UnmarkFile(file_schema);
             LOG_ENGINE_DEBUG_ << "Finish build index file " << file_schema.file_id_;
@@ -2210,6 +2809,43 @@ DBImpl::GetPartitionsByTags(const std::string& collection_id, const std::vector<
     return Status::OK();
 }
 
+Status
+DBImpl::GetCollectionsToSearch(const std::string& collection_id, const std::vector<std::string>& partition_tags,
+                               std::set<std::string>& search_collection_ids) {
+    if (partition_tags.empty()) {
+        // no partition tag specified, means search in whole collection
+        search_collection_ids.insert(collection_id);
+
+        std::vector<meta::CollectionSchema> partition_array;
+        auto status = meta_ptr_->ShowPartitions(collection_id, partition_array);
+        for (auto& schema : partition_array) {
+            search_collection_ids.insert(schema.collection_id_);
+        }
+    } else {
+        // search the specified partitions
+        auto status = GetPartitionsByTags(collection_id, partition_tags, search_collection_ids);
+        if (!status.ok()) {
+            return status;  // didn't match any partition.
+        }
+    }
+
+    return Status::OK();
+}
+
+Status
+DBImpl::GetFilesToSearch(const std::string& collection_id, const std::set<std::string>& search_collection_ids,
+                         meta::FilesHolder& files_holder) {
+    for (auto& search_collection_id : search_collection_ids) {
+        // a partition dropped meanwhile has no files left to search
+        auto status = meta_ptr_->FilesToSearch(search_collection_id, files_holder);
+        if (!status.ok() && search_collection_id == collection_id) {
+            return status;
+        }
+    }
+
+    return Status::OK();
+}
+
 Status
 DBImpl::DropCollectionRecursively(const std::string& collection_id) {
     // dates partly delete files of the collection but currently we don't support
@@ -2417,6 +3053,10 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
             }
         }
 
+        for (auto& collection : collection_ids) {
+            BumpCollectionVersion(collection);
+        }
+
         std::lock_guard<std::mutex> lck(merge_result_mutex_);
         for (auto& collection : collection_ids) {
             merge_collection_ids_.insert(collection);
@@ -2441,6 +3081,7 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
                                               (const float*)record.data, record.attr_nbytes, record.attr_data_size,
                                               record.attr_data, record.lsn, flushed_collections);
             collections_flushed(flushed_collections);
+            BumpCollectionVersion(record.collection_id, true);
 
             milvus::server::CollectInsertMetrics metrics(record.length, status);
             break;
@@ -2459,6 +3100,7 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
                                              (const u_int8_t*)record.data, record.lsn, flushed_collections);
             // even though !status.ok, run
             collections_flushed(flushed_collections);
+            BumpCollectionVersion(record.collection_id, true);
 
             // metrics
             milvus::server::CollectInsertMetrics metrics(record.length, status);
@@ -2479,6 +3121,7 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
                                              (const float*)record.data, record.lsn, flushed_collections);
             // even though !status.ok, run
             collections_flushed(flushed_collections);
+            BumpCollectionVersion(record.collection_id, true);
 
             // metrics
             milvus::server::CollectInsertMetrics metrics(record.length, status);
@@ -2513,6 +3156,8 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
                     }
                 }
             }
+            BumpCollectionVersion(record.collection_id, true);
+            MarkCollectionsToCompact(collection_ids);
             break;
         }
 
@@ -2563,6 +3208,22 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
     return status;
 }
 
+void
+DBImpl::BumpCollectionVersion(const std::string& collection_id, bool is_root) {
+    // partitions share the version of their root collection
+    std::string root_id = collection_id;
+    if (!is_root) {
+        meta::CollectionSchema collection_schema;
+        collection_schema.collection_id_ = collection_id;
+        if (meta_ptr_->DescribeCollection(collection_schema).ok() && !collection_schema.owner_collection_.empty()) {
+            root_id = collection_schema.owner_collection_;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(collection_versions_mutex_);
+    collection_versions_[root_id] = ++last_collection_version_;
+}
+
 void
 DBImpl::InternalFlush(const std::string& collection_id) {
     wal::MXLogRecord record;
@@ -2632,6 +3293,175 @@ DBImpl::BackgroundWalThread() {
     }
 }
 
+void
+DBImpl::BackgroundReplicaThread() {
+    SetThreadName("replica_thread");
+    server::SystemInfo::GetInstance().Init();
+
+    // start where the writable node recovers from
+    uint64_t start_lsn = 0;
+    meta_ptr_->GetGlobalLastLSN(start_lsn);
+    std::vector<meta::CollectionSchema> collection_schema_array;
+    meta_ptr_->AllCollections(collection_schema_array);
+    if (!collection_schema_array.empty()) {
+        uint64_t min_flushed_lsn = collection_schema_array[0].flush_lsn_;
+        for (auto& schema : collection_schema_array) {
+            min_flushed_lsn = std::min(min_flushed_lsn, schema.flush_lsn_);
+        }
+        start_lsn = std::max(start_lsn, min_flushed_lsn);
+    }
+    replica_tailer_->Seek(start_lsn);
+    replica_caught_up_time_ = std::chrono::steady_clock::now();
+    LOG_ENGINE_DEBUG_ << "Read replica follows wal " << options_.mxlog_path_ << " from lsn " << start_lsn;
+
+    while (true) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            LOG_ENGINE_DEBUG_ << "DB background replica thread exit";
+            break;
+        }
+
+        uint64_t replay_lsn = 0;
+        if (ReplicaCollectionsFlushed(replay_lsn)) {
+            replica_tailer_->Seek(replay_lsn);
+        }
+
+        bool caught_up = false;
+        for (int64_t i = 0; i < REPLICA_APPLY_BATCH; ++i) {
+            wal::MXLogRecord record;
+            auto error_code = replica_tailer_->Next(record);
+            if (error_code != WAL_SUCCESS) {
+                LOG_ENGINE_ERROR_ << "Read replica fails to read wal at lsn " << replica_tailer_->GetReadLsn();
+                break;
+            }
+            if (record.type == wal::MXLogType::None) {
+                caught_up = true;
+                break;
+            }
+
+            auto status = ApplyReplicaRecord(record);
+            if (!status.ok()) {
+                LOG_ENGINE_WARNING_ << "Read replica skips wal record " << record.lsn << ": " << status.message();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lck(replica_status_mutex_);
+            replica_applied_lsn_ = replica_tailer_->GetReadLsn();
+            replica_written_lsn_ = replica_tailer_->GetWriteLsn();
+            if (replica_applied_lsn_ >= replica_written_lsn_) {
+                replica_caught_up_time_ = std::chrono::steady_clock::now();
+            }
+        }
+
+        if (caught_up) {
+            swn_replica_.Wait_For(std::chrono::milliseconds(BACKGROUND_REPLICA_INTERVAL));
+        }
+    }
+}
+
+Status
+DBImpl::ApplyReplicaRecord(const wal::MXLogRecord& record) {
+    switch (record.type) {
+        case wal::MXLogType::InsertBinary:
+        case wal::MXLogType::InsertVector: {
+            std::string target_collection_name;
+            auto status = GetPartitionByTag(record.collection_id, record.partition_tag, target_collection_name);
+            if (!status.ok()) {
+                return status;
+            }
+
+            bool applied = false;
+            STATUS_CHECK(ReplicaRecordApplied(target_collection_name, record.lsn, applied));
+            if (applied) {
+                return Status::OK();
+            }
+            return ExecWalRecord(record);
+        }
+        case wal::MXLogType::Delete: {
+            std::vector<meta::CollectionSchema> partition_array;
+            STATUS_CHECK(meta_ptr_->ShowPartitions(record.collection_id, partition_array));
+            std::vector<std::string> collection_ids{record.collection_id};
+            for (auto& partition : partition_array) {
+                collection_ids.emplace_back(partition.collection_id_);
+            }
+
+            for (auto& collection_id : collection_ids) {
+                bool applied = false;
+                STATUS_CHECK(ReplicaRecordApplied(collection_id, record.lsn, applied));
+                if (applied) {
+                    continue;
+                }
+                if (record.length == 1) {
+                    STATUS_CHECK(mem_mgr_->DeleteVector(collection_id, *record.ids, record.lsn));
+                } else {
+                    STATUS_CHECK(mem_mgr_->DeleteVectors(collection_id, record.length, record.ids, record.lsn));
+                }
+            }
+            BumpCollectionVersion(record.collection_id, true);
+            return Status::OK();
+        }
+        default: {
+            // flushes are seen in the meta, entities are not written to the wal by the writable node
+            return Status::OK();
+        }
+    }
+}
+
+Status
+DBImpl::ReplicaRecordApplied(const std::string& collection_id, uint64_t lsn, bool& applied) {
+    auto iter = replica_applied_lsns_.find(collection_id);
+    if (iter == replica_applied_lsns_.end()) {
+        uint64_t flush_lsn = 0;
+        STATUS_CHECK(meta_ptr_->GetCollectionFlushLSN(collection_id, flush_lsn));
+        replica_flush_lsns_[collection_id] = flush_lsn;
+        iter = replica_applied_lsns_.insert(std::make_pair(collection_id, flush_lsn)).first;
+    }
+
+    // in the segments or in the insert buffer already
+    applied = (lsn <= iter->second);
+    if (!applied) {
+        iter->second = lsn;
+    }
+    return Status::OK();
+}
+
+bool
+DBImpl::ReplicaCollectionsFlushed(uint64_t& replay_lsn) {
+    bool flushed = false;
+    replay_lsn = replica_tailer_->GetReadLsn();
+    for (auto iter = replica_flush_lsns_.begin(); iter != replica_flush_lsns_.end();) {
+        uint64_t flush_lsn = 0;
+        auto status = meta_ptr_->GetCollectionFlushLSN(iter->first, flush_lsn);
+        if (!status.ok()) {
+            // dropped, its buffer goes and its records are not looked for any more
+            mem_mgr_->EraseMemVector(iter->first);
+            replica_applied_lsns_.erase(iter->first);
+            iter = replica_flush_lsns_.erase(iter);
+            continue;
+        }
+
+        if (flush_lsn != iter->second) {
+            // the buffered records can't be told apart once they are in the insert buffer, drop the buffer and
+            // read the records of the collection again from its flush. other collections keep their buffers,
+            // the records they applied already are skipped
+            // the writable node shows a new segment before it moves the flush lsn, searches merge the buffer hits
+            // with unique ids to drop the ones it shares with the segments meanwhile
+            mem_mgr_->EraseMemVector(iter->first);
+            BumpCollectionVersion(iter->first);
+            iter->second = flush_lsn;
+            replica_applied_lsns_[iter->first] = flush_lsn;
+            replay_lsn = std::min(replay_lsn, flush_lsn);
+            flushed = true;
+        }
+        ++iter;
+    }
+
+    if (flushed) {
+        LOG_ENGINE_DEBUG_ << "Writable node flushed, read replica reads wal again from lsn " << replay_lsn;
+    }
+    return flushed;
+}
+
 void
 DBImpl::BackgroundFlushThread() {
     SetThreadName("flush_thread");
@@ -2651,6 +3481,136 @@ DBImpl::BackgroundFlushThread() {
     }
 }
 
+void
+DBImpl::BackgroundCompactThread() {
+    SetThreadName("compact_thread");
+    server::SystemInfo::GetInstance().Init();
+    while (true) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            LOG_ENGINE_DEBUG_ << "DB background compact thread exit";
+            break;
+        }
+
+        swn_compact_.Wait_For(std::chrono::seconds(options_.auto_compact_interval_));
+        BackgroundCompact();
+    }
+}
+
+void
+DBImpl::MarkCollectionsToCompact(const std::vector<std::string>& collection_ids) {
+    if (options_.auto_compact_ratio_ <= 0.0) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(compact_collection_mutex_);
+    for (auto& collection_id : collection_ids) {
+        compact_collection_ids_[collection_id] = now;
+    }
+}
+
+void
+DBImpl::BackgroundCompact() {
+    // deletes reach the segments with the next flush, collections deleted from just now are left to the next round
+    auto flush_lag = std::chrono::seconds(2 * std::max<int64_t>(options_.auto_flush_interval_, 1));
+    auto flushed_before = std::chrono::steady_clock::now() - flush_lag;
+    std::vector<std::string> collection_ids;
+    {
+        std::lock_guard<std::mutex> lock(compact_collection_mutex_);
+        for (auto iter = compact_collection_ids_.begin(); iter != compact_collection_ids_.end();) {
+            if (iter->second <= flushed_before) {
+                collection_ids.push_back(iter->first);
+                iter = compact_collection_ids_.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+    if (collection_ids.empty()) {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> index_lock(build_index_mutex_);
+    const std::lock_guard<std::mutex> merge_lock(flush_merge_compact_mutex_);
+
+    // find the segments whose deleted fraction reaches the ratio
+    std::vector<int> file_types{meta::SegmentSchema::FILE_TYPE::RAW, meta::SegmentSchema::FILE_TYPE::TO_INDEX,
+                                meta::SegmentSchema::FILE_TYPE::BACKUP};
+    meta::FilesHolder files_holder;
+    for (auto& collection_id : collection_ids) {
+        auto status = meta_ptr_->FilesByType(collection_id, file_types, files_holder);
+        if (!status.ok()) {
+            LOG_ENGINE_ERROR_ << "Failed to get files to compact for collection " << collection_id << ": "
+                              << status.message();
+        }
+    }
+
+    std::vector<std::pair<double, meta::SegmentSchema>> candidates;
+    for (auto& file : files_holder.HoldFiles()) {
+        std::string segment_dir;
+        utils::GetParentPath(file.location_, segment_dir);
+        segment::SegmentReader segment_reader(segment_dir);
+        size_t deleted_docs_size = 0;
+        if (!segment_reader.ReadDeletedDocsSize(deleted_docs_size).ok() || deleted_docs_size == 0) {
+            continue;
+        }
+        // row count of the meta excludes the deleted rows
+        double delete_ratio = (double)deleted_docs_size / (double)(file.row_count_ + deleted_docs_size);
+        if (delete_ratio >= options_.auto_compact_ratio_) {
+            candidates.emplace_back(delete_ratio, file);
+        }
+    }
+
+    // most deleted first, rewrite no more than the rate allows in a round, the rest waits for the next round
+    std::sort(candidates.begin(), candidates.end(),
+              [](const std::pair<double, meta::SegmentSchema>& a, const std::pair<double, meta::SegmentSchema>& b) {
+                  return a.first > b.first;
+              });
+    int64_t budget = options_.auto_compact_rate_ * MB * options_.auto_compact_interval_ / 60;
+    int64_t compacted_size = 0;
+    std::set<std::string> compacted_collections;
+    std::vector<std::string> postponed_collections;
+    for (auto& candidate : candidates) {
+        auto& file = candidate.second;
+        if (compacted_size >= budget || !initialized_.load(std::memory_order_acquire)) {
+            postponed_collections.push_back(file.collection_id_);
+            continue;
+        }
+
+        LOG_ENGINE_DEBUG_ << "Auto compact segment " << file.segment_id_ << " of collection " << file.collection_id_
+                          << ", " << candidate.first * 100 << "% deleted";
+        meta::SegmentsSchema files_to_update;
+        auto status = CompactFile(file.collection_id_, 0.0, file, files_to_update);
+        if (!status.ok()) {
+            LOG_ENGINE_ERROR_ << "Auto compact failed for segment " << file.segment_id_ << ": " << status.message();
+            continue;
+        }
+        status = meta_ptr_->UpdateCollectionFiles(files_to_update);
+        if (!status.ok()) {
+            LOG_ENGINE_ERROR_ << "Failed to update meta after auto compaction: " << status.message();
+            break;
+        }
+        compacted_size += file.file_size_;
+        compacted_collections.insert(file.collection_id_);
+    }
+    files_holder.ReleaseFiles();
+
+    if (!postponed_collections.empty()) {
+        std::lock_guard<std::mutex> lock(compact_collection_mutex_);
+        for (auto& collection_id : postponed_collections) {
+            compact_collection_ids_.emplace(collection_id, flushed_before);
+        }
+    }
+
+    for (auto& collection_id : compacted_collections) {
+        BumpCollectionVersion(collection_id);
+    }
+    if (!compacted_collections.empty()) {
+        LOG_ENGINE_DEBUG_ << "Auto compacted " << compacted_size << " bytes of segments";
+        swn_index_.Notify();  // compacted segments of indexed files are to index again
+    }
+}
+
 void
 DBImpl::BackgroundMetricThread() {
     server::SystemInfo::GetInstance().Init();
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <list>
 #include <map>
@@ -33,6 +34,7 @@
 #include "db/meta/FilesHolder.h"
 #include "utils/ThreadPool.h"
 #include "wal/WalManager.h"
+#include "wal/WalTailer.h"
 
 namespace milvus {
 namespace engine {
@@ -86,6 +88,9 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     Status
     GetCollectionRowCount(const std::string& collection_id, uint64_t& row_count) override;
 
+    Status
+    GetCollectionVersion(const std::string& collection_id, uint64_t& version) override;
+
     Status
     CreatePartition(const std::string& collection_id, const std::string& partition_name,
                     const std::string& partition_tag) override;
@@ -141,6 +146,10 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     Status
     DropIndex(const std::string& collection_id) override;
 
+    Status
+    TuneSearchParams(const std::string& collection_id, uint64_t k, double target_recall, const VectorsData& vectors,
+                     milvus::json& tune_result) override;
+
     Status
     CreateHybridCollection(meta::CollectionSchema& collection_schema,
                            meta::hybrid::FieldsSchema& fields_schema) override;
@@ -171,6 +180,12 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
           const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
           const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) override;
 
+    Status
+    QueryCollections(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& collection_ids,
+                     const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
+                     const VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances,
+                     std::vector<int64_t>& result_collections) override;
+
     Status
     QueryByFileID(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& file_ids, uint64_t k,
                   const milvus::json& extra_params, const VectorsData& vectors, ResultIds& result_ids,
@@ -179,6 +194,9 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     Status
     Size(uint64_t& result) override;
 
+    Status
+    GetReplicationStatus(milvus::json& replication_status) override;
+
  protected:
     void
     OnCacheInsertDataChanged(bool value) override;
@@ -209,9 +227,33 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     void
     BackgroundWalThread();
 
+    void
+    BackgroundCompactThread();
+
+    void
+    BackgroundCompact();
+
+    void
+    MarkCollectionsToCompact(const std::vector<std::string>& collection_ids);
+
     void
     BackgroundFlushThread();
 
+    void
+    BackgroundReplicaThread();
+
+    Status
+    ApplyReplicaRecord(const wal::MXLogRecord& record);
+
+    // whether a record of the collection at lsn is applied already, marks it applied if not
+    Status
+    ReplicaRecordApplied(const std::string& collection_id, uint64_t lsn, bool& applied);
+
+    // true when the writable node flushed collections the replica buffers records for, replay_lsn is where
+    // the wal has to be read again from
+    bool
+    ReplicaCollectionsFlushed(uint64_t& replay_lsn);
+
     void
     BackgroundMetricThread();
 
@@ -262,6 +304,14 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     GetPartitionsByTags(const std::string& collection_id, const std::vector<std::string>& partition_tags,
                         std::set<std::string>& partition_name_array);
 
+    Status
+    GetCollectionsToSearch(const std::string& collection_id, const std::vector<std::string>& partition_tags,
+                           std::set<std::string>& search_collection_ids);
+
+    Status
+    GetFilesToSearch(const std::string& collection_id, const std::set<std::string>& search_collection_ids,
+                     meta::FilesHolder& files_holder);
+
     Status
     DropCollectionRecursively(const std::string& collection_id);
 
@@ -281,6 +331,9 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     Status
     ExecWalRecord(const wal::MXLogRecord& record);
 
+    void
+    BumpCollectionVersion(const std::string& collection_id, bool is_root = false);
+
     void
     SuspendIfFirst();
 
@@ -299,9 +352,22 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     std::shared_ptr<wal::WalManager> wal_mgr_;
     std::thread bg_wal_thread_;
 
+    // read replica (cluster_readonly with wal enabled), follows the wal of the writable node
+    wal::MXLogTailerPtr replica_tailer_;
+    std::thread bg_replica_thread_;
+    // flush lsn of the collections (and partitions) the replica buffers records for, and lsn of the last record
+    // applied to each, only used by its thread
+    std::unordered_map<std::string, uint64_t> replica_flush_lsns_;
+    std::unordered_map<std::string, uint64_t> replica_applied_lsns_;
+    std::mutex replica_status_mutex_;
+    uint64_t replica_applied_lsn_ = 0;
+    uint64_t replica_written_lsn_ = 0;
+    std::chrono::steady_clock::time_point replica_caught_up_time_;
+
     std::thread bg_flush_thread_;
     std::thread bg_metric_thread_;
     std::thread bg_index_thread_;
+    std::thread bg_compact_thread_;
 
     struct SimpleWaitNotify {
         bool notified_ = false;
@@ -348,6 +414,8 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     SimpleWaitNotify swn_flush_;
     SimpleWaitNotify swn_metric_;
     SimpleWaitNotify swn_index_;
+    SimpleWaitNotify swn_compact_;
+    SimpleWaitNotify swn_replica_;
 
     SimpleWaitNotify flush_req_swn_;
     SimpleWaitNotify index_req_swn_;
@@ -367,8 +435,19 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
 
     std::mutex flush_merge_compact_mutex_;
 
+    // collections (and partitions) with deletes since their last automatic compaction, with the time of the
+    // latest delete
+    std::mutex compact_collection_mutex_;
+    std::map<std::string, std::chrono::steady_clock::time_point> compact_collection_ids_;
+
     int64_t live_search_num_ = 0;
     std::mutex suspend_build_mutex_;
+
+    // data versions of root collections, drawn from one counter so that a dropped and recreated collection
+    // never gets back an old version
+    std::mutex collection_versions_mutex_;
+    std::unordered_map<std::string, uint64_t> collection_versions_;
+    uint64_t last_collection_version_ = 0;
 };  // DBImpl
 
 }  // namespace engine
@@ -74,6 +74,11 @@ struct DBOptions {
     int64_t auto_flush_interval_ = 1;
     int64_t file_cleanup_timeout_ = 10;
 
+    // segments with at least this fraction of deleted vectors are compacted in the background, 0 disables it
+    double auto_compact_ratio_ = 0.0;
+    int64_t auto_compact_rate_ = 1024;  // MB of segments rewritten per minute
+    int64_t auto_compact_interval_ = 60;  // seconds between two rounds of automatic compaction
+
     // wal relative configurations
     bool wal_enable_ = true;
     bool recovery_error_ignore_ = true;
@@ -46,6 +46,9 @@ struct VectorsData {
     std::vector<float> float_data_;
     std::vector<uint8_t> binary_data_;
     IDNumbers id_array_;
+    // inserting entities: the number of vectors of each entity, empty when each has one.
+    // the vectors of an entity are stored as rows sharing its id and attributes
+    std::vector<int64_t> vector_lengths_;
 };
 
 struct Entity {
@@ -11,6 +11,7 @@
 
 #include "db/Utils.h"
 
+#include <faiss/utils/distances.h>
 #include <fiu-local.h>
 
 #include <unistd.h>
@@ -20,7 +21,10 @@
 #include <regex>
 #include <vector>
 
+#include "cache/CpuCacheMgr.h"
 #include "config/Config.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "segment/IdIndex.h"
 //#include "storage/s3/S3ClientWrapper.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
@@ -194,6 +198,17 @@ Status
 DeleteCollectionFilePath(const DBMetaOptions& options, meta::SegmentSchema& table_file) {
     utils::GetCollectionFilePath(options, table_file);
     boost::filesystem::remove(table_file.location_);
+
+    // the inverted lists an index file refers to, and the ones older versions wrote on each load
+    boost::filesystem::path index_path(table_file.location_);
+    std::string lists_prefix = boost::filesystem::path(GetIVFListsPath(table_file.location_)).filename().string();
+    boost::system::error_code err;
+    boost::filesystem::directory_iterator it(index_path.parent_path(), err), end;
+    for (; !err && it != end; it.increment(err)) {
+        if (it->path().filename().string().compare(0, lists_prefix.size(), lists_prefix) == 0) {
+            boost::filesystem::remove(it->path(), err);
+        }
+    }
     return Status::OK();
 }
 
@@ -202,6 +217,7 @@ DeleteSegment(const DBMetaOptions& options, meta::SegmentSchema& table_file) {
     utils::GetCollectionFilePath(options, table_file);
     std::string segment_dir;
     GetParentPath(table_file.location_, segment_dir);
+    cache::CpuCacheMgr::GetInstance()->EraseItem(segment::IdIndexCacheKey(segment_dir));
     boost::filesystem::remove_all(segment_dir);
     return Status::OK();
 }
@@ -213,12 +229,69 @@ GetParentPath(const std::string& path, std::string& parent_path) {
     return Status::OK();
 }
 
+std::string
+GetIndexBasePath(const std::string& segment_dir) {
+    return segment_dir + "/index_base";
+}
+
+std::string
+GetIVFListsPath(const std::string& index_location) {
+    return index_location + ".lists";
+}
+
+const std::string&
+GetQuotaCollectionId(const meta::SegmentSchema& table_file) {
+    return table_file.owner_collection_.empty() ? table_file.collection_id_ : table_file.owner_collection_;
+}
+
 bool
 IsSameIndex(const CollectionIndex& index1, const CollectionIndex& index2) {
-    return index1.engine_type_ == index2.engine_type_ && index1.extra_params_ == index2.extra_params_ &&
+    milvus::json params1 = index1.extra_params_;
+    milvus::json params2 = index2.extra_params_;
+    if (params1.is_object()) {
+        params1.erase(TUNED_SEARCH_PARAMS);
+    }
+    if (params2.is_object()) {
+        params2.erase(TUNED_SEARCH_PARAMS);
+    }
+    return index1.engine_type_ == index2.engine_type_ && params1 == params2 &&
            index1.metric_type_ == index2.metric_type_;
 }
 
+void
+ApplyTunedSearchParams(const std::string& index_params, const milvus::json& user_params, milvus::json& extra_params) {
+    milvus::json tuned;
+    try {
+        tuned = milvus::json::parse(index_params);
+    } catch (std::exception& e) {
+        return;
+    }
+    if (!tuned.is_object() || !tuned.contains(TUNED_SEARCH_PARAMS)) {
+        return;
+    }
+
+    for (auto& item : tuned[TUNED_SEARCH_PARAMS].items()) {
+        if (user_params.contains(item.key()) || !item.value().is_number_integer()) {
+            continue;
+        }
+        int64_t value = item.value().get<int64_t>();
+        if (!extra_params.contains(item.key()) || extra_params[item.key()].get<int64_t>() < value) {
+            extra_params[item.key()] = value;
+        }
+    }
+}
+
+bool
+IsPreTransformedIndex(const std::string& index_params) {
+    milvus::json params;
+    try {
+        params = milvus::json::parse(index_params);
+    } catch (std::exception& e) {
+        return false;
+    }
+    return params.is_object() && params.contains(knowhere::IndexParams::pre_transform);
+}
+
 bool
 IsRawIndexType(int32_t type) {
     return (type == (int32_t)EngineType::FAISS_IDMAP) || (type == (int32_t)EngineType::FAISS_BIN_IDMAP);
@@ -233,6 +306,31 @@ IsBinaryMetricType(int32_t metric_type) {
            (metric_type == (int32_t)engine::MetricType::TANIMOTO);
 }
 
+bool
+IsSimilarityMetricType(int32_t metric_type) {
+    return (metric_type == (int32_t)engine::MetricType::IP) || (metric_type == (int32_t)engine::MetricType::COSINE);
+}
+
+void
+NormalizeVectors(int32_t metric_type, VectorsData& vectors) {
+    if (metric_type != (int32_t)engine::MetricType::COSINE || vectors.float_data_.empty() ||
+        vectors.vector_count_ == 0) {
+        return;
+    }
+
+    int64_t dim = vectors.float_data_.size() / vectors.vector_count_;
+    NormalizeVectors(metric_type, dim, vectors.float_data_);
+}
+
+void
+NormalizeVectors(int32_t metric_type, int64_t dimension, std::vector<float>& float_data) {
+    if (metric_type != (int32_t)engine::MetricType::COSINE || float_data.empty() || dimension <= 0) {
+        return;
+    }
+
+    faiss::fvec_renorm_L2(dimension, float_data.size() / dimension, float_data.data());
+}
+
 meta::DateT
 GetDate(const std::time_t& t, int day_delta) {
     struct tm ltm;
@@ -306,6 +404,7 @@ GetIndexName(int32_t index_type) {
         {(int32_t)engine::EngineType::ANNOY, "ANNOY"},
         {(int32_t)engine::EngineType::FAISS_IVFSQ8H, "IVFSQ8H"},
         {(int32_t)engine::EngineType::FAISS_PQ, "PQ"},
+        {(int32_t)engine::EngineType::FAISS_PQ_FASTSCAN, "PQ_FASTSCAN"},
         {(int32_t)engine::EngineType::SPTAG_KDT, "KDT"},
         {(int32_t)engine::EngineType::SPTAG_BKT, "BKT"},
         {(int32_t)engine::EngineType::FAISS_BIN_IDMAP, "IDMAP"},
@@ -13,6 +13,7 @@
 
 #include <ctime>
 #include <string>
+#include <vector>
 
 #include "Options.h"
 #include "db/Types.h"
@@ -42,15 +43,53 @@ DeleteSegment(const DBMetaOptions& options, meta::SegmentSchema& table_file);
 Status
 GetParentPath(const std::string& path, std::string& parent_path);
 
+// an HNSW index of a merged segment kept in it to be grown rather than rebuilt, see MergeTask
+std::string
+GetIndexBasePath(const std::string& segment_dir);
+
+// inverted lists of an IVF index kept in a file of their own, see engine_config.ivf_lists_on_disk
+std::string
+GetIVFListsPath(const std::string& index_location);
+
+// memory quotas are set per collection, the files of a partition count for the collection owning it
+const std::string&
+GetQuotaCollectionId(const meta::SegmentSchema& table_file);
+
+// search params tuned for a collection, see DB::TuneSearchParams, are kept in its index params under this key
+constexpr const char* TUNED_SEARCH_PARAMS = "search_params";
+
+// the tuned search params are ignored, they do not change the index
 bool
 IsSameIndex(const CollectionIndex& index1, const CollectionIndex& index2);
 
+// fill extra_params with the search params tuned for a collection, except those given in user_params. when
+// several collections are searched at once the largest value of each param is kept
+void
+ApplyTunedSearchParams(const std::string& index_params, const milvus::json& user_params, milvus::json& extra_params);
+
+// an index with a pre-transform, OPQ or PCA, is built and searched on cpu, it can't be copied to gpu
+bool
+IsPreTransformedIndex(const std::string& index_params);
+
 bool
 IsRawIndexType(int32_t type);
 
 bool
 IsBinaryMetricType(int32_t metric_type);
 
+// IP and COSINE, the larger the distance the closer the vectors
+bool
+IsSimilarityMetricType(int32_t metric_type);
+
+// the float vectors of a COSINE collection are normalized to unit length once, when they are inserted or
+// searched, so that the indexes compare them by inner product. zero vectors are left as is
+void
+NormalizeVectors(int32_t metric_type, VectorsData& vectors);
+
+// same for the query vectors of a hybrid search, float_data holds vectors of the collection dimension
+void
+NormalizeVectors(int32_t metric_type, int64_t dimension, std::vector<float>& float_data);
+
 meta::DateT
 GetDate(const std::time_t& t, int day_delta = 0);
 meta::DateT
@@ -40,18 +40,20 @@ enum class EngineType {
     FAISS_BIN_IVFFLAT,
     HNSW,
     ANNOY,
-    MAX_VALUE = ANNOY,
+    FAISS_PQ_FASTSCAN,
+    MAX_VALUE = FAISS_PQ_FASTSCAN,
 };
 
 enum class MetricType {
     L2 = 1,              // Euclidean Distance
-    IP = 2,              // Cosine Similarity
+    IP = 2,              // Inner Product
     HAMMING = 3,         // Hamming Distance
     JACCARD = 4,         // Jaccard Distance
     TANIMOTO = 5,        // Tanimoto Distance
     SUBSTRUCTURE = 6,    // Substructure Distance
     SUPERSTRUCTURE = 7,  // Superstructure Distance
-    MAX_VALUE = SUPERSTRUCTURE
+    COSINE = 8,          // Cosine Similarity, inner product of the vectors normalized at insert and search
+    MAX_VALUE = COSINE
 };
 
 enum class DataType {
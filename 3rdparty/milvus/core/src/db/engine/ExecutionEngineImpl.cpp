@@ -14,6 +14,7 @@
 #include <faiss/utils/ConcurrentBitset.h>
 #include <fiu-local.h>
 
+#include <boost/filesystem.hpp>
 #include <stdexcept>
 #include <unordered_map>
 #include <utility>
@@ -28,6 +29,7 @@
 #include "knowhere/index/vector_index/ConfAdapterMgr.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 #include "knowhere/index/vector_index/VecIndexFactory.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -59,6 +61,7 @@ Status
 MappingMetricType(MetricType metric_type, milvus::json& conf) {
     switch (metric_type) {
         case MetricType::IP:
+        case MetricType::COSINE:  // the vectors are normalized before they reach the engine
             conf[knowhere::Metric::TYPE] = knowhere::Metric::IP;
             break;
         case MetricType::L2:
@@ -91,6 +94,31 @@ IsBinaryIndexType(knowhere::IndexType type) {
     return type == knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP || type == knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT;
 }
 
+// the hnsw index a merged segment is grown from, see MergeTask. it is removed once read, the index built from it
+// replaces it. null if there is none or it does not fit the rows of the segment
+knowhere::VecIndexPtr
+LoadIndexBase(const std::string& location, int64_t dimension, int64_t count) {
+    std::string segment_dir;
+    utils::GetParentPath(location, segment_dir);
+    auto base_path = utils::GetIndexBasePath(segment_dir);
+    if (!boost::filesystem::exists(base_path)) {
+        return nullptr;
+    }
+
+    segment::SegmentReader segment_reader(segment_dir);
+    auto vector_index_ptr = std::make_shared<segment::VectorIndex>();
+    segment_reader.LoadVectorIndex(base_path, vector_index_ptr);
+    boost::system::error_code err;
+    boost::filesystem::remove(base_path, err);
+
+    auto base = vector_index_ptr->GetVectorIndex();
+    if (base == nullptr || base->index_type() != knowhere::IndexEnum::INDEX_HNSW || base->Dim() != dimension ||
+        base->Count() >= count) {
+        return nullptr;
+    }
+    return base;
+}
+
 }  // namespace
 
 #ifdef MILVUS_GPU_VERSION
@@ -165,7 +193,8 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
     bool gpu_resource_enable = true;
     config.GetGpuResourceConfigEnable(gpu_resource_enable);
     fiu_do_on("ExecutionEngineImpl.CreatetVecIndex.gpu_res_disabled", gpu_resource_enable = false);
-    if (gpu_resource_enable) {
+    // pre-transformed indexes are built and searched on cpu
+    if (gpu_resource_enable && !index_params_.contains(knowhere::IndexParams::pre_transform)) {
         mode = knowhere::IndexMode::MODE_GPU;
     }
 #endif
@@ -185,6 +214,10 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
             index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IVFPQ, mode);
             break;
         }
+        case EngineType::FAISS_PQ_FASTSCAN: {
+            index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IVFPQFASTSCAN, mode);
+            break;
+        }
         case EngineType::FAISS_IVFSQ8: {
             index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IVFSQ8, mode);
             break;
@@ -312,6 +345,35 @@ ExecutionEngineImpl::HybridUnset() const {
 #endif
 }
 
+Status
+ExecutionEngineImpl::MoveIVFListsToDisk() {
+    auto index_type = index_->index_type();
+    if (index_->index_mode() != knowhere::IndexMode::MODE_CPU ||
+        (index_type != knowhere::IndexEnum::INDEX_FAISS_IVFFLAT &&
+         index_type != knowhere::IndexEnum::INDEX_FAISS_IVFSQ8)) {
+        return Status::OK();
+    }
+
+    bool lists_on_disk = false;
+    server::Config& config = server::Config::GetInstance();
+    STATUS_CHECK(config.GetEngineConfigIvfListsOnDisk(lists_on_disk));
+    if (!lists_on_disk) {
+        return Status::OK();
+    }
+
+    // the lists are written once next to the index file, the serialized index maps them when it is loaded
+    std::string lists_path = utils::GetIVFListsPath(location_);
+    try {
+        std::static_pointer_cast<knowhere::IVF>(index_)->MoveListsToDisk(lists_path);
+    } catch (std::exception& e) {
+        std::string msg = "Failed to move inverted lists of " + location_ + " to disk: " + e.what();
+        LOG_ENGINE_ERROR_ << msg;
+        return Status(DB_ERROR, msg);
+    }
+    LOG_ENGINE_DEBUG_ << "Inverted lists of " << location_ << " moved to " << lists_path;
+    return Status::OK();
+}
+
 Status
 ExecutionEngineImpl::AddWithIds(int64_t n, const float* xdata, const int64_t* xids) {
     auto dataset = knowhere::GenDatasetWithIds(n, index_->Dim(), xdata, xids);
@@ -358,6 +420,7 @@ ExecutionEngineImpl::Serialize() {
     std::string segment_dir;
     utils::GetParentPath(location_, segment_dir);
     auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(segment_dir);
+    STATUS_CHECK(MoveIVFListsToDisk());
     segment_writer_ptr->SetVectorIndex(index_);
     auto status = segment_writer_ptr->WriteVectorIndex(location_);
 
@@ -674,9 +737,21 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     std::vector<segment::doc_id_t> uids;
     faiss::ConcurrentBitsetPtr blacklist;
     if (from_index) {
-        auto dataset =
-            knowhere::GenDatasetWithIds(Count(), Dimension(), from_index->GetRawVectors(), from_index->GetRawIds());
-        to_index->BuildAll(dataset, conf);
+        auto base = (engine_type == EngineType::HNSW) ? LoadIndexBase(location_, Dimension(), Count()) : nullptr;
+        if (base != nullptr) {
+            // the rows of the base come first in the merged segment, only those after them are inserted
+            auto base_count = base->Count();
+            auto dataset = knowhere::GenDatasetWithIds(Count() - base_count, Dimension(),
+                                                       from_index->GetRawVectors() + base_count * Dimension(),
+                                                       from_index->GetRawIds() + base_count);
+            base->Add(dataset, conf);
+            to_index = base;
+            LOG_ENGINE_DEBUG_ << "Grow index of " << base_count << " rows to " << Count() << " rows";
+        } else {
+            auto dataset = knowhere::GenDatasetWithIds(Count(), Dimension(), from_index->GetRawVectors(),
+                                                       from_index->GetRawIds());
+            to_index->BuildAll(dataset, conf);
+        }
         uids = from_index->GetUids();
         blacklist = from_index->GetBlacklist();
     } else if (bin_from_index) {
@@ -1055,17 +1130,21 @@ ExecutionEngineImpl::ExecBinaryQuery(milvus::query::GeneralQueryPtr general_quer
         }
         if (general_query->leaf->vector_query != nullptr) {
             // Do search
-            faiss::ConcurrentBitsetPtr list;
-            list = index_->GetBlacklist();
-            // Do OR
-            for (uint64_t i = 0; i < vector_count_; ++i) {
-                if (list->test(i) || bitset->test(i)) {
-                    bitset->set(i);
+            if (bitset != nullptr) {
+                faiss::ConcurrentBitsetPtr list;
+                list = index_->GetBlacklist();
+                // Do OR
+                for (uint64_t i = 0; i < vector_count_; ++i) {
+                    if ((list != nullptr && list->test(i)) || bitset->test(i)) {
+                        bitset->set(i);
+                    }
                 }
+                index_->SetBlacklist(bitset);
             }
-            index_->SetBlacklist(bitset);
             auto vector_query = general_query->leaf->vector_query;
-            topk = vector_query->topk;
+            // the hits of the vectors of multi-vector entities are aggregated by the search task
+            topk = vector_query->max_sim == query::MaxSimType::NONE ? vector_query->topk
+                                                                    : vector_query->max_sim_candidates;
             nq = vector_query->query_vector.float_data.size() / dim_;
 
             distances.resize(nq * topk);
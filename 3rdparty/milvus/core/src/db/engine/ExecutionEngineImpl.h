@@ -119,6 +119,9 @@ class ExecutionEngineImpl : public ExecutionEngine {
     void
     HybridUnset() const;
 
+    Status
+    MoveIVFListsToDisk();
+
  protected:
     knowhere::VecIndexPtr index_ = nullptr;
     EngineType index_type_;
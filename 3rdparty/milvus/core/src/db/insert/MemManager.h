@@ -46,6 +46,10 @@ class MemManager {
     virtual Status
     DeleteVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, uint64_t lsn) = 0;
 
+    virtual Status
+    Search(const std::set<std::string>& collection_ids, uint64_t k, const VectorsData& vectors,
+           ResultIds& result_ids, ResultDistances& result_distances, bool& ascending) = 0;
+
     virtual Status
     Flush(const std::string& collection_id, bool apply_delete = true) = 0;
 
@@ -11,10 +11,12 @@
 
 #include "db/insert/MemManagerImpl.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "VectorSource.h"
 #include "db/Constants.h"
+#include "scheduler/task/SearchTask.h"
 #include "utils/Log.h"
 
 namespace milvus {
@@ -35,7 +37,7 @@ Status
 MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                               const float* vectors, uint64_t lsn, std::set<std::string>& flushed_tables) {
     flushed_tables.clear();
-    if (GetCurrentMem() > options_.insert_buffer_size_) {
+    if (ForceFlushNeeded()) {
         LOG_ENGINE_DEBUG_ << "Insert buffer size exceeds limit. Performing force flush";
         // TODO(zhiru): Don't apply delete here in order to avoid possible concurrency issues with Merge
         auto status = Flush(flushed_tables, false);
@@ -61,7 +63,7 @@ Status
 MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                               const uint8_t* vectors, uint64_t lsn, std::set<std::string>& flushed_tables) {
     flushed_tables.clear();
-    if (GetCurrentMem() > options_.insert_buffer_size_) {
+    if (ForceFlushNeeded()) {
         LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] ", "insert", 0)
                           << "Insert buffer size exceeds limit. Performing force flush";
         // TODO(zhiru): Don't apply delete here in order to avoid possible concurrency issues with Merge
@@ -92,7 +94,7 @@ MemManagerImpl::InsertEntities(const std::string& table_id, int64_t length, cons
                                const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data, uint64_t lsn,
                                std::set<std::string>& flushed_tables) {
     flushed_tables.clear();
-    if (GetCurrentMem() > options_.insert_buffer_size_) {
+    if (ForceFlushNeeded()) {
         LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld] ", "insert", 0)
                           << "Insert buffer size exceeds limit. Performing force flush";
         auto status = Flush(flushed_tables, false);
@@ -171,6 +173,56 @@ MemManagerImpl::DeleteVectors(const std::string& collection_id, int64_t length,
     return Status::OK();
 }
 
+Status
+MemManagerImpl::Search(const std::set<std::string>& collection_ids, uint64_t k, const VectorsData& vectors,
+                       ResultIds& result_ids, ResultDistances& result_distances, bool& ascending) {
+    // pick up every table still holding unflushed data, each paired with the deletes issued after it was sealed
+    std::vector<std::pair<MemTablePtr, std::set<segment::doc_id_t>>> tables;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (auto& collection_id : collection_ids) {
+            MemList history;  // oldest first
+            for (auto& mem : serializing_mem_list_) {
+                if (mem->GetTableId() == collection_id) {
+                    history.push_back(mem);
+                }
+            }
+            for (auto& mem : immu_mem_list_) {
+                if (mem->GetTableId() == collection_id) {
+                    history.push_back(mem);
+                }
+            }
+            auto mem_it = mem_id_map_.find(collection_id);
+            if (mem_it != mem_id_map_.end()) {
+                history.push_back(mem_it->second);
+            }
+
+            std::set<segment::doc_id_t> newer_deletes;
+            for (auto it = history.rbegin(); it != history.rend(); ++it) {
+                tables.emplace_back(*it, newer_deletes);
+                (*it)->GetPendingDeletes(newer_deletes);
+            }
+        }
+    }
+
+    auto nq = vectors.vector_count_;
+    for (auto& pair : tables) {
+        ResultIds table_ids;
+        ResultDistances table_distances;
+        auto status = pair.first->Search(k, vectors, pair.second, table_ids, table_distances, ascending);
+        if (!status.ok()) {
+            LOG_ENGINE_ERROR_ << "Search insert buffer of collection " << pair.first->GetTableId()
+                              << " failed: " << status.message();
+            return status;
+        }
+
+        scheduler::XSearchTask::MergeTopkToResultSet(table_ids, table_distances, k, nq, k, ascending, result_ids,
+                                                     result_distances);
+    }
+
+    return Status::OK();
+}
+
 Status
 MemManagerImpl::Flush(const std::string& collection_id, bool apply_delete) {
     ToImmutable(collection_id);
@@ -179,6 +231,8 @@ MemManagerImpl::Flush(const std::string& collection_id, bool apply_delete) {
     {
         std::unique_lock<std::mutex> lock(mutex_);
         immu_mem_list_.swap(temp_immutable_list);
+        serializing_mem_list_.insert(serializing_mem_list_.end(), temp_immutable_list.begin(),
+                                     temp_immutable_list.end());
     }
 
     std::unique_lock<std::mutex> lock(serialization_mtx_);
@@ -188,10 +242,12 @@ MemManagerImpl::Flush(const std::string& collection_id, bool apply_delete) {
         auto status = mem->Serialize(max_lsn, apply_delete);
         if (!status.ok()) {
             LOG_ENGINE_ERROR_ << "Flush collection " << mem->GetTableId() << " failed";
+            FinishSerialize(temp_immutable_list);
             return status;
         }
         LOG_ENGINE_DEBUG_ << "Flushed collection: " << mem->GetTableId();
     }
+    FinishSerialize(temp_immutable_list);
 
     return Status::OK();
 }
@@ -204,6 +260,8 @@ MemManagerImpl::Flush(std::set<std::string>& table_ids, bool apply_delete) {
     {
         std::unique_lock<std::mutex> lock(mutex_);
         immu_mem_list_.swap(temp_immutable_list);
+        serializing_mem_list_.insert(serializing_mem_list_.end(), temp_immutable_list.begin(),
+                                     temp_immutable_list.end());
     }
 
     std::unique_lock<std::mutex> lock(serialization_mtx_);
@@ -214,11 +272,13 @@ MemManagerImpl::Flush(std::set<std::string>& table_ids, bool apply_delete) {
         auto status = mem->Serialize(max_lsn, apply_delete);
         if (!status.ok()) {
             LOG_ENGINE_ERROR_ << "Flush collection " << mem->GetTableId() << " failed";
+            FinishSerialize(temp_immutable_list);
             return status;
         }
         table_ids.insert(mem->GetTableId());
         LOG_ENGINE_DEBUG_ << "Flushed collection: " << mem->GetTableId();
     }
+    FinishSerialize(temp_immutable_list);
 
     meta_->SetGlobalLastLSN(max_lsn);
 
@@ -280,6 +340,15 @@ MemManagerImpl::EraseMemVector(const std::string& collection_id) {
     return Status::OK();
 }
 
+bool
+MemManagerImpl::ForceFlushNeeded() {
+    // a read replica doesn't write segments, its buffer is dropped when the writable node flushes
+    if (options_.mode_ == DBOptions::MODE::CLUSTER_READONLY && options_.wal_enable_) {
+        return false;
+    }
+    return GetCurrentMem() > options_.insert_buffer_size_;
+}
+
 size_t
 MemManagerImpl::GetCurrentMutableMem() {
     size_t total_mem = 0;
@@ -318,6 +387,17 @@ MemManagerImpl::GetMaxLSN(const MemList& tables) {
     return max_lsn;
 }
 
+void
+MemManagerImpl::FinishSerialize(const MemList& tables) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto& mem : tables) {
+        auto it = std::find(serializing_mem_list_.begin(), serializing_mem_list_.end(), mem);
+        if (it != serializing_mem_list_.end()) {
+            serializing_mem_list_.erase(it);
+        }
+    }
+}
+
 void
 MemManagerImpl::OnInsertBufferSizeChanged(int64_t value) {
     options_.insert_buffer_size_ = value * GB;
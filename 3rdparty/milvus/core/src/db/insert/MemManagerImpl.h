@@ -62,6 +62,10 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     Status
     DeleteVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, uint64_t lsn) override;
 
+    Status
+    Search(const std::set<std::string>& collection_ids, uint64_t k, const VectorsData& vectors,
+           ResultIds& result_ids, ResultDistances& result_distances, bool& ascending) override;
+
     Status
     Flush(const std::string& collection_id, bool apply_delete = true) override;
 
@@ -91,6 +95,9 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     MemTablePtr
     GetMemByTable(const std::string& collection_id);
 
+    bool
+    ForceFlushNeeded();
+
     Status
     InsertVectorsNoLock(const std::string& collection_id, const VectorSourcePtr& source, uint64_t lsn);
 
@@ -106,8 +113,13 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     uint64_t
     GetMaxLSN(const MemList& tables);
 
+    void
+    FinishSerialize(const MemList& tables);
+
     MemIdMap mem_id_map_;
     MemList immu_mem_list_;
+    // tables being written to disk, kept searchable until their segments are visible in meta
+    MemList serializing_mem_list_;
     meta::MetaPtr meta_;
     DBOptions options_;
     std::mutex mutex_;
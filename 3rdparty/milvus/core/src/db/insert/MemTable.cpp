@@ -20,6 +20,7 @@
 #include "db/insert/MemTable.h"
 #include "db/meta/FilesHolder.h"
 #include "knowhere/index/vector_index/VecIndex.h"
+#include "scheduler/task/SearchTask.h"
 #include "segment/SegmentReader.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
@@ -35,6 +36,7 @@ MemTable::MemTable(const std::string& collection_id, const meta::MetaPtr& meta,
 
 Status
 MemTable::Add(const VectorSourcePtr& source) {
+    std::lock_guard<std::mutex> lock(mutex_);
     while (!source->AllAdded()) {
         MemTableFilePtr current_mem_table_file;
         if (!mem_table_file_list_.empty()) {
@@ -63,6 +65,7 @@ MemTable::Add(const VectorSourcePtr& source) {
 
 Status
 MemTable::AddEntities(const milvus::engine::VectorSourcePtr& source) {
+    std::lock_guard<std::mutex> lock(mutex_);
     while (!source->AllAdded()) {
         MemTableFilePtr current_mem_table_file;
         if (!mem_table_file_list_.empty()) {
@@ -91,6 +94,7 @@ MemTable::AddEntities(const milvus::engine::VectorSourcePtr& source) {
 
 Status
 MemTable::Delete(segment::doc_id_t doc_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
     // Locate which collection file the doc id lands in
     for (auto& table_file : mem_table_file_list_) {
         table_file->Delete(doc_id);
@@ -103,6 +107,7 @@ MemTable::Delete(segment::doc_id_t doc_id) {
 
 Status
 MemTable::Delete(const std::vector<segment::doc_id_t>& doc_ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
     // Locate which collection file the doc id lands in
     for (auto& table_file : mem_table_file_list_) {
         table_file->Delete(doc_ids);
@@ -115,6 +120,34 @@ MemTable::Delete(const std::vector<segment::doc_id_t>& doc_ids) {
     return Status::OK();
 }
 
+Status
+MemTable::Search(uint64_t k, const VectorsData& vectors, const std::set<segment::doc_id_t>& pending_deletes,
+                 ResultIds& result_ids, ResultDistances& result_distances, bool& ascending) {
+    // hold the lock during the scan so that inserts can't reallocate the buffers underneath
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto nq = vectors.vector_count_;
+    for (auto& mem_table_file : mem_table_file_list_) {
+        ResultIds file_ids;
+        ResultDistances file_distances;
+        auto status = mem_table_file->Search(k, vectors, pending_deletes, file_ids, file_distances);
+        if (!status.ok()) {
+            return status;
+        }
+
+        ascending = mem_table_file->IsAscending();
+        scheduler::XSearchTask::MergeTopkToResultSet(file_ids, file_distances, k, nq, k, ascending, result_ids,
+                                                     result_distances);
+    }
+
+    return Status::OK();
+}
+
+void
+MemTable::GetPendingDeletes(std::set<segment::doc_id_t>& doc_ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    doc_ids.insert(doc_ids_to_delete_.begin(), doc_ids_to_delete_.end());
+}
+
 void
 MemTable::GetCurrentMemTableFile(MemTableFilePtr& mem_table_file) {
     mem_table_file = mem_table_file_list_.back();
@@ -382,7 +415,10 @@ MemTable::ApplyDeletes() {
         return Status(DB_ERROR, err_msg);
     }
 
-    doc_ids_to_delete_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        doc_ids_to_delete_.clear();
+    }
 
     recorder.RecordSection("Update deletes to meta");
     recorder.ElapseFromBegin("Finished deletes");
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "config/handler/CacheConfigHandler.h"
+#include "db/Types.h"
 #include "db/insert/MemTableFile.h"
 #include "db/insert/VectorSource.h"
 #include "utils/Status.h"
@@ -44,6 +45,13 @@ class MemTable : public server::CacheConfigHandler {
     Status
     Delete(const std::vector<segment::doc_id_t>& doc_ids);
 
+    Status
+    Search(uint64_t k, const VectorsData& vectors, const std::set<segment::doc_id_t>& pending_deletes,
+           ResultIds& result_ids, ResultDistances& result_distances, bool& ascending);
+
+    void
+    GetPendingDeletes(std::set<segment::doc_id_t>& doc_ids);
+
     void
     GetCurrentMemTableFile(MemTableFilePtr& mem_table_file);
 
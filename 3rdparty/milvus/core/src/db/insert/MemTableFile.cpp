@@ -11,9 +11,14 @@
 
 #include "db/insert/MemTableFile.h"
 
+#include <faiss/utils/BinaryDistance.h>
+#include <faiss/utils/distances.h>
+#include <faiss/utils/hamming.h>
+
 #include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -31,7 +36,10 @@ namespace engine {
 MemTableFile::MemTableFile(const std::string& collection_id, const meta::MetaPtr& meta, const DBOptions& options)
     : collection_id_(collection_id), meta_(meta), options_(options) {
     current_mem_ = 0;
-    auto status = CreateCollectionFile();
+    // a read replica buffers the wal of the writable node for search only, the shared meta and storage are
+    // left to the writable node
+    bool replica = options_.mode_ == DBOptions::MODE::CLUSTER_READONLY;
+    auto status = replica ? DescribeCollectionFile() : CreateCollectionFile();
     if (status.ok()) {
         /*execution_engine_ = EngineFactory::Build(
             table_file_schema_.dimension_, table_file_schema_.location_, (EngineType)table_file_schema_.engine_type_,
@@ -59,6 +67,26 @@ MemTableFile::CreateCollectionFile() {
     return status;
 }
 
+Status
+MemTableFile::DescribeCollectionFile() {
+    meta::CollectionSchema collection_schema;
+    collection_schema.collection_id_ = collection_id_;
+    auto status = meta_->DescribeCollection(collection_schema);
+    if (!status.ok()) {
+        std::string err_msg = "MemTableFile::DescribeCollectionFile failed: " + status.ToString();
+        LOG_ENGINE_ERROR_ << err_msg;
+        return status;
+    }
+
+    table_file_schema_.collection_id_ = collection_id_;
+    table_file_schema_.dimension_ = collection_schema.dimension_;
+    table_file_schema_.index_file_size_ = collection_schema.index_file_size_;
+    table_file_schema_.index_params_ = collection_schema.index_params_;
+    table_file_schema_.engine_type_ = collection_schema.engine_type_;
+    table_file_schema_.metric_type_ = collection_schema.metric_type_;
+    return Status::OK();
+}
+
 Status
 MemTableFile::Add(const VectorSourcePtr& source) {
     if (table_file_schema_.dimension_ <= 0) {
@@ -164,6 +192,130 @@ MemTableFile::Delete(const std::vector<segment::doc_id_t>& doc_ids) {
     return Status::OK();
 }
 
+Status
+MemTableFile::Search(uint64_t k, const VectorsData& vectors, const std::set<segment::doc_id_t>& pending_deletes,
+                     ResultIds& result_ids, ResultDistances& result_distances) {
+    auto nq = vectors.vector_count_;
+    auto ascending = IsAscending();
+    result_ids.assign(nq * k, -1);
+    result_distances.assign(nq * k, ascending ? std::numeric_limits<float>::max() : -std::numeric_limits<float>::max());
+
+    segment::SegmentPtr segment_ptr;
+    segment_writer_ptr_->GetSegment(segment_ptr);
+    auto& uids = segment_ptr->vectors_ptr_->GetUids();
+    auto& data = segment_ptr->vectors_ptr_->GetData();
+    size_t count = uids.size();
+    if (count == 0 || nq == 0 || k == 0) {
+        return Status::OK();
+    }
+
+    // deletes arrived after this buffer became immutable, mask them out like a segment blacklist
+    faiss::ConcurrentBitsetPtr blacklist = nullptr;
+    if (!pending_deletes.empty()) {
+        for (size_t i = 0; i < count; ++i) {
+            if (pending_deletes.find(uids[i]) != pending_deletes.end()) {
+                if (blacklist == nullptr) {
+                    blacklist = std::make_shared<faiss::ConcurrentBitset>(count);
+                }
+                blacklist->set(i);
+            }
+        }
+    }
+
+    size_t dim = table_file_schema_.dimension_;
+    size_t code_size = dim / 8;
+    auto metric_type = (MetricType)table_file_schema_.metric_type_;
+    float* distances = result_distances.data();
+    int64_t* labels = result_ids.data();
+    try {
+        switch (metric_type) {
+            case MetricType::L2: {
+                if (vectors.float_data_.empty()) {
+                    return Status(DB_ERROR, "Search float collection with binary vectors");
+                }
+                faiss::float_maxheap_array_t res = {nq, k, labels, distances};
+                faiss::knn_L2sqr(vectors.float_data_.data(), reinterpret_cast<const float*>(data.data()), dim, nq,
+                                 count, &res, blacklist);
+                break;
+            }
+            case MetricType::IP:
+            case MetricType::COSINE: {
+                if (vectors.float_data_.empty()) {
+                    return Status(DB_ERROR, "Search float collection with binary vectors");
+                }
+                faiss::float_minheap_array_t res = {nq, k, labels, distances};
+                faiss::knn_inner_product(vectors.float_data_.data(), reinterpret_cast<const float*>(data.data()),
+                                         dim, nq, count, &res, blacklist);
+                break;
+            }
+            case MetricType::HAMMING: {
+                if (vectors.binary_data_.empty()) {
+                    return Status(DB_ERROR, "Search binary collection with float vectors");
+                }
+                std::vector<int32_t> int_distances(nq * k);
+                faiss::int_maxheap_array_t res = {nq, k, labels, int_distances.data()};
+                faiss::hammings_knn_hc(&res, vectors.binary_data_.data(), data.data(), count, code_size, 1, blacklist);
+                for (size_t i = 0; i < nq * k; ++i) {
+                    distances[i] = labels[i] == -1 ? std::numeric_limits<float>::max() : (float)int_distances[i];
+                }
+                break;
+            }
+            case MetricType::JACCARD:
+            case MetricType::TANIMOTO: {
+                if (vectors.binary_data_.empty()) {
+                    return Status(DB_ERROR, "Search binary collection with float vectors");
+                }
+                faiss::float_maxheap_array_t res = {nq, k, labels, distances};
+                faiss::binary_distence_knn_hc(faiss::METRIC_Jaccard, &res, vectors.binary_data_.data(), data.data(),
+                                              count, code_size, 1, blacklist);
+                if (metric_type == MetricType::TANIMOTO) {
+                    for (size_t i = 0; i < nq * k; ++i) {
+                        if (labels[i] != -1) {
+                            distances[i] = -log2(1 - distances[i]);
+                        }
+                    }
+                }
+                break;
+            }
+            case MetricType::SUBSTRUCTURE:
+            case MetricType::SUPERSTRUCTURE: {
+                if (vectors.binary_data_.empty()) {
+                    return Status(DB_ERROR, "Search binary collection with float vectors");
+                }
+                auto faiss_metric = (metric_type == MetricType::SUBSTRUCTURE) ? faiss::METRIC_Substructure
+                                                                               : faiss::METRIC_Superstructure;
+                faiss::binary_distence_knn_mc(faiss_metric, vectors.binary_data_.data(), data.data(), nq, count, k,
+                                              code_size, distances, labels, blacklist);
+                break;
+            }
+            default:
+                return Status(DB_ERROR, "Unsupported metric type: " + std::to_string((int)metric_type));
+        }
+    } catch (std::exception& ex) {
+        std::string err_msg = "Failed to search insert buffer: " + std::string(ex.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+
+    /* map offsets to ids */
+    for (size_t i = 0; i < nq * k; ++i) {
+        if (labels[i] >= 0 && labels[i] < (int64_t)count) {
+            labels[i] = uids[labels[i]];
+        } else {
+            labels[i] = -1;
+        }
+    }
+
+    return Status::OK();
+}
+
+bool
+MemTableFile::IsAscending() const {
+    // distance -- value 0 means two vectors equal, ascending reduce, L2/HAMMING/JACCARD/TONIMOTO ...
+    // similarity -- infinity value means two vectors equal, descending reduce, IP/COSINE
+    return !utils::IsSimilarityMetricType(table_file_schema_.metric_type_);
+}
+
 size_t
 MemTableFile::GetCurrentMem() {
     return current_mem_;
@@ -182,6 +334,10 @@ MemTableFile::IsFull() {
 
 Status
 MemTableFile::Serialize(uint64_t wal_lsn) {
+    if (table_file_schema_.file_id_.empty()) {
+        return Status(DB_ERROR, "Insert buffer file isn't in the meta, it can't be serialized");
+    }
+
     size_t size = GetCurrentMem();
     server::CollectSerializeMetrics metrics(size);
 
@@ -12,10 +12,12 @@
 #pragma once
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "config/handler/CacheConfigHandler.h"
+#include "db/Types.h"
 #include "db/engine/ExecutionEngine.h"
 #include "db/insert/VectorSource.h"
 #include "db/meta/Meta.h"
@@ -44,6 +46,14 @@ class MemTableFile : public server::CacheConfigHandler {
     Status
     Delete(const std::vector<segment::doc_id_t>& doc_ids);
 
+    // brute-force search over the buffered vectors, ids in pending_deletes are skipped
+    Status
+    Search(uint64_t k, const VectorsData& vectors, const std::set<segment::doc_id_t>& pending_deletes,
+           ResultIds& result_ids, ResultDistances& result_distances);
+
+    bool
+    IsAscending() const;
+
     size_t
     GetCurrentMem();
 
@@ -67,6 +77,10 @@ class MemTableFile : public server::CacheConfigHandler {
     Status
     CreateCollectionFile();
 
+    // collection settings of a file that is never added to the meta
+    Status
+    DescribeCollectionFile();
+
  private:
     const std::string collection_id_;
     meta::SegmentSchema table_file_schema_;
@@ -77,7 +77,10 @@ MergeManagerImpl::MergeFiles(const std::string& collection_id) {
 
     for (auto& group : files_groups) {
         MergeTask task(meta_ptr_, options_, group);
-        status = task.Execute();
+        auto merge_status = task.Execute();
+        if (!merge_status.ok()) {
+            status = merge_status;
+        }
 
         files_holder.UnmarkFiles(group);
     }
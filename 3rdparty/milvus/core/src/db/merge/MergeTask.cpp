@@ -11,17 +11,69 @@
 
 #include "db/merge/MergeTask.h"
 #include "db/Utils.h"
+#include "db/meta/MetaConsts.h"
 #include "metrics/Metrics.h"
+#include "scheduler/SchedInst.h"
 #include "segment/SegmentReader.h"
 #include "segment/SegmentWriter.h"
 #include "utils/Log.h"
 
+#include <algorithm>
+#include <boost/filesystem.hpp>
 #include <memory>
 #include <string>
 
 namespace milvus {
 namespace engine {
 
+namespace {
+
+// the input whose hnsw index the merged one is grown from, the indexed one with the most rows. an index over rows
+// some of which are deleted is not used, the merge drops those rows and the offsets it is labeled with would shift
+int64_t
+PickIndexBase(const meta::SegmentsSchema& files, int32_t engine_type) {
+    if (engine_type != (int32_t)EngineType::HNSW) {
+        return -1;
+    }
+
+    int64_t base = -1;
+    for (size_t i = 0; i < files.size(); ++i) {
+        auto& file = files[i];
+        if (file.file_type_ != (int32_t)meta::SegmentSchema::INDEX || file.engine_type_ != engine_type) {
+            continue;
+        }
+        if (base >= 0 && files[base].row_count_ >= file.row_count_) {
+            continue;
+        }
+
+        std::string segment_dir;
+        utils::GetParentPath(file.location_, segment_dir);
+        segment::SegmentReader segment_reader(segment_dir);
+        size_t deleted_count = 0;
+        if (segment_reader.ReadDeletedDocsSize(deleted_count).ok() && deleted_count == 0) {
+            base = i;
+        }
+    }
+    return base;
+}
+
+// the index file is linked into the merged segment, or copied where it cannot be linked
+Status
+LinkIndexBase(const std::string& location, const std::string& segment_dir) {
+    auto base_path = utils::GetIndexBasePath(segment_dir);
+    boost::system::error_code err;
+    boost::filesystem::create_hard_link(location, base_path, err);
+    if (err) {
+        boost::filesystem::copy_file(location, base_path, boost::filesystem::copy_option::overwrite_if_exists, err);
+    }
+    if (err) {
+        return Status(DB_ERROR, "Failed to link index " + location + ": " + err.message());
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
 MergeTask::MergeTask(const meta::MetaPtr& meta_ptr, const DBOptions& options, meta::SegmentsSchema& files)
     : meta_ptr_(meta_ptr), options_(options), files_(files) {
 }
@@ -40,6 +92,29 @@ MergeTask::Execute() {
         }
     }
 
+    // merged vectors are buffered in memory until serialized, fail this round if memory budget is exhausted,
+    // the files stay unmerged and are picked again by next merge
+    int64_t merge_size = 0;
+    for (auto& file : files_) {
+        merge_size += static_cast<int64_t>(file.file_size_);
+    }
+    auto& quota_collection_id = utils::GetQuotaCollectionId(files_.front());
+    auto mem_mgr = scheduler::MemMgrInst::GetInstance();
+    if (!mem_mgr->Fits(quota_collection_id, merge_size)) {
+        std::string msg = "Failed to merge " + std::to_string(files_.size()) + " files of collection " +
+                          collection_id + ", " + std::to_string(merge_size) +
+                          " bytes exceed memory budget or collection quota";
+        LOG_ENGINE_WARNING_ << msg;
+        return Status(DB_ERROR, msg);
+    }
+    scheduler::MemReservation reservation(mem_mgr, quota_collection_id, merge_size);
+    if (!reservation.Ok()) {
+        std::string msg = "Failed to merge " + std::to_string(files_.size()) + " files of collection " +
+                          collection_id + ", " + std::to_string(merge_size) + " bytes exceed memory budget";
+        LOG_ENGINE_DEBUG_ << msg;
+        return Status(DB_ERROR, msg);
+    }
+
     // step 1: create collection file
     meta::SegmentSchema collection_file;
     collection_file.collection_id_ = collection_id;
@@ -57,8 +132,16 @@ MergeTask::Execute() {
     utils::GetParentPath(collection_file.location_, new_segment_dir);
     auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(new_segment_dir);
 
+    // the rows of the base index are merged first so that they keep their offsets
+    auto base = PickIndexBase(files_, collection_file.engine_type_);
+    if (base > 0) {
+        std::rotate(files_.begin(), files_.begin() + base, files_.begin() + base + 1);
+        base = 0;
+    }
+
     // attention: here is a copy, not reference, since files_holder.UnmarkFile will change the array internal
     std::string info = "Merge task files size info:";
+    bool has_index = false;
     for (auto& file : files_) {
         info += std::to_string(file.file_size_);
         info += ", ";
@@ -68,9 +151,29 @@ MergeTask::Execute() {
         utils::GetParentPath(file.location_, segment_dir_to_merge);
         segment_writer_ptr->Merge(segment_dir_to_merge, collection_file.file_id_);
 
+        // rows deleted from the base since it was picked are dropped by the merge, it cannot be used then
+        if (base == 0 && &file == &files_.front() &&
+            segment_writer_ptr->VectorCount() != file.row_count_) {
+            base = -1;
+        }
+
         auto file_schema = file;
         file_schema.file_type_ = meta::SegmentSchema::TO_DELETE;
         updated.push_back(file_schema);
+        if (file.file_type_ != (int32_t)meta::SegmentSchema::RAW) {
+            // the raw file the index was built from is kept in the segment as backup
+            has_index = true;
+            meta::FilesHolder segment_holder;
+            meta_ptr_->GetCollectionFilesBySegmentId(file.segment_id_, segment_holder);
+            for (auto& segment_file : segment_holder.HoldFiles()) {
+                if (segment_file.id_ != file.id_) {
+                    segment_file.file_type_ = meta::SegmentSchema::TO_DELETE;
+                    updated.push_back(segment_file);
+                }
+            }
+            segment_holder.ReleaseFiles();
+        }
+
         auto size = segment_writer_ptr->Size();
         if (size >= file_schema.index_file_size_) {
             break;
@@ -101,17 +204,25 @@ MergeTask::Execute() {
     }
 
     // step 4: update collection files state
-    // if index type isn't IDMAP, set file type to TO_INDEX if file size exceed index_file_size
-    // else set file type to RAW, no need to build index
-    if (!utils::IsRawIndexType(collection_file.engine_type_)) {
-        collection_file.file_type_ = (segment_writer_ptr->Size() >= collection_file.index_file_size_)
-                                         ? meta::SegmentSchema::TO_INDEX
-                                         : meta::SegmentSchema::RAW;
+    // if index type isn't IDMAP, set file type to TO_INDEX if file size exceed index_file_size,
+    // or if indexed files were merged and there are enough rows to index, else set file type to RAW
+    collection_file.file_size_ = segment_writer_ptr->Size();
+    collection_file.row_count_ = segment_writer_ptr->VectorCount();
+    if (!utils::IsRawIndexType(collection_file.engine_type_) &&
+        (collection_file.file_size_ >= collection_file.index_file_size_ ||
+         (has_index && collection_file.row_count_ >= meta::BUILD_INDEX_THRESHOLD))) {
+        collection_file.file_type_ = meta::SegmentSchema::TO_INDEX;
     } else {
         collection_file.file_type_ = meta::SegmentSchema::RAW;
     }
-    collection_file.file_size_ = segment_writer_ptr->Size();
-    collection_file.row_count_ = segment_writer_ptr->VectorCount();
+
+    // the index is built by inserting the other rows into the base, see ExecutionEngineImpl::BuildIndex
+    if (base == 0 && collection_file.file_type_ == meta::SegmentSchema::TO_INDEX) {
+        auto link_status = LinkIndexBase(files_.front().location_, new_segment_dir);
+        if (!link_status.ok()) {
+            LOG_ENGINE_WARNING_ << link_status.message() << ", the merged index will be built from scratch";
+        }
+    }
     updated.push_back(collection_file);
     status = meta_ptr_->UpdateCollectionFiles(updated);
     LOG_ENGINE_DEBUG_ << "New merged segment " << collection_file.segment_id_ << " of size "
@@ -99,6 +99,10 @@ class Meta {
     virtual Status
     UpdateCollectionFilesToIndex(const std::string& collection_id) = 0;
 
+    // replace the index params only, unlike UpdateCollectionIndex the files are left as they are
+    virtual Status
+    UpdateCollectionIndexParams(const std::string& collection_id, const std::string& index_params) = 0;
+
     virtual Status
     DescribeCollectionIndex(const std::string& collection_id, CollectionIndex& index) = 0;
 
@@ -59,7 +59,7 @@ MetaFactory::Build(const DBMetaOptions& meta_options, const int& mode) {
         return std::make_shared<meta::MySQLMetaImpl>(meta_options, mode);
     } else if (strcasecmp(uri_info.dialect_.c_str(), "sqlite") == 0) {
         LOG_ENGINE_INFO_ << "Using SQLite";
-        return std::make_shared<meta::SqliteMetaImpl>(meta_options);
+        return std::make_shared<meta::SqliteMetaImpl>(meta_options, mode);
     } else {
         LOG_ENGINE_ERROR_ << "Invalid dialect in URI: dialect = " << uri_info.dialect_;
         throw InvalidArgumentException("URI dialect is not mysql / sqlite");
@@ -91,6 +91,7 @@ struct SegmentSchema {
     int32_t engine_type_ = DEFAULT_ENGINE_TYPE;
     std::string index_params_;                   // not persist to meta
     int32_t metric_type_ = DEFAULT_METRIC_TYPE;  // not persist to meta
+    std::string owner_collection_;               // not persist to meta
     uint64_t flush_lsn_ = 0;
 };  // SegmentSchema
 
@@ -741,6 +741,7 @@ MySQLMetaImpl::CreateCollectionFile(SegmentSchema& file_schema) {
         file_schema.index_params_ = collection_schema.index_params_;
         file_schema.engine_type_ = collection_schema.engine_type_;
         file_schema.metric_type_ = collection_schema.metric_type_;
+        file_schema.owner_collection_ = collection_schema.owner_collection_;
 
         std::string id = "NULL";  // auto-increment
         std::string collection_id = file_schema.collection_id_;
@@ -848,6 +849,7 @@ MySQLMetaImpl::GetCollectionFiles(const std::string& collection_id, const std::v
             file_schema.engine_type_ = resRow["engine_type"];
             file_schema.index_params_ = collection_schema.index_params_;
             file_schema.metric_type_ = collection_schema.metric_type_;
+            file_schema.owner_collection_ = collection_schema.owner_collection_;
             resRow["file_id"].to_string(file_schema.file_id_);
             file_schema.file_type_ = resRow["file_type"];
             file_schema.file_size_ = resRow["file_size"];
@@ -909,6 +911,7 @@ MySQLMetaImpl::GetCollectionFilesBySegmentId(const std::string& segment_id, File
                 file_schema.engine_type_ = resRow["engine_type"];
                 file_schema.index_params_ = collection_schema.index_params_;
                 file_schema.metric_type_ = collection_schema.metric_type_;
+                file_schema.owner_collection_ = collection_schema.owner_collection_;
                 resRow["file_id"].to_string(file_schema.file_id_);
                 file_schema.file_type_ = resRow["file_type"];
                 file_schema.file_size_ = resRow["file_size"];
@@ -1019,6 +1022,41 @@ MySQLMetaImpl::UpdateCollectionFlag(const std::string& collection_id, int64_t fl
     return Status::OK();
 }
 
+Status
+MySQLMetaImpl::UpdateCollectionIndexParams(const std::string& collection_id, const std::string& index_params) {
+    try {
+        server::MetricCollector metric;
+
+        {
+            mysqlpp::ScopedConnection connectionPtr(*mysql_connection_pool_, safe_grab_);
+
+            bool is_null_connection = (connectionPtr == nullptr);
+            fiu_do_on("MySQLMetaImpl.UpdateCollectionIndexParams.null_connection", is_null_connection = true);
+            fiu_do_on("MySQLMetaImpl.UpdateCollectionIndexParams.throw_exception", throw std::exception(););
+            if (is_null_connection) {
+                return Status(DB_ERROR, "Failed to connect to meta server(mysql)");
+            }
+
+            mysqlpp::Query statement = connectionPtr->query();
+            statement << "UPDATE " << META_TABLES << " SET index_params = " << mysqlpp::quote << index_params
+                      << " WHERE table_id = " << mysqlpp::quote << collection_id
+                      << " AND state <> " << std::to_string(CollectionSchema::TO_DELETE) << ";";
+
+            LOG_ENGINE_DEBUG_ << "UpdateCollectionIndexParams: " << statement.str();
+
+            if (!statement.exec()) {
+                return HandleException("Failed to update collection index params", statement.error());
+            }
+        }  // Scoped Connection
+
+        LOG_ENGINE_DEBUG_ << "Successfully update collection index params for " << collection_id;
+    } catch (std::exception& e) {
+        return HandleException("Failed to update collection index params", e.what());
+    }
+
+    return Status::OK();
+}
+
 Status
 MySQLMetaImpl::UpdateCollectionFlushLSN(const std::string& collection_id, uint64_t flush_lsn) {
     try {
@@ -1664,6 +1702,7 @@ MySQLMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& file
             collection_file.engine_type_ = resRow["engine_type"];
             collection_file.index_params_ = collection_schema.index_params_;
             collection_file.metric_type_ = collection_schema.metric_type_;
+            collection_file.owner_collection_ = collection_schema.owner_collection_;
             resRow["file_id"].to_string(collection_file.file_id_);
             collection_file.file_type_ = resRow["file_type"];
             collection_file.file_size_ = resRow["file_size"];
@@ -1719,11 +1758,17 @@ MySQLMetaImpl::FilesToMerge(const std::string& collection_id, FilesHolder& files
             // to ensure UpdateCollectionFiles to be a atomic operation
             std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
+            // small hnsw indexes are merged too, the merged index is grown from the largest of them
+            std::string file_types = std::to_string(SegmentSchema::RAW);
+            if (collection_schema.engine_type_ == (int32_t)EngineType::HNSW) {
+                file_types += "," + std::to_string(SegmentSchema::INDEX);
+            }
+
             mysqlpp::Query statement = connectionPtr->query();
             statement << "SELECT id, table_id, segment_id, file_id, file_type, file_size, row_count, date, "
                          "engine_type, created_on"
                       << " FROM " << META_TABLEFILES << " WHERE table_id = " << mysqlpp::quote << collection_id
-                      << " AND file_type = " << std::to_string(SegmentSchema::RAW) << " ORDER BY row_count DESC;";
+                      << " AND file_type IN (" << file_types << ") ORDER BY row_count DESC;";
 
             LOG_ENGINE_DEBUG_ << "FilesToMerge: " << statement.str();
 
@@ -1750,6 +1795,7 @@ MySQLMetaImpl::FilesToMerge(const std::string& collection_id, FilesHolder& files
             collection_file.engine_type_ = resRow["engine_type"];
             collection_file.index_params_ = collection_schema.index_params_;
             collection_file.metric_type_ = collection_schema.metric_type_;
+            collection_file.owner_collection_ = collection_schema.owner_collection_;
             collection_file.created_on_ = resRow["created_on"];
             collection_file.dimension_ = collection_schema.dimension_;
 
@@ -1831,6 +1877,7 @@ MySQLMetaImpl::FilesToIndex(FilesHolder& files_holder) {
             collection_file.index_file_size_ = groups[collection_file.collection_id_].index_file_size_;
             collection_file.index_params_ = groups[collection_file.collection_id_].index_params_;
             collection_file.metric_type_ = groups[collection_file.collection_id_].metric_type_;
+            collection_file.owner_collection_ = groups[collection_file.collection_id_].owner_collection_;
 
             auto status = utils::GetCollectionFilePath(options_, collection_file);
             if (!status.ok()) {
@@ -1919,6 +1966,7 @@ MySQLMetaImpl::FilesByType(const std::string& collection_id, const std::vector<i
                 file_schema.index_file_size_ = collection_schema.index_file_size_;
                 file_schema.index_params_ = collection_schema.index_params_;
                 file_schema.metric_type_ = collection_schema.metric_type_;
+                file_schema.owner_collection_ = collection_schema.owner_collection_;
                 file_schema.dimension_ = collection_schema.dimension_;
 
                 auto status = utils::GetCollectionFilePath(options_, file_schema);
@@ -2081,6 +2129,7 @@ MySQLMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hold
             collection_file.index_file_size_ = collection_schema.index_file_size_;
             collection_file.index_params_ = collection_schema.index_params_;
             collection_file.metric_type_ = collection_schema.metric_type_;
+            collection_file.owner_collection_ = collection_schema.owner_collection_;
         }
 
         if (files_count == 0) {
@@ -65,6 +65,9 @@ class MySQLMetaImpl : public Meta {
     Status
     UpdateCollectionFlag(const std::string& collection_id, int64_t flag) override;
 
+    Status
+    UpdateCollectionIndexParams(const std::string& collection_id, const std::string& index_params) override;
+
     Status
     UpdateCollectionFlushLSN(const std::string& collection_id, uint64_t flush_lsn) override;
 
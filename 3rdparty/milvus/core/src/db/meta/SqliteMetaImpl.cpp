@@ -100,7 +100,7 @@ StoragePrototype(const std::string& path) {
 using ConnectorT = decltype(StoragePrototype("table"));
 static std::unique_ptr<ConnectorT> ConnectorPtr;
 
-SqliteMetaImpl::SqliteMetaImpl(const DBMetaOptions& options) : options_(options) {
+SqliteMetaImpl::SqliteMetaImpl(const DBMetaOptions& options, const int& mode) : options_(options), mode_(mode) {
     Initialize();
 }
 
@@ -171,7 +171,10 @@ SqliteMetaImpl::Initialize() {
     ConnectorPtr->open_forever();                          // thread safe option
     ConnectorPtr->pragma.journal_mode(journal_mode::WAL);  // WAL => write ahead log
 
-    CleanUpShadowFiles();
+    // a read replica shares the meta with the writable node, whose shadow files are in use
+    if (mode_ != DBOptions::MODE::CLUSTER_READONLY) {
+        CleanUpShadowFiles();
+    }
 
     return Status::OK();
 }
@@ -434,6 +437,7 @@ SqliteMetaImpl::CreateCollectionFile(SegmentSchema& file_schema) {
         file_schema.index_params_ = collection_schema.index_params_;
         file_schema.engine_type_ = collection_schema.engine_type_;
         file_schema.metric_type_ = collection_schema.metric_type_;
+        file_schema.owner_collection_ = collection_schema.owner_collection_;
 
         // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
@@ -499,6 +503,7 @@ SqliteMetaImpl::GetCollectionFiles(const std::string& collection_id, const std::
             file_schema.index_file_size_ = collection_schema.index_file_size_;
             file_schema.index_params_ = collection_schema.index_params_;
             file_schema.metric_type_ = collection_schema.metric_type_;
+            file_schema.owner_collection_ = collection_schema.owner_collection_;
 
             utils::GetCollectionFilePath(options_, file_schema);
 
@@ -553,6 +558,7 @@ SqliteMetaImpl::GetCollectionFilesBySegmentId(const std::string& segment_id,
                 file_schema.index_file_size_ = collection_schema.index_file_size_;
                 file_schema.index_params_ = collection_schema.index_params_;
                 file_schema.metric_type_ = collection_schema.metric_type_;
+                file_schema.owner_collection_ = collection_schema.owner_collection_;
 
                 utils::GetCollectionFilePath(options_, file_schema);
                 files_holder.MarkFile(file_schema);
@@ -587,6 +593,27 @@ SqliteMetaImpl::UpdateCollectionFlag(const std::string& collection_id, int64_t f
     return Status::OK();
 }
 
+Status
+SqliteMetaImpl::UpdateCollectionIndexParams(const std::string& collection_id, const std::string& index_params) {
+    try {
+        server::MetricCollector metric;
+        fiu_do_on("SqliteMetaImpl.UpdateCollectionIndexParams.throw_exception", throw std::exception());
+
+        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
+        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+
+        ConnectorPtr->update_all(set(c(&CollectionSchema::index_params_) = index_params),
+                                 where(c(&CollectionSchema::collection_id_) == collection_id and
+                                       c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
+        LOG_ENGINE_DEBUG_ << "Successfully update collection index params, collection id = " << collection_id;
+    } catch (std::exception& e) {
+        std::string msg = "Encounter exception when update collection index params: collection_id = " + collection_id;
+        return HandleException(msg, e.what());
+    }
+
+    return Status::OK();
+}
+
 Status
 SqliteMetaImpl::UpdateCollectionFlushLSN(const std::string& collection_id, uint64_t flush_lsn) {
     try {
@@ -1097,6 +1124,7 @@ SqliteMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& fil
             collection_file.index_file_size_ = collection_schema.index_file_size_;
             collection_file.index_params_ = collection_schema.index_params_;
             collection_file.metric_type_ = collection_schema.metric_type_;
+            collection_file.owner_collection_ = collection_schema.owner_collection_;
 
             auto status = utils::GetCollectionFilePath(options_, collection_file);
             if (!status.ok()) {
@@ -1133,16 +1161,21 @@ SqliteMetaImpl::FilesToMerge(const std::string& collection_id, FilesHolder& file
             return status;
         }
 
-        // get files to merge
+        // get files to merge, small hnsw indexes too since the merged index is grown from the largest of them
+        std::vector<int> file_types = {(int)SegmentSchema::RAW};
+        if (collection_schema.engine_type_ == (int)EngineType::HNSW) {
+            file_types.push_back((int)SegmentSchema::INDEX);
+        }
         auto select_columns = columns(&SegmentSchema::id_, &SegmentSchema::collection_id_, &SegmentSchema::segment_id_,
                                       &SegmentSchema::file_id_, &SegmentSchema::file_type_, &SegmentSchema::file_size_,
-                                      &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::created_on_);
+                                      &SegmentSchema::row_count_, &SegmentSchema::date_, &SegmentSchema::created_on_,
+                                      &SegmentSchema::engine_type_);
         decltype(ConnectorPtr->select(select_columns)) selected;
         {
             // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
             std::lock_guard<std::mutex> meta_lock(meta_mutex_);
             selected = ConnectorPtr->select(select_columns,
-                                            where(c(&SegmentSchema::file_type_) == (int)SegmentSchema::RAW and
+                                            where(in(&SegmentSchema::file_type_, file_types) and
                                                   c(&SegmentSchema::collection_id_) == collection_id),
                                             order_by(&SegmentSchema::file_size_).desc());
         }
@@ -1164,10 +1197,12 @@ SqliteMetaImpl::FilesToMerge(const std::string& collection_id, FilesHolder& file
             collection_file.row_count_ = std::get<6>(file);
             collection_file.date_ = std::get<7>(file);
             collection_file.created_on_ = std::get<8>(file);
+            collection_file.engine_type_ = std::get<9>(file);
             collection_file.dimension_ = collection_schema.dimension_;
             collection_file.index_file_size_ = collection_schema.index_file_size_;
             collection_file.index_params_ = collection_schema.index_params_;
             collection_file.metric_type_ = collection_schema.metric_type_;
+            collection_file.owner_collection_ = collection_schema.owner_collection_;
 
             auto status = utils::GetCollectionFilePath(options_, collection_file);
             if (!status.ok()) {
@@ -1242,6 +1277,7 @@ SqliteMetaImpl::FilesToIndex(FilesHolder& files_holder) {
             collection_file.index_file_size_ = groups[collection_file.collection_id_].index_file_size_;
             collection_file.index_params_ = groups[collection_file.collection_id_].index_params_;
             collection_file.metric_type_ = groups[collection_file.collection_id_].metric_type_;
+            collection_file.owner_collection_ = groups[collection_file.collection_id_].owner_collection_;
             files_holder.MarkFile(collection_file);
 
             files_count++;
@@ -1310,6 +1346,7 @@ SqliteMetaImpl::FilesByType(const std::string& collection_id,
                 file_schema.index_file_size_ = collection_schema.index_file_size_;
                 file_schema.index_params_ = collection_schema.index_params_;
                 file_schema.metric_type_ = collection_schema.metric_type_;
+                file_schema.owner_collection_ = collection_schema.owner_collection_;
 
                 switch (file_schema.file_type_) {
                     case (int)SegmentSchema::RAW:
@@ -1451,6 +1488,7 @@ SqliteMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hol
             collection_file.index_file_size_ = collection_schema.index_file_size_;
             collection_file.index_params_ = collection_schema.index_params_;
             collection_file.metric_type_ = collection_schema.metric_type_;
+            collection_file.owner_collection_ = collection_schema.owner_collection_;
         }
 
         if (files_count == 0) {
@@ -2047,6 +2085,7 @@ SqliteMetaImpl::CreateHybridCollectionFile(SegmentSchema& file_schema) {
         file_schema.index_params_ = collection_schema.index_params_;
         file_schema.engine_type_ = collection_schema.engine_type_;
         file_schema.metric_type_ = collection_schema.metric_type_;
+        file_schema.owner_collection_ = collection_schema.owner_collection_;
 
         // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
@@ -30,7 +30,7 @@ CollectionPrototype(const std::string& path);
 
 class SqliteMetaImpl : public Meta {
  public:
-    explicit SqliteMetaImpl(const DBMetaOptions& options);
+    explicit SqliteMetaImpl(const DBMetaOptions& options, const int& mode = DBOptions::MODE::SINGLE);
     ~SqliteMetaImpl();
 
     Status
@@ -67,6 +67,9 @@ class SqliteMetaImpl : public Meta {
     Status
     UpdateCollectionFlag(const std::string& collection_id, int64_t flag) override;
 
+    Status
+    UpdateCollectionIndexParams(const std::string& collection_id, const std::string& index_params) override;
+
     Status
     UpdateCollectionFlushLSN(const std::string& collection_id, uint64_t flush_lsn) override;
 
@@ -172,6 +175,7 @@ class SqliteMetaImpl : public Meta {
 
  private:
     const DBMetaOptions options_;
+    const int mode_;
     std::mutex meta_mutex_;
     std::mutex genid_mutex_;
 };  // DBMetaImpl
@@ -22,22 +22,6 @@ namespace milvus {
 namespace engine {
 namespace wal {
 
-inline std::string
-ToFileName(int32_t file_no) {
-    return std::to_string(file_no) + ".wal";
-}
-
-inline void
-BuildLsn(uint32_t file_no, uint32_t offset, uint64_t& lsn) {
-    lsn = (uint64_t)file_no << 32 | offset;
-}
-
-inline void
-ParserLsn(uint64_t lsn, uint32_t& file_no, uint32_t& offset) {
-    file_no = uint32_t(lsn >> 32);
-    offset = uint32_t(lsn & LSN_OFFSET_MASK);
-}
-
 MXLogBuffer::MXLogBuffer(const std::string& mxlog_path, const uint32_t buffer_size)
     : mxlog_buffer_size_(buffer_size * UNIT_MB), mxlog_writer_(mxlog_path) {
 }
@@ -430,9 +414,17 @@ MXLogBuffer::Next(const uint64_t last_applied_lsn, MXLogRecord& record) {
     }
 
     char* current_read_buf = buf_[mxlog_buffer_reader_.buf_idx].get();
-    uint64_t current_read_offset = mxlog_buffer_reader_.buf_offset;
+    DecodeRecord(current_read_buf + mxlog_buffer_reader_.buf_offset, record);
 
-    MXLogRecordHeader* head = (MXLogRecordHeader*)(current_read_buf + current_read_offset);
+    mxlog_buffer_reader_.buf_offset = uint32_t(record.lsn & LSN_OFFSET_MASK);
+    return WAL_SUCCESS;
+}
+
+void
+MXLogBuffer::DecodeRecord(char* buf, MXLogRecord& record) {
+    uint64_t current_read_offset = 0;
+
+    MXLogRecordHeader* head = (MXLogRecordHeader*)buf;
     record.type = (MXLogType)head->mxl_type;
     record.lsn = head->mxl_lsn;
     record.length = head->vector_num;
@@ -441,34 +433,31 @@ MXLogBuffer::Next(const uint64_t last_applied_lsn, MXLogRecord& record) {
     current_read_offset += SizeOfMXLogRecordHeader;
 
     if (head->table_id_size != 0) {
-        record.collection_id.assign(current_read_buf + current_read_offset, head->table_id_size);
+        record.collection_id.assign(buf + current_read_offset, head->table_id_size);
         current_read_offset += head->table_id_size;
     } else {
         record.collection_id = "";
     }
 
     if (head->partition_tag_size != 0) {
-        record.partition_tag.assign(current_read_buf + current_read_offset, head->partition_tag_size);
+        record.partition_tag.assign(buf + current_read_offset, head->partition_tag_size);
         current_read_offset += head->partition_tag_size;
     } else {
         record.partition_tag = "";
     }
 
     if (head->vector_num != 0) {
-        record.ids = (IDNumber*)(current_read_buf + current_read_offset);
+        record.ids = (IDNumber*)(buf + current_read_offset);
         current_read_offset += head->vector_num * sizeof(IDNumber);
     } else {
         record.ids = nullptr;
     }
 
     if (record.data_size != 0) {
-        record.data = current_read_buf + current_read_offset;
+        record.data = buf + current_read_offset;
     } else {
         record.data = nullptr;
     }
-
-    mxlog_buffer_reader_.buf_offset = uint32_t(head->mxl_lsn & LSN_OFFSET_MASK);
-    return WAL_SUCCESS;
 }
 
 ErrorCode
@@ -26,6 +26,22 @@ namespace milvus {
 namespace engine {
 namespace wal {
 
+inline std::string
+ToFileName(int32_t file_no) {
+    return std::to_string(file_no) + ".wal";
+}
+
+inline void
+BuildLsn(uint32_t file_no, uint32_t offset, uint64_t& lsn) {
+    lsn = (uint64_t)file_no << 32 | offset;
+}
+
+inline void
+ParserLsn(uint64_t lsn, uint32_t& file_no, uint32_t& offset) {
+    file_no = uint32_t(lsn >> 32);
+    offset = uint32_t(lsn & LSN_OFFSET_MASK);
+}
+
 #pragma pack(push)
 #pragma pack(1)
 
@@ -83,6 +99,10 @@ class MXLogBuffer {
     ErrorCode
     NextEntity(const uint64_t last_applied_lsn, MXLogRecord& record);
 
+    // fill record from the serialized (not entity) record at buf, the ids and data of record point into buf
+    static void
+    DecodeRecord(char* buf, MXLogRecord& record);
+
     uint64_t
     GetReadLsn();
 
@@ -0,0 +1,170 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/wal/WalTailer.h"
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <string>
+#include <vector>
+
+#include "db/wal/WalBuffer.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+namespace wal {
+
+namespace {
+
+// numbers of the wal files in the folder, the writer removes the old ones once they are flushed
+void
+ListFileNos(const std::string& mxlog_path, std::vector<uint32_t>& file_nos) {
+    file_nos.clear();
+    boost::system::error_code err;
+    boost::filesystem::directory_iterator it(mxlog_path, err), end;
+    for (; !err && it != end; it.increment(err)) {
+        auto& path = it->path();
+        if (path.extension() != ".wal") {
+            continue;
+        }
+        try {
+            file_nos.push_back(std::stoul(path.stem().string()));
+        } catch (std::exception& ex) {
+            continue;
+        }
+    }
+}
+
+}  // namespace
+
+MXLogTailer::MXLogTailer(const std::string& mxlog_path) : mxlog_path_(mxlog_path), mxlog_reader_(mxlog_path) {
+    if (mxlog_path_.back() != '/') {
+        mxlog_path_ += '/';
+        mxlog_reader_.SetFilePath(mxlog_path_);
+    }
+}
+
+MXLogTailer::~MXLogTailer() {
+}
+
+void
+MXLogTailer::Seek(uint64_t lsn) {
+    ParserLsn(lsn, file_no_, offset_);
+    mxlog_reader_.ReBorn(ToFileName(file_no_), "r");
+}
+
+ErrorCode
+MXLogTailer::Next(MXLogRecord& record) {
+    record.type = MXLogType::None;
+
+    while (true) {
+        if (mxlog_reader_.GetFileName().empty()) {
+            mxlog_reader_.ReBorn(ToFileName(file_no_), "r");
+        }
+
+        uint32_t file_size = mxlog_reader_.GetFileSize();
+        if (file_size >= offset_ + SizeOfMXLogRecordHeader) {
+            MXLogRecordHeader head;
+            if (!mxlog_reader_.OpenFile() || !mxlog_reader_.Load((char*)&head, offset_, SizeOfMXLogRecordHeader)) {
+                LOG_WAL_ERROR_ << "read wal file error " << file_no_;
+                return WAL_FILE_ERROR;
+            }
+
+            uint32_t file_no = 0, end_offset = 0;
+            ParserLsn(head.mxl_lsn, file_no, end_offset);
+            if (file_no != file_no_ || end_offset <= offset_) {
+                LOG_WAL_ERROR_ << "bad wal record in file " << file_no_ << " at " << offset_;
+                return WAL_FILE_ERROR;
+            }
+            if (file_size < end_offset) {
+                // the record is being written
+                return WAL_SUCCESS;
+            }
+
+            buf_.resize(end_offset - offset_);
+            if (!mxlog_reader_.Load(buf_.data(), offset_, end_offset - offset_)) {
+                LOG_WAL_ERROR_ << "read wal file error " << file_no_;
+                return WAL_FILE_ERROR;
+            }
+            MXLogBuffer::DecodeRecord(buf_.data(), record);
+            offset_ = end_offset;
+            return WAL_SUCCESS;
+        }
+
+        if (file_size > offset_) {
+            // the header is being written
+            return WAL_SUCCESS;
+        }
+
+        // the current file is complete once the writer started a later one
+        if (!NextFile()) {
+            return WAL_SUCCESS;
+        }
+    }
+}
+
+uint64_t
+MXLogTailer::GetReadLsn() {
+    uint64_t lsn = 0;
+    BuildLsn(file_no_, offset_, lsn);
+    return lsn;
+}
+
+uint64_t
+MXLogTailer::GetWriteLsn() {
+    std::vector<uint32_t> file_nos;
+    ListFileNos(mxlog_path_, file_nos);
+
+    uint32_t last_file_no = file_no_;
+    for (auto file_no : file_nos) {
+        last_file_no = std::max(last_file_no, file_no);
+    }
+
+    MXLogFileHandler file_handler(mxlog_path_);
+    file_handler.SetFileName(ToFileName(last_file_no));
+    uint32_t file_size = file_handler.GetFileSize();
+
+    uint64_t lsn = 0;
+    BuildLsn(last_file_no, file_size, lsn);
+    return std::max(lsn, GetReadLsn());
+}
+
+bool
+MXLogTailer::NextFile() {
+    // the next file is usually there, otherwise the files in between were removed after a flush
+    uint32_t next_file_no = file_no_ + 1;
+    mxlog_reader_.SetFileName(ToFileName(next_file_no));
+    if (!mxlog_reader_.FileExists()) {
+        std::vector<uint32_t> file_nos;
+        ListFileNos(mxlog_path_, file_nos);
+
+        next_file_no = 0;
+        for (auto file_no : file_nos) {
+            if (file_no > file_no_ && (next_file_no == 0 || file_no < next_file_no)) {
+                next_file_no = file_no;
+            }
+        }
+        if (next_file_no == 0) {
+            mxlog_reader_.SetFileName(ToFileName(file_no_));
+            return false;
+        }
+    }
+
+    file_no_ = next_file_no;
+    offset_ = 0;
+    mxlog_reader_.ReBorn(ToFileName(file_no_), "r");
+    return true;
+}
+
+}  // namespace wal
+}  // namespace engine
+}  // namespace milvus
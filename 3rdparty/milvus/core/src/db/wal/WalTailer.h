@@ -0,0 +1,71 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "WalDefinations.h"
+#include "WalFileHandler.h"
+#include "utils/Error.h"
+
+namespace milvus {
+namespace engine {
+namespace wal {
+
+// reads the wal files of another milvus instance while they are written, for a read replica.
+// the files are only opened for reading, a record is returned once all of it is in the file
+class MXLogTailer {
+ public:
+    explicit MXLogTailer(const std::string& mxlog_path);
+    ~MXLogTailer();
+
+    // read from the record following lsn
+    void
+    Seek(uint64_t lsn);
+
+    /*
+     * Get next record
+     * @param record[out]: record, type is None when all the written records are read.
+     *                     ids and data are valid until the next call
+     * @retval error_code
+     */
+    ErrorCode
+    Next(MXLogRecord& record);
+
+    // lsn of the last record read
+    uint64_t
+    GetReadLsn();
+
+    // lsn of the last record written, as far as it is in the files
+    uint64_t
+    GetWriteLsn();
+
+ private:
+    // move to the oldest file after the current one, false if there is none yet
+    bool
+    NextFile();
+
+ private:
+    std::string mxlog_path_;
+    MXLogFileHandler mxlog_reader_;
+    uint32_t file_no_ = 0;
+    uint32_t offset_ = 0;
+    std::vector<char> buf_;
+};
+
+using MXLogTailerPtr = std::shared_ptr<MXLogTailer>;
+
+}  // namespace wal
+}  // namespace engine
+}  // namespace milvus
@@ -92,11 +92,50 @@ MatchNlist(const int64_t& size, const int64_t& nlist, const int64_t& per_nlist)
     return nlist;
 }
 
+/*
+ * The optional pre-transform of the IVF indexes, built and searched on cpu only. PCA reduces the dimension but
+ * centers the vectors, which does not preserve inner products. OPQ rotates the vectors for the PQ sub-quantizers.
+ * index_dim is set to the dimension of the vectors seen by the IVF index.
+ */
+bool
+CheckPreTransform(Config& oricfg, const IndexMode mode, bool is_pq, int64_t& index_dim) {
+    static std::vector<std::string> TRANSFORMS{knowhere::PreTransform::PCA};
+    static std::vector<std::string> PQ_TRANSFORMS{knowhere::PreTransform::OPQ, knowhere::PreTransform::PCA};
+
+    CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
+    index_dim = oricfg[knowhere::meta::DIM].get<int64_t>();
+    if (!oricfg.contains(knowhere::IndexParams::pre_transform)) {
+        return true;
+    }
+    if (mode == IndexMode::MODE_GPU) {
+        return false;
+    }
+
+    if (is_pq) {
+        CheckStrByValues(knowhere::IndexParams::pre_transform, PQ_TRANSFORMS);
+    } else {
+        CheckStrByValues(knowhere::IndexParams::pre_transform, TRANSFORMS);
+    }
+    if (oricfg[knowhere::IndexParams::pre_transform] == knowhere::PreTransform::PCA &&
+        oricfg[knowhere::Metric::TYPE] != knowhere::Metric::L2) {
+        return false;
+    }
+    if (oricfg.contains(knowhere::IndexParams::pre_transform_dim)) {
+        CheckIntByRange(knowhere::IndexParams::pre_transform_dim, DEFAULT_MIN_DIM, index_dim);
+        index_dim = oricfg[knowhere::IndexParams::pre_transform_dim].get<int64_t>();
+    }
+    return true;
+}
+
 bool
 IVFConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static int64_t MAX_NLIST = 999999;
     static int64_t MIN_NLIST = 1;
 
+    int64_t index_dim;
+    if (!CheckPreTransform(oricfg, mode, false, index_dim)) {
+        return false;
+    }
     CheckIntByRange(knowhere::IndexParams::nlist, MIN_NLIST, MAX_NLIST);
     CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
 
@@ -170,8 +209,12 @@ IVFPQConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     // static int64_t MAX_POINTS_PER_CENTROID = 256;
     // CheckIntByRange(knowhere::meta::ROWS, MIN_POINTS_PER_CENTROID * nlist, MAX_POINTS_PER_CENTROID * nlist);
 
+    // the sub-quantizers split the transformed vectors
+    int64_t dimension;
+    if (!CheckPreTransform(oricfg, mode, true, dimension)) {
+        return false;
+    }
     std::vector<int64_t> resset;
-    int64_t dimension = oricfg[knowhere::meta::DIM].get<int64_t>();
     IVFPQConfAdapter::GetValidMList(dimension, resset);
 
     CheckIntByValues(knowhere::IndexParams::m, resset);
@@ -201,6 +244,35 @@ IVFPQConfAdapter::GetValidMList(int64_t dimension, std::vector<int64_t>& resset)
     }
 }
 
+bool
+IVFPQFastScanConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    static int64_t MAX_NLIST = 999999;
+    static int64_t MIN_NLIST = 1;
+    static std::vector<std::string> METRICS{knowhere::Metric::L2, knowhere::Metric::IP};
+
+    // the codes are 4 bits per sub-quantizer, searched on cpu only
+    CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+    CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
+    CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
+    CheckIntByRange(knowhere::IndexParams::nlist, MIN_NLIST, MAX_NLIST);
+
+    // auto tune params
+    oricfg[knowhere::IndexParams::nlist] = MatchNlist(oricfg[knowhere::meta::ROWS].get<int64_t>(),
+                                                      oricfg[knowhere::IndexParams::nlist].get<int64_t>(), 16384);
+
+    // any number of sub-quantizers dividing the dimension of the transformed vectors
+    int64_t dimension;
+    if (!CheckPreTransform(oricfg, mode, true, dimension)) {
+        return false;
+    }
+    CheckIntByRange(knowhere::IndexParams::m, 1, dimension);
+    if (dimension % oricfg[knowhere::IndexParams::m].get<int64_t>() != 0) {
+        return false;
+    }
+
+    return true;
+}
+
 bool
 NSGConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static int64_t MIN_KNNG = 5;
@@ -54,6 +54,12 @@ class IVFPQConfAdapter : public IVFConfAdapter {
     GetValidMList(int64_t dimension, std::vector<int64_t>& resset);
 };
 
+class IVFPQFastScanConfAdapter : public IVFConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+};
+
 class NSGConfAdapter : public IVFConfAdapter {
  public:
     bool
@@ -47,7 +47,8 @@ FaissBaseIndex::LoadImpl(const BinarySet& binary_set, const IndexType& type) {
     reader.total = binary->size;
     reader.data_ = binary->data.get();
 
-    faiss::Index* index = faiss::read_index(&reader);
+    // inverted lists kept on disk are mapped read only, they are never added to once serialized
+    faiss::Index* index = faiss::read_index(&reader, faiss::IO_FLAG_READ_ONLY);
     index_.reset(index);
 
     SealImpl();
@@ -11,6 +11,8 @@
 
 #include "knowhere/index/vector_index/IndexAnnoy.h"
 
+#include <omp.h>
+
 #include <algorithm>
 #include <cassert>
 #include <iterator>
@@ -56,6 +58,32 @@ IndexAnnoy::Serialize(const Config& config) {
 
 void
 IndexAnnoy::Load(const BinarySet& index_binary) {
+    CreateIndex(index_binary);
+
+    auto index_data = index_binary.GetByName("annoy_index_data");
+    char* p = nullptr;
+    if (!index_->load_index(reinterpret_cast<void*>(index_data->data.get()), index_data->size, &p)) {
+        std::string error_msg(p);
+        free(p);
+        KNOWHERE_THROW_MSG(error_msg);
+    }
+}
+
+void
+IndexAnnoy::LoadMapped(const BinarySet& index_binary, const std::string& path, int64_t offset, int64_t size) {
+    CreateIndex(index_binary);
+
+    char* p = nullptr;
+    if (!index_->load_index(path.c_str(), offset, size, false, &p)) {
+        std::string error_msg(p);
+        free(p);
+        index_ = nullptr;
+        KNOWHERE_THROW_MSG(error_msg);
+    }
+}
+
+void
+IndexAnnoy::CreateIndex(const BinarySet& index_binary) {
     auto metric_type = index_binary.GetByName("annoy_metric_type");
     metric_type_.resize((size_t)metric_type->size);
     memcpy(metric_type_.data(), metric_type->data.get(), (size_t)metric_type->size);
@@ -71,14 +99,6 @@ IndexAnnoy::Load(const BinarySet& index_binary) {
     } else {
         KNOWHERE_THROW_MSG("metric not supported " + metric_type_);
     }
-
-    auto index_data = index_binary.GetByName("annoy_index_data");
-    char* p = nullptr;
-    if (!index_->load_index(reinterpret_cast<void*>(index_data->data.get()), index_data->size, &p)) {
-        std::string error_msg(p);
-        free(p);
-        KNOWHERE_THROW_MSG(error_msg);
-    }
 }
 
 void
@@ -104,7 +124,8 @@ IndexAnnoy::BuildAll(const DatasetPtr& dataset_ptr, const Config& config) {
         index_->add_item(p_ids[i], (const float*)p_data + dim * i);
     }
 
-    index_->build(config[IndexParams::n_trees].get<int64_t>());
+    // the trees are built in parallel, with as many threads as the other knowhere builds
+    index_->build(config[IndexParams::n_trees].get<int64_t>(), omp_get_max_threads());
 }
 
 DatasetPtr
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <mutex>
+#include <string>
 
 #include "annoy/src/annoylib.h"
 #include "annoy/src/kissrandom.h"
@@ -35,6 +36,11 @@ class IndexAnnoy : public VecIndex {
     void
     Load(const BinarySet& index_binary) override;
 
+    // Load with the "annoy_index_data" blob left in the file: the trees are mapped from the size bytes at offset
+    // of path instead of being copied into memory, so the processes serving the file share its page cache.
+    void
+    LoadMapped(const BinarySet& index_binary, const std::string& path, int64_t offset, int64_t size);
+
     void
     BuildAll(const DatasetPtr& dataset_ptr, const Config& config) override;
 
@@ -65,6 +71,10 @@ class IndexAnnoy : public VecIndex {
     int64_t
     IndexSize() override;
 
+ private:
+    void
+    CreateIndex(const BinarySet& index_binary);
+
  private:
     MetricType metric_type_;
     std::shared_ptr<AnnoyIndexInterface<int64_t, float>> index_ = nullptr;
@@ -180,12 +180,11 @@ BinaryIVF::QueryImpl(int64_t n, const uint8_t* data, int64_t k, float* distances
                      const Config& config) {
     auto params = GenParams(config);
     auto ivf_index = dynamic_cast<faiss::IndexBinaryIVF*>(index_.get());
-    ivf_index->nprobe = params->nprobe;
     int32_t* pdistances = (int32_t*)distances;
     stdclock::time_point before = stdclock::now();
 
-    // todo: remove static cast (zhiru)
-    static_cast<faiss::IndexBinary*>(index_.get())->search(n, (uint8_t*)data, k, pdistances, labels, bitset_);
+    // per-call parameters, the index is shared by concurrent queries
+    ivf_index->search_with_parameters(n, data, k, pdistances, labels, params.get(), bitset_);
 
     stdclock::time_point after = stdclock::now();
     double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
@@ -104,6 +104,11 @@ IndexHNSW::Add(const DatasetPtr& dataset_ptr, const Config& config) {
 
     GETTENSORWITHIDS(dataset_ptr)
 
+    // a loaded graph is grown to take the new rows, the ones already in it keep their links
+    if (index_->cur_element_count + rows > index_->max_elements_) {
+        index_->resizeIndex(index_->cur_element_count + rows);
+    }
+
     //     if (normalize) {
     //         std::vector<float> ep_norm_vector(Dim());
     //         normalize_vector((float*)(p_data), ep_norm_vector.data(), Dim());
@@ -143,7 +148,8 @@ IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     auto p_id = (int64_t*)malloc(id_size * rows);
     auto p_dist = (float*)malloc(dist_size * rows);
 
-    index_->setEf(config[IndexParams::ef]);
+    // per-call ef, the index is shared by concurrent queries
+    size_t ef = config[IndexParams::ef].get<int64_t>();
 
     using P = std::pair<float, int64_t>;
     auto compare = [](const P& v1, const P& v2) { return v1.first < v2.first; };
@@ -161,7 +167,7 @@ IndexHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config) {
         // } else {
         //     ret = index_->searchKnn((float*)single_query, config[meta::TOPK].get<int64_t>(), compare);
         // }
-        ret = index_->searchKnn((float*)single_query, k, compare, blacklist);
+        ret = index_->searchKnn((float*)single_query, k, ef, compare, blacklist);
 
         while (ret.size() < k) {
             ret.emplace_back(std::make_pair(-1, -1));
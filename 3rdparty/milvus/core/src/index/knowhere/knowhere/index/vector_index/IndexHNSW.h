@@ -37,6 +37,7 @@ class IndexHNSW : public VecIndex {
     void
     Train(const DatasetPtr& dataset_ptr, const Config& config) override;
 
+    // rows can be added to a loaded index too, its graph is grown to take them
     void
     Add(const DatasetPtr& dataset_ptr, const Config& config) override;
 
@@ -15,6 +15,8 @@
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFFlat.h>
 #include <faiss/IndexIVFPQ.h>
+#include <faiss/IndexPreTransform.h>
+#include <faiss/OnDiskInvertedLists.h>
 #include <faiss/clone_index.h>
 #include <faiss/index_factory.h>
 #include <faiss/index_io.h>
@@ -24,6 +26,7 @@
 #endif
 
 #include <fiu-local.h>
+#include <unistd.h>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -66,13 +69,14 @@ void
 IVF::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     GETTENSOR(dataset_ptr)
 
-    faiss::Index* coarse_quantizer = new faiss::IndexFlatL2(dim);
+    std::unique_ptr<faiss::VectorTransform> transform(GenPreTransform(dim, config));
+    int64_t index_dim = transform ? transform->d_out : dim;
+
+    faiss::Index* coarse_quantizer = new faiss::IndexFlatL2(index_dim);
     int64_t nlist = config[IndexParams::nlist].get<int64_t>();
     faiss::MetricType metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
-    auto index = std::make_shared<faiss::IndexIVFFlat>(coarse_quantizer, dim, nlist, metric_type);
-    index->train(rows, (float*)p_data);
-
-    index_.reset(faiss::clone_index(index.get()));
+    auto index = std::make_shared<faiss::IndexIVFFlat>(coarse_quantizer, index_dim, nlist, metric_type);
+    TrainImpl(index.get(), transform.get(), rows, (float*)p_data);
 }
 
 void
@@ -162,8 +166,8 @@ IVF::QueryById(const DatasetPtr& dataset_ptr, const Config& config) {
 
         // todo: enable search by id (zhiru)
         //        auto blacklist = dataset_ptr->Get<faiss::ConcurrentBitsetPtr>("bitset");
-        auto index_ivf = std::static_pointer_cast<faiss::IndexIVF>(index_);
-        index_ivf->search_by_id(rows, p_data, k, p_dist, p_id, bitset_);
+        // the stored vectors are searched in the transformed space
+        GetIVFIndex()->search_by_id(rows, p_data, k, p_dist, p_id, bitset_);
 
         //    std::stringstream ss_res_id, ss_res_dist;
         //    for (int i = 0; i < 10; ++i) {
@@ -202,8 +206,15 @@ IVF::GetVectorById(const DatasetPtr& dataset_ptr, const Config& config) {
         size_t p_x_size = sizeof(float) * elems;
         auto p_x = (float*)malloc(p_x_size);
 
-        auto index_ivf = std::static_pointer_cast<faiss::IndexIVF>(index_);
-        index_ivf->get_vector_by_id(1, p_data, p_x, bitset_);
+        auto index_ivf = GetIVFIndex();
+        if (auto pre_transform = dynamic_cast<faiss::IndexPreTransform*>(index_.get())) {
+            // OPQ and PCA are orthonormal, a PCA reduced vector comes back as its projection
+            std::vector<float> xt(index_ivf->d);
+            index_ivf->get_vector_by_id(1, p_data, xt.data(), bitset_);
+            pre_transform->reverse_chain(1, xt.data(), p_x);
+        } else {
+            index_ivf->get_vector_by_id(1, p_data, p_x, bitset_);
+        }
 
         auto ret_ds = std::make_shared<Dataset>();
         ret_ds->Set(meta::TENSOR, p_x);
@@ -215,6 +226,82 @@ IVF::GetVectorById(const DatasetPtr& dataset_ptr, const Config& config) {
     }
 }
 
+void
+IVF::MoveListsToDisk(const std::string& path) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto ivf_index = GetIVFIndex();
+    if (ivf_index == nullptr) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    if (dynamic_cast<faiss::OnDiskInvertedLists*>(ivf_index->invlists) != nullptr) {
+        return;
+    }
+    if (dynamic_cast<faiss::BlockInvertedLists*>(ivf_index->invlists) != nullptr) {
+        KNOWHERE_THROW_MSG("packed inverted lists can not be moved to disk");
+    }
+
+    try {
+        auto ondisk = new faiss::OnDiskInvertedLists(ivf_index->nlist, ivf_index->code_size, path.c_str());
+        const faiss::InvertedLists* ils[] = {ivf_index->invlists};
+        ondisk->merge_from(ils, 1);
+        ivf_index->replace_invlists(ondisk, true);
+    } catch (std::exception& e) {
+        unlink(path.c_str());
+        KNOWHERE_THROW_MSG(e.what());
+    }
+
+    // only quantizer and list metadata remain resident
+    SetIndexSize(ivf_index->quantizer->ntotal * ivf_index->d * sizeof(float) +
+                 ivf_index->nlist * sizeof(faiss::OnDiskInvertedLists::List));
+}
+
+bool
+IVF::IsPreTransformed() const {
+    return dynamic_cast<faiss::IndexPreTransform*>(index_.get()) != nullptr;
+}
+
+faiss::VectorTransform*
+IVF::GenPreTransform(int64_t dim, const Config& config) {
+    if (!config.contains(IndexParams::pre_transform)) {
+        return nullptr;
+    }
+
+    auto type = config[IndexParams::pre_transform].get<std::string>();
+    int64_t out_dim = dim;
+    if (config.contains(IndexParams::pre_transform_dim)) {
+        out_dim = config[IndexParams::pre_transform_dim].get<int64_t>();
+    }
+    if (type == PreTransform::OPQ) {
+        return new faiss::OPQMatrix(dim, config[IndexParams::m].get<int64_t>(), out_dim);
+    } else if (type == PreTransform::PCA) {
+        return new faiss::PCAMatrix(dim, out_dim);
+    }
+    KNOWHERE_THROW_MSG("unsupported pre-transform: " + type);
+}
+
+void
+IVF::TrainImpl(faiss::Index* index, faiss::VectorTransform* transform, int64_t rows, const float* data) {
+    if (transform == nullptr) {
+        index->train(rows, data);
+        index_.reset(faiss::clone_index(index));
+        return;
+    }
+
+    // the transform is trained first, then the index on the transformed vectors
+    faiss::IndexPreTransform pre_transform(transform, index);
+    pre_transform.train(rows, data);
+    index_.reset(faiss::clone_index(&pre_transform));
+}
+
+faiss::IndexIVF*
+IVF::GetIVFIndex() {
+    faiss::Index* index = index_.get();
+    if (auto pre_transform = dynamic_cast<faiss::IndexPreTransform*>(index)) {
+        index = pre_transform->index;
+    }
+    return dynamic_cast<faiss::IndexIVF*>(index);
+}
+
 void
 IVF::Seal() {
     if (!index_ || !index_->is_trained) {
@@ -289,16 +376,22 @@ IVF::GenParams(const Config& config) {
 
 void
 IVF::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& config) {
+    // per-call parameters, the index is shared by concurrent queries
     auto params = GenParams(config);
-    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
-    ivf_index->nprobe = params->nprobe;
-    stdclock::time_point before = stdclock::now();
     if (params->nprobe > 1 && n <= 4) {
-        ivf_index->parallel_mode = 1;
+        params->parallel_mode = 1;
     } else {
-        ivf_index->parallel_mode = 0;
+        params->parallel_mode = 0;
+    }
+    auto ivf_index = GetIVFIndex();
+    stdclock::time_point before = stdclock::now();
+    if (auto pre_transform = dynamic_cast<faiss::IndexPreTransform*>(index_.get())) {
+        const float* xt = pre_transform->apply_chain(n, data);
+        faiss::ScopeDeleter<float> del(xt == data ? nullptr : xt);
+        ivf_index->search_with_parameters(n, xt, k, distances, labels, params.get(), bitset_);
+    } else {
+        ivf_index->search_with_parameters(n, data, k, distances, labels, params.get(), bitset_);
     }
-    ivf_index->search(n, (float*)data, k, distances, labels, bitset_);
     stdclock::time_point after = stdclock::now();
     double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
     LOG_KNOWHERE_DEBUG_ << "IVF search cost: " << search_cost
@@ -311,8 +404,7 @@ IVF::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_
 void
 IVF::SealImpl() {
 #ifdef MILVUS_GPU_VERSION
-    faiss::Index* index = index_.get();
-    auto idx = dynamic_cast<faiss::IndexIVF*>(index);
+    auto idx = GetIVFIndex();
     if (idx != nullptr) {
         idx->to_readonly();
     }
@@ -13,10 +13,12 @@
 
 #include <memory>
 #include <mutex>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include <faiss/IndexIVF.h>
+#include <faiss/VectorTransform.h>
 
 #include "knowhere/common/Typedef.h"
 #include "knowhere/index/vector_index/FaissBaseIndex.h"
@@ -78,7 +80,32 @@ class IVF : public VecIndex, public FaissBaseIndex {
     virtual void
     GenGraph(const float* data, const int64_t k, GraphType& graph, const Config& config);
 
+    /*
+     * Move inverted lists into an mmapped file at path, only centroids and list metadata stay in memory.
+     * Lists probed by a query batch are read ahead asynchronously while the scan is running.
+     * The index serializes a reference to the file, loading it maps the file again, so the file belongs
+     * with the serialized index and is left in place.
+     */
+    void
+    MoveListsToDisk(const std::string& path);
+
+    /* Whether the vectors go through an OPQ or PCA pre-transform before reaching the IVF index */
+    bool
+    IsPreTransformed() const;
+
  protected:
+    /* The pre-transform asked by the config, nullptr if there is none */
+    static faiss::VectorTransform*
+    GenPreTransform(int64_t dim, const Config& config);
+
+    /* Train index behind transform (if not null) and keep a copy of the result */
+    void
+    TrainImpl(faiss::Index* index, faiss::VectorTransform* transform, int64_t rows, const float* data);
+
+    /* The IVF index, unwrapped from its pre-transform */
+    faiss::IndexIVF*
+    GetIVFIndex();
+
     virtual std::shared_ptr<faiss::IVFSearchParameters>
     GenParams(const Config&);
 
@@ -9,6 +9,7 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <memory>
 #include <string>
 
 #include <faiss/IndexFlat.h>
@@ -35,13 +36,16 @@ void
 IVFPQ::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     GETTENSOR(dataset_ptr)
 
-    faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, GetMetricType(config[Metric::TYPE].get<std::string>()));
-    auto index = std::make_shared<faiss::IndexIVFPQ>(coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(),
+    std::unique_ptr<faiss::VectorTransform> transform(GenPreTransform(dim, config));
+    int64_t index_dim = transform ? transform->d_out : dim;
+
+    faiss::Index* coarse_quantizer =
+        new faiss::IndexFlat(index_dim, GetMetricType(config[Metric::TYPE].get<std::string>()));
+    auto index = std::make_shared<faiss::IndexIVFPQ>(coarse_quantizer, index_dim,
+                                                     config[IndexParams::nlist].get<int64_t>(),
                                                      config[IndexParams::m].get<int64_t>(),
                                                      config[IndexParams::nbits].get<int64_t>());
-    index->train(rows, (float*)p_data);
-
-    index_.reset(faiss::clone_index(index.get()));
+    TrainImpl(index.get(), transform.get(), rows, (float*)p_data);
 }
 
 VecIndexPtr
@@ -0,0 +1,49 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <memory>
+#include <string>
+
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFPQFastScan.h>
+#include <faiss/clone_index.h>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace milvus {
+namespace knowhere {
+
+void
+IVFPQFastScan::Train(const DatasetPtr& dataset_ptr, const Config& config) {
+    GETTENSOR(dataset_ptr)
+
+    std::unique_ptr<faiss::VectorTransform> transform(GenPreTransform(dim, config));
+    int64_t index_dim = transform ? transform->d_out : dim;
+
+    auto metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+    faiss::Index* coarse_quantizer = new faiss::IndexFlat(index_dim, metric_type);
+    auto index = std::make_shared<faiss::IndexIVFPQFastScan>(coarse_quantizer, index_dim,
+                                                             config[IndexParams::nlist].get<int64_t>(),
+                                                             config[IndexParams::m].get<int64_t>(), metric_type);
+    index->own_fields = true;
+    TrainImpl(index.get(), transform.get(), rows, (float*)p_data);
+}
+
+VecIndexPtr
+IVFPQFastScan::CopyCpuToGpu(const int64_t device_id, const Config& config) {
+    KNOWHERE_THROW_MSG("IVFPQFastScan does not support GPU search");
+}
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -35,14 +35,15 @@ void
 IVFSQ::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     GETTENSOR(dataset_ptr)
 
+    std::unique_ptr<faiss::VectorTransform> transform(GenPreTransform(dim, config));
+    int64_t index_dim = transform ? transform->d_out : dim;
+
     std::stringstream index_type;
     index_type << "IVF" << config[IndexParams::nlist] << ","
                << "SQ" << config[IndexParams::nbits];
-    auto build_index =
-        faiss::index_factory(dim, index_type.str().c_str(), GetMetricType(config[Metric::TYPE].get<std::string>()));
-    build_index->train(rows, (float*)p_data);
-
-    index_.reset(faiss::clone_index(build_index));
+    auto build_index = faiss::index_factory(index_dim, index_type.str().c_str(),
+                                            GetMetricType(config[Metric::TYPE].get<std::string>()));
+    TrainImpl(build_index, transform.get(), rows, (float*)p_data);
 }
 
 VecIndexPtr
@@ -35,6 +35,7 @@ static std::unordered_map<int32_t, std::string> old_index_type_str_map = {
     {(int32_t)OldIndexType::SPTAG_BKT_RNT_CPU, IndexEnum::INDEX_SPTAG_BKT_RNT},
     {(int32_t)OldIndexType::HNSW, IndexEnum::INDEX_HNSW},
     {(int32_t)OldIndexType::ANNOY, IndexEnum::INDEX_ANNOY},
+    {(int32_t)OldIndexType::FAISS_IVFPQ_FASTSCAN, IndexEnum::INDEX_FAISS_IVFPQFASTSCAN},
     {(int32_t)OldIndexType::FAISS_BIN_IDMAP, IndexEnum::INDEX_FAISS_BIN_IDMAP},
     {(int32_t)OldIndexType::FAISS_BIN_IVFLAT_CPU, IndexEnum::INDEX_FAISS_BIN_IVFFLAT},
 };
@@ -51,6 +52,7 @@ static std::unordered_map<std::string, int32_t> str_old_index_type_map = {
     {IndexEnum::INDEX_SPTAG_BKT_RNT, (int32_t)OldIndexType::SPTAG_BKT_RNT_CPU},
     {IndexEnum::INDEX_HNSW, (int32_t)OldIndexType::HNSW},
     {IndexEnum::INDEX_ANNOY, (int32_t)OldIndexType::ANNOY},
+    {IndexEnum::INDEX_FAISS_IVFPQFASTSCAN, (int32_t)OldIndexType::FAISS_IVFPQ_FASTSCAN},
     {IndexEnum::INDEX_FAISS_BIN_IDMAP, (int32_t)OldIndexType::FAISS_BIN_IDMAP},
     {IndexEnum::INDEX_FAISS_BIN_IVFFLAT, (int32_t)OldIndexType::FAISS_BIN_IVFLAT_CPU},
 };
@@ -61,6 +63,7 @@ const char* INVALID = "";
 const char* INDEX_FAISS_IDMAP = "IDMAP";
 const char* INDEX_FAISS_IVFFLAT = "IVF_FLAT";
 const char* INDEX_FAISS_IVFPQ = "IVF_PQ";
+const char* INDEX_FAISS_IVFPQFASTSCAN = "IVF_PQ_FASTSCAN";
 const char* INDEX_FAISS_IVFSQ8 = "IVF_SQ8";
 const char* INDEX_FAISS_IVFSQ8H = "IVF_SQ8_HYBRID";
 const char* INDEX_FAISS_BIN_IDMAP = "BIN_IDMAP";
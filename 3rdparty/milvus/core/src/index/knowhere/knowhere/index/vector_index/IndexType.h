@@ -35,6 +35,7 @@ enum class OldIndexType {
     SPTAG_BKT_RNT_CPU,
     HNSW,
     ANNOY,
+    FAISS_IVFPQ_FASTSCAN,
     FAISS_BIN_IDMAP = 100,
     FAISS_BIN_IVFLAT_CPU = 101,
 };
@@ -47,6 +48,7 @@ extern const char* INVALID;
 extern const char* INDEX_FAISS_IDMAP;
 extern const char* INDEX_FAISS_IVFFLAT;
 extern const char* INDEX_FAISS_IVFPQ;
+extern const char* INDEX_FAISS_IVFPQFASTSCAN;
 extern const char* INDEX_FAISS_IVFSQ8;
 extern const char* INDEX_FAISS_IVFSQ8H;
 extern const char* INDEX_FAISS_BIN_IDMAP;
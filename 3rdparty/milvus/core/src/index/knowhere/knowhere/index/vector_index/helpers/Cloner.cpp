@@ -47,6 +47,11 @@ CopyGpuToCpu(const VecIndexPtr& index, const Config& config) {
 
 VecIndexPtr
 CopyCpuToGpu(const VecIndexPtr& index, const int64_t device_id, const Config& config) {
+    auto ivf_index = std::dynamic_pointer_cast<IVF>(index);
+    if (ivf_index != nullptr && ivf_index->IsPreTransformed()) {
+        KNOWHERE_THROW_MSG("pre-transformed index not support transfer to gpu");
+    }
+
     VecIndexPtr result;
     if (auto device_index = std::dynamic_pointer_cast<IVFSQHybrid>(index)) {
         result = device_index->CopyCpuToGpu(device_id, config);
@@ -33,6 +33,8 @@ constexpr const char* nprobe = "nprobe";
 constexpr const char* nlist = "nlist";
 constexpr const char* m = "m";          // PQ
 constexpr const char* nbits = "nbits";  // PQ/SQ
+constexpr const char* pre_transform = "pre_transform";          // OPQ/PCA applied before the IVF index
+constexpr const char* pre_transform_dim = "pre_transform_dim";  // output dimension of the pre-transform
 
 // NSG Params
 constexpr const char* knng = "knng";
@@ -50,6 +52,11 @@ constexpr const char* n_trees = "n_trees";
 constexpr const char* search_k = "search_k";
 }  // namespace IndexParams
 
+namespace PreTransform {
+constexpr const char* OPQ = "OPQ";  // rotation balancing the PQ sub-spaces, PQ indexes only
+constexpr const char* PCA = "PCA";  // dimensionality reduction, L2 only
+}  // namespace PreTransform
+
 namespace Metric {
 constexpr const char* TYPE = "metric_type";
 constexpr const char* IP = "IP";
@@ -57,6 +57,8 @@ typedef signed __int64    int64_t;
 #include <algorithm>
 #include <queue>
 #include <limits>
+#include <mutex>
+#include <thread>
 
 #ifdef _MSC_VER
 // Needed for Visual Studio to disable runtime checks for mempcy
@@ -830,12 +832,14 @@ class AnnoyIndexInterface {
   // Note that the methods with an **error argument will allocate memory and write the pointer to that string if error is non-nullptr
   virtual ~AnnoyIndexInterface() {};
   virtual bool add_item(S item, const T* w, char** error=nullptr) = 0;
-  virtual bool build(int q, char** error=nullptr) = 0;
+  virtual bool build(int q, int n_threads=-1, char** error=nullptr) = 0;
   virtual bool unbuild(char** error=nullptr) = 0;
   virtual bool save(const char* filename, bool prefault=false, char** error=nullptr) = 0;
   virtual void unload() = 0;
   virtual bool load(const char* filename, bool prefault=false, char** error=nullptr) = 0;
   virtual bool load_index(void* index_data, const int64_t& index_size, char** error = nullptr) = 0;
+  virtual bool load_index(const char* filename, int64_t offset, int64_t index_size, bool prefault=false,
+                          char** error=nullptr) = 0;
   virtual T get_distance(S i, S j) const = 0;
   virtual void get_nns_by_item(S item, size_t n, int64_t search_k, vector<S>* result, vector<T>* distances,
                                faiss::ConcurrentBitsetPtr& bitset = nullptr) const = 0;
@@ -880,6 +884,8 @@ protected:
   int _fd;
   bool _on_disk;
   bool _built;
+  void* _mapped;       // start of the pages mapped by load_index(filename, ...)
+  size_t _mapped_size;
 public:
 
    AnnoyIndex(int f) : _f(f), _random() {
@@ -948,7 +954,7 @@ public:
     return true;
   }
     
-  bool build(int q, char** error=nullptr) {
+  bool build(int q, int n_threads=-1, char** error=nullptr) {
     if (_loaded) {
       set_error_from_string(error, "You can't build a loaded index");
       return false;
@@ -962,20 +968,79 @@ public:
     D::template preprocess<T, S, Node>(_nodes, _s, _n_items, _f);
 
     _n_nodes = _n_items;
-    while (1) {
-      if (q == -1 && _n_nodes >= _n_items * 2)
-        break;
-      if (q != -1 && _roots.size() >= (size_t)q)
-        break;
-      if (_verbose) showUpdate("pass %zd...\n", _roots.size());
 
-      vector<S> indices;
-      for (S i = 0; i < _n_items; i++) {
-        if (_get(i)->n_descendants >= 1) // Issue #223
-          indices.push_back(i);
+    if (n_threads == -1) {
+      n_threads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    if (q != -1) {
+      n_threads = std::max(1, std::min(n_threads, q));
+    }
+
+    // Every thread grows its own trees in a private buffer, the items are only read.
+    // Thread 0 keeps using _random so that a single threaded build is unchanged.
+    vector<TreeBuffer> buffers(n_threads);
+    vector<Random> randoms;
+    for (int t = 1; t < n_threads; t++)
+      randoms.push_back(Random(_random.kiss() + t));
+
+    std::mutex lock;
+    size_t n_started = 0;
+    S n_total = _n_nodes;
+    auto worker = [&](int t) {
+      Random& random = (t == 0) ? _random : randoms[t - 1];
+      TreeBuffer& buffer = buffers[t];
+      while (1) {
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          if (q == -1 && n_total >= _n_items * 2)
+            break;
+          if (q != -1 && n_started >= (size_t)q)
+            break;
+          if (_verbose) showUpdate("pass %zd...\n", n_started);
+          n_started++;
+        }
+
+        vector<S> indices;
+        for (S i = 0; i < _n_items; i++) {
+          if (_get(i)->n_descendants >= 1) // Issue #223
+            indices.push_back(i);
+        }
+
+        S before = buffer.n_nodes;
+        buffer.roots.push_back(_make_tree(indices, true, random, buffer));
+
+        std::lock_guard<std::mutex> guard(lock);
+        n_total += buffer.n_nodes - before;
       }
+    };
 
-      _roots.push_back(_make_tree(indices, true));
+    if (n_threads == 1) {
+      worker(0);
+    } else {
+      vector<std::thread> threads;
+      for (int t = 0; t < n_threads; t++)
+        threads.emplace_back(worker, t);
+      for (auto& thread : threads)
+        thread.join();
+    }
+
+    // Append the buffers to the items, moving the node ids of each buffer past the previous ones
+    _allocate_size(n_total);
+    for (auto& buffer : buffers) {
+      S base = _n_nodes;
+      for (S i = 0; i < buffer.n_nodes; i++) {
+        Node* n = _get(base + i);
+        memcpy(n, buffer.get(_s, i), _s);
+        if (n->n_descendants > _K) {
+          for (int side = 0; side < 2; side++) {
+            if (n->children[side] >= _n_items)
+              n->children[side] = base + n->children[side] - _n_items;
+          }
+        }
+      }
+      for (S root : buffer.roots)
+        _roots.push_back(base + root - _n_items);
+      _n_nodes += buffer.n_nodes;
     }
 
     // Also, copy the roots into the last segment of the array
@@ -1053,11 +1118,17 @@ public:
     _n_nodes = 0;
     _nodes_size = 0;
     _on_disk = false;
+    _mapped = nullptr;
+    _mapped_size = 0;
     _roots.clear();
   }
 
   void unload() {
-    if (_on_disk && _fd) {
+    if (_mapped) {
+      // the nodes are a range of a mapped file
+      close(_fd);
+      munmap(_mapped, _mapped_size);
+    } else if (_on_disk && _fd) {
       close(_fd);
       munmap(_nodes, _s * _nodes_size);
     } else {
@@ -1171,6 +1242,72 @@ public:
     return true;
   }
 
+  // Map the index_size bytes at offset of filename instead of copying them, so that the processes
+  // serving the same file share its pages in the page cache.
+  bool load_index(const char* filename, int64_t offset, int64_t index_size, bool prefault=false,
+                  char** error=nullptr) {
+    if (index_size <= 0) {
+      set_error_from_string(error, "Size of index is zero");
+      return false;
+    } else if (index_size % _s) {
+      // Something is fishy with this index!
+      set_error_from_string(error, "Index size is not a multiple of vector size");
+      return false;
+    }
+
+    _fd = open(filename, O_RDONLY, (int)0400);
+    if (_fd == -1) {
+      set_error_from_errno(error, "Unable to open");
+      _fd = 0;
+      return false;
+    }
+
+    // mmap wants a page aligned offset
+    int64_t page_size = sysconf(_SC_PAGESIZE);
+    int64_t aligned_offset = offset - offset % page_size;
+    int flags = MAP_SHARED;
+    if (prefault) {
+#ifdef MAP_POPULATE
+      flags |= MAP_POPULATE;
+#else
+      showUpdate("prefault is set to true, but MAP_POPULATE is not defined on this platform");
+#endif
+    }
+    _mapped_size = (size_t)(offset - aligned_offset + index_size);
+    _mapped = mmap(0, _mapped_size, PROT_READ, flags, _fd, aligned_offset);
+    if (_mapped == MAP_FAILED) {
+      set_error_from_errno(error, "Unable to mmap");
+      close(_fd);
+      _fd = 0;
+      _mapped = nullptr;
+      _mapped_size = 0;
+      return false;
+    }
+    _nodes = (char*)_mapped + (offset - aligned_offset);
+    _n_nodes = (S)(index_size / _s);
+
+    // Find the roots by scanning the end of the file and taking the nodes with most descendants
+    _roots.clear();
+    S m = -1;
+    for (S i = _n_nodes - 1; i >= 0; i--) {
+      S k = _get(i)->n_descendants;
+      if (m == -1 || k == m) {
+        _roots.push_back(i);
+        m = k;
+      } else {
+        break;
+      }
+    }
+    // hacky fix: since the last root precedes the copy of all roots, delete it
+    if (_roots.size() > 1 && _get(_roots.front())->children[0] == _get(_roots.back())->children[0])
+      _roots.pop_back();
+    _loaded = true;
+    _built = true;
+    _n_items = m;
+    if (_verbose) showUpdate("found %lu roots with degree %ld\n", _roots.size(), m);
+    return true;
+  }
+
   T get_distance(S i, S j) const {
     return D::normalized_distance(D::distance(_get(i), _get(j), _f));
   }
@@ -1222,6 +1359,22 @@ public:
   }
 
 protected:
+  struct TreeBuffer {
+    vector<char> nodes;
+    S n_nodes = 0;
+    vector<S> roots;
+
+    // zeroed like the nodes from _allocate_size, return the local index
+    S allocate(size_t s) {
+      nodes.resize(nodes.size() + s, 0);
+      return n_nodes++;
+    }
+
+    Node* get(size_t s, S i) {
+      return (Node*)(nodes.data() + s * i);
+    }
+  };
+
   void _allocate_size(S n) {
     if (n > _nodes_size) {
       const double reallocation_factor = 1.3;
@@ -1246,7 +1399,9 @@ protected:
     return get_node_ptr<S, Node>(_nodes, _s, i);
   }
 
-  S _make_tree(const vector<S >& indices, bool is_root) {
+  // Nodes created by _make_tree go to a TreeBuffer, node i of the buffer having the id _n_items + i.
+  // The ids are moved to their final place when the buffers are appended to the items.
+  S _make_tree(const vector<S >& indices, bool is_root, Random& random, TreeBuffer& buffer) {
     // The basic rule is that if we have <= _K items, then it's a leaf node, otherwise it's a split node.
     // There's some regrettable complications caused by the problem that root nodes have to be "special":
     // 1. We identify root nodes by the arguable logic that _n_items == n->n_descendants, regardless of how many descendants they actually have
@@ -1256,9 +1411,8 @@ protected:
       return indices[0];
 
     if (indices.size() <= (size_t)_K && (!is_root || (size_t)_n_items <= (size_t)_K || indices.size() == 1)) {
-      _allocate_size(_n_nodes + 1);
-      S item = _n_nodes++;
-      Node* m = _get(item);
+      S item = _n_items + buffer.allocate(_s);
+      Node* m = buffer.get(_s, item - _n_items);
       m->n_descendants = is_root ? _n_items : (S)indices.size();
 
       // Using std::copy instead of a loop seems to resolve issues #3 and #13,
@@ -1280,14 +1434,14 @@ protected:
 
     vector<S> children_indices[2];
     Node* m = (Node*)alloca(_s);
-    D::create_split(children, _f, _s, _random, m);
+    D::create_split(children, _f, _s, random, m);
     faiss::BuilderSuspend::check_wait();
 
     for (size_t i = 0; i < indices.size(); i++) {
       S j = indices[i];
       Node* n = _get(j);
       if (n) {
-        bool side = D::side(m, n->v, _f, _random);
+        bool side = D::side(m, n->v, _f, random);
         children_indices[side].push_back(j);
       } else {
         showUpdate("No node for index %ld?\n", j);
@@ -1312,7 +1466,7 @@ protected:
       for (size_t i = 0; i < indices.size(); i++) {
         S j = indices[i];
         // Just randomize...
-        children_indices[_random.flip()].push_back(j);
+        children_indices[random.flip()].push_back(j);
       }
     }
 
@@ -1322,12 +1476,11 @@ protected:
     for (int side = 0; side < 2; side++) {
       // run _make_tree for the smallest child first (for cache locality)
       faiss::BuilderSuspend::check_wait();
-      m->children[side^flip] = _make_tree(children_indices[side^flip], false);
+      m->children[side^flip] = _make_tree(children_indices[side^flip], false, random, buffer);
     }
 
-    _allocate_size(_n_nodes + 1);
-    S item = _n_nodes++;
-    memcpy(_get(item), m, _s);
+    S item = _n_items + buffer.allocate(_s);
+    memcpy(buffer.get(_s, item - _n_items), m, _s);
 
     return item;
   }
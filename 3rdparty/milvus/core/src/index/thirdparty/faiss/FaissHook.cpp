@@ -9,6 +9,13 @@
 #include <faiss/impl/ScalarQuantizerDC.h>
 #include <faiss/impl/ScalarQuantizerDC_avx.h>
 #include <faiss/impl/ScalarQuantizerDC_avx512.h>
+#include <faiss/impl/pq4_fast_scan.h>
+#include <faiss/impl/pq4_fast_scan_avx.h>
+#include <faiss/impl/pq4_fast_scan_avx512.h>
+#include <faiss/impl/sq8_int_scan_avx.h>
+#include <faiss/impl/sq8_int_scan_avx512.h>
+#include <faiss/utils/BinaryDistance_avx.h>
+#include <faiss/utils/BinaryDistance_avx512.h>
 #include <faiss/utils/distances.h>
 #include <faiss/utils/distances_avx.h>
 #include <faiss/utils/distances_avx512.h>
@@ -26,10 +33,20 @@ fvec_func_ptr fvec_L2sqr = fvec_L2sqr_avx;
 fvec_func_ptr fvec_L1 = fvec_L1_avx;
 fvec_func_ptr fvec_Linf = fvec_Linf_avx;
 
+fvec_block_func_ptr fvec_L2sqr_block = nullptr;
+fvec_block_func_ptr fvec_inner_product_block = nullptr;
+
 sq_get_func_ptr sq_get_distance_computer_L2 = sq_get_distance_computer_L2_avx;
 sq_get_func_ptr sq_get_distance_computer_IP = sq_get_distance_computer_IP_avx;
 sq_sel_func_ptr sq_sel_quantizer = sq_select_quantizer_avx;
 
+hamming_block_func_ptr binary_hamming_block = nullptr;
+jaccard_block_func_ptr binary_jaccard_block = nullptr;
+size_t binary_block_min_code_size = 0;
+
+pq4_accumulate_func_ptr pq4_accumulate = pq4_accumulate_ref;
+
+sq8_dot_func_ptr sq8_dot = nullptr;
 
 /*****************************************************************************/
 
@@ -42,6 +59,20 @@ bool support_avx512() {
             instruction_set_inst.AVX512BW());
 }
 
+bool support_avx512_vpopcntdq() {
+    if (!support_avx512()) return false;
+
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.AVX512VPOPCNTDQ());
+}
+
+bool support_avx512_vnni() {
+    if (!support_avx512()) return false;
+
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.AVX512VNNI());
+}
+
 bool support_avx2() {
     if (!faiss_use_avx2) return false;
 
@@ -67,11 +98,32 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L1 = fvec_L1_avx512;
         fvec_Linf = fvec_Linf_avx512;
 
+        /* for IDMAP */
+        fvec_L2sqr_block = fvec_L2sqr_block_avx512;
+        fvec_inner_product_block = fvec_inner_product_block_avx512;
+
         /* for IVFSQ */
         sq_get_distance_computer_L2 = sq_get_distance_computer_L2_avx512;
         sq_get_distance_computer_IP = sq_get_distance_computer_IP_avx512;
         sq_sel_quantizer = sq_select_quantizer_avx512;
 
+        /* for binary IDMAP and IVF */
+        if (support_avx512_vpopcntdq()) {
+            binary_hamming_block = binary_hamming_block_avx512;
+            binary_jaccard_block = binary_jaccard_block_avx512;
+            binary_block_min_code_size = 64;
+        } else {
+            binary_hamming_block = binary_hamming_block_avx;
+            binary_jaccard_block = binary_jaccard_block_avx;
+            binary_block_min_code_size = 128;
+        }
+
+        /* for IVFPQ fast scan */
+        pq4_accumulate = pq4_accumulate_avx512;
+
+        /* for IVFSQ8 */
+        sq8_dot = support_avx512_vnni() ? sq8_dot_avx512_vnni : sq8_dot_avx512;
+
         cpu_flag = "AVX512";
     } else if (support_avx2()) {
         /* for IVFFLAT */
@@ -80,11 +132,26 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L1 = fvec_L1_avx;
         fvec_Linf = fvec_Linf_avx;
 
+        /* for IDMAP */
+        fvec_L2sqr_block = fvec_L2sqr_block_avx;
+        fvec_inner_product_block = fvec_inner_product_block_avx;
+
         /* for IVFSQ */
         sq_get_distance_computer_L2 = sq_get_distance_computer_L2_avx;
         sq_get_distance_computer_IP = sq_get_distance_computer_IP_avx;
         sq_sel_quantizer = sq_select_quantizer_avx;
 
+        /* for binary IDMAP and IVF */
+        binary_hamming_block = binary_hamming_block_avx;
+        binary_jaccard_block = binary_jaccard_block_avx;
+        binary_block_min_code_size = 128;
+
+        /* for IVFPQ fast scan */
+        pq4_accumulate = pq4_accumulate_avx;
+
+        /* for IVFSQ8 */
+        sq8_dot = sq8_dot_avx;
+
         cpu_flag = "AVX2";
     } else if (support_sse()) {
         /* for IVFFLAT */
@@ -93,11 +160,25 @@ bool hook_init(std::string& cpu_flag) {
         fvec_L1 = fvec_L1_sse;
         fvec_Linf = fvec_Linf_sse;
 
+        /* for IDMAP */
+        fvec_L2sqr_block = nullptr;
+        fvec_inner_product_block = nullptr;
+
         /* for IVFSQ */
         sq_get_distance_computer_L2 = sq_get_distance_computer_L2_sse;
         sq_get_distance_computer_IP = sq_get_distance_computer_IP_sse;
         sq_sel_quantizer = sq_select_quantizer_sse;
 
+        /* for binary IDMAP and IVF */
+        binary_hamming_block = nullptr;
+        binary_jaccard_block = nullptr;
+
+        /* for IVFPQ fast scan */
+        pq4_accumulate = pq4_accumulate_ref;
+
+        /* for IVFSQ8 */
+        sq8_dot = nullptr;
+
         cpu_flag = "SSE42";
     } else {
         cpu_flag = "UNSUPPORTED";
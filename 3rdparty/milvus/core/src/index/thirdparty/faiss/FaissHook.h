@@ -5,12 +5,21 @@
 
 #include <vector>
 #include <stddef.h>
+#include <stdint.h>
 #include <string>
 #include <faiss/impl/ScalarQuantizerOp.h>
 
 namespace faiss {
 
 typedef float (*fvec_func_ptr)(const float*, const float*, size_t);
+typedef void (*fvec_block_func_ptr)(const float*, size_t, const float*, size_t, size_t, float*);
+
+typedef void (*hamming_block_func_ptr)(const uint8_t*, size_t, const uint8_t*, size_t, size_t, int32_t*);
+typedef void (*jaccard_block_func_ptr)(const uint8_t*, size_t, const uint8_t*, size_t, size_t, float*);
+
+typedef void (*pq4_accumulate_func_ptr)(const uint8_t*, size_t, size_t, const uint8_t*, uint16_t*);
+
+typedef void (*sq8_dot_func_ptr)(const uint8_t*, size_t, size_t, const int8_t*, const int8_t*, int32_t*, int32_t*);
 
 typedef SQDistanceComputer* (*sq_get_func_ptr)(QuantizerType, size_t, const std::vector<float>&);
 typedef Quantizer* (*sq_sel_func_ptr)(QuantizerType, size_t, const std::vector<float>&);
@@ -25,11 +34,29 @@ extern fvec_func_ptr fvec_L2sqr;
 extern fvec_func_ptr fvec_L1;
 extern fvec_func_ptr fvec_Linf;
 
+/* nullptr when no SIMD kernel is available, brute force search uses the sse / blas paths then */
+extern fvec_block_func_ptr fvec_L2sqr_block;
+extern fvec_block_func_ptr fvec_inner_product_block;
+
 extern sq_get_func_ptr sq_get_distance_computer_L2;
 extern sq_get_func_ptr sq_get_distance_computer_IP;
 extern sq_sel_func_ptr sq_sel_quantizer;
 
+/* nullptr when no SIMD kernel is available, the scalar computers are used then */
+extern hamming_block_func_ptr binary_hamming_block;
+extern jaccard_block_func_ptr binary_jaccard_block;
+/* shorter codes (bytes) stay on the register-resident computers */
+extern size_t binary_block_min_code_size;
+
+/* for IVFPQ fast scan */
+extern pq4_accumulate_func_ptr pq4_accumulate;
+
+/* for IVFSQ8, nullptr when no SIMD kernel is available, the float scanners are used then */
+extern sq8_dot_func_ptr sq8_dot;
+
 extern bool support_avx512();
+extern bool support_avx512_vpopcntdq();
+extern bool support_avx512_vnni();
 extern bool support_avx2();
 extern bool support_sse();
 
@@ -16,6 +16,7 @@
 #include <memory>
 #include <cmath>
 
+#include <faiss/FaissHook.h>
 #include <faiss/utils/BinaryDistance.h>
 #include <faiss/utils/hamming.h>
 #include <faiss/utils/utils.h>
@@ -148,6 +149,14 @@ void IndexBinaryIVF::make_direct_map(bool new_maintain_direct_map) {
 
 void IndexBinaryIVF::search(idx_t n, const uint8_t *x, idx_t k, int32_t *distances, idx_t *labels,
                             ConcurrentBitsetPtr bitset) const {
+  search_with_parameters(n, x, k, distances, labels, nullptr, bitset);
+}
+
+void IndexBinaryIVF::search_with_parameters(idx_t n, const uint8_t *x, idx_t k,
+                                            int32_t *distances, idx_t *labels,
+                                            const IVFSearchParameters *params,
+                                            ConcurrentBitsetPtr bitset) const {
+  size_t nprobe = params ? params->nprobe : this->nprobe;
   std::unique_ptr<idx_t[]> idx(new idx_t[n * nprobe]);
   std::unique_ptr<int32_t[]> coarse_dis(new int32_t[n * nprobe]);
 
@@ -159,7 +168,7 @@ void IndexBinaryIVF::search(idx_t n, const uint8_t *x, idx_t k, int32_t *distanc
   invlists->prefetch_lists(idx.get(), n * nprobe);
 
   search_preassigned(n, x, k, idx.get(), coarse_dis.get(),
-                     distances, labels, false, nullptr, bitset);
+                     distances, labels, false, params, bitset);
   indexIVF_stats.search_time += getmillisecs() - t0;
 }
 
@@ -481,8 +490,68 @@ struct IVFBinaryScannerJaccard: BinaryInvertedListScanner {
 
 };
 
+/* scans the lists by blocks of codes with the SIMD kernels set up by hook_init */
+template<class C, typename BlockFunc, bool store_pairs>
+struct IVFBinaryScannerBlock: BinaryInvertedListScanner {
+    using T = typename C::T;
+    static const size_t block_size = 256;
+
+    BlockFunc block_func;
+    size_t code_size;
+    const uint8_t *query = nullptr;
+
+    IVFBinaryScannerBlock (BlockFunc block_func, size_t code_size):
+        block_func (block_func), code_size (code_size)
+    {}
+
+    void set_query (const uint8_t *query_vector) override {
+        query = query_vector;
+    }
+
+    idx_t list_no;
+    void set_list (idx_t list_no, uint8_t /* coarse_dis */) override {
+        this->list_no = list_no;
+    }
+
+    uint32_t distance_to_code (const uint8_t *code) const override {
+        T dis;
+        block_func (query, 1, code, 1, code_size, &dis);
+        return dis;
+    }
+
+    size_t scan_codes (size_t n,
+                       const uint8_t *codes,
+                       const idx_t *ids,
+                       int32_t *simi, idx_t *idxi,
+                       size_t k,
+                       ConcurrentBitsetPtr bitset) const override
+    {
+        T* psimi = (T*)simi;
+        T dis[block_size];
+        size_t nup = 0;
+        for (size_t j0 = 0; j0 < n; j0 += block_size) {
+            size_t nj = std::min(n - j0, block_size);
+            block_func (query, 1, codes + j0 * code_size, nj, code_size, dis);
+            for (size_t j = 0; j < nj; j++) {
+                // the bitset is only checked for the codes that would enter the heap
+                if (dis[j] < psimi[0] && (!bitset || !bitset->test(ids[j0 + j]))) {
+                    idx_t id = store_pairs ? (list_no << 32 | (j0 + j)) : ids[j0 + j];
+                    heap_swap_top<C> (k, psimi, idxi, dis[j], id);
+                    nup++;
+                }
+            }
+        }
+        return nup;
+    }
+
+};
+
 template <bool store_pairs>
 BinaryInvertedListScanner *select_IVFBinaryScannerL2 (size_t code_size) {
+    if (binary_hamming_block && code_size >= binary_block_min_code_size) {
+        return new IVFBinaryScannerBlock<CMax<int32_t, idx_t>, hamming_block_func_ptr, store_pairs>
+            (binary_hamming_block, code_size);
+    }
 
     switch (code_size) {
 #define HANDLE_CS(cs)                                                  \
@@ -511,6 +580,11 @@ BinaryInvertedListScanner *select_IVFBinaryScannerL2 (size_t code_size) {
 
 template <bool store_pairs>
 BinaryInvertedListScanner *select_IVFBinaryScannerJaccard (size_t code_size) {
+    if (binary_jaccard_block && code_size >= binary_block_min_code_size) {
+        return new IVFBinaryScannerBlock<CMax<float, idx_t>, jaccard_block_func_ptr, store_pairs>
+            (binary_jaccard_block, code_size);
+    }
+
     switch (code_size) {
 #define HANDLE_CS(cs)                                                  \
     case cs:                                                            \
@@ -12,12 +12,14 @@
 
 #include <omp.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <memory>
 #include <iostream>
 
 #include <faiss/utils/utils.h>
 #include <faiss/utils/hamming.h>
+#include <faiss/utils/ResultHandler.h>
 
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/IndexFlat.h>
@@ -175,6 +177,7 @@ IndexIVF::IndexIVF (Index * quantizer, size_t d,
     nprobe (1),
     max_codes (0),
     parallel_mode (0),
+    bitset_compact_ratio (0.1),
     maintain_direct_map (false)
 {
     FAISS_THROW_IF_NOT (d == quantizer->d);
@@ -190,6 +193,7 @@ IndexIVF::IndexIVF ():
     invlists (nullptr), own_invlists (false),
     code_size (0),
     nprobe (1), max_codes (0), parallel_mode (0),
+    bitset_compact_ratio (0.1),
     maintain_direct_map (false)
 {}
 
@@ -299,18 +303,42 @@ void IndexIVF::make_direct_map (bool new_maintain_direct_map)
 
 void IndexIVF::search (idx_t n, const float *x, idx_t k, float *distances, idx_t *labels,
                        ConcurrentBitsetPtr bitset) const {
-    std::unique_ptr<idx_t[]> idx(new idx_t[n * nprobe]);
-    std::unique_ptr<float[]> coarse_dis(new float[n * nprobe]);
+    search_with_parameters (n, x, k, distances, labels, nullptr, bitset);
+}
+
+void IndexIVF::search_with_parameters (idx_t n, const float *x, idx_t k,
+                                       float *distances, idx_t *labels,
+                                       const IVFSearchParameters *search_params,
+                                       ConcurrentBitsetPtr bitset) const {
+    IVFSearchParameters params;
+    params.nprobe = search_params ? search_params->nprobe : nprobe;
+    params.max_codes = search_params ? search_params->max_codes : max_codes;
+    params.parallel_mode = search_params ? search_params->parallel_mode : -1;
+
+    // A bitset selective enough for search_preassigned to compact the lists
+    // may leave less than k survivors in nprobe lists on average: probe all
+    // lists then, which only visits the surviving codes
+    if (bitset && ntotal > 0) {
+        size_t alive = ntotal - std::min ((size_t)ntotal, bitset->count ());
+        params.nalive = alive;
+        if (alive < bitset_compact_ratio * ntotal &&
+            alive * params.nprobe < k * nlist) {
+            params.nprobe = nlist;
+        }
+    }
+
+    std::unique_ptr<idx_t[]> idx(new idx_t[n * params.nprobe]);
+    std::unique_ptr<float[]> coarse_dis(new float[n * params.nprobe]);
 
     double t0 = getmillisecs();
-    quantizer->search (n, x, nprobe, coarse_dis.get(), idx.get());
+    quantizer->search (n, x, params.nprobe, coarse_dis.get(), idx.get());
     indexIVF_stats.quantization_time += getmillisecs() - t0;
 
     t0 = getmillisecs();
-    invlists->prefetch_lists (idx.get(), n * nprobe);
+    invlists->prefetch_lists (idx.get(), n * params.nprobe);
 
     search_preassigned (n, x, k, idx.get(), coarse_dis.get(),
-                        distances, labels, false, nullptr, bitset);
+                        distances, labels, false, &params, bitset);
     indexIVF_stats.search_time += getmillisecs() - t0;
 }
 
@@ -344,6 +372,34 @@ void IndexIVF::search_by_id (idx_t n, const idx_t *xid, idx_t k, float *distance
     delete []x;
 }
 
+namespace {
+
+/* scan codes into a reservoir: the distances of a batch of codes are
+ * computed first, filtered codes get the neutral distance and are dropped
+ * by the threshold test */
+template <class C>
+size_t scan_codes_reservoir (const InvertedListScanner *scanner,
+                             size_t list_size, const uint8_t *codes,
+                             const Index::idx_t *ids, size_t code_size,
+                             const ConcurrentBitsetPtr &bitset,
+                             ReservoirTopK<C> &res)
+{
+    const size_t bs = ReservoirTopK<C>::batch_size;
+    float dis[bs];
+    size_t nup = 0;
+    for (size_t j0 = 0; j0 < list_size; j0 += bs) {
+        size_t nj = std::min (list_size - j0, bs);
+        for (size_t j = 0; j < nj; j++) {
+            dis[j] = (bitset && bitset->test (ids[j0 + j])) ? C::neutral () :
+                scanner->distance_to_code (codes + (j0 + j) * code_size);
+        }
+        nup += res.add_batch (dis, nj, [&] (size_t j) { return ids[j0 + j]; });
+    }
+    return nup;
+}
+
+} // namespace
+
 void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                                    const idx_t *keys,
                                    const float *coarse_dis ,
@@ -354,6 +410,8 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
 {
     long nprobe = params ? params->nprobe : this->nprobe;
     long max_codes = params ? params->max_codes : this->max_codes;
+    int parallel_mode = params && params->parallel_mode >= 0 ?
+        params->parallel_mode : this->parallel_mode;
 
     size_t nlistv = 0, ndis = 0, nheap = 0;
 
@@ -368,11 +426,73 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
         parallel_mode == 1 ? nprobe > 1 :
         nprobe * n > 1;
 
+    // large k: the results of a query are collected into a reservoir
+    // instead of a heap, if the scanner computes distances code by code
+    bool use_reservoir = parallel_mode == 0 && !store_pairs &&
+        k >= (idx_t) reservoir_topk_threshold;
+
+    // Gather the surviving codes of every probed list once per batch when
+    // the bitset filters out most ids. Scanners then skip the filtered codes
+    // without testing them, and lists without survivors are not visited
+    bool compact = false;
+    if (bitset && !store_pairs && ntotal > 0) {
+        size_t alive = params && params->nalive >= 0 ? params->nalive :
+            ntotal - std::min ((size_t)ntotal, bitset->count ());
+        compact = alive < bitset_compact_ratio * ntotal;
+    }
+
+    std::vector<idx_t> compact_slot;
+    std::vector<std::vector<uint8_t>> compact_codes;
+    std::vector<std::vector<idx_t>> compact_ids;
+    if (compact) {
+        compact_slot.assign (nlist, -1);
+        std::vector<idx_t> probed;
+        for (idx_t i = 0; i < n * nprobe; i++) {
+            idx_t key = keys[i];
+            if (key >= 0 && key < (idx_t) nlist && compact_slot[key] < 0) {
+                compact_slot[key] = probed.size ();
+                probed.push_back (key);
+            }
+        }
+        compact_codes.resize (probed.size ());
+        compact_ids.resize (probed.size ());
+
+#pragma omp parallel for schedule(dynamic)
+        for (size_t s = 0; s < probed.size (); s++) {
+            size_t list_size = invlists->list_size (probed[s]);
+            if (list_size == 0) {
+                continue;
+            }
+            InvertedLists::ScopedCodes scodes (invlists, probed[s]);
+            InvertedLists::ScopedIds sids (invlists, probed[s]);
+            const uint8_t *codes = scodes.get ();
+            const idx_t *ids = sids.get ();
+            for (size_t j = 0; j < list_size; j++) {
+                if (!bitset->test (ids[j])) {
+                    compact_ids[s].push_back (ids[j]);
+                    compact_codes[s].insert (compact_codes[s].end (),
+                                             codes + j * code_size,
+                                             codes + (j + 1) * code_size);
+                }
+            }
+        }
+    }
+
 #pragma omp parallel if(do_parallel) reduction(+: nlistv, ndis, nheap)
     {
         InvertedListScanner *scanner = get_InvertedListScanner(store_pairs);
         ScopeDeleter1<InvertedListScanner> del(scanner);
 
+        std::unique_ptr<ReservoirTopK<HeapForIP>> res_ip;
+        std::unique_ptr<ReservoirTopK<HeapForL2>> res_l2;
+        if (use_reservoir && scanner->exact_distance_to_code ()) {
+            if (metric_type == METRIC_INNER_PRODUCT) {
+                res_ip.reset (new ReservoirTopK<HeapForIP> (k));
+            } else {
+                res_l2.reset (new ReservoirTopK<HeapForL2> (k));
+            }
+        }
+
         /*****************************************************
          * Depending on parallel_mode, there are two possible ways
          * to organize the search. Here we define local functions
@@ -382,7 +502,11 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
         // intialize + reorder a result heap
 
         auto init_result = [&](float *simi, idx_t *idxi) {
-            if (metric_type == METRIC_INNER_PRODUCT) {
+            if (res_ip) {
+                res_ip->reset ();
+            } else if (res_l2) {
+                res_l2->reset ();
+            } else if (metric_type == METRIC_INNER_PRODUCT) {
                 heap_heapify<HeapForIP> (k, simi, idxi);
             } else {
                 heap_heapify<HeapForL2> (k, simi, idxi);
@@ -390,13 +514,31 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
         };
 
         auto reorder_result = [&] (float *simi, idx_t *idxi) {
-            if (metric_type == METRIC_INNER_PRODUCT) {
+            if (res_ip) {
+                res_ip->finalize (simi, idxi);
+            } else if (res_l2) {
+                res_l2->finalize (simi, idxi);
+            } else if (metric_type == METRIC_INNER_PRODUCT) {
                 heap_reorder<HeapForIP> (k, simi, idxi);
             } else {
                 heap_reorder<HeapForL2> (k, simi, idxi);
             }
         };
 
+        // scan codes into the reservoir or the result heap
+        auto scan_codes = [&] (size_t list_size, const uint8_t *codes,
+                               const idx_t *ids, float *simi, idx_t *idxi,
+                               const ConcurrentBitsetPtr &bitset) -> size_t {
+            if (res_ip) {
+                return scan_codes_reservoir (scanner, list_size, codes, ids,
+                                             code_size, bitset, *res_ip);
+            } else if (res_l2) {
+                return scan_codes_reservoir (scanner, list_size, codes, ids,
+                                             code_size, bitset, *res_l2);
+            }
+            return scanner->scan_codes (list_size, codes, ids, simi, idxi, k, bitset);
+        };
+
         // single list scan using the current scanner (with query
         // set porperly) and storing results in simi and idxi
         auto scan_one_list = [&] (idx_t key, float coarse_dis_i,
@@ -410,6 +552,20 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                                     "Invalid key=%ld nlist=%ld\n",
                                     key, nlist);
 
+            if (compact) {
+                idx_t slot = compact_slot[key];
+                size_t nsurvive = compact_ids[slot].size ();
+                if (nsurvive == 0) {
+                    return (size_t)0;
+                }
+                scanner->set_list (key, coarse_dis_i);
+                nlistv++;
+                nheap += scan_codes (nsurvive, compact_codes[slot].data (),
+                                     compact_ids[slot].data (),
+                                     simi, idxi, nullptr);
+                return nsurvive;
+            }
+
             size_t list_size = invlists->list_size(key);
 
             // don't waste time on empty lists
@@ -431,8 +587,8 @@ void IndexIVF::search_preassigned (idx_t n, const float *x, idx_t k,
                 ids = sids->get();
             }
 
-            nheap += scanner->scan_codes (list_size, scodes.get(),
-                                          ids, simi, idxi, k, bitset);
+            nheap += scan_codes (list_size, scodes.get(),
+                                 ids, simi, idxi, bitset);
 
             return list_size;
         };
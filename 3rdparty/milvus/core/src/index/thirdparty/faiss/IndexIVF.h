@@ -69,6 +69,9 @@ struct Level1Quantizer {
 struct IVFSearchParameters {
     size_t nprobe;            ///< number of probes at query time
     size_t max_codes;         ///< max nb of codes to visit to do a query
+    int parallel_mode;        ///< overrides IndexIVF::parallel_mode if >= 0
+    long nalive;              ///< nb of ids kept by the bitset, -1 if not counted
+    IVFSearchParameters (): nprobe (1), max_codes (0), parallel_mode (-1), nalive (-1) {}
     virtual ~IVFSearchParameters () {}
 };
 
@@ -114,6 +117,12 @@ struct IndexIVF: Index, Level1Quantizer {
      */
     int parallel_mode;
 
+    /** When a search bitset keeps less than this fraction of the ids,
+     * the probed lists are compacted to their surviving codes before
+     * scanning, and lists without survivors are skipped
+     */
+    float bitset_compact_ratio;
+
     /// map for direct access to the elements. Enables reconstruct().
     bool maintain_direct_map;
     std::vector <idx_t> direct_map;
@@ -187,6 +196,15 @@ struct IndexIVF: Index, Level1Quantizer {
     void search (idx_t n, const float *x, idx_t k, float *distances, idx_t *labels,
                  ConcurrentBitsetPtr bitset = nullptr) const override;
 
+    /** same as search, with params overriding the object's search
+     * parameters for this call only, so concurrent callers may use
+     * different ones without writing to the index
+     */
+    void search_with_parameters (idx_t n, const float *x, idx_t k,
+                                 float *distances, idx_t *labels,
+                                 const IVFSearchParameters *params,
+                                 ConcurrentBitsetPtr bitset = nullptr) const;
+
     /** get raw vectors by ids */
     void get_vector_by_id (idx_t n, const idx_t *xid, float *x, ConcurrentBitsetPtr bitset = nullptr) override;
 
@@ -319,6 +337,12 @@ struct InvertedListScanner {
     /// compute a single query-to-code distance
     virtual float distance_to_code (const uint8_t *code) const = 0;
 
+    /// true if distance_to_code returns the distance scan_codes compares,
+    /// so that the codes can be scanned into other result structures
+    virtual bool exact_distance_to_code () const {
+        return false;
+    }
+
     /** scan a set of codes, compute distances to current query and
      * update heap of results if necessary.
      *
@@ -144,6 +144,10 @@ struct IVFFlatScanner: InvertedListScanner {
         return dis;
     }
 
+    bool exact_distance_to_code () const override {
+        return true;
+    }
+
     size_t scan_codes (size_t list_size,
                        const uint8_t *codes,
                        const idx_t *ids,
@@ -1063,6 +1063,10 @@ struct IVFPQScanner:
         return dis;
     }
 
+    bool exact_distance_to_code () const override {
+        return precompute_mode == 2 && this->polysemous_ht == 0;
+    }
+
     size_t scan_codes (size_t ncode,
                        const uint8_t *codes,
                        const idx_t *ids,
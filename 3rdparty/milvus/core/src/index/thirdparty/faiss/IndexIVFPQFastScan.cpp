@@ -0,0 +1,242 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#include <faiss/IndexIVFPQFastScan.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <faiss/FaissHook.h>
+#include <faiss/impl/AuxIndexStructures.h>
+#include <faiss/impl/FaissAssert.h>
+#include <faiss/impl/pq4_fast_scan.h>
+#include <faiss/utils/Heap.h>
+
+namespace faiss {
+
+IndexIVFPQFastScan::IndexIVFPQFastScan (Index * quantizer, size_t d,
+                                        size_t nlist, size_t M,
+                                        MetricType metric):
+    IndexIVFPQ (quantizer, d, nlist, M, 4)
+{
+    FAISS_THROW_IF_NOT (metric == METRIC_L2 ||
+                        metric == METRIC_INNER_PRODUCT);
+    metric_type = metric;
+    replace_invlists (new BlockInvertedLists (nlist, code_size,
+                                              pq4_block_size), true);
+    // the compacted codes of IndexIVF::search_preassigned are not packed,
+    // the scanner tests the bitset on the candidates instead
+    bitset_compact_ratio = 0;
+}
+
+IndexIVFPQFastScan::IndexIVFPQFastScan ()
+{
+    bitset_compact_ratio = 0;
+}
+
+void IndexIVFPQFastScan::reconstruct_from_offset (int64_t list_no,
+                                                  int64_t offset,
+                                                  float* recons) const
+{
+    // the single codes are unpacked copies that must be released
+    InvertedLists::ScopedCodes code (invlists, list_no, offset);
+    pq.decode (code.get(), recons);
+
+    if (by_residual) {
+        std::vector<float> centroid (d);
+        quantizer->reconstruct (list_no, centroid.data());
+        for (int i = 0; i < d; ++i) {
+            recons[i] += centroid[i];
+        }
+    }
+}
+
+namespace {
+
+/* The distances are handled as values to minimize: the L2 distance, or the
+ * opposite of the inner product. */
+struct PQ4FastScanner: InvertedListScanner {
+    const IndexIVFPQFastScan &ivf;
+    bool store_pairs;
+    bool is_ip;
+    size_t code_size;
+    size_t nsq;              // sub-quantizers covered by the codes, 2 * code_size
+
+    const float *qi;
+    idx_t list_no;
+
+    std::vector<float> query_table;   // table of the query, if not by residual
+    std::vector<float> residual;
+    std::vector<float> sim_table;     // float table of the list, nsq * 16
+    std::vector<uint8_t> lut;         // quantized sim_table
+    mutable std::vector<uint16_t> accu;
+
+    float dis0;              // constant term of the exact distances
+    float qdis0;             // constant term of the quantized distances
+    float scale;             // quantization steps per unit of distance
+
+    PQ4FastScanner (const IndexIVFPQFastScan &ivf, bool store_pairs):
+        ivf (ivf), store_pairs (store_pairs),
+        is_ip (ivf.metric_type == METRIC_INNER_PRODUCT),
+        code_size (ivf.code_size), nsq (2 * ivf.code_size),
+        qi (nullptr), list_no (-1),
+        query_table (nsq * 16, 0), residual (ivf.d),
+        sim_table (nsq * 16, 0), lut (nsq * 16, 0),
+        dis0 (0), qdis0 (0), scale (1)
+    {}
+
+    void set_query (const float *query) override {
+        qi = query;
+        if (is_ip) {
+            ivf.pq.compute_inner_prod_table (qi, query_table.data());
+            for (size_t m = 0; m < ivf.pq.M * 16; m++) {
+                query_table[m] = -query_table[m];
+            }
+        } else if (!ivf.by_residual) {
+            ivf.pq.compute_distance_table (qi, query_table.data());
+        }
+    }
+
+    void set_list (idx_t list, float coarse_dis) override {
+        list_no = list;
+        dis0 = 0;
+        if (is_ip) {
+            // <q, c + r> = <q, c> + <q, r>
+            sim_table = query_table;
+            if (ivf.by_residual) {
+                dis0 = -coarse_dis;
+            }
+        } else if (ivf.by_residual) {
+            ivf.quantizer->compute_residual (qi, residual.data(), list_no);
+            ivf.pq.compute_distance_table (residual.data(), sim_table.data());
+        } else {
+            sim_table = query_table;
+        }
+        quantize_table ();
+    }
+
+    /* per sub-quantizer, entry - min is quantized with a common scale such
+     * that the sum over the sub-quantizers fits in uint16 */
+    void quantize_table () {
+        size_t M = ivf.pq.M;
+        std::vector<float> mins (M);
+        float max_range = 0;
+        qdis0 = dis0;
+        for (size_t m = 0; m < M; m++) {
+            const float *t = sim_table.data() + m * 16;
+            float mn = *std::min_element (t, t + 16);
+            float mx = *std::max_element (t, t + 16);
+            mins[m] = mn;
+            qdis0 += mn;
+            max_range = std::max (max_range, mx - mn);
+        }
+        float qmax = std::min (255.0f, std::floor (65535.0f / M));
+        scale = max_range > 0 ? qmax / max_range : 1;
+        for (size_t m = 0; m < M; m++) {
+            const float *t = sim_table.data() + m * 16;
+            for (size_t c = 0; c < 16; c++) {
+                float q = std::round ((t[c] - mins[m]) * scale);
+                lut[m * 16 + c] = (uint8_t) std::min (q, qmax);
+            }
+        }
+    }
+
+    /// exact distance of the code at position j of a block
+    float block_distance (const uint8_t *block, size_t j) const {
+        float dis = dis0;
+        const float *t = sim_table.data();
+        for (size_t b = 0; b < code_size; b++) {
+            uint8_t c = block[b * pq4_block_size + j];
+            dis += t[c & 15] + t[16 + (c >> 4)];
+            t += 32;
+        }
+        return dis;
+    }
+
+    float distance_to_code (const uint8_t *code) const override {
+        float dis = dis0;
+        const float *t = sim_table.data();
+        for (size_t b = 0; b < code_size; b++) {
+            dis += t[code[b] & 15] + t[16 + (code[b] >> 4)];
+            t += 32;
+        }
+        return is_ip ? -dis : dis;
+    }
+
+    size_t scan_codes (size_t n, const uint8_t *codes, const idx_t *ids,
+                       float *simi, idx_t *idxi, size_t k,
+                       ConcurrentBitsetPtr bitset) const override
+    {
+        size_t nblock = (n + pq4_block_size - 1) / pq4_block_size;
+        accu.resize (nblock * pq4_block_size);
+        pq4_accumulate (codes, nblock, code_size, lut.data(), accu.data());
+
+        // a quantized distance is at most 0.5 step per sub-quantizer off,
+        // one more step covers the rounding of the float tables
+        float margin = 0.5f * ivf.pq.M + 1;
+        auto bound_of = [&] () {
+            float thr = is_ip ? -simi[0] : simi[0];
+            return (thr - qdis0) * scale + margin;
+        };
+        float bound = bound_of ();
+
+        size_t nup = 0;
+        for (size_t j = 0; j < n; j++) {
+            if (accu[j] >= bound) {
+                continue;
+            }
+            idx_t id = store_pairs ? (list_no << 32 | j) : ids[j];
+            if (bitset && bitset->test (id)) {
+                continue;
+            }
+            const uint8_t *block = codes + (j / pq4_block_size) * pq4_block_size * code_size;
+            float dis = block_distance (block, j % pq4_block_size);
+            if (is_ip) {
+                if (dis < -simi[0]) {
+                    heap_swap_top<CMin<float, idx_t>> (k, simi, idxi, -dis, id);
+                    nup++;
+                    bound = bound_of ();
+                }
+            } else if (dis < simi[0]) {
+                heap_swap_top<CMax<float, idx_t>> (k, simi, idxi, dis, id);
+                nup++;
+                bound = bound_of ();
+            }
+        }
+        return nup;
+    }
+
+    void scan_codes_range (size_t n, const uint8_t *codes, const idx_t *ids,
+                           float radius, RangeQueryResult &res,
+                           ConcurrentBitsetPtr bitset) const override
+    {
+        for (size_t j = 0; j < n; j++) {
+            idx_t id = store_pairs ? (list_no << 32 | j) : ids[j];
+            if (bitset && bitset->test (id)) {
+                continue;
+            }
+            const uint8_t *block = codes + (j / pq4_block_size) * pq4_block_size * code_size;
+            float dis = block_distance (block, j % pq4_block_size);
+            if (is_ip ? -dis > radius : dis < radius) {
+                res.add (is_ip ? -dis : dis, id);
+            }
+        }
+    }
+};
+
+} // namespace
+
+InvertedListScanner *
+IndexIVFPQFastScan::get_InvertedListScanner (bool store_pairs) const
+{
+    return new PQ4FastScanner (*this, store_pairs);
+}
+
+} // namespace faiss
@@ -0,0 +1,43 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#ifndef FAISS_INDEX_IVFPQ_FAST_SCAN_H
+#define FAISS_INDEX_IVFPQ_FAST_SCAN_H
+
+#include <faiss/IndexIVFPQ.h>
+
+namespace faiss {
+
+/** IVFPQ with 4-bit sub-quantizers, scanned with in-register tables.
+ *
+ * The codes are stored in blocks of 32 vectors (BlockInvertedLists). For
+ * every probed list the float distance tables are quantized to uint8, and
+ * the distances of a block are accumulated in uint16 with SIMD shuffles
+ * (see impl/pq4_fast_scan.h). The quantized distances only select the
+ * candidates: the ones that may beat the current results given the
+ * quantization error are re-checked with the float tables, so the results
+ * are those of an IndexIVFPQ with nbits = 4.
+ */
+struct IndexIVFPQFastScan: IndexIVFPQ {
+
+    IndexIVFPQFastScan (Index * quantizer, size_t d, size_t nlist,
+                        size_t M, MetricType metric = METRIC_L2);
+
+    IndexIVFPQFastScan ();
+
+    void reconstruct_from_offset (int64_t list_no, int64_t offset,
+                                  float* recons) const override;
+
+    InvertedListScanner *get_InvertedListScanner (bool store_pairs)
+        const override;
+};
+
+} // namespace faiss
+
+#endif
@@ -186,7 +186,7 @@ void IndexPreTransform::search (idx_t n, const float *x, idx_t k,
     FAISS_THROW_IF_NOT (is_trained);
     const float *xt = apply_chain (n, x);
     ScopeDeleter<float> del(xt == x ? nullptr : xt);
-    index->search (n, xt, k, distances, labels);
+    index->search (n, xt, k, distances, labels, bitset);
 }
 
 void IndexPreTransform::range_search (idx_t n, const float* x, float radius,
@@ -196,7 +196,7 @@ void IndexPreTransform::range_search (idx_t n, const float* x, float radius,
     FAISS_THROW_IF_NOT (is_trained);
     const float *xt = apply_chain (n, x);
     ScopeDeleter<float> del(xt == x ? nullptr : xt);
-    index->range_search (n, xt, radius, result);
+    index->range_search (n, xt, radius, result, bitset);
 }
 
 
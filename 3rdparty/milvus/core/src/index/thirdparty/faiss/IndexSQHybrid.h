@@ -30,6 +30,9 @@ struct IndexIVFSQHybrid: IndexIVF {
     ScalarQuantizer sq;
     bool by_residual;
 
+    /// for the integer scan of the lists, see ScalarQuantizer
+    SQCodeNorms code_norms;
+
     IndexIVFSQHybrid(Index *quantizer, size_t d, size_t nlist,
                             QuantizerType qtype,
                             MetricType metric = METRIC_L2,
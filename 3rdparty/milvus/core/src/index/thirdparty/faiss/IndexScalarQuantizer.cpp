@@ -294,7 +294,7 @@ InvertedListScanner* IndexIVFScalarQuantizer::get_InvertedListScanner
     (bool store_pairs) const
 {
     return sq.select_InvertedListScanner (metric_type, quantizer, store_pairs,
-                                          by_residual);
+                                          by_residual, invlists, &code_norms);
 }
 
 
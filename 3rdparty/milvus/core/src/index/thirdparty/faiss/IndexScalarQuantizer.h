@@ -93,6 +93,9 @@ struct IndexIVFScalarQuantizer: IndexIVF {
     ScalarQuantizer sq;
     bool by_residual;
 
+    /// for the integer scan of the lists, see ScalarQuantizer
+    SQCodeNorms code_norms;
+
     IndexIVFScalarQuantizer(Index *quantizer, size_t d, size_t nlist,
                             QuantizerType qtype,
                             MetricType metric = METRIC_L2,
@@ -430,6 +430,99 @@ bool ReadOnlyArrayInvertedLists::is_readonly() const {
     return true;
 }
 
+/*****************************************************************
+ * BlockInvertedLists implementations
+ *****************************************************************/
+
+BlockInvertedLists::BlockInvertedLists (size_t nlist, size_t code_size,
+                                        size_t n_per_block):
+    InvertedLists (nlist, code_size),
+    n_per_block (n_per_block), block_size (n_per_block * code_size)
+{
+    ids.resize (nlist);
+    codes.resize (nlist);
+}
+
+size_t BlockInvertedLists::list_size (size_t list_no) const
+{
+    assert (list_no < nlist);
+    return ids[list_no].size();
+}
+
+const uint8_t * BlockInvertedLists::get_codes (size_t list_no) const
+{
+    assert (list_no < nlist);
+    return codes[list_no].data();
+}
+
+const InvertedLists::idx_t * BlockInvertedLists::get_ids (size_t list_no) const
+{
+    assert (list_no < nlist);
+    return ids[list_no].data();
+}
+
+const uint8_t * BlockInvertedLists::get_single_code (
+            size_t list_no, size_t offset) const
+{
+    assert (offset < list_size (list_no));
+    const uint8_t *block = codes[list_no].data() +
+        (offset / n_per_block) * block_size + offset % n_per_block;
+    uint8_t *code = new uint8_t [code_size];
+    for (size_t b = 0; b < code_size; b++) {
+        code[b] = block[b * n_per_block];
+    }
+    return code;
+}
+
+void BlockInvertedLists::release_codes (size_t list_no,
+                                        const uint8_t *codes_in) const
+{
+    // only the copies of get_single_code are owned by the caller
+    if (codes_in != codes[list_no].data()) {
+        delete [] codes_in;
+    }
+}
+
+size_t BlockInvertedLists::add_entries (
+           size_t list_no, size_t n_entry,
+           const idx_t* ids_in, const uint8_t *code)
+{
+    if (n_entry == 0) return 0;
+    assert (list_no < nlist);
+    size_t o = ids [list_no].size();
+    resize (list_no, o + n_entry);
+    update_entries (list_no, o, n_entry, ids_in, code);
+    return o;
+}
+
+void BlockInvertedLists::update_entries (
+      size_t list_no, size_t offset, size_t n_entry,
+      const idx_t *ids_in, const uint8_t *codes_in)
+{
+    assert (list_no < nlist);
+    assert (n_entry + offset <= ids[list_no].size());
+    memcpy (&ids[list_no][offset], ids_in, sizeof(ids_in[0]) * n_entry);
+    uint8_t *packed = codes[list_no].data();
+    for (size_t i = 0; i < n_entry; i++) {
+        size_t j = offset + i;
+        uint8_t *block = packed + (j / n_per_block) * block_size + j % n_per_block;
+        for (size_t b = 0; b < code_size; b++) {
+            block[b * n_per_block] = codes_in[i * code_size + b];
+        }
+    }
+}
+
+void BlockInvertedLists::resize (size_t list_no, size_t new_size)
+{
+    ids[list_no].resize (new_size);
+    size_t nblock = (new_size + n_per_block - 1) / n_per_block;
+    // stale bytes in the padding of the last block are never returned
+    codes[list_no].resize (nblock * block_size, 0);
+}
+
+BlockInvertedLists::~BlockInvertedLists ()
+{}
+
 /*****************************************************************
  * Meta-inverted list implementations
  *****************************************************************/
@@ -276,6 +276,43 @@ struct ReadOnlyArrayInvertedLists: InvertedLists {
 
     bool is_valid();
 };
+
+/** Inverted lists storing the codes in blocks of n_per_block vectors,
+ * byte b of the codes of the vectors of a block are contiguous:
+ *
+ *   codes[list][blk * block_size + b * n_per_block + j] = code(blk * n_per_block + j)[b]
+ *
+ * get_codes returns the packed blocks, the last block is padded with 0s.
+ * get_single_code returns an unpacked copy, freed by release_codes.
+ */
+struct BlockInvertedLists: InvertedLists {
+    size_t n_per_block;   ///< vectors per block
+    size_t block_size;    ///< bytes per block, n_per_block * code_size
+
+    std::vector < std::vector<uint8_t> > codes;
+    std::vector < std::vector<idx_t> > ids;
+
+    BlockInvertedLists (size_t nlist, size_t code_size, size_t n_per_block = 32);
+
+    size_t list_size(size_t list_no) const override;
+    const uint8_t * get_codes (size_t list_no) const override;
+    const idx_t * get_ids (size_t list_no) const override;
+
+    const uint8_t * get_single_code (
+           size_t list_no, size_t offset) const override;
+    void release_codes (size_t list_no, const uint8_t *codes) const override;
+
+    size_t add_entries (
+           size_t list_no, size_t n_entry,
+           const idx_t* ids, const uint8_t *code) override;
+
+    void update_entries (size_t list_no, size_t offset, size_t n_entry,
+                         const idx_t *ids, const uint8_t *code) override;
+
+    void resize (size_t list_no, size_t new_size) override;
+
+    virtual ~BlockInvertedLists ();
+};
 /*****************************************************************
  * Meta-inverted lists
  *
@@ -23,6 +23,8 @@
 
 namespace faiss {
 
+#define INVALID_OFFSET (size_t)(-1)
+
 
 /**********************************************
  * LockLevels
@@ -151,6 +153,9 @@ struct OnDiskInvertedLists::OngoingPrefetch {
             if(list_no == -1) return false;
             const OnDiskInvertedLists *od = pf->od;
             od->locks->lock_1 (list_no);
+            // ask the kernel to read the whole list asynchronously, so the
+            // page touching below and the scanners do not fault page by page
+            od->advise_willneed (list_no);
             size_t n = od->list_size (list_no);
             const Index::idx_t *idx = od->get_ids (list_no);
             const uint8_t *codes = od->get_codes (list_no);
@@ -225,13 +230,17 @@ struct OnDiskInvertedLists::OngoingPrefetch {
         int nt = std::min (n, od->prefetch_nthread);
 
         if (nt > 0) {
-            // prepare tasks
+            // prepare tasks in probe order, a list probed by several
+            // queries of the batch is fetched once
+            std::unordered_set<idx_t> seen;
             for (int i = 0; i < n; i++) {
                 idx_t list_no = list_nos[i];
-                if (list_no >= 0 && od->list_size(list_no) > 0) {
+                if (list_no >= 0 && od->list_size(list_no) > 0 &&
+                    seen.insert (list_no).second) {
                     list_ids.push_back (list_no);
                 }
             }
+            nt = std::min (nt, (int)list_ids.size ());
             // prepare threads
             threads.resize (nt);
             for (Thread &th: threads) {
@@ -262,6 +271,18 @@ void OnDiskInvertedLists::prefetch_lists (const idx_t *list_nos, int n) const
     pf->prefetch_lists (list_nos, n);
 }
 
+void OnDiskInvertedLists::advise_willneed (size_t list_no) const
+{
+    const List & l = lists[list_no];
+    if (ptr == nullptr || l.offset == INVALID_OFFSET || l.capacity == 0) {
+        return;
+    }
+    size_t page = sysconf (_SC_PAGESIZE);
+    size_t begin = l.offset / page * page;
+    size_t end = l.offset + l.capacity * (code_size + sizeof (idx_t));
+    madvise (ptr + begin, end - begin, MADV_WILLNEED);
+}
+
 
 
 /**********************************************
@@ -339,8 +360,6 @@ void OnDiskInvertedLists::update_totsize (size_t new_size)
  * OnDiskInvertedLists
  **********************************************/
 
-#define INVALID_OFFSET (size_t)(-1)
-
 OnDiskInvertedLists::List::List ():
     size (0), capacity (0), offset (INVALID_OFFSET)
 {}
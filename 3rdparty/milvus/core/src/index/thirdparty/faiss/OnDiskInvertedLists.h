@@ -100,6 +100,9 @@ struct OnDiskInvertedLists: InvertedLists {
 
     void prefetch_lists (const idx_t *list_nos, int nlist) const override;
 
+    /// start an asynchronous kernel read of the pages of a list
+    void advise_willneed (size_t list_no) const;
+
     virtual ~OnDiskInvertedLists ();
 
     // private
@@ -607,6 +607,29 @@ void PCAMatrix::prepare_Ab ()
 
 }
 
+void PCAMatrix::reverse_transform (idx_t n, const float * xt,
+                                   float *x) const
+{
+    FAISS_THROW_IF_NOT_MSG (is_orthonormal,
+        "reverse transform not implemented for non-orthonormal matrices");
+
+    // A^T (xt - b) would only restore the projection of the mean on
+    // the output components when d_out < d_in
+    {
+        FINTEGER dii = d_in, doi = d_out, ni = n;
+        float one = 1.0, zero = 0.0;
+        sgemm_ ("Not", "Not", &dii, &ni, &doi,
+                &one, A.data (), &dii, xt, &doi, &zero, x, &dii);
+    }
+    if (!mean.empty()) {
+        for (idx_t i = 0; i < n; i++) {
+            for (int j = 0; j < d_in; j++) {
+                x[i * d_in + j] += mean[j];
+            }
+        }
+    }
+}
+
 /*********************************************
  * ITQMatrix
  *********************************************/
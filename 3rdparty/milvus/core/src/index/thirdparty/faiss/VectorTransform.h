@@ -175,6 +175,10 @@ struct PCAMatrix: LinearTransform {
     /// called after mean, PCAMat and eigenvalues are computed
     void prepare_Ab();
 
+    /// restores the mean, the reconstruction is mean + A^T xt
+    void reverse_transform (idx_t n, const float * xt,
+                            float *x) const override;
+
 };
 
 
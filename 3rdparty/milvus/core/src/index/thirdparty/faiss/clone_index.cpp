@@ -21,6 +21,7 @@
 #include <faiss/IndexPQ.h>
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
+#include <faiss/IndexIVFPQFastScan.h>
 #include <faiss/IndexIVFPQR.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
@@ -71,6 +72,7 @@ VectorTransform *Cloner::clone_VectorTransform (const VectorTransform *vt)
 IndexIVF * Cloner::clone_IndexIVF (const IndexIVF *ivf)
 {
     TRYCLONE (IndexIVFPQR, ivf)
+    TRYCLONE (IndexIVFPQFastScan, ivf)
     TRYCLONE (IndexIVFPQ, ivf)
     TRYCLONE (IndexIVFFlat, ivf)
     TRYCLONE (IndexIVFScalarQuantizer, ivf)
@@ -106,6 +108,9 @@ Index *Cloner::clone_Index (const Index *index)
         } else if (auto *ails = dynamic_cast<const ReadOnlyArrayInvertedLists*>(ivf->invlists)) {
             res->invlists = new ReadOnlyArrayInvertedLists(*ails);
             res->own_invlists = true;
+        } else if (auto *bils = dynamic_cast<const BlockInvertedLists*>(ivf->invlists)) {
+            res->invlists = new BlockInvertedLists(*bils);
+            res->own_invlists = true;
         } else {
             FAISS_THROW_MSG( "clone not supported for this type of inverted lists");
         }
@@ -116,6 +121,10 @@ Index *Cloner::clone_Index (const Index *index)
                dynamic_cast<const IndexPreTransform*> (index)) {
         IndexPreTransform *res = new IndexPreTransform ();
         res->d = ipt->d;
+        res->ntotal = ipt->ntotal;
+        res->is_trained = ipt->is_trained;
+        res->metric_type = ipt->metric_type;
+        res->metric_arg = ipt->metric_arg;
         res->index = clone_Index (ipt->index);
         for (int i = 0; i < ipt->chain.size(); i++)
             res->chain.push_back (clone_VectorTransform (ipt->chain[i]));
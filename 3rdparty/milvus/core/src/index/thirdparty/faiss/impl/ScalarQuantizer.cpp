@@ -17,6 +17,7 @@
 #include <faiss/utils/utils.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/impl/ScalarQuantizerCodec.h>
+#include <faiss/impl/sq8_int_scan.h>
 
 namespace faiss {
 
@@ -129,7 +130,7 @@ void ScalarQuantizer::train_residual(size_t n,
 Quantizer *ScalarQuantizer::select_quantizer () const
 {
     /* use hook to decide use AVX512 or not */
-    sq_sel_quantizer(qtype, d, trained);
+    return sq_sel_quantizer(qtype, d, trained);
 }
 
 
@@ -209,6 +210,10 @@ struct IVFSQScannerIP: InvertedListScanner {
         return accu0 + dc.query_to_code (code);
     }
 
+    bool exact_distance_to_code () const final {
+        return true;
+    }
+
     size_t scan_codes (size_t list_size,
                        const uint8_t *codes,
                        const idx_t *ids,
@@ -297,6 +302,10 @@ struct IVFSQScannerL2: InvertedListScanner {
         return dc.query_to_code (code);
     }
 
+    bool exact_distance_to_code () const final {
+        return true;
+    }
+
     size_t scan_codes (size_t list_size,
                        const uint8_t *codes,
                        const idx_t *ids,
@@ -338,6 +347,210 @@ struct IVFSQScannerL2: InvertedListScanner {
     }
 };
 
+/* a component of an 8-bit code decodes to offset + scale * code */
+void sq8_scale_offset (const ScalarQuantizer *sq,
+                       std::vector<float> & scale, std::vector<float> & offset)
+{
+    bool uniform = sq->qtype == QuantizerType::QT_8bit_uniform;
+    scale.resize (sq->d);
+    offset.resize (sq->d);
+    for (size_t i = 0; i < sq->d; i++) {
+        float vmin = uniform ? sq->trained[0] : sq->trained[i];
+        float vdiff = uniform ? sq->trained[1] : sq->trained[sq->d + i];
+        scale[i] = vdiff / 255.0f;
+        offset[i] = vmin + 0.5f * scale[i];
+    }
+}
+
+
+/* Scanner of 8-bit codes in the integer domain, see sq8_int_scan.h.
+ *
+ * The distance of a code is estimated from its integer dot product with the
+ * quantized weights, with a bound of the error. Only the codes that may enter
+ * the heap given the bound are passed to the float scanner, so that the
+ * results are those of the float scanner. The L2 distance
+ * |p - scale * c|^2 = |p|^2 - 2 <p * scale, c> + |scale * c|^2, with p the
+ * query (or its residual) less the offsets, takes the norms of the codes of
+ * the scanned list from SQCodeNorms.
+ */
+struct IVFSQ8IntScanner: InvertedListScanner {
+    std::unique_ptr<InvertedListScanner> exact;
+    size_t d;
+    bool store_pairs, by_residual, is_ip;
+    const Index *quantizer;
+    const InvertedLists *invlists;
+    const ScalarQuantizer *sq;
+    const SQCodeNorms *code_norms;
+
+    std::vector<float> scale, offset;
+
+    const float *x;     /// current query
+    idx_t list_no;
+    float accu0;        /// IP: coarse term + <q, offset>, L2: |p|^2
+    float wscale;       /// the dot product is (128 * dot_hi + dot_lo) * wscale
+    float margin;       /// bound of the error of the dot product
+    float qoffset;      /// IP: <q, offset>
+    float qabs;         /// IP: bound of the sum of the absolute products
+    float eps;          /// relative error of the float distances
+
+    std::vector<float> tmp;
+    std::vector<int8_t> w_hi, w_lo;
+    std::shared_ptr<const std::vector<float>> list_norms;
+    mutable std::vector<int32_t> dot_hi, dot_lo;
+
+    IVFSQ8IntScanner (InvertedListScanner *exact, const ScalarQuantizer *sq,
+                      MetricType mt, const Index *quantizer,
+                      bool store_pairs, bool by_residual,
+                      const InvertedLists *invlists,
+                      const SQCodeNorms *code_norms):
+        exact (exact), d (sq->d), store_pairs (store_pairs),
+        by_residual (by_residual), is_ip (mt == METRIC_INNER_PRODUCT),
+        quantizer (quantizer), invlists (invlists), sq (sq),
+        code_norms (code_norms), x (nullptr), list_no (0),
+        accu0 (0), wscale (0), margin (0), qoffset (0), qabs (0),
+        eps (1.2e-7f * (sq->d + 8)), tmp (sq->d)
+    {
+        sq8_scale_offset (sq, scale, offset);
+        size_t dpad = (d + sq8_weight_block - 1) / sq8_weight_block * sq8_weight_block;
+        w_hi.resize (dpad, 0);
+        w_lo.resize (dpad, 0);
+    }
+
+    /// weights of the components of p, quantized to 14 bits
+    void set_weights (const float *p) {
+        float wmax = 0;
+        for (size_t i = 0; i < d; i++) {
+            wmax = std::max (wmax, std::abs (p[i] * scale[i]));
+        }
+        const int wbound = 2 * sq8_weight_bound * sq8_weight_bound;
+        float a = wmax > 0 ? wbound / wmax : 0;
+        wscale = wmax > 0 ? wmax / wbound : 0;
+        margin = 0;
+        for (size_t i = 0; i < d; i++) {
+            float w = p[i] * scale[i];
+            int wq = std::min (wbound, std::max (-wbound, (int)std::lrint (w * a)));
+            int hi = (int)std::floor ((wq + 64) / 128.0);
+            w_hi[i] = hi;
+            w_lo[i] = wq - 128 * hi;
+            margin += std::abs (w - wq * wscale) * 255;
+        }
+    }
+
+    void set_query (const float *query) override {
+        exact->set_query (query);
+        x = query;
+        if (is_ip) {
+            // the weights do not depend on the list
+            set_weights (query);
+            qoffset = 0;
+            qabs = 0;
+            for (size_t i = 0; i < d; i++) {
+                qoffset += query[i] * offset[i];
+                qabs += std::abs (query[i]) *
+                    (std::abs (offset[i]) + 255 * std::abs (scale[i]));
+            }
+            // the flat index does not set a list
+            accu0 = qoffset;
+        }
+    }
+
+    void set_list (idx_t list_no, float coarse_dis) override {
+        exact->set_list (list_no, coarse_dis);
+        this->list_no = list_no;
+        if (is_ip) {
+            accu0 = (by_residual ? coarse_dis : 0) + qoffset;
+            return;
+        }
+        list_norms = code_norms->get (*sq, invlists, list_no);
+        if (by_residual) {
+            quantizer->Index::compute_residual (x, tmp.data(), list_no);
+        } else {
+            memcpy (tmp.data(), x, d * sizeof (float));
+        }
+        accu0 = 0;
+        for (size_t i = 0; i < d; i++) {
+            tmp[i] -= offset[i];
+            accu0 += tmp[i] * tmp[i];
+        }
+        set_weights (tmp.data());
+    }
+
+    float distance_to_code (const uint8_t *code) const override {
+        return exact->distance_to_code (code);
+    }
+
+    bool exact_distance_to_code () const override {
+        return exact->exact_distance_to_code ();
+    }
+
+    size_t scan_codes (size_t list_size,
+                       const uint8_t *codes,
+                       const idx_t *ids,
+                       float *simi, idx_t *idxi,
+                       size_t k,
+                       ConcurrentBitsetPtr bitset) const override
+    {
+        // the norms are those of the whole list, the codes may be compacted
+        if (!is_ip && (!list_norms || list_norms->size () != list_size)) {
+            return exact->scan_codes (list_size, codes, ids, simi, idxi, k, bitset);
+        }
+
+        const size_t bs = 256;
+        dot_hi.resize (bs);
+        dot_lo.resize (bs);
+        size_t nup = 0;
+        for (size_t j0 = 0; j0 < list_size; j0 += bs) {
+            size_t j1 = std::min (list_size, j0 + bs);
+            sq8_dot (codes + j0 * d, j1 - j0, d, w_hi.data(), w_lo.data(),
+                     dot_hi.data(), dot_lo.data());
+            for (size_t j = j0; j < j1; j++) {
+                if (bitset && bitset->test (ids[j])) {
+                    continue;
+                }
+                float dot = (128.0f * dot_hi[j - j0] + dot_lo[j - j0]) * wscale;
+                const uint8_t *code = codes + j * d;
+                if (is_ip) {
+                    float accu = accu0 + dot;
+                    if (accu + margin + eps * (qabs + std::abs (accu0)) <= simi[0]) {
+                        continue;
+                    }
+                    accu = exact->distance_to_code (code);
+                    if (accu > simi[0]) {
+                        int64_t id = store_pairs ? (list_no << 32 | j) : ids[j];
+                        minheap_swap_top (k, simi, idxi, accu, id);
+                        nup++;
+                    }
+                } else {
+                    float norm = (*list_norms)[j];
+                    float dis = accu0 + norm - 2 * dot;
+                    float bound = 2 * margin + eps * (accu0 + norm + 2 * std::abs (dot) + 2 * margin);
+                    if (dis - bound >= simi[0]) {
+                        continue;
+                    }
+                    dis = exact->distance_to_code (code);
+                    if (dis < simi[0]) {
+                        int64_t id = store_pairs ? (list_no << 32 | j) : ids[j];
+                        maxheap_swap_top (k, simi, idxi, dis, id);
+                        nup++;
+                    }
+                }
+            }
+        }
+        return nup;
+    }
+
+    void scan_codes_range (size_t list_size,
+                           const uint8_t *codes,
+                           const idx_t *ids,
+                           float radius,
+                           RangeQueryResult & res,
+                           ConcurrentBitsetPtr bitset = nullptr) const override
+    {
+        exact->scan_codes_range (list_size, codes, ids, radius, res, bitset);
+    }
+};
+
+
 template<class DCClass>
 InvertedListScanner* sel2_InvertedListScanner
       (const ScalarQuantizer *sq,
@@ -431,18 +644,83 @@ InvertedListScanner* sel0_InvertedListScanner
 
 InvertedListScanner* ScalarQuantizer::select_InvertedListScanner
         (MetricType mt, const Index *quantizer,
-         bool store_pairs, bool by_residual) const
+         bool store_pairs, bool by_residual,
+         const InvertedLists *invlists, const SQCodeNorms *code_norms) const
 {
+    InvertedListScanner *scanner;
     if (d % 16 == 0 && support_avx512()) {
-        return sel0_InvertedListScanner<16>
+        scanner = sel0_InvertedListScanner<16>
                 (mt, this, quantizer, store_pairs, by_residual);
-    } if (d % 8 == 0) {
-        return sel0_InvertedListScanner<8>
+    } else if (d % 8 == 0) {
+        scanner = sel0_InvertedListScanner<8>
             (mt, this, quantizer, store_pairs, by_residual);
     } else {
-        return sel0_InvertedListScanner<1>
+        scanner = sel0_InvertedListScanner<1>
             (mt, this, quantizer, store_pairs, by_residual);
     }
+
+    bool int8 = qtype == QuantizerType::QT_8bit ||
+                qtype == QuantizerType::QT_8bit_uniform;
+    bool has_norms = invlists && code_norms && (quantizer || !by_residual);
+    if (sq8_dot && int8 &&
+        (mt == METRIC_INNER_PRODUCT || (mt == METRIC_L2 && has_norms))) {
+        return new IVFSQ8IntScanner (scanner, this, mt, quantizer, store_pairs,
+                                     by_residual, invlists, code_norms);
+    }
+    return scanner;
+}
+
+
+SQCodeNorms & SQCodeNorms::operator = (const SQCodeNorms &)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+    invlists = nullptr;
+    lists.clear ();
+    return *this;
+}
+
+std::shared_ptr<const std::vector<float>> SQCodeNorms::get
+        (const ScalarQuantizer &sq, const InvertedLists *il,
+         size_t list_no) const
+{
+    size_t list_size = il->list_size (list_no);
+    InvertedLists::ScopedCodes codes (il, list_no);
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        if (invlists != il) {
+            invlists = il;
+            lists.clear ();
+        }
+        if (lists.size () < il->nlist) {
+            lists.resize (il->nlist);
+        }
+        const Entry & entry = lists[list_no];
+        if (entry.norms && entry.codes == codes.get () &&
+            entry.norms->size () == list_size) {
+            return entry.norms;
+        }
+    }
+
+    // computed out of the lock, the scanners of a list may compute it together
+    std::vector<float> scale, offset;
+    sq8_scale_offset (&sq, scale, offset);
+    auto norms = std::make_shared<std::vector<float>> (list_size);
+    for (size_t j = 0; j < list_size; j++) {
+        const uint8_t *code = codes.get () + j * sq.code_size;
+        float norm = 0;
+        for (size_t i = 0; i < sq.d; i++) {
+            float y = scale[i] * code[i];
+            norm += y * y;
+        }
+        (*norms)[j] = norm;
+    }
+
+    std::lock_guard<std::mutex> lock (mutex);
+    if (invlists == il) {
+        lists[list_no].codes = codes.get ();
+        lists[list_no].norms = norms;
+    }
+    return norms;
 }
 
 
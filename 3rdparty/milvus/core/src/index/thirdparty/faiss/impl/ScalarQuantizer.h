@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+
 #include <faiss/IndexIVF.h>
 #include <faiss/impl/ScalarQuantizerOp.h>
 
@@ -21,6 +24,34 @@ namespace faiss {
  * (default).
  */
 
+struct ScalarQuantizer;
+
+/** Squared norms of the 8-bit codes of the inverted lists, the components
+ * decoded without the offset of the quantizer. They are the part of the L2
+ * distances that does not depend on the query, for the integer scan of the
+ * lists. The norms of a list are computed when it is first scanned, and again
+ * when its codes moved or its size changed. A copy starts empty.
+ */
+struct SQCodeNorms {
+    SQCodeNorms () {}
+    SQCodeNorms (const SQCodeNorms &) {}
+    SQCodeNorms & operator = (const SQCodeNorms &);
+
+    std::shared_ptr<const std::vector<float>> get (const ScalarQuantizer &sq,
+                                                   const InvertedLists *invlists,
+                                                   size_t list_no) const;
+
+  private:
+    struct Entry {
+        const uint8_t *codes = nullptr;
+        std::shared_ptr<const std::vector<float>> norms;
+    };
+
+    mutable std::mutex mutex;
+    mutable const InvertedLists *invlists = nullptr;
+    mutable std::vector<Entry> lists;
+};
+
 struct ScalarQuantizer {
 
     QuantizerType qtype;
@@ -72,9 +103,12 @@ struct ScalarQuantizer {
     SQDistanceComputer *get_distance_computer (MetricType metric = METRIC_L2)
         const;
 
+    /** the 8-bit codes are scanned in the integer domain when a kernel is
+     * available, for L2 only if the lists and their norms are given */
     InvertedListScanner *select_InvertedListScanner
         (MetricType mt, const Index *quantizer, bool store_pairs,
-         bool by_residual=false) const;
+         bool by_residual=false, const InvertedLists *invlists=nullptr,
+         const SQCodeNorms *code_norms=nullptr) const;
 
 };
 
@@ -27,6 +27,7 @@
 #include <faiss/IndexPQ.h>
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
+#include <faiss/IndexIVFPQFastScan.h>
 #include <faiss/IndexIVFPQR.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
@@ -243,6 +244,17 @@ InvertedLists *read_InvertedLists (IOReader *f, int io_flags) {
             }
         }
         return ails;
+    } else if (h == fourcc ("ilbl")) {
+        size_t nlist, code_size, n_per_block;
+        READ1 (nlist);
+        READ1 (code_size);
+        READ1 (n_per_block);
+        auto bils = new BlockInvertedLists (nlist, code_size, n_per_block);
+        for (size_t i = 0; i < nlist; i++) {
+            READVECTOR (bils->ids[i]);
+            READVECTOR (bils->codes[i]);
+        }
+        return bils;
     } else if (h == fourcc ("ilar") && (io_flags & IO_FLAG_MMAP)) {
         // then we load it as an OnDiskInvertedLists
 
@@ -624,6 +636,14 @@ Index *read_index (IOReader *f, int io_flags) {
 
         idx = read_ivfpq (f, h, io_flags);
 
+    } else if(h == fourcc ("IwPf")) {
+        IndexIVFPQFastScan * ivpf = new IndexIVFPQFastScan ();
+        read_ivf_header (ivpf, f);
+        READ1 (ivpf->by_residual);
+        READ1 (ivpf->code_size);
+        read_ProductQuantizer (&ivpf->pq, f);
+        read_InvertedLists (ivpf, f, io_flags);
+        idx = ivpf;
     } else if(h == fourcc ("IxPT")) {
         IndexPreTransform * ixpt = new IndexPreTransform();
         ixpt->own_fields = true;
@@ -27,6 +27,7 @@
 #include <faiss/IndexPQ.h>
 #include <faiss/IndexIVF.h>
 #include <faiss/IndexIVFPQ.h>
+#include <faiss/IndexIVFPQFastScan.h>
 #include <faiss/IndexIVFPQR.h>
 #include <faiss/Index2Layer.h>
 #include <faiss/IndexIVFFlat.h>
@@ -276,6 +277,17 @@ void write_InvertedLists (const InvertedLists *ils, IOWriter *f) {
         }
         WRITE1(od->totsize);
 
+    } else if (const auto & bils =
+               dynamic_cast<const BlockInvertedLists *>(ils)) {
+        uint32_t h = fourcc ("ilbl");
+        WRITE1 (h);
+        WRITE1 (bils->nlist);
+        WRITE1 (bils->code_size);
+        WRITE1 (bils->n_per_block);
+        for (size_t i = 0; i < bils->nlist; i++) {
+            WRITEVECTOR (bils->ids[i]);
+            WRITEVECTOR (bils->codes[i]);
+        }
     } else {
         fprintf(stderr, "WARN! write_InvertedLists: unsupported invlist type, "
                 "saving null invlist\n");
@@ -424,6 +436,15 @@ void write_index (const Index *idx, IOWriter *f) {
         WRITE1 (ivsp->threshold_type);
         WRITEVECTOR (ivsp->trained);
         write_InvertedLists (ivsp->invlists, f);
+    } else if(const IndexIVFPQFastScan * ivpf =
+              dynamic_cast<const IndexIVFPQFastScan *> (idx)) {
+        uint32_t h = fourcc ("IwPf");
+        WRITE1 (h);
+        write_ivf_header (ivpf, f);
+        WRITE1 (ivpf->by_residual);
+        WRITE1 (ivpf->code_size);
+        write_ProductQuantizer (&ivpf->pq, f);
+        write_InvertedLists (ivpf->invlists, f);
     } else if(const IndexIVFPQ * ivpq =
               dynamic_cast<const IndexIVFPQ *> (idx)) {
         const IndexIVFPQR * ivfpqr = dynamic_cast<const IndexIVFPQR *> (idx);
@@ -0,0 +1,34 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#include <faiss/impl/pq4_fast_scan.h>
+
+namespace faiss {
+
+void pq4_accumulate_ref (const uint8_t *codes, size_t nblock, size_t code_size,
+                         const uint8_t *lut, uint16_t *dis)
+{
+    for (size_t blk = 0; blk < nblock; blk++) {
+        uint16_t *d = dis + blk * pq4_block_size;
+        for (size_t j = 0; j < pq4_block_size; j++) {
+            d[j] = 0;
+        }
+        for (size_t b = 0; b < code_size; b++) {
+            const uint8_t *lo = lut + 32 * b;
+            const uint8_t *hi = lo + 16;
+            for (size_t j = 0; j < pq4_block_size; j++) {
+                uint8_t c = codes[j];
+                d[j] += lo[c & 15] + hi[c >> 4];
+            }
+            codes += pq4_block_size;
+        }
+    }
+}
+
+} // namespace faiss
@@ -0,0 +1,40 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+/* Fast scan of 4-bit PQ codes.
+ *
+ * The codes of a list are stored in blocks of pq4_block_size vectors by
+ * BlockInvertedLists: byte b of the 32 codes of a block is a 32-byte chunk,
+ * its low nibbles index sub-quantizer 2b and its high nibbles 2b + 1.
+ * With a distance table of 16 uint8 entries per sub-quantizer, the table of
+ * a sub-quantizer fits in a SIMD register and the 32 lookups of a chunk are
+ * a single shuffle. The lookups are accumulated in uint16.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/// vectors per block of the packed layout
+const size_t pq4_block_size = 32;
+
+/** accumulate the quantized distance tables over the blocks
+ *
+ * @param codes      packed codes, nblock * pq4_block_size * code_size bytes
+ * @param code_size  bytes per code, the tables cover 2 * code_size sub-quantizers
+ * @param lut        tables, 16 uint8 per sub-quantizer, size 32 * code_size
+ * @param dis        output sums, size nblock * pq4_block_size
+ */
+void pq4_accumulate_ref (const uint8_t *codes, size_t nblock, size_t code_size,
+                         const uint8_t *lut, uint16_t *dis);
+
+} // namespace faiss
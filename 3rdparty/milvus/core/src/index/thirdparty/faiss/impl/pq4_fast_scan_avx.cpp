@@ -0,0 +1,52 @@
+
+// -*- c++ -*-
+
+#include <faiss/impl/pq4_fast_scan_avx.h>
+#include <faiss/impl/pq4_fast_scan.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#ifdef __AVX2__
+
+void
+pq4_accumulate_avx(const uint8_t* codes, size_t nblock, size_t code_size, const uint8_t* lut, uint16_t* dis) {
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    for (size_t blk = 0; blk < nblock; blk++) {
+        // vectors 0..15 and 16..31 of the block
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        for (size_t b = 0; b < code_size; b++) {
+            __m256i c = _mm256_loadu_si256((const __m256i*)codes);
+            __m256i lo = _mm256_and_si256(c, low_mask);
+            __m256i hi = _mm256_and_si256(_mm256_srli_epi16(c, 4), low_mask);
+            // the 16-entry tables are repeated in both 128-bit lanes
+            __m256i tlo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(lut + 32 * b)));
+            __m256i thi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(lut + 32 * b + 16)));
+            __m256i dlo = _mm256_shuffle_epi8(tlo, lo);
+            __m256i dhi = _mm256_shuffle_epi8(thi, hi);
+            // widen before adding, two uint8 entries may exceed 255
+            acc0 = _mm256_add_epi16(acc0, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(dlo)));
+            acc0 = _mm256_add_epi16(acc0, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(dhi)));
+            acc1 = _mm256_add_epi16(acc1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(dlo, 1)));
+            acc1 = _mm256_add_epi16(acc1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(dhi, 1)));
+            codes += pq4_block_size;
+        }
+        _mm256_storeu_si256((__m256i*)dis, acc0);
+        _mm256_storeu_si256((__m256i*)(dis + 16), acc1);
+        dis += pq4_block_size;
+    }
+}
+
+#else
+
+void
+pq4_accumulate_avx(const uint8_t* codes, size_t nblock, size_t code_size, const uint8_t* lut, uint16_t* dis) {
+    FAISS_ASSERT(false);
+}
+
+#endif
+
+} // namespace faiss
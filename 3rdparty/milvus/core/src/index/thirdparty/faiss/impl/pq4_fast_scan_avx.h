@@ -0,0 +1,18 @@
+
+// -*- c++ -*-
+
+/* AVX2 fast scan of 4-bit PQ codes.
+ * The actual functions are implemented in pq4_fast_scan_avx.cpp */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/// same as pq4_accumulate_ref, one 32-byte shuffle per byte of the codes
+void
+pq4_accumulate_avx(const uint8_t* codes, size_t nblock, size_t code_size, const uint8_t* lut, uint16_t* dis);
+
+} // namespace faiss
@@ -0,0 +1,71 @@
+
+// -*- c++ -*-
+
+#include <faiss/impl/pq4_fast_scan_avx512.h>
+#include <faiss/impl/pq4_fast_scan.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#if (defined(__AVX512F__) && defined(__AVX512BW__))
+
+namespace {
+
+// the 16-entry tables t0 in the two low 128-bit lanes, t1 in the two high ones
+inline __m512i load_tables (const uint8_t* t0, const uint8_t* t1) {
+    __m256i l0 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)t0));
+    __m256i l1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)t1));
+    return _mm512_inserti64x4(_mm512_castsi256_si512(l0), l1, 1);
+}
+
+} // namespace
+
+void
+pq4_accumulate_avx512(const uint8_t* codes, size_t nblock, size_t code_size, const uint8_t* lut, uint16_t* dis) {
+    const __m512i low_mask = _mm512_set1_epi8(0x0f);
+    const __m256i low_mask_256 = _mm256_set1_epi8(0x0f);
+    for (size_t blk = 0; blk < nblock; blk++) {
+        // the 32 vectors of the block
+        __m512i acc = _mm512_setzero_si512();
+        size_t b = 0;
+        // bytes b and b + 1 of the codes in a register
+        for (; b + 2 <= code_size; b += 2) {
+            __m512i c = _mm512_loadu_si512((const void*)codes);
+            __m512i lo = _mm512_and_si512(c, low_mask);
+            __m512i hi = _mm512_and_si512(_mm512_srli_epi16(c, 4), low_mask);
+            __m512i dlo = _mm512_shuffle_epi8(load_tables(lut + 32 * b, lut + 32 * b + 32), lo);
+            __m512i dhi = _mm512_shuffle_epi8(load_tables(lut + 32 * b + 16, lut + 32 * b + 48), hi);
+            // widen before adding, two uint8 entries may exceed 255
+            acc = _mm512_add_epi16(acc, _mm512_cvtepu8_epi16(_mm512_castsi512_si256(dlo)));
+            acc = _mm512_add_epi16(acc, _mm512_cvtepu8_epi16(_mm512_extracti64x4_epi64(dlo, 1)));
+            acc = _mm512_add_epi16(acc, _mm512_cvtepu8_epi16(_mm512_castsi512_si256(dhi)));
+            acc = _mm512_add_epi16(acc, _mm512_cvtepu8_epi16(_mm512_extracti64x4_epi64(dhi, 1)));
+            codes += 2 * pq4_block_size;
+        }
+        if (b < code_size) {
+            __m256i c = _mm256_loadu_si256((const __m256i*)codes);
+            __m256i lo = _mm256_and_si256(c, low_mask_256);
+            __m256i hi = _mm256_and_si256(_mm256_srli_epi16(c, 4), low_mask_256);
+            __m256i tlo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(lut + 32 * b)));
+            __m256i thi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(lut + 32 * b + 16)));
+            acc = _mm512_add_epi16(acc, _mm512_cvtepu8_epi16(_mm256_shuffle_epi8(tlo, lo)));
+            acc = _mm512_add_epi16(acc, _mm512_cvtepu8_epi16(_mm256_shuffle_epi8(thi, hi)));
+            codes += pq4_block_size;
+        }
+        _mm512_storeu_si512((void*)dis, acc);
+        dis += pq4_block_size;
+    }
+}
+
+#else
+
+void
+pq4_accumulate_avx512(const uint8_t* codes, size_t nblock, size_t code_size, const uint8_t* lut, uint16_t* dis) {
+    FAISS_ASSERT(false);
+}
+
+#endif
+
+} // namespace faiss
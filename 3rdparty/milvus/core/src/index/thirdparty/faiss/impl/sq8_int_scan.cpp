@@ -0,0 +1,30 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#include <faiss/impl/sq8_int_scan.h>
+
+namespace faiss {
+
+void sq8_dot_ref (const uint8_t *codes, size_t n, size_t d,
+                  const int8_t *w_hi, const int8_t *w_lo,
+                  int32_t *dot_hi, int32_t *dot_lo)
+{
+    for (size_t j = 0; j < n; j++) {
+        int32_t hi = 0, lo = 0;
+        for (size_t i = 0; i < d; i++) {
+            hi += codes[i] * w_hi[i];
+            lo += codes[i] * w_lo[i];
+        }
+        dot_hi[j] = hi;
+        dot_lo[j] = lo;
+        codes += d;
+    }
+}
+
+} // namespace faiss
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+/* Integer scan of 8-bit scalar quantizer codes.
+ *
+ * A component decodes to vmin + vdiff * (c + 0.5) / 255, so the inner
+ * product of a query with a decoded vector is a constant plus a dot product
+ * of the uint8 codes with weights derived from the query. The weights are
+ * quantized to 14 bits, split in two int8 halves such that
+ * w = 128 * w_hi + w_lo, and the two dot products are computed with
+ * u8 x s8 multiply-adds (pmaddubsw, vpdpbusd). With |w_hi|, |w_lo| <= 64
+ * the pairs summed by pmaddubsw do not saturate int16.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/// bound of the int8 halves of the weights
+const int sq8_weight_bound = 64;
+
+/// the weights are read by blocks of this many components, padded with 0
+const size_t sq8_weight_block = 64;
+
+/** dot products of the codes with the two halves of the weights
+ *
+ * @param codes   n codes of d bytes
+ * @param w_hi    high halves of the weights, d rounded up to sq8_weight_block
+ * @param w_lo    low halves of the weights, same size
+ * @param dot_hi  output dot products with w_hi, size n
+ * @param dot_lo  output dot products with w_lo, size n
+ */
+void sq8_dot_ref (const uint8_t *codes, size_t n, size_t d,
+                  const int8_t *w_hi, const int8_t *w_lo,
+                  int32_t *dot_hi, int32_t *dot_lo);
+
+} // namespace faiss
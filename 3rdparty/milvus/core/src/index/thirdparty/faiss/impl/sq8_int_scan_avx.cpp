@@ -0,0 +1,62 @@
+
+// -*- c++ -*-
+
+#include <faiss/impl/sq8_int_scan_avx.h>
+#include <faiss/impl/sq8_int_scan.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#ifdef __AVX2__
+
+namespace {
+
+inline int32_t reduce_add_epi32 (__m256i x) {
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(s);
+}
+
+} // namespace
+
+void
+sq8_dot_avx(const uint8_t* codes, size_t n, size_t d, const int8_t* w_hi, const int8_t* w_lo, int32_t* dot_hi,
+            int32_t* dot_lo) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    for (size_t j = 0; j < n; j++) {
+        __m256i acc_hi = _mm256_setzero_si256();
+        __m256i acc_lo = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 32 <= d; i += 32) {
+            __m256i c = _mm256_loadu_si256((const __m256i*)(codes + i));
+            __m256i h = _mm256_maddubs_epi16(c, _mm256_loadu_si256((const __m256i*)(w_hi + i)));
+            __m256i l = _mm256_maddubs_epi16(c, _mm256_loadu_si256((const __m256i*)(w_lo + i)));
+            acc_hi = _mm256_add_epi32(acc_hi, _mm256_madd_epi16(h, ones));
+            acc_lo = _mm256_add_epi32(acc_lo, _mm256_madd_epi16(l, ones));
+        }
+        int32_t hi = reduce_add_epi32(acc_hi);
+        int32_t lo = reduce_add_epi32(acc_lo);
+        for (; i < d; i++) {
+            hi += codes[i] * w_hi[i];
+            lo += codes[i] * w_lo[i];
+        }
+        dot_hi[j] = hi;
+        dot_lo[j] = lo;
+        codes += d;
+    }
+}
+
+#else
+
+void
+sq8_dot_avx(const uint8_t* codes, size_t n, size_t d, const int8_t* w_hi, const int8_t* w_lo, int32_t* dot_hi,
+            int32_t* dot_lo) {
+    FAISS_ASSERT(false);
+}
+
+#endif
+
+} // namespace faiss
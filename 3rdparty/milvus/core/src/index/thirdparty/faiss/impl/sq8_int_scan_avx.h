@@ -0,0 +1,19 @@
+
+// -*- c++ -*-
+
+/* AVX2 integer scan of 8-bit scalar quantizer codes.
+ * The actual functions are implemented in sq8_int_scan_avx.cpp */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/// same as sq8_dot_ref, 32 components per pmaddubsw
+void
+sq8_dot_avx(const uint8_t* codes, size_t n, size_t d, const int8_t* w_hi, const int8_t* w_lo, int32_t* dot_hi,
+            int32_t* dot_lo);
+
+} // namespace faiss
@@ -0,0 +1,83 @@
+
+// -*- c++ -*-
+
+#include <faiss/impl/sq8_int_scan_avx512.h>
+#include <faiss/impl/sq8_int_scan.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#if (defined(__AVX512F__) && defined(__AVX512BW__))
+
+namespace {
+
+// mask of the components left after the full 64-byte chunks
+inline __mmask64 tail_mask (size_t rest) {
+    return rest == 0 ? 0 : (~(__mmask64)0) >> (64 - rest);
+}
+
+} // namespace
+
+void
+sq8_dot_avx512(const uint8_t* codes, size_t n, size_t d, const int8_t* w_hi, const int8_t* w_lo, int32_t* dot_hi,
+               int32_t* dot_lo) {
+    const __m512i ones = _mm512_set1_epi16(1);
+    const size_t dfull = d / 64 * 64;
+    const __mmask64 mask = tail_mask(d - dfull);
+    for (size_t j = 0; j < n; j++) {
+        __m512i acc_hi = _mm512_setzero_si512();
+        __m512i acc_lo = _mm512_setzero_si512();
+        for (size_t i = 0; i < d; i += 64) {
+            __m512i c = i < dfull ? _mm512_loadu_si512((const void*)(codes + i))
+                                  : _mm512_maskz_loadu_epi8(mask, codes + i);
+            __m512i h = _mm512_maddubs_epi16(c, _mm512_loadu_si512((const void*)(w_hi + i)));
+            __m512i l = _mm512_maddubs_epi16(c, _mm512_loadu_si512((const void*)(w_lo + i)));
+            acc_hi = _mm512_add_epi32(acc_hi, _mm512_madd_epi16(h, ones));
+            acc_lo = _mm512_add_epi32(acc_lo, _mm512_madd_epi16(l, ones));
+        }
+        dot_hi[j] = _mm512_reduce_add_epi32(acc_hi);
+        dot_lo[j] = _mm512_reduce_add_epi32(acc_lo);
+        codes += d;
+    }
+}
+
+// vpdpbusd sums the four u8 x s8 products of each int32 lane into it, the intermediate products are not saturated
+__attribute__((target("avx512vnni"))) void
+sq8_dot_avx512_vnni(const uint8_t* codes, size_t n, size_t d, const int8_t* w_hi, const int8_t* w_lo,
+                    int32_t* dot_hi, int32_t* dot_lo) {
+    const size_t dfull = d / 64 * 64;
+    const __mmask64 mask = tail_mask(d - dfull);
+    for (size_t j = 0; j < n; j++) {
+        __m512i acc_hi = _mm512_setzero_si512();
+        __m512i acc_lo = _mm512_setzero_si512();
+        for (size_t i = 0; i < d; i += 64) {
+            __m512i c = i < dfull ? _mm512_loadu_si512((const void*)(codes + i))
+                                  : _mm512_maskz_loadu_epi8(mask, codes + i);
+            acc_hi = _mm512_dpbusd_epi32(acc_hi, c, _mm512_loadu_si512((const void*)(w_hi + i)));
+            acc_lo = _mm512_dpbusd_epi32(acc_lo, c, _mm512_loadu_si512((const void*)(w_lo + i)));
+        }
+        dot_hi[j] = _mm512_reduce_add_epi32(acc_hi);
+        dot_lo[j] = _mm512_reduce_add_epi32(acc_lo);
+        codes += d;
+    }
+}
+
+#else
+
+void
+sq8_dot_avx512(const uint8_t* codes, size_t n, size_t d, const int8_t* w_hi, const int8_t* w_lo, int32_t* dot_hi,
+               int32_t* dot_lo) {
+    FAISS_ASSERT(false);
+}
+
+void
+sq8_dot_avx512_vnni(const uint8_t* codes, size_t n, size_t d, const int8_t* w_hi, const int8_t* w_lo,
+                    int32_t* dot_hi, int32_t* dot_lo) {
+    FAISS_ASSERT(false);
+}
+
+#endif
+
+} // namespace faiss
@@ -0,0 +1,24 @@
+
+// -*- c++ -*-
+
+/* AVX512 integer scan of 8-bit scalar quantizer codes.
+ * The actual functions are implemented in sq8_int_scan_avx512.cpp */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/// same as sq8_dot_ref, 64 components per pmaddubsw
+void
+sq8_dot_avx512(const uint8_t* codes, size_t n, size_t d, const int8_t* w_hi, const int8_t* w_lo, int32_t* dot_hi,
+               int32_t* dot_lo);
+
+/// same as sq8_dot_ref, 64 components per vpdpbusd, for cpus with AVX512_VNNI
+void
+sq8_dot_avx512_vnni(const uint8_t* codes, size_t n, size_t d, const int8_t* w_hi, const int8_t* w_lo,
+                    int32_t* dot_hi, int32_t* dot_lo);
+
+} // namespace faiss
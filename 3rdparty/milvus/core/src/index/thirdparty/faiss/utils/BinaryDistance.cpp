@@ -9,7 +9,9 @@
 #include <limits.h>
 #include <omp.h>
 
+#include <faiss/FaissHook.h>
 #include <faiss/utils/Heap.h>
+#include <faiss/utils/ResultHandler.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/utils/utils.h>
 
@@ -18,6 +20,182 @@ namespace faiss {
 static const size_t size_1M = 1 * 1024 * 1024;
 static const size_t batch_size = 65536;
 
+/* tile sizes of the block kernels: the database block stays in L1/L2
+ * while every query of the tile is compared with it */
+static const size_t block_query_tile = 8;
+static const size_t block_code_tile = 256;
+
+template <class C, typename BlockFunc>
+static
+void binary_knn_hc_block(
+        BlockFunc block_func,
+        HeapArray<C> * ha,
+        const uint8_t * bs1,
+        const uint8_t * bs2,
+        size_t n2,
+        size_t bytes_per_code,
+        bool order,
+        ConcurrentBitsetPtr bitset)
+{
+    using T = typename C::T;
+    const size_t k = ha->k;
+    const size_t nh = ha->nh;
+    const size_t n_blocks = (n2 + block_code_tile - 1) / block_code_tile;
+
+    // distances of queries [i0, i1) to codes [j0, j1), pushed to the heaps in val / ids,
+    // the bitset is only checked for the codes that would enter a heap
+    auto scan_tile = [&](size_t i0, size_t i1, size_t j0, size_t j1, T * val, int64_t * ids, T * dis) {
+        const size_t nj = j1 - j0;
+        block_func(bs1 + i0 * bytes_per_code, i1 - i0, bs2 + j0 * bytes_per_code, nj, bytes_per_code, dis);
+        for (size_t i = i0; i < i1; i++) {
+            T * val_i = val + i * k;
+            int64_t * ids_i = ids + i * k;
+            const T * dis_i = dis + (i - i0) * nj;
+            for (size_t j = 0; j < nj; j++) {
+                if (dis_i[j] < val_i[0] && (!bitset || !bitset->test(j0 + j))) {
+                    faiss::maxheap_swap_top<T> (k, val_i, ids_i, dis_i[j], j0 + j);
+                }
+            }
+        }
+    };
+
+    int thread_max_num = omp_get_max_threads();
+
+    if (order && k >= reservoir_topk_threshold) {
+        // large k: the candidates go to reservoirs instead of heaps, same
+        // split of the work as below
+        typedef ReservoirTopK<C> Reservoir;
+        bool split_db = nh < thread_max_num;
+        std::vector<std::vector<Reservoir>> reservoirs (split_db ? thread_max_num : 1,
+                                                        std::vector<Reservoir> (nh, Reservoir (k)));
+
+        auto scan_tile_reservoir = [&](size_t i0, size_t i1, size_t j0, size_t j1, Reservoir * res, T * dis) {
+            const size_t nj = j1 - j0;
+            block_func(bs1 + i0 * bytes_per_code, i1 - i0, bs2 + j0 * bytes_per_code, nj, bytes_per_code, dis);
+            auto id_of = [&](size_t j) -> int64_t {
+                int64_t id = j0 + j;
+                return (bitset && bitset->test(id)) ? -1 : id;
+            };
+            for (size_t i = i0; i < i1; i++) {
+                res[i].add_batch(dis + (i - i0) * nj, nj, id_of);
+            }
+        };
+
+        if (split_db) {
+#pragma omp parallel for
+            for (size_t b = 0; b < n_blocks; b++) {
+                int thread_no = omp_get_thread_num();
+                T dis[block_query_tile * block_code_tile];
+                size_t j0 = b * block_code_tile;
+                size_t j1 = std::min(j0 + block_code_tile, n2);
+                for (size_t i0 = 0; i0 < nh; i0 += block_query_tile) {
+                    size_t i1 = std::min(i0 + block_query_tile, nh);
+                    scan_tile_reservoir(i0, i1, j0, j1, reservoirs[thread_no].data(), dis);
+                }
+            }
+        } else {
+#pragma omp parallel for
+            for (size_t i0 = 0; i0 < nh; i0 += block_query_tile) {
+                T dis[block_query_tile * block_code_tile];
+                size_t i1 = std::min(i0 + block_query_tile, nh);
+                for (size_t j0 = 0; j0 < n2; j0 += block_code_tile) {
+                    size_t j1 = std::min(j0 + block_code_tile, n2);
+                    scan_tile_reservoir(i0, i1, j0, j1, reservoirs[0].data(), dis);
+                }
+            }
+        }
+
+#pragma omp parallel for
+        for (size_t i = 0; i < nh; i++) {
+            for (size_t t = 1; t < reservoirs.size(); t++) {
+                reservoirs[0][i].merge(reservoirs[t][i]);
+            }
+            reservoirs[0][i].finalize(ha->val + i * k, ha->ids + i * k);
+        }
+        return;
+    }
+
+    if (nh < thread_max_num) {
+        // few queries: split the database, every thread keeps its own heaps
+        size_t thread_heap_size = nh * k;
+        std::vector<T> value(thread_heap_size * thread_max_num, C::neutral());
+        std::vector<int64_t> labels(thread_heap_size * thread_max_num, -1);
+
+#pragma omp parallel for
+        for (size_t b = 0; b < n_blocks; b++) {
+            int thread_no = omp_get_thread_num();
+            T dis[block_query_tile * block_code_tile];
+            size_t j0 = b * block_code_tile;
+            size_t j1 = std::min(j0 + block_code_tile, n2);
+            for (size_t i0 = 0; i0 < nh; i0 += block_query_tile) {
+                size_t i1 = std::min(i0 + block_query_tile, nh);
+                scan_tile(i0, i1, j0, j1, value.data() + thread_no * thread_heap_size,
+                          labels.data() + thread_no * thread_heap_size, dis);
+            }
+        }
+
+        for (size_t t = 1; t < thread_max_num; t++) {
+            // merge heap
+            for (size_t i = 0; i < nh; i++) {
+                T * __restrict value_x = value.data() + i * k;
+                int64_t * __restrict labels_x = labels.data() + i * k;
+                T *value_x_t = value_x + t * thread_heap_size;
+                int64_t *labels_x_t = labels_x + t * thread_heap_size;
+                for (size_t j = 0; j < k; j++) {
+                    if (value_x_t[j] < value_x[0]) {
+                        faiss::maxheap_swap_top<T> (k, value_x, labels_x, value_x_t[j], labels_x_t[j]);
+                    }
+                }
+            }
+        }
+
+        // copy result
+        memcpy(ha->val, value.data(), thread_heap_size * sizeof(T));
+        memcpy(ha->ids, labels.data(), thread_heap_size * sizeof(int64_t));
+
+    } else {
+        ha->heapify ();
+
+#pragma omp parallel for
+        for (size_t i0 = 0; i0 < nh; i0 += block_query_tile) {
+            T dis[block_query_tile * block_code_tile];
+            size_t i1 = std::min(i0 + block_query_tile, nh);
+            for (size_t j0 = 0; j0 < n2; j0 += block_code_tile) {
+                size_t j1 = std::min(j0 + block_code_tile, n2);
+                scan_tile(i0, i1, j0, j1, ha->val, ha->ids, dis);
+            }
+        }
+    }
+
+    if (order) ha->reorder ();
+}
+
+void hammings_knn_hc_block (
+        int_maxheap_array_t * ha,
+        const uint8_t * a,
+        const uint8_t * b,
+        size_t nb,
+        size_t ncodes,
+        int order,
+        ConcurrentBitsetPtr bitset)
+{
+    FAISS_ASSERT(binary_hamming_block != nullptr);
+    binary_knn_hc_block(binary_hamming_block, ha, a, b, nb, ncodes, order, bitset);
+}
+
+void jaccard_knn_hc_block (
+        float_maxheap_array_t * ha,
+        const uint8_t * a,
+        const uint8_t * b,
+        size_t nb,
+        size_t ncodes,
+        int order,
+        ConcurrentBitsetPtr bitset)
+{
+    FAISS_ASSERT(binary_jaccard_block != nullptr);
+    binary_knn_hc_block(binary_jaccard_block, ha, a, b, nb, ncodes, order, bitset);
+}
+
 template <class T>
 static
 void binary_distence_knn_hc(
@@ -134,6 +312,10 @@ void binary_distence_knn_hc (
     switch (metric_type) {
     case METRIC_Jaccard:
     case METRIC_Tanimoto:
+        if (binary_jaccard_block && ncodes >= binary_block_min_code_size) {
+            jaccard_knn_hc_block(ha, a, b, nb, ncodes, order, bitset);
+            break;
+        }
         switch (ncodes) {
 #define binary_distence_knn_hc_jaccard(ncodes) \
         case ncodes: \
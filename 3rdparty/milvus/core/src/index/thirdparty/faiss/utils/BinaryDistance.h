@@ -53,6 +53,28 @@ namespace faiss {
             int64_t *labels,
             ConcurrentBitsetPtr bitset);
 
+/** Same as hammings_knn_hc and binary_distence_knn_hc (Jaccard, Tanimoto),
+ * the distances are computed by the SIMD block kernels set up by hook_init,
+ * a tile of queries against a block of database codes at a time.
+ * Only to be called when binary_hamming_block / binary_jaccard_block is set. */
+    void hammings_knn_hc_block (
+            int_maxheap_array_t * ha,
+            const uint8_t * a,
+            const uint8_t * b,
+            size_t nb,
+            size_t ncodes,
+            int ordered,
+            ConcurrentBitsetPtr bitset = nullptr);
+
+    void jaccard_knn_hc_block (
+            float_maxheap_array_t * ha,
+            const uint8_t * a,
+            const uint8_t * b,
+            size_t nb,
+            size_t ncodes,
+            int ordered,
+            ConcurrentBitsetPtr bitset = nullptr);
+
 } // namespace faiss
 
 #include <faiss/utils/jaccard-inl.h>
@@ -0,0 +1,132 @@
+
+// -*- c++ -*-
+
+#include <faiss/utils/BinaryDistance_avx.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#ifdef __AVX2__
+
+namespace {
+
+// per 64-bit lane population count, nibble lookup (Mula)
+inline __m256i popcount256 (__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                  _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+// carry-save adder
+inline void csa (__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c) {
+    __m256i u = _mm256_xor_si256(a, b);
+    h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    l = _mm256_xor_si256(u, c);
+}
+
+struct OpXor {
+    inline __m256i operator() (__m256i a, __m256i b) const { return _mm256_xor_si256(a, b); }
+    inline uint64_t operator() (uint64_t a, uint64_t b) const { return a ^ b; }
+};
+
+struct OpAnd {
+    inline __m256i operator() (__m256i a, __m256i b) const { return _mm256_and_si256(a, b); }
+    inline uint64_t operator() (uint64_t a, uint64_t b) const { return a & b; }
+};
+
+struct OpOr {
+    inline __m256i operator() (__m256i a, __m256i b) const { return _mm256_or_si256(a, b); }
+    inline uint64_t operator() (uint64_t a, uint64_t b) const { return a | b; }
+};
+
+// population count of op(a, b) over code_size bytes,
+// 32-byte chunks are reduced by groups of 4 with the Harley-Seal carry-save adders
+template <class Op>
+inline uint64_t popcount_harley_seal (const uint8_t* a, const uint8_t* b, size_t code_size, Op op) {
+#define LOAD_OP(i) op(_mm256_loadu_si256((const __m256i*)(a + 32 * (i))), \
+                      _mm256_loadu_si256((const __m256i*)(b + 32 * (i))))
+    const size_t n = code_size / 32;
+    __m256i total = _mm256_setzero_si256();
+    __m256i ones = _mm256_setzero_si256();
+    __m256i twos = _mm256_setzero_si256();
+    __m256i fours, twos_a, twos_b;
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        csa(twos_a, ones, ones, LOAD_OP(i), LOAD_OP(i + 1));
+        csa(twos_b, ones, ones, LOAD_OP(i + 2), LOAD_OP(i + 3));
+        csa(fours, twos, twos, twos_a, twos_b);
+        total = _mm256_add_epi64(total, popcount256(fours));
+    }
+    total = _mm256_slli_epi64(total, 2);
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(twos), 1));
+    total = _mm256_add_epi64(total, popcount256(ones));
+    for (; i < n; i++) {
+        total = _mm256_add_epi64(total, popcount256(LOAD_OP(i)));
+    }
+#undef LOAD_OP
+
+    uint64_t cnt = _mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) +
+                   _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3);
+
+    // tail of the code, 8 then 1 byte at a time
+    size_t j = n * 32;
+    for (; j + 8 <= code_size; j += 8) {
+        cnt += __builtin_popcountll(op(*(const uint64_t*)(a + j), *(const uint64_t*)(b + j)));
+    }
+    for (; j < code_size; j++) {
+        cnt += __builtin_popcountll(op((uint64_t)a[j], (uint64_t)b[j]));
+    }
+    return cnt;
+}
+
+} // namespace
+
+void
+binary_hamming_block_avx(const uint8_t* x, size_t nx, const uint8_t* y, size_t ny, size_t code_size, int32_t* dis) {
+    // database codes in the outer loop: each one is read once and shared by the tile of queries
+    for (size_t j = 0; j < ny; j++) {
+        const uint8_t* y_j = y + j * code_size;
+        for (size_t i = 0; i < nx; i++) {
+            dis[i * ny + j] = popcount_harley_seal(x + i * code_size, y_j, code_size, OpXor());
+        }
+    }
+}
+
+void
+binary_jaccard_block_avx(const uint8_t* x, size_t nx, const uint8_t* y, size_t ny, size_t code_size, float* dis) {
+    for (size_t j = 0; j < ny; j++) {
+        const uint8_t* y_j = y + j * code_size;
+        for (size_t i = 0; i < nx; i++) {
+            const uint8_t* x_i = x + i * code_size;
+            int accu_num = popcount_harley_seal(x_i, y_j, code_size, OpAnd());
+            int accu_den = popcount_harley_seal(x_i, y_j, code_size, OpOr());
+            // same expression as JaccardComputer
+            dis[i * ny + j] = (accu_num == 0) ? 1.0 : 1.0 - (float)(accu_num) / (float)(accu_den);
+        }
+    }
+}
+
+#else
+
+void
+binary_hamming_block_avx(const uint8_t* x, size_t nx, const uint8_t* y, size_t ny, size_t code_size, int32_t* dis) {
+    FAISS_ASSERT(false);
+}
+
+void
+binary_jaccard_block_avx(const uint8_t* x, size_t nx, const uint8_t* y, size_t ny, size_t code_size, float* dis) {
+    FAISS_ASSERT(false);
+}
+
+#endif
+
+} // namespace faiss
@@ -0,0 +1,27 @@
+
+// -*- c++ -*-
+
+/* Block kernels for binary distances.
+ * The actual functions are implemented in BinaryDistance_avx.cpp */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/*********************************************************
+ * Block kernels: nx query codes against ny database codes,
+ * the distances are written to dis, row major (nx * ny)
+ *********************************************************/
+
+/// Hamming distances, Harley-Seal population count
+void
+binary_hamming_block_avx(const uint8_t* x, size_t nx, const uint8_t* y, size_t ny, size_t code_size, int32_t* dis);
+
+/// Jaccard distances, Harley-Seal population count
+void
+binary_jaccard_block_avx(const uint8_t* x, size_t nx, const uint8_t* y, size_t ny, size_t code_size, float* dis);
+
+} // namespace faiss
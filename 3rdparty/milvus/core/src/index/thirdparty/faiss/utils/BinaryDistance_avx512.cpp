@@ -0,0 +1,104 @@
+
+// -*- c++ -*-
+
+#include <faiss/utils/BinaryDistance_avx512.h>
+#include <faiss/impl/FaissAssert.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#if (defined(__AVX512F__) && defined(__AVX512BW__))
+
+/* VPOPCNTDQ is not part of the flags this file is built with,
+ * only these kernels use it and they are hooked after a cpuid check */
+#define VPOPCNT_TARGET __attribute__((target("avx512vpopcntdq")))
+
+namespace {
+
+// reads the last 0 < n < 64 bytes of a code
+inline __m512i masked_read (const uint8_t* p, size_t n) {
+    return _mm512_maskz_loadu_epi8((__mmask64)(~0ULL >> (64 - n)), p);
+}
+
+VPOPCNT_TARGET
+inline uint64_t popcount_xor (const uint8_t* a, const uint8_t* b, size_t code_size) {
+    __m512i total = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 64 <= code_size; i += 64) {
+        __m512i v = _mm512_xor_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(v));
+    }
+    if (i < code_size) {
+        __m512i v = _mm512_xor_si512(masked_read(a + i, code_size - i), masked_read(b + i, code_size - i));
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(v));
+    }
+    return _mm512_reduce_add_epi64(total);
+}
+
+VPOPCNT_TARGET
+inline void popcount_and_or (const uint8_t* a, const uint8_t* b, size_t code_size, int& accu_num, int& accu_den) {
+    __m512i total_and = _mm512_setzero_si512();
+    __m512i total_or = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 64 <= code_size; i += 64) {
+        __m512i va = _mm512_loadu_si512(a + i);
+        __m512i vb = _mm512_loadu_si512(b + i);
+        total_and = _mm512_add_epi64(total_and, _mm512_popcnt_epi64(_mm512_and_si512(va, vb)));
+        total_or = _mm512_add_epi64(total_or, _mm512_popcnt_epi64(_mm512_or_si512(va, vb)));
+    }
+    if (i < code_size) {
+        __m512i va = masked_read(a + i, code_size - i);
+        __m512i vb = masked_read(b + i, code_size - i);
+        total_and = _mm512_add_epi64(total_and, _mm512_popcnt_epi64(_mm512_and_si512(va, vb)));
+        total_or = _mm512_add_epi64(total_or, _mm512_popcnt_epi64(_mm512_or_si512(va, vb)));
+    }
+    accu_num = _mm512_reduce_add_epi64(total_and);
+    accu_den = _mm512_reduce_add_epi64(total_or);
+}
+
+} // namespace
+
+VPOPCNT_TARGET
+void
+binary_hamming_block_avx512(const uint8_t* x, size_t nx, const uint8_t* y, size_t ny, size_t code_size, int32_t* dis) {
+    // database codes in the outer loop: each one is read once and shared by the tile of queries
+    for (size_t j = 0; j < ny; j++) {
+        const uint8_t* y_j = y + j * code_size;
+        for (size_t i = 0; i < nx; i++) {
+            dis[i * ny + j] = popcount_xor(x + i * code_size, y_j, code_size);
+        }
+    }
+}
+
+VPOPCNT_TARGET
+void
+binary_jaccard_block_avx512(const uint8_t* x, size_t nx, const uint8_t* y, size_t ny, size_t code_size, float* dis) {
+    for (size_t j = 0; j < ny; j++) {
+        const uint8_t* y_j = y + j * code_size;
+        for (size_t i = 0; i < nx; i++) {
+            int accu_num, accu_den;
+            popcount_and_or(x + i * code_size, y_j, code_size, accu_num, accu_den);
+            // same expression as JaccardComputer
+            dis[i * ny + j] = (accu_num == 0) ? 1.0 : 1.0 - (float)(accu_num) / (float)(accu_den);
+        }
+    }
+}
+
+#undef VPOPCNT_TARGET
+
+#else
+
+void
+binary_hamming_block_avx512(const uint8_t* x, size_t nx, const uint8_t* y, size_t ny, size_t code_size, int32_t* dis) {
+    FAISS_ASSERT(false);
+}
+
+void
+binary_jaccard_block_avx512(const uint8_t* x, size_t nx, const uint8_t* y, size_t ny, size_t code_size, float* dis) {
+    FAISS_ASSERT(false);
+}
+
+#endif
+
+} // namespace faiss
@@ -17,6 +17,8 @@
 
 #include "ConcurrentBitset.h"
 
+#include <cstring>
+
 namespace faiss {
 
 ConcurrentBitset::ConcurrentBitset(id_type_t capacity) : capacity_(capacity), bitset_((capacity + 8 - 1) >> 3) {
@@ -47,6 +49,22 @@ ConcurrentBitset::size() {
     return ((capacity_ + 8 - 1) >> 3);
 }
 
+size_t
+ConcurrentBitset::count() {
+    size_t bytes = size();
+    const uint8_t* p = data();
+    size_t ret = 0, i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t word;
+        memcpy(&word, p + i, sizeof(word));
+        ret += __builtin_popcountll(word);
+    }
+    for (; i < bytes; i++) {
+        ret += __builtin_popcount(p[i]);
+    }
+    return ret;
+}
+
 const uint8_t*
 ConcurrentBitset::data() {
     return reinterpret_cast<const uint8_t*>(bitset_.data());
@@ -48,6 +48,10 @@ class ConcurrentBitset {
     size_t
     size();
 
+    // number of set bits
+    size_t
+    count();
+
     const uint8_t*
     data();
 
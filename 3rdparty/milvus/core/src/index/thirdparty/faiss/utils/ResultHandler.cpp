@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+#include <faiss/utils/ResultHandler.h>
+
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
+namespace faiss {
+
+size_t reservoir_topk_threshold = 128;
+
+namespace {
+
+// append the positions of the bits set in mask, offset by j0
+inline size_t push_mask (unsigned mask, size_t j0, uint8_t *idx)
+{
+    size_t nf = 0;
+    while (mask) {
+        idx[nf++] = j0 + __builtin_ctz (mask);
+        mask &= mask - 1;
+    }
+    return nf;
+}
+
+} // namespace
+
+size_t fvec_filter_lt (const float *dis, size_t n, float thr, uint8_t *idx)
+{
+    size_t nf = 0;
+    size_t j = 0;
+#ifdef __SSE2__
+    __m128 t = _mm_set1_ps (thr);
+    for (; j + 8 <= n; j += 8) {
+        __m128 lo = _mm_cmplt_ps (_mm_loadu_ps (dis + j), t);
+        __m128 hi = _mm_cmplt_ps (_mm_loadu_ps (dis + j + 4), t);
+        unsigned mask = _mm_movemask_ps (lo) | (_mm_movemask_ps (hi) << 4);
+        nf += push_mask (mask, j, idx + nf);
+    }
+#endif
+    for (; j < n; j++) {
+        if (dis[j] < thr) {
+            idx[nf++] = j;
+        }
+    }
+    return nf;
+}
+
+size_t fvec_filter_gt (const float *dis, size_t n, float thr, uint8_t *idx)
+{
+    size_t nf = 0;
+    size_t j = 0;
+#ifdef __SSE2__
+    __m128 t = _mm_set1_ps (thr);
+    for (; j + 8 <= n; j += 8) {
+        __m128 lo = _mm_cmpgt_ps (_mm_loadu_ps (dis + j), t);
+        __m128 hi = _mm_cmpgt_ps (_mm_loadu_ps (dis + j + 4), t);
+        unsigned mask = _mm_movemask_ps (lo) | (_mm_movemask_ps (hi) << 4);
+        nf += push_mask (mask, j, idx + nf);
+    }
+#endif
+    for (; j < n; j++) {
+        if (dis[j] > thr) {
+            idx[nf++] = j;
+        }
+    }
+    return nf;
+}
+
+size_t ivec_filter_lt (const int32_t *dis, size_t n, int32_t thr, uint8_t *idx)
+{
+    size_t nf = 0;
+    size_t j = 0;
+#ifdef __SSE2__
+    __m128i t = _mm_set1_epi32 (thr);
+    for (; j + 8 <= n; j += 8) {
+        __m128i lo = _mm_cmplt_epi32 (_mm_loadu_si128 ((const __m128i*)(dis + j)), t);
+        __m128i hi = _mm_cmplt_epi32 (_mm_loadu_si128 ((const __m128i*)(dis + j + 4)), t);
+        unsigned mask = _mm_movemask_ps (_mm_castsi128_ps (lo)) |
+                        (_mm_movemask_ps (_mm_castsi128_ps (hi)) << 4);
+        nf += push_mask (mask, j, idx + nf);
+    }
+#endif
+    for (; j < n; j++) {
+        if (dis[j] < thr) {
+            idx[nf++] = j;
+        }
+    }
+    return nf;
+}
+
+} // namespace faiss
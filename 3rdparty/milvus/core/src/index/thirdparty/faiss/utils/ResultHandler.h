@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// -*- c++ -*-
+
+/*
+ * Top-k selection for large k.
+ *
+ * A heap pays a branchy sift of log(k) steps for every candidate that beats
+ * its top. ReservoirTopK instead appends the candidates that beat a running
+ * threshold to a buffer of 2 * k entries; when the buffer is full it is cut
+ * back to the k best with nth_element and the threshold tightens. Batches of
+ * distances are compared with the threshold with SIMD before anything is
+ * stored, so most candidates cost a vector compare only.
+ *
+ * The results are the same as with the heaps of Heap.h, up to the order of
+ * ties.
+ */
+
+#ifndef FAISS_RESULT_HANDLER_H
+#define FAISS_RESULT_HANDLER_H
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <faiss/utils/Heap.h>
+
+namespace faiss {
+
+/// searches with k >= reservoir_topk_threshold collect their results with
+/// ReservoirTopK, smaller k keep using the heaps
+extern size_t reservoir_topk_threshold;
+
+/** store in idx the positions j in [0, n) where dis[j] < thr (resp. > thr),
+ * n <= 256, return the number of positions */
+size_t fvec_filter_lt (const float *dis, size_t n, float thr, uint8_t *idx);
+size_t fvec_filter_gt (const float *dis, size_t n, float thr, uint8_t *idx);
+size_t ivec_filter_lt (const int32_t *dis, size_t n, int32_t thr, uint8_t *idx);
+
+/// positions j in [0, n) where C::cmp(thr, dis[j]), n <= 256
+template <class C>
+inline size_t topk_filter (const typename C::T *dis, size_t n,
+                           typename C::T thr, uint8_t *idx)
+{
+    size_t nf = 0;
+    for (size_t j = 0; j < n; j++) {
+        if (C::cmp (thr, dis[j])) {
+            idx[nf++] = j;
+        }
+    }
+    return nf;
+}
+
+template <>
+inline size_t topk_filter<CMax<float, int64_t>> (const float *dis, size_t n,
+                                                 float thr, uint8_t *idx)
+{
+    return fvec_filter_lt (dis, n, thr, idx);
+}
+
+template <>
+inline size_t topk_filter<CMin<float, int64_t>> (const float *dis, size_t n,
+                                                 float thr, uint8_t *idx)
+{
+    return fvec_filter_gt (dis, n, thr, idx);
+}
+
+template <>
+inline size_t topk_filter<CMax<int32_t, int64_t>> (const int32_t *dis, size_t n,
+                                                   int32_t thr, uint8_t *idx)
+{
+    return ivec_filter_lt (dis, n, thr, idx);
+}
+
+
+/** Keeps the k best (dis, id) pairs, best meaning C::cmp(other, dis)
+ * as for a heap with comparator C */
+template <class C>
+class ReservoirTopK {
+  public:
+    typedef typename C::T T;
+    typedef typename C::TI TI;
+    typedef std::pair<T, TI> Entry;
+
+    /// distances handed to topk_filter at once
+    static const size_t batch_size = 256;
+
+    explicit ReservoirTopK (size_t k):
+        k_ (k), capacity_ (std::max (2 * k, (size_t)batch_size)),
+        threshold_ (C::neutral ())
+    {
+        buf_.reserve (capacity_);
+    }
+
+    void reset () {
+        buf_.clear ();
+        threshold_ = C::neutral ();
+    }
+
+    /// candidates not beating the threshold can not make it into the top k
+    T threshold () const {
+        return threshold_;
+    }
+
+    /// return true if the candidate was kept
+    bool add (T dis, TI id) {
+        if (!C::cmp (threshold_, dis)) {
+            return false;
+        }
+        buf_.emplace_back (dis, id);
+        if (buf_.size () == capacity_) {
+            shrink ();
+        }
+        return true;
+    }
+
+    /** add dis[j] for j in [0, n), with id id_of(j). id_of is called for
+     * the candidates beating the threshold only, a negative id drops the
+     * candidate (eg. filtered by a bitset). Return the number kept. */
+    template <typename IdFunc>
+    size_t add_batch (const T *dis, size_t n, IdFunc id_of) {
+        uint8_t idx[batch_size];
+        size_t nup = 0;
+        for (size_t j0 = 0; j0 < n; j0 += batch_size) {
+            size_t nj = std::min (n - j0, (size_t)batch_size);
+            size_t nf = topk_filter<C> (dis + j0, nj, threshold_, idx);
+            for (size_t f = 0; f < nf; f++) {
+                size_t j = j0 + idx[f];
+                TI id = id_of (j);
+                if (id >= 0 && add (dis[j], id)) {
+                    nup++;
+                }
+            }
+        }
+        return nup;
+    }
+
+    void merge (const ReservoirTopK<C> &other) {
+        for (const Entry &e : other.buf_) {
+            add (e.first, e.second);
+        }
+    }
+
+    /** write the k best to dis / ids, best first as after heap_reorder,
+     * missing results are set to C::neutral() / -1 */
+    void finalize (T *dis, TI *ids) {
+        if (buf_.size () > k_) {
+            shrink ();
+        }
+        std::sort (buf_.begin (), buf_.end (), better);
+        size_t i = 0;
+        for (; i < buf_.size (); i++) {
+            dis[i] = buf_[i].first;
+            ids[i] = buf_[i].second;
+        }
+        for (; i < k_; i++) {
+            dis[i] = C::neutral ();
+            ids[i] = -1;
+        }
+    }
+
+  private:
+    static bool better (const Entry &a, const Entry &b) {
+        return C::cmp (b.first, a.first);
+    }
+
+    void shrink () {
+        if (k_ == 0) {
+            buf_.clear ();
+            return;
+        }
+        std::nth_element (buf_.begin (), buf_.begin () + (k_ - 1), buf_.end (), better);
+        buf_.resize (k_);
+        threshold_ = buf_[k_ - 1].first;
+    }
+
+    size_t k_;
+    size_t capacity_;
+    T threshold_;
+    std::vector<Entry> buf_;
+};
+
+} // namespace faiss
+
+#endif
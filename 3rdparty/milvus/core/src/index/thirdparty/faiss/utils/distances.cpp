@@ -20,6 +20,7 @@
 #include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/utils/ConcurrentBitset.h>
+#include <faiss/utils/ResultHandler.h>
 
 
 #ifndef FINTEGER
@@ -352,6 +353,200 @@ static void knn_L2sqr_sse (
     */
 }
 
+/* Same as the sse functions above for large k: every thread scans blocks of
+ * the database and collects candidates of each query into a reservoir, the
+ * reservoirs of the threads are merged at the end */
+template <class C>
+static void knn_reservoir_sse (
+                const float * x,
+                const float * y,
+                size_t d, size_t nx, size_t ny,
+                HeapArray<C> * res,
+                fvec_func_ptr dis_func,
+                ConcurrentBitsetPtr bitset)
+{
+    typedef ReservoirTopK<C> Reservoir;
+    const size_t bs_y = Reservoir::batch_size;
+    size_t k = res->k;
+    size_t thread_max_num = omp_get_max_threads();
+    size_t n_blocks = (ny + bs_y - 1) / bs_y;
+
+    std::vector<std::vector<Reservoir>> reservoirs (thread_max_num, std::vector<Reservoir> (nx, Reservoir (k)));
+
+#pragma omp parallel for
+    for (size_t b = 0; b < n_blocks; b++) {
+        size_t thread_no = omp_get_thread_num();
+        size_t j0 = b * bs_y;
+        size_t j1 = std::min (j0 + bs_y, ny);
+        float dis[bs_y];
+        auto id_of = [&] (size_t j) -> int64_t {
+            int64_t id = j0 + j;
+            return (bitset && bitset->test(id)) ? -1 : id;
+        };
+        for (size_t i = 0; i < nx; i++) {
+            const float *x_i = x + i * d;
+            for (size_t j = j0; j < j1; j++) {
+                dis[j - j0] = dis_func (x_i, y + j * d, d);
+            }
+            reservoirs[thread_no][i].add_batch (dis, j1 - j0, id_of);
+        }
+    }
+
+#pragma omp parallel for
+    for (size_t i = 0; i < nx; i++) {
+        for (size_t t = 1; t < thread_max_num; t++) {
+            reservoirs[0][i].merge (reservoirs[t][i]);
+        }
+        reservoirs[0][i].finalize (res->get_val(i), res->get_ids(i));
+    }
+}
+
+/* tile sizes of the block kernels: the database block stays in L2 while
+ * every query of the tile is compared with it */
+static const size_t knn_query_tile = 8;
+static const size_t knn_base_tile = 256;
+
+/* Find the nearest neighbors with a block kernel of FaissHook: distances of
+ * a tile of queries to a tile of the database are computed in a buffer that
+ * stays in L1, only the ones beating the top of the heap of their query are
+ * checked against the bitset and pushed. Same split of the work as the sse
+ * functions when there are few queries. */
+template <class C>
+static void knn_block (
+                fvec_block_func_ptr block_func,
+                const float * x,
+                const float * y,
+                size_t d, size_t nx, size_t ny,
+                HeapArray<C> * res,
+                ConcurrentBitsetPtr bitset)
+{
+    typedef typename C::T T;
+    const size_t k = res->k;
+    const size_t n_blocks = (ny + knn_base_tile - 1) / knn_base_tile;
+    size_t thread_max_num = omp_get_max_threads();
+    // too few query tiles to keep the threads busy: split the database
+    bool split_db = (nx + knn_query_tile - 1) / knn_query_tile < thread_max_num;
+
+    if (k >= reservoir_topk_threshold) {
+        typedef ReservoirTopK<C> Reservoir;
+        std::vector<std::vector<Reservoir>> reservoirs (split_db ? thread_max_num : 1,
+                                                        std::vector<Reservoir> (nx, Reservoir (k)));
+
+        auto scan_tile = [&] (size_t i0, size_t i1, size_t j0, size_t j1, Reservoir * rs, T * dis) {
+            const size_t nj = j1 - j0;
+            block_func (x + i0 * d, i1 - i0, y + j0 * d, nj, d, dis);
+            auto id_of = [&] (size_t j) -> int64_t {
+                int64_t id = j0 + j;
+                return (bitset && bitset->test(id)) ? -1 : id;
+            };
+            for (size_t i = i0; i < i1; i++) {
+                rs[i].add_batch (dis + (i - i0) * nj, nj, id_of);
+            }
+        };
+
+        if (split_db) {
+#pragma omp parallel for
+            for (size_t b = 0; b < n_blocks; b++) {
+                size_t thread_no = omp_get_thread_num();
+                T dis[knn_query_tile * knn_base_tile];
+                size_t j0 = b * knn_base_tile;
+                size_t j1 = std::min (j0 + knn_base_tile, ny);
+                for (size_t i0 = 0; i0 < nx; i0 += knn_query_tile) {
+                    size_t i1 = std::min (i0 + knn_query_tile, nx);
+                    scan_tile (i0, i1, j0, j1, reservoirs[thread_no].data(), dis);
+                }
+            }
+        } else {
+#pragma omp parallel for
+            for (size_t i0 = 0; i0 < nx; i0 += knn_query_tile) {
+                T dis[knn_query_tile * knn_base_tile];
+                size_t i1 = std::min (i0 + knn_query_tile, nx);
+                for (size_t j0 = 0; j0 < ny; j0 += knn_base_tile) {
+                    size_t j1 = std::min (j0 + knn_base_tile, ny);
+                    scan_tile (i0, i1, j0, j1, reservoirs[0].data(), dis);
+                }
+            }
+        }
+
+#pragma omp parallel for
+        for (size_t i = 0; i < nx; i++) {
+            for (size_t t = 1; t < reservoirs.size(); t++) {
+                reservoirs[0][i].merge (reservoirs[t][i]);
+            }
+            reservoirs[0][i].finalize (res->get_val(i), res->get_ids(i));
+        }
+        return;
+    }
+
+    auto scan_tile = [&] (size_t i0, size_t i1, size_t j0, size_t j1, T * val, int64_t * ids, T * dis) {
+        const size_t nj = j1 - j0;
+        block_func (x + i0 * d, i1 - i0, y + j0 * d, nj, d, dis);
+        for (size_t i = i0; i < i1; i++) {
+            T * val_i = val + i * k;
+            int64_t * ids_i = ids + i * k;
+            const T * dis_i = dis + (i - i0) * nj;
+            for (size_t j = 0; j < nj; j++) {
+                if (C::cmp (val_i[0], dis_i[j]) && (!bitset || !bitset->test(j0 + j))) {
+                    heap_swap_top<C> (k, val_i, ids_i, dis_i[j], j0 + j);
+                }
+            }
+        }
+    };
+
+    if (split_db) {
+        // every thread keeps its own heaps
+        size_t thread_heap_size = nx * k;
+        std::vector<T> value (thread_heap_size * thread_max_num, C::neutral());
+        std::vector<int64_t> labels (thread_heap_size * thread_max_num, -1);
+
+#pragma omp parallel for
+        for (size_t b = 0; b < n_blocks; b++) {
+            size_t thread_no = omp_get_thread_num();
+            T dis[knn_query_tile * knn_base_tile];
+            size_t j0 = b * knn_base_tile;
+            size_t j1 = std::min (j0 + knn_base_tile, ny);
+            for (size_t i0 = 0; i0 < nx; i0 += knn_query_tile) {
+                size_t i1 = std::min (i0 + knn_query_tile, nx);
+                scan_tile (i0, i1, j0, j1, value.data() + thread_no * thread_heap_size,
+                           labels.data() + thread_no * thread_heap_size, dis);
+            }
+        }
+
+        for (size_t t = 1; t < thread_max_num; t++) {
+            // merge heap
+            for (size_t i = 0; i < nx; i++) {
+                T * __restrict value_x = value.data() + i * k;
+                int64_t * __restrict labels_x = labels.data() + i * k;
+                T *value_x_t = value_x + t * thread_heap_size;
+                int64_t *labels_x_t = labels_x + t * thread_heap_size;
+                for (size_t j = 0; j < k; j++) {
+                    if (C::cmp (value_x[0], value_x_t[j])) {
+                        heap_swap_top<C> (k, value_x, labels_x, value_x_t[j], labels_x_t[j]);
+                    }
+                }
+            }
+        }
+
+        // copy result
+        memcpy (res->val, value.data(), thread_heap_size * sizeof(T));
+        memcpy (res->ids, labels.data(), thread_heap_size * sizeof(int64_t));
+    } else {
+        res->heapify ();
+
+#pragma omp parallel for
+        for (size_t i0 = 0; i0 < nx; i0 += knn_query_tile) {
+            T dis[knn_query_tile * knn_base_tile];
+            size_t i1 = std::min (i0 + knn_query_tile, nx);
+            for (size_t j0 = 0; j0 < ny; j0 += knn_base_tile) {
+                size_t j1 = std::min (j0 + knn_base_tile, ny);
+                scan_tile (i0, i1, j0, j1, res->val, res->ids, dis);
+            }
+        }
+    }
+
+    res->reorder ();
+}
+
 /** Find the nearest neighbors for nx queries in a set of ny vectors */
 static void knn_inner_product_blas (
         const float * x,
@@ -373,10 +568,18 @@ static void knn_inner_product_blas (
     float *ip_block = new float[bs_x * bs_y];
     ScopeDeleter<float> del1(ip_block);;
 
+    // large k: candidates of the queries of a block go to reservoirs
+    bool use_reservoir = k >= reservoir_topk_threshold;
+    std::vector<ReservoirTopK<CMin<float, int64_t>>> reservoirs;
+
     for (size_t i0 = 0; i0 < nx; i0 += bs_x) {
         size_t i1 = i0 + bs_x;
         if(i1 > nx) i1 = nx;
 
+        if (use_reservoir) {
+            reservoirs.assign (i1 - i0, ReservoirTopK<CMin<float, int64_t>> (k));
+        }
+
         for (size_t j0 = 0; j0 < ny; j0 += bs_y) {
             size_t j1 = j0 + bs_y;
             if (j1 > ny) j1 = ny;
@@ -397,21 +600,37 @@ static void knn_inner_product_blas (
                 int64_t * __restrict idxi = res->get_ids (i);
                 const float *ip_line = ip_block + (i - i0) * (j1 - j0);
 
+                if (use_reservoir) {
+                    reservoirs[i - i0].add_batch (ip_line, j1 - j0, [&] (size_t j) -> int64_t {
+                        int64_t id = j0 + j;
+                        return (bitset && bitset->test(id)) ? -1 : id;
+                    });
+                    continue;
+                }
+
                 for(size_t j = j0; j < j1; j++){
-                    if(!bitset || !bitset->test(j)){
-                        float dis = *ip_line;
+                    float dis = *ip_line;
 
-                        if(dis > simi[0]){
-                            minheap_swap_top(k, simi, idxi, dis, j);
-                        }
+                    // the bitset is only checked for the vectors entering the heap
+                    if(dis > simi[0] && (!bitset || !bitset->test(j))){
+                        minheap_swap_top(k, simi, idxi, dis, j);
                     }
                     ip_line++;
                 }
             }
         }
+
+        if (use_reservoir) {
+#pragma omp parallel for
+            for (size_t i = i0; i < i1; i++) {
+                reservoirs[i - i0].finalize (res->get_val(i), res->get_ids(i));
+            }
+        }
         InterruptCallback::check ();
     }
-    res->reorder ();
+    if (!use_reservoir) {
+        res->reorder ();
+    }
 }
 
 // distance correction is an operator that can be applied to transform
@@ -442,11 +661,18 @@ static void knn_L2sqr_blas (const float * x,
     fvec_norms_L2sqr (x_norms, x, d, nx);
     fvec_norms_L2sqr (y_norms, y, d, ny);
 
+    // large k: candidates of the queries of a block go to reservoirs
+    bool use_reservoir = k >= reservoir_topk_threshold;
+    std::vector<ReservoirTopK<CMax<float, int64_t>>> reservoirs;
 
     for (size_t i0 = 0; i0 < nx; i0 += bs_x) {
         size_t i1 = i0 + bs_x;
         if(i1 > nx) i1 = nx;
 
+        if (use_reservoir) {
+            reservoirs.assign (i1 - i0, ReservoirTopK<CMax<float, int64_t>> (k));
+        }
+
         for (size_t j0 = 0; j0 < ny; j0 += bs_y) {
             size_t j1 = j0 + bs_y;
             if (j1 > ny) j1 = ny;
@@ -467,28 +693,49 @@ static void knn_L2sqr_blas (const float * x,
                 int64_t * __restrict idxi = res->get_ids (i);
                 const float *ip_line = ip_block + (i - i0) * (j1 - j0);
 
+                if (use_reservoir) {
+                    float dis_line[bs_y];
+                    for (size_t j = j0; j < j1; j++) {
+                        float dis = x_norms[i] + y_norms[j] - 2 * ip_line[j - j0];
+                        dis_line[j - j0] = corr (dis < 0 ? 0 : dis, i, j);
+                    }
+                    reservoirs[i - i0].add_batch (dis_line, j1 - j0, [&] (size_t j) -> int64_t {
+                        int64_t id = j0 + j;
+                        return (bitset && bitset->test(id)) ? -1 : id;
+                    });
+                    continue;
+                }
+
                 for (size_t j = j0; j < j1; j++) {
-                    if(!bitset || !bitset->test(j)){
-                        float ip = *ip_line;
-                        float dis = x_norms[i] + y_norms[j] - 2 * ip;
+                    float ip = *ip_line;
+                    float dis = x_norms[i] + y_norms[j] - 2 * ip;
 
-                        // negative values can occur for identical vectors
-                        // due to roundoff errors
-                        if (dis < 0) dis = 0;
+                    // negative values can occur for identical vectors
+                    // due to roundoff errors
+                    if (dis < 0) dis = 0;
 
-                        dis = corr (dis, i, j);
+                    dis = corr (dis, i, j);
 
-                        if (dis < simi[0]) {
-                            maxheap_swap_top (k, simi, idxi, dis, j);
-                        }
+                    // the bitset is only checked for the vectors entering the heap
+                    if (dis < simi[0] && (!bitset || !bitset->test(j))) {
+                        maxheap_swap_top (k, simi, idxi, dis, j);
                     }
                     ip_line++;
                 }
             }
         }
+
+        if (use_reservoir) {
+#pragma omp parallel for
+            for (size_t i = i0; i < i1; i++) {
+                reservoirs[i - i0].finalize (res->get_val(i), res->get_ids(i));
+            }
+        }
         InterruptCallback::check ();
     }
-    res->reorder ();
+    if (!use_reservoir) {
+        res->reorder ();
+    }
 
 }
 
@@ -585,8 +832,14 @@ void knn_inner_product (const float * x,
         float_minheap_array_t * res,
         ConcurrentBitsetPtr bitset)
 {
-    if (d % 4 == 0 && nx < distance_compute_blas_threshold) {
-        knn_inner_product_sse (x, y, d, nx, ny, res, bitset);
+    if (fvec_inner_product_block && nx < distance_compute_blas_threshold) {
+        knn_block (fvec_inner_product_block, x, y, d, nx, ny, res, bitset);
+    } else if (d % 4 == 0 && nx < distance_compute_blas_threshold) {
+        if (res->k >= reservoir_topk_threshold) {
+            knn_reservoir_sse (x, y, d, nx, ny, res, fvec_inner_product, bitset);
+        } else {
+            knn_inner_product_sse (x, y, d, nx, ny, res, bitset);
+        }
     } else {
         knn_inner_product_blas (x, y, d, nx, ny, res, bitset);
     }
@@ -606,8 +859,14 @@ void knn_L2sqr (const float * x,
                 float_maxheap_array_t * res,
                 ConcurrentBitsetPtr bitset)
 {
-    if (d % 4 == 0 && nx < distance_compute_blas_threshold) {
-        knn_L2sqr_sse (x, y, d, nx, ny, res, bitset);
+    if (fvec_L2sqr_block && nx < distance_compute_blas_threshold) {
+        knn_block (fvec_L2sqr_block, x, y, d, nx, ny, res, bitset);
+    } else if (d % 4 == 0 && nx < distance_compute_blas_threshold) {
+        if (res->k >= reservoir_topk_threshold) {
+            knn_reservoir_sse (x, y, d, nx, ny, res, fvec_L2sqr, bitset);
+        } else {
+            knn_L2sqr_sse (x, y, d, nx, ny, res, bitset);
+        }
     } else {
         NopDistanceCorrection nop;
         knn_L2sqr_blas (x, y, d, nx, ny, res, nop, bitset);
@@ -29,4 +29,11 @@ fvec_L1_avx(const float* x, const float* y, size_t d);
 float
 fvec_Linf_avx(const float* x, const float* y, size_t d);
 
+/// distances of nx queries x to ny vectors y, dis is nx * ny row major
+void
+fvec_L2sqr_block_avx(const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis);
+
+void
+fvec_inner_product_block_avx(const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis);
+
 } // namespace faiss
@@ -186,6 +186,107 @@ float fvec_Linf_avx (const float* x, const float* y, size_t d) {
     return  _mm_cvtss_f32 (msum2);
 }
 
+namespace {
+
+inline float hsum256 (__m256 v) {
+    __m128 s = _mm_add_ps (_mm256_extractf128_ps (v, 1), _mm256_castps256_ps128 (v));
+    s = _mm_hadd_ps (s, s);
+    s = _mm_hadd_ps (s, s);
+    return _mm_cvtss_f32 (s);
+}
+
+struct AccIP {
+    static inline __m256 acc (__m256 sum, __m256 x, __m256 y) {
+        return _mm256_add_ps (sum, _mm256_mul_ps (x, y));
+    }
+};
+
+struct AccL2 {
+    static inline __m256 acc (__m256 sum, __m256 x, __m256 y) {
+        const __m256 a_m_b = _mm256_sub_ps (x, y);
+        return _mm256_add_ps (sum, _mm256_mul_ps (a_m_b, a_m_b));
+    }
+};
+
+// distances of NX queries to NY vectors, the NX * NY sums stay in registers
+// and every loaded component is used NX (resp. NY) times
+template <class Acc, size_t NX, size_t NY>
+inline void fvec_kernel (const float* x, const float* y, size_t d, float* dis, size_t ldd) {
+    __m256 sum[NX][NY];
+    for (size_t r = 0; r < NX; r++) {
+        for (size_t c = 0; c < NY; c++) {
+            sum[r][c] = _mm256_setzero_ps ();
+        }
+    }
+
+    size_t l = 0;
+    for (; l + 8 <= d; l += 8) {
+        __m256 my[NY];
+        for (size_t c = 0; c < NY; c++) {
+            my[c] = _mm256_loadu_ps (y + c * d + l);
+        }
+        for (size_t r = 0; r < NX; r++) {
+            __m256 mx = _mm256_loadu_ps (x + r * d + l);
+            for (size_t c = 0; c < NY; c++) {
+                sum[r][c] = Acc::acc (sum[r][c], mx, my[c]);
+            }
+        }
+    }
+    if (l < d) {
+        // zero padded tail, adds nothing to both distances
+        __m256 my[NY];
+        for (size_t c = 0; c < NY; c++) {
+            my[c] = masked_read_8 (d - l, y + c * d + l);
+        }
+        for (size_t r = 0; r < NX; r++) {
+            __m256 mx = masked_read_8 (d - l, x + r * d + l);
+            for (size_t c = 0; c < NY; c++) {
+                sum[r][c] = Acc::acc (sum[r][c], mx, my[c]);
+            }
+        }
+    }
+
+    for (size_t r = 0; r < NX; r++) {
+        for (size_t c = 0; c < NY; c++) {
+            dis[r * ldd + c] = hsum256 (sum[r][c]);
+        }
+    }
+}
+
+// queries by groups of 4 against pairs of vectors, single query rows against groups of 4
+template <class Acc>
+void fvec_block (const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis) {
+    size_t i = 0;
+    for (; i + 4 <= nx; i += 4) {
+        size_t j = 0;
+        for (; j + 2 <= ny; j += 2) {
+            fvec_kernel<Acc, 4, 2> (x + i * d, y + j * d, d, dis + i * ny + j, ny);
+        }
+        for (; j < ny; j++) {
+            fvec_kernel<Acc, 4, 1> (x + i * d, y + j * d, d, dis + i * ny + j, ny);
+        }
+    }
+    for (; i < nx; i++) {
+        size_t j = 0;
+        for (; j + 4 <= ny; j += 4) {
+            fvec_kernel<Acc, 1, 4> (x + i * d, y + j * d, d, dis + i * ny + j, ny);
+        }
+        for (; j < ny; j++) {
+            fvec_kernel<Acc, 1, 1> (x + i * d, y + j * d, d, dis + i * ny + j, ny);
+        }
+    }
+}
+
+} // namespace
+
+void fvec_L2sqr_block_avx (const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis) {
+    fvec_block<AccL2> (x, nx, y, ny, d, dis);
+}
+
+void fvec_inner_product_block_avx (const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis) {
+    fvec_block<AccIP> (x, nx, y, ny, d, dis);
+}
+
 #else
 
 float fvec_inner_product_avx(const float* x, const float* y, size_t d) {
@@ -208,6 +309,14 @@ float fvec_Linf_avx (const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+void fvec_L2sqr_block_avx (const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis) {
+    FAISS_ASSERT(false);
+}
+
+void fvec_inner_product_block_avx (const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis) {
+    FAISS_ASSERT(false);
+}
+
 #endif
 
 } // namespace faiss
@@ -219,6 +219,103 @@ fvec_Linf_avx512(const float* x, const float* y, size_t d) {
     return  _mm_cvtss_f32 (msum2);
 }
 
+namespace {
+
+struct AccIP {
+    static inline __m512 acc (__m512 sum, __m512 x, __m512 y) {
+        return _mm512_fmadd_ps (x, y, sum);
+    }
+};
+
+struct AccL2 {
+    static inline __m512 acc (__m512 sum, __m512 x, __m512 y) {
+        const __m512 a_m_b = _mm512_sub_ps (x, y);
+        return _mm512_fmadd_ps (a_m_b, a_m_b, sum);
+    }
+};
+
+// distances of NX queries to NY vectors, the NX * NY sums stay in registers
+// and every loaded component is used NX (resp. NY) times
+template <class Acc, size_t NX, size_t NY>
+inline void fvec_kernel (const float* x, const float* y, size_t d, float* dis, size_t ldd) {
+    __m512 sum[NX][NY];
+    for (size_t r = 0; r < NX; r++) {
+        for (size_t c = 0; c < NY; c++) {
+            sum[r][c] = _mm512_setzero_ps ();
+        }
+    }
+
+    size_t l = 0;
+    for (; l + 16 <= d; l += 16) {
+        __m512 my[NY];
+        for (size_t c = 0; c < NY; c++) {
+            my[c] = _mm512_loadu_ps (y + c * d + l);
+        }
+        for (size_t r = 0; r < NX; r++) {
+            __m512 mx = _mm512_loadu_ps (x + r * d + l);
+            for (size_t c = 0; c < NY; c++) {
+                sum[r][c] = Acc::acc (sum[r][c], mx, my[c]);
+            }
+        }
+    }
+    if (l < d) {
+        // zero padded tail, adds nothing to both distances
+        const __mmask16 mask = (__mmask16)((1u << (d - l)) - 1);
+        __m512 my[NY];
+        for (size_t c = 0; c < NY; c++) {
+            my[c] = _mm512_maskz_loadu_ps (mask, y + c * d + l);
+        }
+        for (size_t r = 0; r < NX; r++) {
+            __m512 mx = _mm512_maskz_loadu_ps (mask, x + r * d + l);
+            for (size_t c = 0; c < NY; c++) {
+                sum[r][c] = Acc::acc (sum[r][c], mx, my[c]);
+            }
+        }
+    }
+
+    for (size_t r = 0; r < NX; r++) {
+        for (size_t c = 0; c < NY; c++) {
+            dis[r * ldd + c] = _mm512_reduce_add_ps (sum[r][c]);
+        }
+    }
+}
+
+// queries by groups of 4 against groups of 4 vectors, single query rows against groups of 8
+template <class Acc>
+void fvec_block (const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis) {
+    size_t i = 0;
+    for (; i + 4 <= nx; i += 4) {
+        size_t j = 0;
+        for (; j + 4 <= ny; j += 4) {
+            fvec_kernel<Acc, 4, 4> (x + i * d, y + j * d, d, dis + i * ny + j, ny);
+        }
+        for (; j < ny; j++) {
+            fvec_kernel<Acc, 4, 1> (x + i * d, y + j * d, d, dis + i * ny + j, ny);
+        }
+    }
+    for (; i < nx; i++) {
+        size_t j = 0;
+        for (; j + 8 <= ny; j += 8) {
+            fvec_kernel<Acc, 1, 8> (x + i * d, y + j * d, d, dis + i * ny + j, ny);
+        }
+        for (; j < ny; j++) {
+            fvec_kernel<Acc, 1, 1> (x + i * d, y + j * d, d, dis + i * ny + j, ny);
+        }
+    }
+}
+
+} // namespace
+
+void
+fvec_L2sqr_block_avx512(const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis) {
+    fvec_block<AccL2> (x, nx, y, ny, d, dis);
+}
+
+void
+fvec_inner_product_block_avx512(const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis) {
+    fvec_block<AccIP> (x, nx, y, ny, d, dis);
+}
+
 #else
 
 float
@@ -245,6 +342,16 @@ fvec_Linf_avx512(const float* x, const float* y, size_t d) {
     return 0.0;
 }
 
+void
+fvec_L2sqr_block_avx512(const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis) {
+    FAISS_ASSERT(false);
+}
+
+void
+fvec_inner_product_block_avx512(const float* x, size_t nx, const float* y, size_t ny, size_t d, float* dis) {
+    FAISS_ASSERT(false);
+}
+
 #endif
 
 } // namespace faiss
@@ -35,7 +35,10 @@
 #include <limits.h>
 #include <omp.h>
 
+#include <faiss/FaissHook.h>
+#include <faiss/utils/BinaryDistance.h>
 #include <faiss/utils/Heap.h>
+#include <faiss/utils/ResultHandler.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/utils/utils.h>
 
@@ -264,6 +267,73 @@ size_t match_hamming_thres (
 }
 
 
+/* Same as hammings_knn_hc below for large k, the candidates are collected
+ * into reservoirs. With few queries every thread scans blocks of the
+ * database and keeps its own reservoirs, else the queries are split. */
+template <class HammingComputer>
+static
+void hammings_knn_reservoir (
+        int bytes_per_code,
+        int_maxheap_array_t * ha,
+        const uint8_t * bs1,
+        const uint8_t * bs2,
+        size_t n2,
+        ConcurrentBitsetPtr bitset)
+{
+    typedef ReservoirTopK<CMax<hamdis_t, int64_t>> Reservoir;
+    const size_t bs = Reservoir::batch_size;
+    size_t k = ha->k;
+    size_t nh = ha->nh;
+    size_t n_blocks = (n2 + bs - 1) / bs;
+    size_t thread_max_num = omp_get_max_threads();
+    bool split_db = nh < thread_max_num;
+
+    std::vector<std::vector<Reservoir>> reservoirs (split_db ? thread_max_num : 1,
+                                                    std::vector<Reservoir> (nh, Reservoir (k)));
+    std::vector<HammingComputer> hc (nh);
+    for (size_t i = 0; i < nh; i++) {
+        hc[i].set(bs1 + i * bytes_per_code, bytes_per_code);
+    }
+
+    auto scan_block = [&] (size_t i, size_t b, Reservoir & res) {
+        size_t j0 = b * bs;
+        size_t j1 = std::min (j0 + bs, n2);
+        hamdis_t dis[bs];
+        for (size_t j = j0; j < j1; j++) {
+            dis[j - j0] = hc[i].hamming (bs2 + j * bytes_per_code);
+        }
+        res.add_batch (dis, j1 - j0, [&] (size_t j) -> int64_t {
+            int64_t id = j0 + j;
+            return (bitset && bitset->test(id)) ? -1 : id;
+        });
+    };
+
+    if (split_db) {
+#pragma omp parallel for
+        for (size_t b = 0; b < n_blocks; b++) {
+            size_t thread_no = omp_get_thread_num();
+            for (size_t i = 0; i < nh; i++) {
+                scan_block (i, b, reservoirs[thread_no][i]);
+            }
+        }
+    } else {
+#pragma omp parallel for
+        for (size_t i = 0; i < nh; i++) {
+            for (size_t b = 0; b < n_blocks; b++) {
+                scan_block (i, b, reservoirs[0][i]);
+            }
+        }
+    }
+
+#pragma omp parallel for
+    for (size_t i = 0; i < nh; i++) {
+        for (size_t t = 1; t < reservoirs.size (); t++) {
+            reservoirs[0][i].merge (reservoirs[t][i]);
+        }
+        reservoirs[0][i].finalize (ha->val + i * k, ha->ids + i * k);
+    }
+}
+
 /* Return closest neighbors w.r.t Hamming distance, using a heap. */
 template <class HammingComputer>
 static
@@ -279,6 +349,11 @@ void hammings_knn_hc (
 {
     size_t k = ha->k;
 
+    if (order && init_heap && k >= reservoir_topk_threshold) {
+        hammings_knn_reservoir<HammingComputer> (bytes_per_code, ha, bs1, bs2, n2, bitset);
+        return;
+    }
+
     if ((bytes_per_code + k * (sizeof(hamdis_t) + sizeof(int64_t))) * ha->nh < size_1M) {
         int thread_max_num = omp_get_max_threads();
         // init heap
@@ -645,6 +720,11 @@ void hammings_knn_hc (
         int order,
         ConcurrentBitsetPtr bitset)
 {
+    if (binary_hamming_block && ncodes >= binary_block_min_code_size) {
+        hammings_knn_hc_block(ha, a, b, nb, ncodes, order, bitset);
+        return;
+    }
+
     switch (ncodes) {
     case 4:
         hammings_knn_hc<faiss::HammingComputer4>
@@ -339,6 +339,14 @@ class InstructionSet {
     PREFETCHWT1(void) {
         return f_7_ECX_[0];
     }
+    bool
+    AVX512VNNI(void) {
+        return f_7_ECX_[11];
+    }
+    bool
+    AVX512VPOPCNTDQ(void) {
+        return f_7_ECX_[14];
+    }
 
     bool
     LAHF(void) {
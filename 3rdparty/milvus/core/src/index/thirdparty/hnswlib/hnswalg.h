@@ -1063,6 +1063,12 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
     std::priority_queue<std::pair<dist_t, labeltype >>
     searchKnn(const void *query_data, size_t k, faiss::ConcurrentBitsetPtr bitset) const {
+        return searchKnn(query_data, k, ef_, bitset);
+    }
+
+    // ef of this call only, concurrent searches do not go through setEf
+    std::priority_queue<std::pair<dist_t, labeltype >>
+    searchKnn(const void *query_data, size_t k, size_t ef, faiss::ConcurrentBitsetPtr bitset) const {
         std::priority_queue<std::pair<dist_t, labeltype >> result;
         if (cur_element_count == 0) return result;
 
@@ -1096,12 +1102,12 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
         std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
         if (bitset != nullptr) {
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-                top_candidates1 = searchBaseLayerST<true>(currObj, query_data, std::max(ef_, k), bitset);
+                top_candidates1 = searchBaseLayerST<true>(currObj, query_data, std::max(ef, k), bitset);
             top_candidates.swap(top_candidates1);
         }
         else{
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-                top_candidates1 = searchBaseLayerST<false>(currObj, query_data, std::max(ef_, k), bitset);
+                top_candidates1 = searchBaseLayerST<false>(currObj, query_data, std::max(ef, k), bitset);
             top_candidates.swap(top_candidates1);
         }
         while (top_candidates.size() > k) {
@@ -1117,11 +1123,17 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
     template <typename Comp>
     std::vector<std::pair<dist_t, labeltype>>
-    searchKnn(const void* query_data, size_t k, Comp comp, faiss::ConcurrentBitsetPtr bitset) {
+    searchKnn(const void* query_data, size_t k, Comp comp, faiss::ConcurrentBitsetPtr bitset) const {
+        return searchKnn(query_data, k, ef_, comp, bitset);
+    }
+
+    template <typename Comp>
+    std::vector<std::pair<dist_t, labeltype>>
+    searchKnn(const void* query_data, size_t k, size_t ef, Comp comp, faiss::ConcurrentBitsetPtr bitset) const {
         std::vector<std::pair<dist_t, labeltype>> result;
         if (cur_element_count == 0) return result;
 
-        auto ret = searchKnn(query_data, k, bitset);
+        auto ret = searchKnn(query_data, k, ef, bitset);
 
         while (!ret.empty()) {
             result.push_back(ret.top());
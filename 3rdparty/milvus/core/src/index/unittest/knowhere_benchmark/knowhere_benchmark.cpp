@@ -0,0 +1,403 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <faiss/utils/ConcurrentBitset.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <unordered_set>
+#include <vector>
+
+#include "easyloggingpp/easylogging++.h"
+#include "knowhere/index/vector_index/ConfAdapterMgr.h"
+#include "knowhere/index/vector_index/VecIndexFactory.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+namespace kn = milvus::knowhere;
+
+/*
+ * Knowhere level benchmark, see README.md for the config format.
+ *
+ * For every index in config: build through VecIndexFactory, record build time and memory, then for every
+ * search param, bitset ratio and thread count record recall@k against brute force and per query latency.
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* DEFAULT_CONFIG = R"({
+    "dataset": {"dim": 128, "nb": 100000, "nq": 1000, "metric": "L2", "binary_metric": "HAMMING", "seed": 2020},
+    "topk": 10,
+    "threads": [1, 4],
+    "bitset_ratios": [0.0, 0.1],
+    "indexes": [
+        {"type": "IDMAP", "build": {}, "search": [{}]},
+        {"type": "IVF_FLAT", "build": {"nlist": 1024}, "search": [{"nprobe": 8}, {"nprobe": 32}]},
+        {"type": "IVF_SQ8", "build": {"nlist": 1024, "nbits": 8}, "search": [{"nprobe": 8}, {"nprobe": 32}]},
+        {"type": "IVF_PQ", "build": {"nlist": 1024, "m": 16, "nbits": 8}, "search": [{"nprobe": 8}, {"nprobe": 32}]},
+        {"type": "HNSW", "build": {"M": 16, "efConstruction": 200}, "search": [{"ef": 32}, {"ef": 128}]},
+        {"type": "ANNOY", "build": {"n_trees": 8}, "search": [{"search_k": 100}, {"search_k": 1000}]},
+        {"type": "NSG", "build": {"nlist": 1024, "nprobe": 32, "knng": 50, "search_length": 45, "out_degree": 40,
+                                  "candidate_pool_size": 100}, "search": [{"search_length": 45}]},
+        {"type": "SPTAG_KDT_RNT", "build": {}, "search": [{}]},
+        {"type": "SPTAG_BKT_RNT", "build": {}, "search": [{}]},
+        {"type": "BIN_IDMAP", "build": {}, "search": [{}]},
+        {"type": "BIN_IVF_FLAT", "build": {"nlist": 1024}, "search": [{"nprobe": 8}, {"nprobe": 32}]}
+    ]
+})";
+
+bool
+IsBinaryIndex(const std::string& type) {
+    return type == kn::IndexEnum::INDEX_FAISS_BIN_IDMAP || type == kn::IndexEnum::INDEX_FAISS_BIN_IVFFLAT;
+}
+
+int64_t
+ResidentMemory() {
+    std::ifstream statm("/proc/self/statm");
+    int64_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+double
+ElapsedMs(const Clock::time_point& start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double
+Percentile(std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t pos = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[pos];
+}
+
+struct Dataset {
+    int64_t dim = 0;  // bits for binary data
+    int64_t nb = 0;
+    int64_t nq = 0;
+    std::vector<float> xb;
+    std::vector<float> xq;
+    std::vector<uint8_t> xb_bin;
+    std::vector<uint8_t> xq_bin;
+    std::vector<int64_t> ids;
+
+    const void*
+    Base(bool binary) const {
+        return binary ? static_cast<const void*>(xb_bin.data()) : static_cast<const void*>(xb.data());
+    }
+
+    const void*
+    Query(bool binary, int64_t offset) const {
+        if (binary) {
+            return xq_bin.data() + offset * (dim / 8);
+        }
+        return xq.data() + offset * dim;
+    }
+};
+
+// .fvecs: every vector is stored as int32 dim followed by dim floats
+std::vector<float>
+ReadFvecs(const std::string& path, int64_t limit, int64_t& dim, int64_t& rows) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    std::vector<float> data;
+    int32_t d = 0;
+    rows = 0;
+    while (rows < limit && file.read(reinterpret_cast<char*>(&d), sizeof(d))) {
+        data.resize((rows + 1) * d);
+        file.read(reinterpret_cast<char*>(data.data() + rows * d), d * sizeof(float));
+        ++rows;
+    }
+    dim = d;
+    return data;
+}
+
+void
+LoadDataset(const milvus::json& conf, Dataset& data) {
+    data.dim = conf.value("dim", 128);
+    data.nb = conf.value("nb", 100000);
+    data.nq = conf.value("nq", 1000);
+    std::mt19937 gen(conf.value("seed", 2020));
+
+    std::string base_file = conf.value("base_file", "");
+    std::string query_file = conf.value("query_file", "");
+    if (!base_file.empty() && !query_file.empty()) {
+        // e.g. sift_base.fvecs and sift_query.fvecs of SIFT1M
+        data.xb = ReadFvecs(base_file, data.nb, data.dim, data.nb);
+        data.xq = ReadFvecs(query_file, data.nq, data.dim, data.nq);
+    } else {
+        std::uniform_real_distribution<float> dis(0.0, 1.0);
+        data.xb.resize(data.nb * data.dim);
+        for (auto& v : data.xb) {
+            v = dis(gen);
+        }
+        data.xq.resize(data.nq * data.dim);
+        for (auto& v : data.xq) {
+            v = dis(gen);
+        }
+    }
+
+    std::uniform_int_distribution<int> byte(0, 255);
+    data.xb_bin.resize(data.nb * data.dim / 8);
+    for (auto& v : data.xb_bin) {
+        v = byte(gen);
+    }
+    data.xq_bin.resize(data.nq * data.dim / 8);
+    for (auto& v : data.xq_bin) {
+        v = byte(gen);
+    }
+
+    data.ids.resize(data.nb);
+    for (int64_t i = 0; i < data.nb; ++i) {
+        data.ids[i] = i;
+    }
+}
+
+faiss::ConcurrentBitsetPtr
+GenBitset(int64_t nb, double ratio, uint32_t seed) {
+    if (ratio <= 0) {
+        return nullptr;
+    }
+    auto bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dis(0.0, 1.0);
+    for (int64_t i = 0; i < nb; ++i) {
+        if (dis(gen) < ratio) {
+            bitset->set(i);
+        }
+    }
+    return bitset;
+}
+
+kn::VecIndexPtr
+BuildIndex(const std::string& type, const Dataset& data, const kn::Config& conf) {
+    auto index = kn::VecIndexFactory::GetInstance().CreateVecIndex(type);
+    if (index == nullptr) {
+        throw std::runtime_error("Unsupported index type: " + type);
+    }
+    auto adapter = kn::AdapterMgr::GetInstance().GetAdapter(type);
+    if (!adapter->CheckTrain(const_cast<kn::Config&>(conf), index->index_mode())) {
+        throw std::runtime_error("Illegal build params: " + conf.dump());
+    }
+    auto dataset = kn::GenDatasetWithIds(data.nb, data.dim, data.Base(IsBinaryIndex(type)), data.ids.data());
+    index->BuildAll(dataset, conf);
+    return index;
+}
+
+std::vector<int64_t>
+QueryAll(const kn::VecIndexPtr& index, const Dataset& data, bool binary, const kn::Config& conf) {
+    auto k = conf[kn::meta::TOPK].get<int64_t>();
+    auto result = index->Query(kn::GenDataset(data.nq, data.dim, data.Query(binary, 0)), conf);
+    auto ids = result->Get<int64_t*>(kn::meta::IDS);
+    return std::vector<int64_t>(ids, ids + data.nq * k);
+}
+
+double
+Recall(const std::vector<int64_t>& result, const std::vector<int64_t>& truth, int64_t nq, int64_t k) {
+    int64_t hit = 0, total = 0;
+    for (int64_t i = 0; i < nq; ++i) {
+        std::unordered_set<int64_t> expect;
+        for (int64_t j = 0; j < k; ++j) {
+            if (truth[i * k + j] >= 0) {
+                expect.insert(truth[i * k + j]);
+            }
+        }
+        total += expect.size();
+        for (int64_t j = 0; j < k; ++j) {
+            if (expect.count(result[i * k + j])) {
+                ++hit;
+            }
+        }
+    }
+    return total == 0 ? 1.0 : static_cast<double>(hit) / total;
+}
+
+milvus::json
+RunSearch(const kn::VecIndexPtr& index, const Dataset& data, bool binary, const kn::Config& conf, int threads,
+          const std::vector<int64_t>& truth) {
+    auto k = conf[kn::meta::TOPK].get<int64_t>();
+    std::vector<int64_t> result(data.nq * k, -1);
+    std::vector<double> latency(data.nq, 0);
+    std::atomic<int64_t> next(0);
+
+    auto worker = [&]() {
+        while (true) {
+            int64_t i = next.fetch_add(1);
+            if (i >= data.nq) {
+                break;
+            }
+            auto start = Clock::now();
+            auto res = index->Query(kn::GenDataset(1, data.dim, data.Query(binary, i)), conf);
+            latency[i] = ElapsedMs(start);
+            auto ids = res->Get<int64_t*>(kn::meta::IDS);
+            std::copy(ids, ids + k, result.begin() + i * k);
+        }
+    };
+
+    auto start = Clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    for (auto& th : pool) {
+        th.join();
+    }
+    double total_ms = ElapsedMs(start);
+
+    std::sort(latency.begin(), latency.end());
+    milvus::json ret;
+    ret["threads"] = threads;
+    ret["recall"] = Recall(result, truth, data.nq, k);
+    ret["qps"] = data.nq * 1000.0 / total_ms;
+    ret["latency_ms"] = {{"p50", Percentile(latency, 0.5)},
+                         {"p95", Percentile(latency, 0.95)},
+                         {"p99", Percentile(latency, 0.99)},
+                         {"max", latency.empty() ? 0 : latency.back()}};
+    return ret;
+}
+
+milvus::json
+RunIndex(const milvus::json& index_conf, const Dataset& data, const milvus::json& bench_conf) {
+    std::string type = index_conf["type"];
+    bool binary = IsBinaryIndex(type);
+    int64_t topk = bench_conf.value("topk", 10);
+    std::string metric = binary ? bench_conf["dataset"].value("binary_metric", kn::Metric::HAMMING)
+                                : bench_conf["dataset"].value("metric", kn::Metric::L2);
+    uint32_t seed = bench_conf["dataset"].value("seed", 2020);
+
+    kn::Config base_conf = index_conf.value("build", milvus::json::object());
+    base_conf[kn::meta::DIM] = data.dim;
+    base_conf[kn::meta::ROWS] = data.nb;
+    base_conf[kn::meta::TOPK] = topk;
+    base_conf[kn::meta::DEVICEID] = 0;
+    base_conf[kn::Metric::TYPE] = metric;
+
+    milvus::json report;
+    report["type"] = type;
+    report["metric"] = metric;
+    report["build_params"] = index_conf.value("build", milvus::json::object());
+
+    int64_t rss_before = ResidentMemory();
+    auto start = Clock::now();
+    auto index = BuildIndex(type, data, base_conf);
+    report["build_ms"] = ElapsedMs(start);
+    report["rss_delta_bytes"] = ResidentMemory() - rss_before;
+    try {
+        int64_t serialized = 0;
+        auto binary_set = index->Serialize(base_conf);
+        for (auto& item : binary_set.binary_map_) {
+            serialized += item.second->size;
+        }
+        report["serialized_bytes"] = serialized;
+    } catch (std::exception& e) {
+        report["serialized_bytes"] = nullptr;
+    }
+
+    // brute force ground truth shares the index layer with the benchmarked index, bitset included
+    auto truth_type = binary ? kn::IndexEnum::INDEX_FAISS_BIN_IDMAP : kn::IndexEnum::INDEX_FAISS_IDMAP;
+    kn::Config truth_conf = {{kn::meta::DIM, data.dim},
+                             {kn::meta::ROWS, data.nb},
+                             {kn::meta::TOPK, topk},
+                             {kn::Metric::TYPE, metric}};
+    auto truth_index = BuildIndex(truth_type, data, truth_conf);
+
+    for (auto& ratio : bench_conf.value("bitset_ratios", std::vector<double>{0.0})) {
+        auto bitset = GenBitset(data.nb, ratio, seed);
+        index->SetBlacklist(bitset);
+        truth_index->SetBlacklist(bitset);
+        auto truth = QueryAll(truth_index, data, binary, truth_conf);
+
+        for (auto& search_params : index_conf.value("search", std::vector<milvus::json>{milvus::json::object()})) {
+            kn::Config conf = base_conf;
+            for (auto& item : search_params.items()) {
+                conf[item.key()] = item.value();
+            }
+            auto adapter = kn::AdapterMgr::GetInstance().GetAdapter(type);
+            if (!adapter->CheckSearch(conf, index->index_type(), index->index_mode())) {
+                std::cerr << type << " skip illegal search params: " << search_params.dump() << std::endl;
+                continue;
+            }
+
+            for (auto& threads : bench_conf.value("threads", std::vector<int>{1})) {
+                auto run = RunSearch(index, data, binary, conf, threads, truth);
+                run["bitset_ratio"] = ratio;
+                run["search_params"] = search_params;
+                std::cout << type << " " << search_params.dump() << " bitset " << ratio << " threads " << threads
+                          << ": recall " << run["recall"] << " qps " << run["qps"] << " p99 "
+                          << run["latency_ms"]["p99"] << " ms" << std::endl;
+                report["searches"].push_back(run);
+            }
+        }
+    }
+    index->SetBlacklist(nullptr);
+    return report;
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+    if (argc > 1 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")) {
+        std::cout << "Usage: " << argv[0] << " [config.json] [result.json]" << std::endl;
+        return 0;
+    }
+
+    milvus::json bench_conf;
+    if (argc > 1) {
+        std::ifstream file(argv[1]);
+        if (!file.is_open()) {
+            std::cerr << "Cannot open config file " << argv[1] << std::endl;
+            return 1;
+        }
+        file >> bench_conf;
+    } else {
+        bench_conf = milvus::json::parse(DEFAULT_CONFIG);
+    }
+    std::string output = (argc > 2) ? argv[2] : "knowhere_benchmark.json";
+
+    Dataset data;
+    LoadDataset(bench_conf["dataset"], data);
+
+    milvus::json report;
+    report["dataset"] = {{"dim", data.dim}, {"nb", data.nb}, {"nq", data.nq}};
+    report["topk"] = bench_conf.value("topk", 10);
+    report["indexes"] = milvus::json::array();
+    for (auto& index_conf : bench_conf["indexes"]) {
+        try {
+            report["indexes"].push_back(RunIndex(index_conf, data, bench_conf));
+        } catch (std::exception& e) {
+            std::cerr << "Benchmark " << index_conf.dump() << " failed: " << e.what() << std::endl;
+            report["indexes"].push_back({{"type", index_conf["type"]}, {"error", e.what()}});
+        }
+    }
+
+    std::ofstream out(output);
+    out << report.dump(4) << std::endl;
+    std::cout << "Result written to " << output << std::endl;
+    return 0;
+}
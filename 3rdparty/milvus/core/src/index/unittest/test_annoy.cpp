@@ -13,6 +13,7 @@
 #include <src/index/knowhere/knowhere/index/vector_index/helpers/IndexParameter.h>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexAnnoy.h"
@@ -306,3 +307,36 @@ main() {
     return 0;
 }
 */
+
+TEST_P(AnnoyTest, annoy_load_mapped) {
+    index_->BuildAll(base_dataset, conf);
+    auto result1 = index_->Query(query_dataset, conf);
+    AssertAnns(result1, nq, k);
+
+    // keep the trees in a file behind some header, at an offset which is not page aligned
+    auto binaryset = index_->Serialize();
+    auto bin_data = binaryset.GetByName("annoy_index_data");
+    std::string filename = "/tmp/annoy_test_load_mapped.bin";
+    const int64_t offset = 100;
+    {
+        std::vector<uint8_t> header(offset, 0);
+        FileIOWriter writer(filename);
+        writer(static_cast<void*>(header.data()), offset);
+        writer(static_cast<void*>(bin_data->data.get()), bin_data->size);
+    }
+
+    auto mapped = std::make_shared<milvus::knowhere::IndexAnnoy>();
+    mapped->LoadMapped(binaryset, filename, offset, bin_data->size);
+    EXPECT_EQ(mapped->Count(), nb);
+    EXPECT_EQ(mapped->Dim(), dim);
+
+    auto result2 = mapped->Query(query_dataset, conf);
+    auto ids1 = result1->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto ids2 = result2->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (auto i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(ids1[i], ids2[i]);
+    }
+
+    auto bad = std::make_shared<milvus::knowhere::IndexAnnoy>();
+    ASSERT_ANY_THROW(bad->LoadMapped(binaryset, filename, offset, bin_data->size - 1));
+}
@@ -11,6 +11,8 @@
 
 #include <gtest/gtest.h>
 
+#include <faiss/FaissHook.h>
+
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
 
@@ -123,3 +125,52 @@ TEST_P(BinaryIDMAPTest, binaryidmap_serialize) {
         //        PrintResult(result, nq, k);
     }
 }
+
+TEST_P(BinaryIDMAPTest, binaryidmap_simd_kernels) {
+    std::string cpu_flag;
+    faiss::hook_init(cpu_flag);
+    auto hamming_block = faiss::binary_hamming_block;
+    auto jaccard_block = faiss::binary_jaccard_block;
+    if (hamming_block == nullptr || jaccard_block == nullptr) {
+        return;  // no SIMD kernels on this CPU
+    }
+
+    // 125 bytes codes go through the block kernels, including the tail handling
+    Generate(1000, nb, nq, true);
+
+    std::string MetricType = GetParam();
+    milvus::knowhere::Config conf{
+        {milvus::knowhere::meta::DIM, dim},
+        {milvus::knowhere::meta::TOPK, k},
+        {milvus::knowhere::Metric::TYPE, MetricType},
+    };
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+
+    auto compare_with_scalar = [&]() {
+        faiss::binary_hamming_block = nullptr;
+        faiss::binary_jaccard_block = nullptr;
+        auto expect = index_->Query(query_dataset, conf);
+        faiss::binary_hamming_block = hamming_block;
+        faiss::binary_jaccard_block = jaccard_block;
+        auto result = index_->Query(query_dataset, conf);
+
+        auto expect_dist = expect->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        auto result_dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        for (int64_t i = 0; i < nq * k; ++i) {
+            EXPECT_FLOAT_EQ(expect_dist[i], result_dist[i]);
+        }
+        return result;
+    };
+
+    auto result = compare_with_scalar();
+    AssertAnns(result, nq, k);
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    index_->SetBlacklist(concurrent_bitset_ptr);
+    result = compare_with_scalar();
+    AssertAnns(result, nq, k, CheckMode::CHECK_NOT_EQUAL);
+}
@@ -13,6 +13,8 @@
 #include <iostream>
 #include <thread>
 
+#include <faiss/FaissHook.h>
+
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Timer.h"
 #include "knowhere/index/vector_index/IndexBinaryIVF.h"
@@ -84,6 +86,35 @@ TEST_P(BinaryIVFTest, binaryivf_basic) {
     //    AssertBinVeceq(result4, base_dataset, xid_dataset, nq, dim/8);
 }
 
+TEST_P(BinaryIVFTest, binaryivf_simd_kernels) {
+    std::string cpu_flag;
+    faiss::hook_init(cpu_flag);
+    auto hamming_block = faiss::binary_hamming_block;
+    auto jaccard_block = faiss::binary_jaccard_block;
+    if (hamming_block == nullptr || jaccard_block == nullptr) {
+        return;  // no SIMD kernels on this CPU
+    }
+
+    // lists of 125 bytes codes are scanned by the block kernels
+    Generate(1000, nb, nq, true);
+    conf[milvus::knowhere::meta::DIM] = dim;
+    index_->Train(base_dataset, conf);
+
+    faiss::binary_hamming_block = nullptr;
+    faiss::binary_jaccard_block = nullptr;
+    auto expect = index_->Query(query_dataset, conf);
+    faiss::binary_hamming_block = hamming_block;
+    faiss::binary_jaccard_block = jaccard_block;
+    auto result = index_->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    auto expect_dist = expect->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    auto result_dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_FLOAT_EQ(expect_dist[i], result_dist[i]);
+    }
+}
+
 TEST_P(BinaryIVFTest, binaryivf_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
         FileIOWriter writer(filename);
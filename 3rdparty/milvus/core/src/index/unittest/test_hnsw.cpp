@@ -12,9 +12,14 @@
 #include <gtest/gtest.h>
 #include <knowhere/index/vector_index/IndexHNSW.h>
 #include <src/index/knowhere/knowhere/index/vector_index/helpers/IndexParameter.h>
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <random>
+#include <thread>
+#include <vector>
 #include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "unittest/utils.h"
 
 using ::testing::Combine;
@@ -56,6 +61,43 @@ TEST_P(HNSWTest, HNSW_basic) {
     AssertAnns(result, nq, k);
 }
 
+TEST_P(HNSWTest, HNSW_concurrent_query) {
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+
+    // each ef gives the same results alone and next to queries with other efs
+    const std::vector<int64_t> efs = {10, 50, 200};
+    std::vector<milvus::knowhere::Config> confs;
+    std::vector<std::vector<int64_t>> expect_ids;
+    for (auto ef : efs) {
+        milvus::knowhere::Config ef_conf = conf;
+        ef_conf[milvus::knowhere::IndexParams::ef] = ef;
+        auto result = index_->Query(query_dataset, ef_conf);
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        expect_ids.emplace_back(ids, ids + nq * k);
+        confs.push_back(ef_conf);
+    }
+
+    std::atomic<int64_t> mismatch(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 6; ++t) {
+        threads.emplace_back([&, t]() {
+            size_t p = t % efs.size();
+            for (int64_t round = 0; round < 20; ++round) {
+                auto result = index_->Query(query_dataset, confs[p]);
+                auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+                if (!std::equal(expect_ids[p].begin(), expect_ids[p].end(), ids)) {
+                    ++mismatch;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(0, mismatch);
+}
+
 TEST_P(HNSWTest, HNSW_delete) {
     assert(!xb.empty());
 
@@ -130,6 +172,27 @@ TEST_P(HNSWTest, HNSW_serialize) {
     }
 }
 
+TEST_P(HNSWTest, HNSW_add_to_loaded) {
+    auto half = nb / 2;
+    auto first_half = milvus::knowhere::GenDatasetWithIds(half, dim, xb.data(), ids.data());
+    auto second_half = milvus::knowhere::GenDatasetWithIds(nb - half, dim, xb.data() + half * dim, ids.data() + half);
+
+    index_->Train(first_half, conf);
+    index_->Add(first_half, conf);
+    auto binaryset = index_->Serialize();
+
+    auto loaded = std::make_shared<milvus::knowhere::IndexHNSW>();
+    loaded->Load(binaryset);
+    EXPECT_EQ(loaded->Count(), half);
+
+    loaded->Add(second_half, conf);
+    EXPECT_EQ(loaded->Count(), nb);
+    EXPECT_EQ(loaded->Dim(), dim);
+
+    auto result = loaded->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+}
+
 /*
  * faiss style test
  * keep it
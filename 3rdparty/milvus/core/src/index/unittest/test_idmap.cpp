@@ -13,9 +13,12 @@
 
 #include <fiu-control.h>
 #include <fiu-local.h>
+#include <cmath>
 #include <iostream>
 #include <thread>
 
+#include <faiss/FaissHook.h>
+
 #include "knowhere/common/Exception.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "knowhere/index/vector_index/IndexType.h"
@@ -124,6 +127,60 @@ TEST_P(IDMAPTest, idmap_basic) {
     AssertVec(result_bs_3, base_dataset, xid_dataset, 1, dim, CheckMode::CHECK_NOT_EQUAL);
 }
 
+TEST_P(IDMAPTest, idmap_simd_kernels) {
+    std::string cpu_flag;
+    faiss::hook_init(cpu_flag);
+    auto l2_block = faiss::fvec_L2sqr_block;
+    auto ip_block = faiss::fvec_inner_product_block;
+    if (l2_block == nullptr || ip_block == nullptr) {
+        return;  // no SIMD kernels on this CPU
+    }
+
+    // 125 dimensions go through the block kernels, including the tail handling
+    Generate(125, nb, nq);
+
+    for (auto metric : {milvus::knowhere::Metric::L2, milvus::knowhere::Metric::IP}) {
+        milvus::knowhere::Config conf{{milvus::knowhere::meta::DIM, dim},
+                                      {milvus::knowhere::meta::TOPK, k},
+                                      {milvus::knowhere::Metric::TYPE, metric}};
+        index_ = std::make_shared<milvus::knowhere::IDMAP>();
+        index_->Train(base_dataset, conf);
+        index_->Add(base_dataset, conf);
+
+        auto compare_with_blas = [&]() {
+            faiss::fvec_L2sqr_block = nullptr;
+            faiss::fvec_inner_product_block = nullptr;
+            auto expect = index_->Query(query_dataset, conf);
+            faiss::fvec_L2sqr_block = l2_block;
+            faiss::fvec_inner_product_block = ip_block;
+            auto result = index_->Query(query_dataset, conf);
+
+            // the kernels sum in another order than sgemm
+            auto expect_dist = expect->Get<float*>(milvus::knowhere::meta::DISTANCE);
+            auto result_dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+            for (int64_t i = 0; i < nq * k; ++i) {
+                EXPECT_NEAR(expect_dist[i], result_dist[i], 1e-4 * (std::abs(expect_dist[i]) + 1));
+            }
+            return result;
+        };
+
+        if (metric == milvus::knowhere::Metric::L2) {
+            auto result = compare_with_blas();
+            AssertAnns(result, nq, k);
+        } else {
+            compare_with_blas();
+        }
+
+        faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+        for (int64_t i = 0; i < nq; ++i) {
+            concurrent_bitset_ptr->set(i);
+        }
+        index_->SetBlacklist(concurrent_bitset_ptr);
+        auto result = compare_with_blas();
+        AssertAnns(result, nq, k, CheckMode::CHECK_NOT_EQUAL);
+    }
+}
+
 TEST_P(IDMAPTest, idmap_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
         FileIOWriter writer(filename);
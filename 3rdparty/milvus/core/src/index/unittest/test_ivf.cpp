@@ -13,17 +13,31 @@
 
 #include <fiu-control.h>
 #include <fiu-local.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <random>
+#include <string>
 #include <thread>
 
+#include <faiss/FaissHook.h>
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFFlat.h>
+#include <faiss/IndexIVFPQFastScan.h>
+#include <faiss/IndexScalarQuantizer.h>
+#include <faiss/impl/pq4_fast_scan.h>
+#include <faiss/impl/sq8_int_scan.h>
 #ifdef MILVUS_GPU_VERSION
 #include <faiss/gpu/GpuIndexIVFFlat.h>
 #endif
 
 #include "knowhere/common/Exception.h"
 #include "knowhere/common/Timer.h"
+#include "knowhere/index/vector_index/ConfAdapterMgr.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
 #include "knowhere/index/vector_index/IndexIVFSQ.h"
 #include "knowhere/index/vector_index/IndexType.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -88,6 +102,7 @@ INSTANTIATE_TEST_CASE_P(
 #endif
         std::make_tuple(milvus::knowhere::IndexEnum::INDEX_FAISS_IVFFLAT, milvus::knowhere::IndexMode::MODE_CPU),
         std::make_tuple(milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQ, milvus::knowhere::IndexMode::MODE_CPU),
+        std::make_tuple(milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQFASTSCAN, milvus::knowhere::IndexMode::MODE_CPU),
         std::make_tuple(milvus::knowhere::IndexEnum::INDEX_FAISS_IVFSQ8, milvus::knowhere::IndexMode::MODE_CPU)));
 
 TEST_P(IVFTest, ivf_basic_cpu) {
@@ -110,7 +125,8 @@ TEST_P(IVFTest, ivf_basic_cpu) {
     AssertAnns(result, nq, k);
     // PrintResult(result, nq, k);
 
-    if (index_type_ != milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQ) {
+    if (index_type_ != milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQ &&
+        index_type_ != milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQFASTSCAN) {
         auto result2 = index_->QueryById(id_dataset, conf_);
         AssertAnns(result2, nq, k);
 
@@ -146,6 +162,363 @@ TEST_P(IVFTest, ivf_basic_cpu) {
 #endif
 }
 
+TEST_P(IVFTest, ivf_selective_bitset_cpu) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->Add(base_dataset, conf_);
+
+    // keep 1% of the ids, far less than nprobe lists can hold on average
+    const int64_t step = 100;
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nb; ++i) {
+        if (i % step != 0) {
+            concurrent_bitset_ptr->set(i);
+        }
+    }
+    ASSERT_EQ(nb - nb / step, concurrent_bitset_ptr->count());
+    index_->SetBlacklist(concurrent_bitset_ptr);
+
+    auto result = index_->Query(query_dataset, conf_);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto dists = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    // fast scan does not compact the lists, so it keeps nprobe and topk may not be filled
+    bool fast_scan = index_type_ == milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQFASTSCAN;
+    for (int64_t i = 0; i < nq; ++i) {
+        for (int64_t j = 0; j < k; ++j) {
+            if (fast_scan && ids[i * k + j] < 0) {
+                continue;
+            }
+            ASSERT_GE(ids[i * k + j], 0);
+            ASSERT_EQ(0, ids[i * k + j] % step);
+        }
+    }
+
+    // all lists are probed, so IVF_FLAT equals brute force over the survivors
+    if (index_type_ == milvus::knowhere::IndexEnum::INDEX_FAISS_IVFFLAT) {
+        for (int64_t i = 0; i < nq; ++i) {
+            std::vector<std::pair<float, int64_t>> expect;
+            for (int64_t id = 0; id < nb; id += step) {
+                float dis = 0;
+                for (int64_t d = 0; d < dim; ++d) {
+                    float diff = xq[i * dim + d] - xb[id * dim + d];
+                    dis += diff * diff;
+                }
+                expect.emplace_back(dis, id);
+            }
+            std::sort(expect.begin(), expect.end());
+            for (int64_t j = 0; j < k; ++j) {
+                ASSERT_NEAR(expect[j].first, dists[i * k + j], 1e-3);
+            }
+        }
+    }
+}
+
+TEST_P(IVFTest, ivf_concurrent_query_cpu) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->Add(base_dataset, conf_);
+
+    // each nprobe gives the same results alone and next to queries with other nprobes
+    const std::vector<int64_t> nprobes = {1, 4, 16, 64};
+    std::vector<milvus::knowhere::Config> confs;
+    std::vector<std::vector<int64_t>> expect_ids;
+    for (auto nprobe : nprobes) {
+        milvus::knowhere::Config conf = conf_;
+        conf[milvus::knowhere::IndexParams::nprobe] = nprobe;
+        auto result = index_->Query(query_dataset, conf);
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        expect_ids.emplace_back(ids, ids + nq * k);
+        confs.push_back(conf);
+    }
+
+    std::atomic<int64_t> mismatch(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t]() {
+            size_t p = t % nprobes.size();
+            for (int64_t round = 0; round < 20; ++round) {
+                auto result = index_->Query(query_dataset, confs[p]);
+                auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+                if (!std::equal(expect_ids[p].begin(), expect_ids[p].end(), ids)) {
+                    ++mismatch;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(0, mismatch);
+}
+
+TEST_P(IVFTest, ivf_lists_on_disk_cpu) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    index_->Train(base_dataset, conf_);
+    index_->Add(base_dataset, conf_);
+    auto expect = index_->Query(query_dataset, conf_);
+    auto expect_ids = expect->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto expect_dists = expect->Get<float*>(milvus::knowhere::meta::DISTANCE);
+
+    const std::string path = "/tmp/knowhere_ivf_lists_on_disk";
+    if (index_type_ == milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQFASTSCAN) {
+        // the codes are packed by blocks of vectors
+        ASSERT_ANY_THROW(index_->MoveListsToDisk(path));
+        return;
+    }
+    index_->MoveListsToDisk(path);
+    ASSERT_EQ(0, access(path.c_str(), F_OK));
+    // only centroids and list metadata stay resident
+    ASSERT_LT(index_->IndexSize(), nb * dim);
+    ASSERT_EQ(nb, index_->Count());
+
+    auto result = index_->Query(query_dataset, conf_);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto dists = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(expect_ids[i], ids[i]);
+        ASSERT_FLOAT_EQ(expect_dists[i], dists[i]);
+    }
+
+    // the serialized index refers to the lists, loading maps them instead of reading them
+    auto binaryset = index_->Serialize();
+    ASSERT_LT(binaryset.GetByName("IVF")->size, nb * dim);
+    index_ = nullptr;
+    ASSERT_EQ(0, access(path.c_str(), F_OK));
+
+    auto loaded = IndexFactory(index_type_, index_mode_);
+    loaded->Load(binaryset);
+    ASSERT_EQ(nb, loaded->Count());
+    result = loaded->Query(query_dataset, conf_);
+    ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    dists = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(expect_ids[i], ids[i]);
+        ASSERT_FLOAT_EQ(expect_dists[i], dists[i]);
+    }
+    loaded = nullptr;
+    unlink(path.c_str());
+}
+
+TEST_P(IVFTest, ivf_pre_transform_cpu) {
+    if (index_mode_ != milvus::knowhere::IndexMode::MODE_CPU) {
+        return;
+    }
+
+    // OPQ for the PQ indexes, PCA for the others, both halving the dimension
+    bool is_pq = index_type_ == milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQ ||
+                 index_type_ == milvus::knowhere::IndexEnum::INDEX_FAISS_IVFPQFASTSCAN;
+    conf_[milvus::knowhere::IndexParams::pre_transform] =
+        is_pq ? milvus::knowhere::PreTransform::OPQ : milvus::knowhere::PreTransform::PCA;
+    conf_[milvus::knowhere::IndexParams::pre_transform_dim] = dim / 2;
+    auto adapter = milvus::knowhere::AdapterMgr::GetInstance().GetAdapter(index_type_);
+    auto check_conf = conf_;
+    check_conf[milvus::knowhere::meta::ROWS] = nb;
+    ASSERT_TRUE(adapter->CheckTrain(check_conf, index_mode_));
+
+    // OPQ alternates many PQ trainings, keep the training set small
+    auto train_dataset = milvus::knowhere::GenDataset(nb / 5, dim, xb.data());
+    index_->Train(train_dataset, conf_);
+    index_->Add(base_dataset, conf_);
+    ASSERT_TRUE(index_->IsPreTransformed());
+    EXPECT_EQ(index_->Count(), nb);
+    EXPECT_EQ(index_->Dim(), dim);
+    auto result = index_->Query(query_dataset, conf_);
+    AssertAnns(result, nq, k);
+
+    // the transform is serialized with the index
+    auto loaded = IndexFactory(index_type_, index_mode_);
+    loaded->Load(index_->Serialize());
+    ASSERT_TRUE(loaded->IsPreTransformed());
+    auto result2 = loaded->Query(query_dataset, conf_);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto ids2 = result2->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        ASSERT_EQ(ids[i], ids2[i]);
+    }
+
+    if (index_type_ == milvus::knowhere::IndexEnum::INDEX_FAISS_IVFFLAT) {
+        // a vector comes back as its projection on the principal components, closer to it than the mean
+        auto result3 = index_->GetVectorById(xid_dataset, conf_);
+        auto x = result3->Get<float*>(milvus::knowhere::meta::TENSOR);
+        auto id = xid_dataset->Get<const int64_t*>(milvus::knowhere::meta::IDS)[0];
+        std::vector<float> mean(dim, 0);
+        for (int64_t i = 0; i < nb; ++i) {
+            for (int64_t j = 0; j < dim; ++j) {
+                mean[j] += xb[i * dim + j] / nb;
+            }
+        }
+        float err = 0, spread = 0;
+        for (int64_t j = 0; j < dim; ++j) {
+            float base = xb[id * dim + j];
+            err += (base - x[j]) * (base - x[j]);
+            spread += (base - mean[j]) * (base - mean[j]);
+        }
+        ASSERT_LT(err, spread);
+    }
+
+    // PCA centers the vectors, which does not preserve inner products
+    check_conf[milvus::knowhere::IndexParams::pre_transform] = milvus::knowhere::PreTransform::PCA;
+    check_conf[milvus::knowhere::Metric::TYPE] = milvus::knowhere::Metric::IP;
+    ASSERT_FALSE(adapter->CheckTrain(check_conf, index_mode_));
+}
+
+TEST(IVFBitsetTest, nprobe_kept_for_loose_bitset) {
+    const int64_t d = 16, nlist = 100, nb = 10000, nq = 10, k = 100;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(0, 1);
+    std::vector<float> xb(nb * d), xq(nq * d);
+    for (auto& x : xb) x = dist(rng);
+    for (auto& x : xq) x = dist(rng);
+
+    faiss::IndexFlatL2 quantizer(d);
+    faiss::IndexIVFFlat index(&quantizer, d, nlist, faiss::METRIC_L2);
+    index.train(nb, xb.data());
+    index.add(nb, xb.data());
+    index.nprobe = 1;
+
+    std::vector<float> dis(nq * k);
+    std::vector<int64_t> ids(nq * k);
+    auto bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+
+    // a single deleted id leaves less than k survivors per probed list on
+    // average, but the filter is not selective: nprobe stays as configured
+    bitset->set(0);
+    faiss::indexIVF_stats.reset();
+    index.search(nq, xq.data(), k, dis.data(), ids.data(), bitset);
+    ASSERT_LE(faiss::indexIVF_stats.nlist, nq * index.nprobe);
+    for (auto id : ids) {
+        ASSERT_NE(0, id);
+    }
+
+    // 1% of the ids survive: all lists are probed to fill topk
+    bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nb; ++i) {
+        if (i % 100 != 0) {
+            bitset->set(i);
+        }
+    }
+    faiss::indexIVF_stats.reset();
+    index.search(nq, xq.data(), k, dis.data(), ids.data(), bitset);
+    ASSERT_GT(faiss::indexIVF_stats.nlist, nq * index.nprobe);
+    for (auto id : ids) {
+        ASSERT_GE(id, 0);
+        ASSERT_EQ(0, id % 100);
+    }
+}
+
+TEST(IVFPQFastScanTest, fast_scan_exact) {
+    std::string cpu_flag;
+    faiss::hook_init(cpu_flag);
+
+    // the hooked kernel against the scalar one, odd and even code sizes
+    std::mt19937 rng(1);
+    for (size_t code_size : {1, 3, 8, 13}) {
+        const size_t nblock = 3;
+        std::vector<uint8_t> codes(nblock * faiss::pq4_block_size * code_size), lut(32 * code_size);
+        for (auto& c : codes) c = rng() & 0xff;
+        for (auto& c : lut) c = rng() & 0xff;
+        std::vector<uint16_t> expect(nblock * faiss::pq4_block_size), dis(nblock * faiss::pq4_block_size);
+        faiss::pq4_accumulate_ref(codes.data(), nblock, code_size, lut.data(), expect.data());
+        faiss::pq4_accumulate(codes.data(), nblock, code_size, lut.data(), dis.data());
+        ASSERT_EQ(expect, dis);
+    }
+
+    // probing all lists, the results are those of brute force over the decoded vectors
+    const int64_t d = 63, m = 7, nlist = 16, nb = 5000, nq = 20, k = 10;
+    std::uniform_real_distribution<float> dist(0, 1);
+    std::vector<float> xb(nb * d), xq(nq * d);
+    for (auto& x : xb) x = dist(rng);
+    for (auto& x : xq) x = dist(rng);
+
+    for (auto metric : {faiss::METRIC_L2, faiss::METRIC_INNER_PRODUCT}) {
+        faiss::IndexFlat quantizer(d, metric);
+        faiss::IndexIVFPQFastScan index(&quantizer, d, nlist, m, metric);
+        index.train(nb, xb.data());
+        index.add(nb, xb.data());
+        index.nprobe = nlist;
+        index.make_direct_map();
+
+        std::vector<float> decoded(nb * d);
+        for (int64_t i = 0; i < nb; ++i) {
+            index.reconstruct(i, decoded.data() + i * d);
+        }
+        faiss::IndexFlat flat(d, metric);
+        flat.add(nb, decoded.data());
+
+        std::vector<float> expect_dis(nq * k), dis(nq * k);
+        std::vector<int64_t> expect_ids(nq * k), ids(nq * k);
+        flat.search(nq, xq.data(), k, expect_dis.data(), expect_ids.data());
+        index.search(nq, xq.data(), k, dis.data(), ids.data());
+        for (int64_t i = 0; i < nq * k; ++i) {
+            ASSERT_EQ(expect_ids[i], ids[i]);
+            ASSERT_NEAR(expect_dis[i], dis[i], 1e-3);
+        }
+    }
+}
+
+TEST(IVFSQTest, sq8_int_scan_exact) {
+    std::string cpu_flag;
+    faiss::hook_init(cpu_flag);
+    if (faiss::sq8_dot == nullptr) {
+        return;
+    }
+
+    // the hooked kernel against the scalar one, with tails of the codes and the blocks
+    std::mt19937 rng(1);
+    for (size_t d : {1, 37, 64, 100, 130}) {
+        const size_t n = 29;
+        size_t dpad = (d + faiss::sq8_weight_block - 1) / faiss::sq8_weight_block * faiss::sq8_weight_block;
+        std::vector<uint8_t> codes(n * d);
+        std::vector<int8_t> w_hi(dpad, 0), w_lo(dpad, 0);
+        for (auto& c : codes) c = rng() & 0xff;
+        for (size_t i = 0; i < d; ++i) {
+            w_hi[i] = static_cast<int>(rng() % 129) - 64;
+            w_lo[i] = static_cast<int>(rng() % 129) - 64;
+        }
+        std::vector<int32_t> expect_hi(n), expect_lo(n), dot_hi(n), dot_lo(n);
+        faiss::sq8_dot_ref(codes.data(), n, d, w_hi.data(), w_lo.data(), expect_hi.data(), expect_lo.data());
+        faiss::sq8_dot(codes.data(), n, d, w_hi.data(), w_lo.data(), dot_hi.data(), dot_lo.data());
+        ASSERT_EQ(expect_hi, dot_hi);
+        ASSERT_EQ(expect_lo, dot_lo);
+    }
+
+    // the integer scan gives the results of the float scanners
+    const int64_t d = 70, nlist = 16, nb = 5000, nq = 20, k = 10;
+    std::uniform_real_distribution<float> dist(-1, 1);
+    std::vector<float> xb(nb * d), xq(nq * d);
+    for (auto& x : xb) x = dist(rng);
+    for (auto& x : xq) x = dist(rng);
+
+    auto sq8_dot = faiss::sq8_dot;
+    for (auto qtype : {faiss::QuantizerType::QT_8bit, faiss::QuantizerType::QT_8bit_uniform}) {
+        for (auto metric : {faiss::METRIC_L2, faiss::METRIC_INNER_PRODUCT}) {
+            faiss::IndexFlat quantizer(d, metric);
+            faiss::IndexIVFScalarQuantizer index(&quantizer, d, nlist, qtype, metric);
+            index.train(nb, xb.data());
+            index.add(nb, xb.data());
+            index.nprobe = 4;
+
+            std::vector<float> expect_dis(nq * k), dis(nq * k);
+            std::vector<int64_t> expect_ids(nq * k), ids(nq * k);
+            faiss::sq8_dot = nullptr;
+            index.search(nq, xq.data(), k, expect_dis.data(), expect_ids.data());
+            faiss::sq8_dot = sq8_dot;
+            index.search(nq, xq.data(), k, dis.data(), ids.data());
+            ASSERT_EQ(expect_ids, ids);
+            ASSERT_EQ(expect_dis, dis);
+        }
+    }
+}
+
 TEST_P(IVFTest, ivf_basic_gpu) {
     assert(!xb.empty());
 
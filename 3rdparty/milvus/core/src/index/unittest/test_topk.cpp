@@ -0,0 +1,243 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <faiss/FaissHook.h>
+#include <faiss/IndexBinaryFlat.h>
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexIVFFlat.h>
+#include <faiss/utils/ConcurrentBitset.h>
+#include <faiss/utils/Heap.h>
+#include <faiss/utils/ResultHandler.h>
+
+namespace {
+
+constexpr size_t HEAP_ONLY = size_t(-1);
+
+class TopkTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        std::string cpu_flag;
+        faiss::hook_init(cpu_flag);
+        threshold_ = faiss::reservoir_topk_threshold;
+    }
+
+    void
+    TearDown() override {
+        faiss::reservoir_topk_threshold = threshold_;
+    }
+
+    std::vector<float>
+    RandomFloats(size_t n, int seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(-1.0, 1.0);
+        std::vector<float> x(n);
+        for (auto& v : x) {
+            v = dist(rng);
+        }
+        return x;
+    }
+
+    std::vector<uint8_t>
+    RandomBytes(size_t n, int seed) {
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> x(n);
+        for (auto& v : x) {
+            v = rng() & 0xff;
+        }
+        return x;
+    }
+
+    faiss::ConcurrentBitsetPtr
+    EveryThird(size_t n) {
+        auto bitset = std::make_shared<faiss::ConcurrentBitset>(n);
+        for (size_t i = 0; i < n; i += 3) {
+            bitset->set(i);
+        }
+        return bitset;
+    }
+
+    // the same search with the heaps and with the reservoirs must find the same distances
+    template <typename T, typename SearchFunc>
+    void
+    CompareWithHeap(size_t nq, size_t k, SearchFunc search, const faiss::ConcurrentBitsetPtr& bitset) {
+        std::vector<T> heap_dis(nq * k), reservoir_dis(nq * k);
+        std::vector<int64_t> heap_ids(nq * k), reservoir_ids(nq * k);
+
+        faiss::reservoir_topk_threshold = HEAP_ONLY;
+        search(heap_dis.data(), heap_ids.data());
+        faiss::reservoir_topk_threshold = 1;
+        search(reservoir_dis.data(), reservoir_ids.data());
+
+        for (size_t i = 0; i < nq * k; i++) {
+            ASSERT_EQ(heap_dis[i], reservoir_dis[i]);
+            ASSERT_EQ(heap_ids[i] < 0, reservoir_ids[i] < 0);
+            if (bitset && reservoir_ids[i] >= 0) {
+                ASSERT_FALSE(bitset->test(reservoir_ids[i]));
+            }
+        }
+    }
+
+    size_t threshold_;
+};
+
+template <class C>
+void
+HeapTopk(const typename C::T* dis, size_t n, size_t k, typename C::T* val, int64_t* ids) {
+    faiss::heap_heapify<C>(k, val, ids);
+    for (size_t j = 0; j < n; j++) {
+        if (C::cmp(val[0], dis[j])) {
+            faiss::heap_swap_top<C>(k, val, ids, dis[j], j);
+        }
+    }
+    faiss::heap_reorder<C>(k, val, ids);
+}
+
+template <class C>
+void
+ReservoirTopk(const typename C::T* dis, size_t n, size_t k, typename C::T* val, int64_t* ids) {
+    faiss::ReservoirTopK<C> res(k);
+    res.add_batch(dis, n, [](size_t j) { return int64_t(j); });
+    res.finalize(val, ids);
+}
+
+}  // namespace
+
+TEST_F(TopkTest, reservoir_matches_heap) {
+    // distinct values, in random order
+    const size_t n = 100000;
+    std::vector<float> dis(n);
+    for (size_t j = 0; j < n; j++) {
+        dis[j] = float(j) / n;
+    }
+    std::shuffle(dis.begin(), dis.end(), std::mt19937(1));
+    std::vector<int32_t> idis(n);
+    for (size_t j = 0; j < n; j++) {
+        idis[j] = static_cast<int32_t>(dis[j] * 1024);  // many ties
+    }
+
+    for (size_t k : {1, 10, 128, 1000, 4096}) {
+        std::vector<float> heap_val(k), res_val(k);
+        std::vector<int32_t> heap_ival(k), res_ival(k);
+        std::vector<int64_t> heap_ids(k), res_ids(k);
+
+        HeapTopk<faiss::CMax<float, int64_t>>(dis.data(), n, k, heap_val.data(), heap_ids.data());
+        ReservoirTopk<faiss::CMax<float, int64_t>>(dis.data(), n, k, res_val.data(), res_ids.data());
+        ASSERT_EQ(heap_val, res_val);
+        ASSERT_EQ(heap_ids, res_ids);
+
+        HeapTopk<faiss::CMin<float, int64_t>>(dis.data(), n, k, heap_val.data(), heap_ids.data());
+        ReservoirTopk<faiss::CMin<float, int64_t>>(dis.data(), n, k, res_val.data(), res_ids.data());
+        ASSERT_EQ(heap_val, res_val);
+        ASSERT_EQ(heap_ids, res_ids);
+
+        HeapTopk<faiss::CMax<int32_t, int64_t>>(idis.data(), n, k, heap_ival.data(), heap_ids.data());
+        ReservoirTopk<faiss::CMax<int32_t, int64_t>>(idis.data(), n, k, res_ival.data(), res_ids.data());
+        ASSERT_EQ(heap_ival, res_ival);
+    }
+
+    // fewer candidates than k
+    std::vector<float> val(8);
+    std::vector<int64_t> ids(8);
+    ReservoirTopk<faiss::CMax<float, int64_t>>(dis.data(), 5, 8, val.data(), ids.data());
+    ASSERT_EQ(-1, ids[5]);
+    ASSERT_EQ(-1, ids[7]);
+    ASSERT_LE(val[0], val[4]);
+}
+
+TEST_F(TopkTest, flat_search) {
+    const size_t d = 64, nb = 20000, k = 1000;
+    auto xb = RandomFloats(nb * d, 2);
+    auto bitset = EveryThird(nb);
+
+    for (auto metric : {faiss::METRIC_L2, faiss::METRIC_INNER_PRODUCT}) {
+        faiss::IndexFlat index(d, metric);
+        index.add(nb, xb.data());
+        // few queries take the sse path, many queries the blas path
+        for (size_t nq : {5, 50}) {
+            auto xq = RandomFloats(nq * d, 3);
+            for (auto& bs : {faiss::ConcurrentBitsetPtr(), bitset}) {
+                CompareWithHeap<float>(
+                    nq, k, [&](float* dis, int64_t* ids) { index.search(nq, xq.data(), k, dis, ids, bs); }, bs);
+            }
+        }
+    }
+}
+
+TEST_F(TopkTest, ivf_search) {
+    const size_t d = 32, nb = 20000, nq = 20, k = 500;
+    auto xb = RandomFloats(nb * d, 4);
+    auto xq = RandomFloats(nq * d, 5);
+    auto bitset = EveryThird(nb);
+
+    faiss::IndexFlatL2 quantizer(d);
+    faiss::IndexIVFFlat index(&quantizer, d, 16);
+    index.train(nb, xb.data());
+    index.add(nb, xb.data());
+    index.nprobe = 4;
+
+    for (auto& bs : {faiss::ConcurrentBitsetPtr(), bitset}) {
+        CompareWithHeap<float>(
+            nq, k, [&](float* dis, int64_t* ids) { index.search(nq, xq.data(), k, dis, ids, bs); }, bs);
+    }
+}
+
+TEST_F(TopkTest, binary_flat_search) {
+    const size_t nb = 20000, nq = 10, k = 1000;
+    auto bitset = EveryThird(nb);
+
+    // 32 bytes codes use the hamming computers, 128 bytes codes the block kernels if available
+    for (size_t d : {256, 1024}) {
+        auto xb = RandomBytes(nb * d / 8, 6);
+        auto xq = RandomBytes(nq * d / 8, 7);
+        faiss::IndexBinaryFlat index(d);
+        index.add(nb, xb.data());
+        for (auto& bs : {faiss::ConcurrentBitsetPtr(), bitset}) {
+            CompareWithHeap<int32_t>(
+                nq, k, [&](int32_t* dis, int64_t* ids) { index.search(nq, xq.data(), k, dis, ids, bs); }, bs);
+        }
+    }
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(TopkTest, DISABLED_benchmark) {
+    const size_t n = 1000000, loop = 10;
+    auto dis = RandomFloats(n, 8);
+
+    for (size_t k : {10, 100, 1000}) {
+        std::vector<float> val(k);
+        std::vector<int64_t> ids(k);
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < loop; i++) {
+            HeapTopk<faiss::CMax<float, int64_t>>(dis.data(), n, k, val.data(), ids.data());
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < loop; i++) {
+            ReservoirTopk<faiss::CMax<float, int64_t>>(dis.data(), n, k, val.data(), ids.data());
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        auto heap_us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count() / loop;
+        auto reservoir_us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() / loop;
+        std::cout << "top " << k << " of " << n << ": heap " << heap_us << "us, reservoir " << reservoir_us << "us"
+                  << std::endl;
+    }
+}
@@ -95,6 +95,30 @@ class MetricsBase {
     SearchRawDataDurationSecondsHistogramObserve(double value) {
     }
 
+    virtual void
+    QueryStageDurationHistogramObserve(const std::string& stage, double value) {
+    }
+
+    virtual void
+    QuerySegmentsHistogramObserve(double value) {
+    }
+
+    virtual void
+    RequestQueueDurationHistogramObserve(const std::string& priority, double value) {
+    }
+
+    virtual void
+    RequestShedTotalIncrement(const std::string& priority) {
+    }
+
+    virtual void
+    ResultCacheAccessTotalIncrement(bool hit) {
+    }
+
+    virtual void
+    ResultCacheUsageGaugeSet(double value) {
+    }
+
     virtual void
     IndexFileSizeTotalIncrement(double value = 1) {
     }
@@ -167,6 +167,52 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    QueryStageDurationHistogramObserve(const std::string& stage, double value) override {
+        if (startup_) {
+            query_stage_duration_microseconds_
+                .Add({{"stage", stage}}, BucketBoundaries{1e2, 1e3, 1e4, 5e4, 1e5, 5e5, 1e6, 5e6})
+                .Observe(value);
+        }
+    }
+
+    void
+    QuerySegmentsHistogramObserve(double value) override {
+        if (startup_) {
+            query_segments_histogram_.Observe(value);
+        }
+    }
+
+    void
+    RequestQueueDurationHistogramObserve(const std::string& priority, double value) override {
+        if (startup_) {
+            request_queue_duration_microseconds_
+                .Add({{"priority", priority}}, BucketBoundaries{1e2, 1e3, 1e4, 5e4, 1e5, 5e5, 1e6, 5e6})
+                .Observe(value);
+        }
+    }
+
+    void
+    RequestShedTotalIncrement(const std::string& priority) override {
+        if (startup_) {
+            request_shed_total_.Add({{"priority", priority}}).Increment();
+        }
+    }
+
+    void
+    ResultCacheAccessTotalIncrement(bool hit) override {
+        if (startup_) {
+            (hit ? result_cache_hit_total_ : result_cache_miss_total_).Increment();
+        }
+    }
+
+    void
+    ResultCacheUsageGaugeSet(double value) override {
+        if (startup_) {
+            result_cache_usage_gauge_.Set(value);
+        }
+    }
+
     void
     IndexFileSizeTotalIncrement(double value = 1) override {
         if (startup_) {
@@ -460,6 +506,35 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Histogram& search_raw_data_duration_seconds_histogram_ =
         search_data_duration_seconds_.Add({{"type", "raw"}}, BucketBoundaries{1e5, 2e5, 4e5, 6e5, 8e5});
 
+    // record per stage duration of query profile, labeled by stage name
+    prometheus::Family<prometheus::Histogram>& query_stage_duration_microseconds_ =
+        prometheus::BuildHistogram()
+            .Name("query_stage_duration_microseconds")
+            .Help("histograms of processing time for each stage of a query")
+            .Register(*registry_);
+
+    // record number of segments touched by a query
+    prometheus::Family<prometheus::Histogram>& query_segments_ =
+        prometheus::BuildHistogram()
+            .Name("query_segments")
+            .Help("histogram of segments searched per query")
+            .Register(*registry_);
+    prometheus::Histogram& query_segments_histogram_ =
+        query_segments_.Add({}, BucketBoundaries{1, 2, 4, 8, 16, 32, 64, 128, 256});
+
+    // record time spent by requests in the request scheduler queues, labeled by priority class
+    prometheus::Family<prometheus::Histogram>& request_queue_duration_microseconds_ =
+        prometheus::BuildHistogram()
+            .Name("request_queue_duration_microseconds")
+            .Help("histograms of time requests wait in the scheduler queues")
+            .Register(*registry_);
+
+    // record requests dropped because their deadline passed while queued
+    prometheus::Family<prometheus::Counter>& request_shed_total_ = prometheus::BuildCounter()
+                                                                       .Name("request_shed_total")
+                                                                       .Help("the number of requests shed at deadline")
+                                                                       .Register(*registry_);
+
     ////all form Cache.cpp
     // record cache usage, when insert/erase/clear/free
 
@@ -549,6 +624,23 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Gauge& cpu_cache_usage_gauge_ = cpu_cache_usage_.Add({});
 
     // record GPU cache usage and %
+    // record search result cache lookups, hit rate is hit / (hit + miss)
+    prometheus::Family<prometheus::Counter>& result_cache_access_ =
+        prometheus::BuildCounter()
+            .Name("result_cache_access_total")
+            .Help("the count of search result cache lookups")
+            .Register(*registry_);
+    prometheus::Counter& result_cache_hit_total_ = result_cache_access_.Add({{"result", "hit"}});
+    prometheus::Counter& result_cache_miss_total_ = result_cache_access_.Add({{"result", "miss"}});
+
+    // record search result cache usage
+    prometheus::Family<prometheus::Gauge>& result_cache_usage_ =
+        prometheus::BuildGauge()
+            .Name("result_cache_usage_bytes")
+            .Help("current search result cache usage by bytes")
+            .Register(*registry_);
+    prometheus::Gauge& result_cache_usage_gauge_ = result_cache_usage_.Add({});
+
     prometheus::Family<prometheus::Gauge>& gpu_cache_usage_ = prometheus::BuildGauge()
                                                                   .Name("gpu_cache_usage_bytes")
                                                                   .Help("current gpu cache usage by bytes")
@@ -9,6 +9,7 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -19,6 +20,10 @@
 namespace milvus {
 namespace query {
 
+namespace {
+constexpr int64_t MAX_SIM_CANDIDATES_LIMIT = 16384;  // the largest topk of a segment search
+}  // namespace
+
 BinaryQueryPtr
 ConstructBinTree(std::vector<BooleanQueryPtr> queries, QueryRelation relation, uint64_t idx) {
     if (idx == queries.size()) {
@@ -216,5 +221,78 @@ ValidateBinaryQuery(BinaryQueryPtr& binary_query) {
     return height > 1 && height < 4;
 }
 
+VectorQueryPtr
+FindVectorQuery(const GeneralQueryPtr& general_query) {
+    if (general_query == nullptr) {
+        return nullptr;
+    }
+    if (general_query->leaf != nullptr) {
+        return general_query->leaf->vector_query;
+    }
+    if (general_query->bin == nullptr) {
+        return nullptr;
+    }
+    auto vector_query = FindVectorQuery(general_query->bin->left_query);
+    return vector_query != nullptr ? vector_query : FindVectorQuery(general_query->bin->right_query);
+}
+
+Status
+ParseMaxSim(VectorQuery& vector_query, int64_t dimension) {
+    auto& params = vector_query.extra_params;
+    vector_query.max_sim = MaxSimType::NONE;
+    vector_query.max_sim_candidates = 0;
+    vector_query.query_lengths.clear();
+    if (!params.contains("max_sim")) {
+        return Status::OK();
+    }
+
+    try {
+        auto type = params["max_sim"].get<std::string>();
+        if (type == "max") {
+            vector_query.max_sim = MaxSimType::MAX;
+        } else if (type == "sum_max") {
+            vector_query.max_sim = MaxSimType::SUM_MAX;
+        } else {
+            return Status(SERVER_INVALID_ARGUMENT, "max_sim must be max or sum_max");
+        }
+
+        // a few hits for each entity by default
+        vector_query.max_sim_candidates = std::min(vector_query.topk * 4, MAX_SIM_CANDIDATES_LIMIT);
+        if (params.contains("max_sim_candidates")) {
+            vector_query.max_sim_candidates = params["max_sim_candidates"].get<int64_t>();
+        }
+        if (vector_query.max_sim_candidates < vector_query.topk ||
+            vector_query.max_sim_candidates > MAX_SIM_CANDIDATES_LIMIT) {
+            return Status(SERVER_INVALID_ARGUMENT, "max_sim_candidates must be between topk and " +
+                                                       std::to_string(MAX_SIM_CANDIDATES_LIMIT));
+        }
+
+        int64_t nq = dimension > 0 ? vector_query.query_vector.float_data.size() / dimension : 0;
+        if (params.contains("query_lengths")) {
+            if (vector_query.max_sim != MaxSimType::SUM_MAX) {
+                return Status(SERVER_INVALID_ARGUMENT, "query_lengths only applies to sum_max");
+            }
+            vector_query.query_lengths = params["query_lengths"].get<std::vector<int64_t>>();
+            int64_t sum = 0;
+            for (auto length : vector_query.query_lengths) {
+                if (length <= 0) {
+                    return Status(SERVER_INVALID_ARGUMENT, "A query must have at least one vector");
+                }
+                sum += length;
+            }
+            if (sum != nq) {
+                return Status(SERVER_INVALID_ARGUMENT, "The query lengths must add up to the number of vectors");
+            }
+        } else if (vector_query.max_sim == MaxSimType::SUM_MAX) {
+            // all the vectors make one query
+            vector_query.query_lengths.push_back(nq);
+        }
+    } catch (std::exception& ex) {
+        return Status(SERVER_INVALID_ARGUMENT, std::string("Invalid max_sim params: ") + ex.what());
+    }
+
+    return Status::OK();
+}
+
 }  // namespace query
 }  // namespace milvus
@@ -34,5 +34,13 @@ BinaryQueryHeight(BinaryQueryPtr& binary_query);
 bool
 ValidateBinaryQuery(BinaryQueryPtr& binary_query);
 
+// the vector query of the tree, nullptr if there is none
+VectorQueryPtr
+FindVectorQuery(const GeneralQueryPtr& general_query);
+
+// read "max_sim", "max_sim_candidates" and "query_lengths" from the extra params of the vector query
+Status
+ParseMaxSim(VectorQuery& vector_query, int64_t dimension);
+
 }  // namespace query
 }  // namespace milvus
@@ -68,12 +68,26 @@ struct VectorRecord {
     std::vector<uint8_t> binary_data;
 };
 
+// late interaction over the vectors of multi-vector entities, the score of an entity aggregates the hits of its
+// vectors. MAX: the best hit of the entity for each query vector. SUM_MAX: the query vectors are the vectors of a
+// query, the score is the sum over them of the best hit of the entity
+enum class MaxSimType {
+    NONE = 0,
+    MAX,
+    SUM_MAX,
+};
+
 struct VectorQuery {
     std::string field_name;
     milvus::json extra_params;
     int64_t topk;
     float boost;
     VectorRecord query_vector;
+
+    // set from extra_params by ParseMaxSim
+    MaxSimType max_sim = MaxSimType::NONE;
+    int64_t max_sim_candidates = 0;      // hits of each query vector in a segment
+    std::vector<int64_t> query_lengths;  // SUM_MAX: the number of query vectors of each query
 };
 using VectorQueryPtr = std::shared_ptr<VectorQuery>;
 
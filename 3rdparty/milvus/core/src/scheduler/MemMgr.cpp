@@ -0,0 +1,160 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "scheduler/MemMgr.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace scheduler {
+
+namespace {
+constexpr int64_t unit = 1024 * 1024 * 1024;
+}
+
+MemMgr::MemMgr(int64_t budget, int64_t collection_quota)
+    : budget_(budget), default_collection_quota_(collection_quota) {
+    SetIdentity("MemMgr");
+    AddMemoryBudgetListener();
+    AddCollectionMemoryQuotaListener();
+    AddCollectionMemoryQuotasListener();
+}
+
+bool
+MemMgr::Reserve(const std::string& collection_id, int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (budget_ > 0 && reserved_ + bytes > budget_) {
+        return false;
+    }
+
+    int64_t quota = CollectionQuota(collection_id);
+    auto& collection_reserved = collection_reserved_[collection_id];
+    if (quota > 0 && collection_reserved + bytes > quota) {
+        if (collection_reserved == 0) {
+            collection_reserved_.erase(collection_id);
+        }
+        return false;
+    }
+
+    reserved_ += bytes;
+    collection_reserved += bytes;
+    return true;
+}
+
+void
+MemMgr::Release(const std::string& collection_id, int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    reserved_ -= bytes;
+    auto iter = collection_reserved_.find(collection_id);
+    if (iter != collection_reserved_.end()) {
+        iter->second -= bytes;
+        if (iter->second <= 0) {
+            collection_reserved_.erase(iter);
+        }
+    }
+    if (reserved_ < 0) {
+        LOG_SERVER_WARNING_ << "MemMgr released more memory than reserved";
+        reserved_ = 0;
+    }
+}
+
+bool
+MemMgr::Fits(const std::string& collection_id, int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (budget_ > 0 && bytes > budget_) {
+        return false;
+    }
+
+    int64_t quota = CollectionQuota(collection_id);
+    return quota <= 0 || bytes <= quota;
+}
+
+void
+MemMgr::SetCollectionQuota(const std::string& collection_id, int64_t quota) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collection_quota_[collection_id] = quota;
+}
+
+void
+MemMgr::SetCollectionQuotas(const std::unordered_map<std::string, int64_t>& quotas) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collection_quota_ = quotas;
+}
+
+void
+MemMgr::SetBudget(int64_t budget) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = budget;
+}
+
+void
+MemMgr::SetDefaultCollectionQuota(int64_t quota) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    default_collection_quota_ = quota;
+}
+
+int64_t
+MemMgr::Budget() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_;
+}
+
+int64_t
+MemMgr::Reserved() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reserved_;
+}
+
+int64_t
+MemMgr::Reserved(const std::string& collection_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = collection_reserved_.find(collection_id);
+    return (iter == collection_reserved_.end()) ? 0 : iter->second;
+}
+
+void
+MemMgr::OnMemoryBudgetChanged(int64_t budget) {
+    SetBudget(budget * unit);
+}
+
+void
+MemMgr::OnCollectionMemoryQuotaChanged(int64_t quota) {
+    SetDefaultCollectionQuota(quota * unit);
+}
+
+void
+MemMgr::OnCollectionMemoryQuotasChanged(const std::unordered_map<std::string, int64_t>& quotas) {
+    std::unordered_map<std::string, int64_t> quotas_in_bytes;
+    for (auto& pair : quotas) {
+        quotas_in_bytes[pair.first] = pair.second * unit;
+    }
+    SetCollectionQuotas(quotas_in_bytes);
+}
+
+int64_t
+MemMgr::CollectionQuota(const std::string& collection_id) {
+    auto iter = collection_quota_.find(collection_id);
+    return (iter == collection_quota_.end()) ? default_collection_quota_ : iter->second;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+MemReservation::MemReservation(const MemMgrPtr& mgr, const std::string& collection_id, int64_t bytes)
+    : mgr_(mgr), collection_id_(collection_id), bytes_(bytes) {
+    ok_ = (mgr_ == nullptr || bytes_ <= 0) ? true : mgr_->Reserve(collection_id_, bytes_);
+}
+
+MemReservation::~MemReservation() {
+    if (ok_ && mgr_ != nullptr && bytes_ > 0) {
+        mgr_->Release(collection_id_, bytes_);
+    }
+}
+
+}  // namespace scheduler
+}  // namespace milvus
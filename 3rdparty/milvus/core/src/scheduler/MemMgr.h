@@ -0,0 +1,119 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "config/handler/EngineConfigHandler.h"
+
+namespace milvus {
+namespace scheduler {
+
+/*
+ * Global accountant of transient memory: segment loads of search tasks, build index scratch,
+ * merge buffers and per file query results.
+ * Index data kept by CpuCacheMgr is bounded by cache capacity and is not counted here.
+ *
+ * A reservation is admitted only if it fits into the global budget and the quota of its collection.
+ * A request bigger than the budget or the quota can never be admitted, callers check Fits() to reject it
+ * instead of waiting for it. Budget or quota of 0 means unlimited.
+ */
+class MemMgr : public server::EngineConfigHandler {
+ public:
+    // budget and quota in bytes
+    MemMgr(int64_t budget, int64_t collection_quota);
+
+ public:
+    bool
+    Reserve(const std::string& collection_id, int64_t bytes);
+
+    void
+    Release(const std::string& collection_id, int64_t bytes);
+
+    // whether the request could be admitted once all other reservations are released
+    bool
+    Fits(const std::string& collection_id, int64_t bytes);
+
+    // override default quota of a collection, 0 means unlimited
+    void
+    SetCollectionQuota(const std::string& collection_id, int64_t quota);
+
+    // replace all overridden quotas
+    void
+    SetCollectionQuotas(const std::unordered_map<std::string, int64_t>& quotas);
+
+    void
+    SetBudget(int64_t budget);
+
+    void
+    SetDefaultCollectionQuota(int64_t quota);
+
+    int64_t
+    Budget();
+
+    int64_t
+    Reserved();
+
+    int64_t
+    Reserved(const std::string& collection_id);
+
+ protected:
+    void
+    OnMemoryBudgetChanged(int64_t budget) override;
+
+    void
+    OnCollectionMemoryQuotaChanged(int64_t quota) override;
+
+    void
+    OnCollectionMemoryQuotasChanged(const std::unordered_map<std::string, int64_t>& quotas) override;
+
+ private:
+    int64_t
+    CollectionQuota(const std::string& collection_id);
+
+ private:
+    int64_t budget_;
+    int64_t default_collection_quota_;
+    int64_t reserved_ = 0;
+    std::unordered_map<std::string, int64_t> collection_reserved_;
+    std::unordered_map<std::string, int64_t> collection_quota_;
+    std::mutex mutex_;
+};
+
+using MemMgrPtr = std::shared_ptr<MemMgr>;
+
+/*
+ * Hold a reservation for the lifetime of the object, Ok() tells whether it was admitted.
+ */
+class MemReservation {
+ public:
+    MemReservation(const MemMgrPtr& mgr, const std::string& collection_id, int64_t bytes);
+
+    ~MemReservation();
+
+    bool
+    Ok() const {
+        return ok_;
+    }
+
+ private:
+    MemMgrPtr mgr_;
+    std::string collection_id_;
+    int64_t bytes_;
+    bool ok_ = false;
+};
+
+}  // namespace scheduler
+}  // namespace milvus
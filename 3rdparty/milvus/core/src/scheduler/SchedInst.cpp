@@ -13,8 +13,11 @@
 #include "ResourceFactory.h"
 #include "Utils.h"
 #include "config/Config.h"
+#include "utils/CommonUtil.h"
 
 #include <fiu-local.h>
+#include <algorithm>
+#include <cmath>
 #include <set>
 #include <string>
 #include <utility>
@@ -38,6 +41,9 @@ std::mutex OptimizerInst::mutex_;
 BuildMgrPtr BuildMgrInst::instance = nullptr;
 std::mutex BuildMgrInst::mutex_;
 
+MemMgrPtr MemMgrInst::instance = nullptr;
+std::mutex MemMgrInst::mutex_;
+
 CPUBuilderPtr CPUBuilderInst::instance = nullptr;
 std::mutex CPUBuilderInst::mutex_;
 
@@ -46,14 +52,33 @@ load_simple_config() {
     // create and connect
     ResMgrInst::GetInstance()->Add(ResourceFactory::Create("disk", "DISK", 0, false));
 
+    server::Config& config = server::Config::GetInstance();
+    int64_t loader_num = 1, executor_num = 1;
+    config.GetEngineConfigSearchLoaderNum(loader_num);
+    config.GetEngineConfigSearchExecutorNum(executor_num);
+
+    auto cpu = ResourceFactory::Create("cpu", "CPU", 0);
+    if (executor_num > 1) {
+        // split the openmp threads between the executors, so that concurrent tasks don't oversubscribe the cores
+        int64_t omp_thread = 0;
+        config.GetEngineConfigOmpThreadNum(omp_thread);
+        if (omp_thread <= 0) {
+            int64_t sys_thread_cnt = 8;
+            server::CommonUtil::GetSystemAvailableThreads(sys_thread_cnt);
+            omp_thread = static_cast<int64_t>(ceil(sys_thread_cnt * 0.5));
+        }
+        cpu->SetWorkerNum(loader_num, executor_num, std::max<int64_t>(omp_thread / executor_num, 1));
+    } else {
+        cpu->SetWorkerNum(loader_num, executor_num);
+    }
+
     auto io = Connection("io", 500);
-    ResMgrInst::GetInstance()->Add(ResourceFactory::Create("cpu", "CPU", 0));
+    ResMgrInst::GetInstance()->Add(std::move(cpu));
     ResMgrInst::GetInstance()->Connect("disk", "cpu", io);
 
 // get resources
 #ifdef MILVUS_GPU_VERSION
     bool enable_gpu = false;
-    server::Config& config = server::Config::GetInstance();
     config.GetGpuResourceConfigEnable(enable_gpu);
     if (enable_gpu) {
         std::vector<int64_t> gpu_ids;
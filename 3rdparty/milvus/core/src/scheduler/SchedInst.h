@@ -14,6 +14,7 @@
 #include "BuildMgr.h"
 #include "CPUBuilder.h"
 #include "JobMgr.h"
+#include "MemMgr.h"
 #include "ResourceMgr.h"
 #include "Scheduler.h"
 #include "Utils.h"
@@ -29,6 +30,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace milvus {
@@ -158,6 +160,35 @@ class BuildMgrInst {
     static std::mutex mutex_;
 };
 
+class MemMgrInst {
+ public:
+    static MemMgrPtr
+    GetInstance() {
+        if (instance == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (instance == nullptr) {
+                constexpr int64_t unit = 1024 * 1024 * 1024;
+                int64_t budget = 0, collection_quota = 0;
+                server::Config& config = server::Config::GetInstance();
+                config.GetEngineConfigMemoryBudget(budget);
+                config.GetEngineConfigCollectionMemoryQuota(collection_quota);
+                instance = std::make_shared<MemMgr>(budget * unit, collection_quota * unit);
+
+                std::unordered_map<std::string, int64_t> collection_quotas;
+                config.GetEngineConfigCollectionMemoryQuotas(collection_quotas);
+                for (auto& pair : collection_quotas) {
+                    instance->SetCollectionQuota(pair.first, pair.second * unit);
+                }
+            }
+        }
+        return instance;
+    }
+
+ private:
+    static MemMgrPtr instance;
+    static std::mutex mutex_;
+};
+
 class CPUBuilderInst {
  public:
     static CPUBuilderPtr
@@ -147,7 +147,7 @@ TaskTableItem::Dump() const {
 }
 
 std::vector<uint64_t>
-TaskTable::PickToLoad(uint64_t limit) {
+TaskTable::PickToLoad(uint64_t limit, uint64_t max_loaded) {
 #if 1
     // TimeRecorder rc("");
     std::vector<uint64_t> indexes;
@@ -165,7 +165,7 @@ TaskTable::PickToLoad(uint64_t limit) {
         } else if (table_[index]->state == TaskTableItemState::LOADED) {
             cross = true;
             ++loaded_count;
-            if (loaded_count > 2)
+            if (loaded_count > max_loaded)
                 return std::vector<uint64_t>();
         } else if (table_[index]->state == TaskTableItemState::START) {
             auto task = table_[index]->task;
@@ -13,6 +13,10 @@
 #include "scheduler/SchedInst.h"
 #include "scheduler/Utils.h"
 
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -53,23 +57,48 @@ Resource::Resource(std::string name, ResourceType type, uint64_t device_id, bool
     });
 }
 
+void
+Resource::SetWorkerNum(uint64_t loader_num, uint64_t executor_num, int64_t omp_thread_num) {
+    loader_num_ = std::max<uint64_t>(loader_num, 1);
+    executor_num_ = std::max<uint64_t>(executor_num, 1);
+    omp_thread_num_ = omp_thread_num;
+}
+
 void
 Resource::Start() {
     running_ = true;
-    loader_thread_ = std::thread(&Resource::loader_function, this);
+    for (uint64_t i = 0; i < loader_num_; ++i) {
+        loader_threads_.emplace_back(&Resource::loader_function, this);
+    }
     if (enable_executor_) {
-        executor_thread_ = std::thread(&Resource::executor_function, this);
+        for (uint64_t i = 0; i < executor_num_; ++i) {
+            executor_threads_.emplace_back(&Resource::executor_function, this, i);
+        }
     }
 }
 
 void
 Resource::Stop() {
     running_ = false;
-    WakeupLoader();
-    loader_thread_.join();
+    {
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        load_flag_ = true;
+    }
+    load_cv_.notify_all();
+    for (auto& loader : loader_threads_) {
+        loader.join();
+    }
+    loader_threads_.clear();
     if (enable_executor_) {
-        WakeupExecutor();
-        executor_thread_.join();
+        {
+            std::lock_guard<std::mutex> lock(exec_mutex_);
+            exec_flag_ = true;
+        }
+        exec_cv_.notify_all();
+        for (auto& executor : executor_threads_) {
+            executor.join();
+        }
+        executor_threads_.clear();
     }
 }
 
@@ -98,10 +127,12 @@ Resource::Dump() const {
         {"name", name_},
         {"type", ToString(type_)},
         {"task_average_cost", TaskAvgCost()},
-        {"task_total_cost", total_cost_},
-        {"total_tasks", total_task_},
+        {"task_total_cost", total_cost_.load()},
+        {"total_tasks", total_task_.load()},
         {"running", running_},
         {"enable_executor", enable_executor_},
+        {"loader_num", loader_num_},
+        {"executor_num", executor_num_},
     };
     return ret;
 }
@@ -113,12 +144,39 @@ Resource::NumOfTaskToExec() {
 
 TaskTableItemPtr
 Resource::pick_task_load() {
-    auto indexes = task_table_.PickToLoad(10);
+    // keep one loaded task ready for each executor plus one in advance
+    auto indexes = task_table_.PickToLoad(10, executor_num_ + 1);
     for (auto index : indexes) {
+        auto task = task_table_.at(index)->task;
+
+        // admission control: a task whose memory can't be reserved now stays in table,
+        // it will be picked again after running tasks release their reservations
+        int64_t reserve_bytes = 0;
+        if (type_ == ResourceType::CPU && task->reserved_memory_ == 0 && !task->over_budget_) {
+            reserve_bytes = task->EstimateMemory();
+            auto mem_mgr = MemMgrInst::GetInstance();
+            if (reserve_bytes > 0 && !mem_mgr->Fits(task->CollectionId(), reserve_bytes)) {
+                LOG_SERVER_WARNING_ << name() << " reject task, " << reserve_bytes
+                                    << " bytes exceed memory budget or collection quota";
+                task->over_budget_ = true;
+                reserve_bytes = 0;
+            } else if (reserve_bytes > 0 && !mem_mgr->Reserve(task->CollectionId(), reserve_bytes)) {
+                LOG_SERVER_DEBUG_ << name() << " delay loading task, " << reserve_bytes
+                                  << " bytes exceed memory budget";
+                load_delayed_ = true;
+                continue;
+            }
+        }
+
         // try to set one task loading, then return
-        if (task_table_.Load(index))
+        if (task_table_.Load(index)) {
+            task->reserved_memory_ += reserve_bytes;
             return task_table_.at(index);
+        }
         // else try next
+        if (reserve_bytes > 0) {
+            MemMgrInst::GetInstance()->Release(task->CollectionId(), reserve_bytes);
+        }
     }
     return nullptr;
 }
@@ -156,14 +214,24 @@ Resource::loader_function() {
     SetThreadName("taskloader_th");
     while (running_) {
         std::unique_lock<std::mutex> lock(load_mutex_);
-        load_cv_.wait(lock, [&] { return load_flag_; });
+        if (load_delayed_) {
+            // reservations may also be released outside scheduler (e.g. merge), so don't wait forever
+            load_cv_.wait_for(lock, std::chrono::milliseconds(100), [&] { return load_flag_ || !running_; });
+        } else {
+            load_cv_.wait(lock, [&] { return load_flag_ || !running_; });
+        }
         load_flag_ = false;
+        load_delayed_ = false;
         lock.unlock();
         while (true) {
             auto task_item = pick_task_load();
             if (task_item == nullptr) {
                 break;
             }
+            if (loader_num_ > 1) {
+                // let an idle loader pick the next task while this one is loading
+                WakeupLoader();
+            }
             if (task_item->task->Type() == TaskType::BuildIndexTask && name() == "cpu") {
                 BuildMgrInst::GetInstance()->Take();
                 LOG_SERVER_DEBUG_ << name() << " load BuildIndexTask";
@@ -183,15 +251,19 @@ Resource::loader_function() {
 }
 
 void
-Resource::executor_function() {
+Resource::executor_function(uint64_t executor_id) {
     SetThreadName("taskexector_th");
-    if (subscriber_) {
+    if (omp_thread_num_ > 0) {
+        // executors share the cores, each one runs its tasks with its part of the openmp threads
+        omp_set_num_threads(omp_thread_num_);
+    }
+    if (executor_id == 0 && subscriber_) {
         auto event = std::make_shared<StartUpEvent>(shared_from_this());
         subscriber_(std::static_pointer_cast<Event>(event));
     }
     while (running_) {
         std::unique_lock<std::mutex> lock(exec_mutex_);
-        exec_cv_.wait(lock, [&] { return exec_flag_; });
+        exec_cv_.wait(lock, [&] { return exec_flag_ || !running_; });
         exec_flag_ = false;
         lock.unlock();
         while (true) {
@@ -199,6 +271,10 @@ Resource::executor_function() {
             if (task_item == nullptr) {
                 break;
             }
+            if (executor_num_ > 1) {
+                // let an idle executor pick the next task while this one is running
+                WakeupExecutor();
+            }
             auto start = get_current_timestamp();
             Process(task_item->task);
             auto finish = get_current_timestamp();
@@ -207,6 +283,15 @@ Resource::executor_function() {
 
             task_item->Executed();
 
+            if (task_item->task->reserved_memory_ > 0) {
+                MemMgrInst::GetInstance()->Release(task_item->task->CollectionId(), task_item->task->reserved_memory_);
+                task_item->task->reserved_memory_ = 0;
+                auto cpu_resource = ResMgrInst::GetInstance()->GetResource(ResourceType::CPU, 0);
+                if (cpu_resource != nullptr) {
+                    cpu_resource->WakeupLoader();
+                }
+            }
+
             if (task_item->task->Type() == TaskType::BuildIndexTask) {
                 BuildMgrInst::GetInstance()->Put();
                 ResMgrInst::GetInstance()->GetResource("cpu")->WakeupLoader();
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -42,6 +43,14 @@ enum class ResourceType {
 
 class Resource : public Node, public std::enable_shared_from_this<Resource> {
  public:
+    /*
+     * Run loader_num loaders and executor_num executors, each executor runs its tasks with
+     * omp_thread_num openmp threads (0 keeps the process setting);
+     * Must be called before Start;
+     */
+    void
+    SetWorkerNum(uint64_t loader_num, uint64_t executor_num, int64_t omp_thread_num = 0);
+
     /*
      * Start loader and executor if enable;
      */
@@ -101,6 +110,11 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
         return enable_executor_;
     }
 
+    inline uint64_t
+    NumOfExecutor() const {
+        return enable_executor_ ? executor_num_ : 0;
+    }
+
     // TODO(wxyu): const
     uint64_t
     NumOfTaskToExec();
@@ -165,7 +179,7 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
      * Only called by worker thread;
      */
     void
-    executor_function();
+    executor_function(uint64_t executor_id);
 
  protected:
     uint64_t device_id_;
@@ -176,18 +190,23 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
 
     TaskTable task_table_;
 
-    uint64_t total_cost_ = 0;
-    uint64_t total_task_ = 0;
+    std::atomic<uint64_t> total_cost_{0};
+    std::atomic<uint64_t> total_task_{0};
 
     std::function<void(EventPtr)> subscriber_ = nullptr;
 
     bool running_ = false;
     bool enable_executor_ = true;
-    std::thread loader_thread_;
-    std::thread executor_thread_;
+    uint64_t loader_num_ = 1;
+    uint64_t executor_num_ = 1;
+    int64_t omp_thread_num_ = 0;
+    std::vector<std::thread> loader_threads_;
+    std::vector<std::thread> executor_threads_;
 
     bool load_flag_ = false;
     bool exec_flag_ = false;
+    // some task was held back by memory admission, loader polls until it can be loaded
+    std::atomic<bool> load_delayed_{false};
     std::mutex load_mutex_;
     std::mutex exec_mutex_;
     std::condition_variable load_cv_;
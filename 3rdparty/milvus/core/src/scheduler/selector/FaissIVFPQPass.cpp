@@ -12,6 +12,7 @@
 #include "scheduler/selector/FaissIVFPQPass.h"
 #include "cache/GpuCacheMgr.h"
 #include "config/Config.h"
+#include "db/Utils.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/Utils.h"
 #include "scheduler/task/SearchTask.h"
@@ -59,6 +60,10 @@ FaissIVFPQPass::Run(const TaskPtr& task) {
     if (!gpu_enable_) {
         LOG_SERVER_DEBUG_ << LogOut("[%s][%d] FaissIVFPQPass: gpu disable, specify cpu to search!", "search", 0);
         res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
+    } else if (engine::utils::IsPreTransformedIndex(search_task->file_->index_params_)) {
+        LOG_SERVER_DEBUG_ << LogOut("[%s][%d] FaissIVFPQPass: pre-transformed index, specify cpu to search!",
+                                    "search", 0);
+        res_ptr = ResMgrInst::GetInstance()->GetResource("cpu");
     } else if (search_job->nq() < threshold_) {
         LOG_SERVER_DEBUG_ << LogOut("[%s][%d] FaissIVFPQPass: nq < gpu_search_threshold, specify cpu to search!",
                                     "search", 0);
@@ -61,7 +61,10 @@ XBuildIndexTask::Load(milvus::scheduler::LoadType type, uint8_t device_id) {
         auto build_index_job = std::static_pointer_cast<scheduler::BuildIndexJob>(job);
         auto options = build_index_job->options();
         try {
-            if (type == LoadType::DISK2CPU) {
+            if (over_budget_) {
+                stat = Status(SERVER_OUT_OF_MEMORY, "out of memory, build index task exceeds memory budget");
+                type_str = "DISK2CPU";
+            } else if (type == LoadType::DISK2CPU) {
                 stat = to_index_engine_->Load(options.insert_cache_immediately_);
                 type_str = "DISK2CPU";
             } else if (type == LoadType::CPU2GPU) {
@@ -244,5 +247,19 @@ XBuildIndexTask::Execute() {
     to_index_engine_ = nullptr;
 }
 
+int64_t
+XBuildIndexTask::EstimateMemory() {
+    if (file_ == nullptr) {
+        return 0;
+    }
+    // raw data of the segment plus the index being built from it
+    return 2 * static_cast<int64_t>(file_->file_size_);
+}
+
+std::string
+XBuildIndexTask::CollectionId() const {
+    return (file_ == nullptr) ? "" : engine::utils::GetQuotaCollectionId(*file_);
+}
+
 }  // namespace scheduler
 }  // namespace milvus
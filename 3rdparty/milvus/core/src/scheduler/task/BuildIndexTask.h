@@ -28,6 +28,12 @@ class XBuildIndexTask : public Task {
     void
     Execute() override;
 
+    int64_t
+    EstimateMemory() override;
+
+    std::string
+    CollectionId() const override;
+
  public:
     SegmentSchemaPtr file_;
     SegmentSchema table_file_;
@@ -14,15 +14,19 @@
 #include <fiu-local.h>
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
+#include "cache/CpuCacheMgr.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
 #include "metrics/Metrics.h"
+#include "query/BinaryQuery.h"
 #include "scheduler/SchedInst.h"
 #include "scheduler/job/SearchJob.h"
 #include "segment/SegmentReader.h"
@@ -104,8 +108,8 @@ XSearchTask::XSearchTask(const std::shared_ptr<server::Context>& context, Segmen
     : Task(TaskType::SearchTask, std::move(label)), context_(context), file_(file) {
     if (file_) {
         // distance -- value 0 means two vectors equal, ascending reduce, L2/HAMMING/JACCARD/TONIMOTO ...
-        // similarity -- infinity value means two vectors equal, descending reduce, IP
-        if (file_->metric_type_ == static_cast<int>(MetricType::IP) &&
+        // similarity -- infinity value means two vectors equal, descending reduce, IP/COSINE
+        if (engine::utils::IsSimilarityMetricType(file_->metric_type_) &&
             file_->engine_type_ != static_cast<int>(EngineType::FAISS_PQ)) {
             ascending_reduce = false;
         }
@@ -147,15 +151,24 @@ XSearchTask::XSearchTask(const std::shared_ptr<server::Context>& context, Segmen
 void
 XSearchTask::Load(LoadType type, uint8_t device_id) {
     milvus::server::ContextFollower tracer(context_, "XSearchTask::Load " + std::to_string(file_->id_));
+    server::QueryProfilePtr profile = context_ ? context_->GetQueryProfile() : nullptr;
+    server::QueryProfileScope load_scope(profile, server::QueryStage::kLoad);
 
     TimeRecorder rc(LogOut("[%s][%ld]", "search", 0));
     Status stat = Status::OK();
     std::string error_msg;
     std::string type_str;
+    bool cache_hit = false;
 
     try {
         fiu_do_on("XSearchTask.Load.throw_std_exception", throw std::exception());
-        if (type == LoadType::DISK2CPU) {
+        if (over_budget_) {
+            stat = Status(SERVER_OUT_OF_MEMORY, "out of memory, search task exceeds memory budget");
+            type_str = "DISK2CPU";
+        } else if (type == LoadType::DISK2CPU) {
+            if (profile) {
+                cache_hit = cache::CpuCacheMgr::GetInstance()->ItemExists(file_->location_);
+            }
             stat = index_engine_->Load();
             type_str = "DISK2CPU";
         } else if (type == LoadType::CPU2GPU) {
@@ -200,6 +213,14 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
     }
 
     size_t file_size = index_engine_->Size();
+    if (profile && type == LoadType::DISK2CPU) {
+        if (cache_hit) {
+            profile->AddCacheHit();
+        } else {
+            profile->AddCacheMiss();
+            profile->AddBytesLoaded(file_size);
+        }
+    }
 
     std::string info = "Search task load file id:" + std::to_string(file_->id_) + " " + type_str +
                        " file type:" + std::to_string(file_->file_type_) + " size:" + std::to_string(file_size) +
@@ -276,6 +297,12 @@ XSearchTask::Execute() {
                     return;
                 }
 
+                auto vector_query = query::FindVectorQuery(general_query);
+                bool max_sim = vector_query != nullptr && vector_query->max_sim != query::MaxSimType::NONE;
+                if (max_sim) {
+                    AggregateMaxSim(*vector_query, ascending_reduce, nq, topk, output_ids, output_distance);
+                }
+
                 auto spec_k = file_->row_count_ < topk ? file_->row_count_ : topk;
                 if (spec_k == 0) {
                     LOG_ENGINE_WARNING_ << "Searching in an empty file. file location = " << file_->location_;
@@ -294,12 +321,18 @@ XSearchTask::Execute() {
 
                     search_job->vector_count() = nq;
                     XSearchTask::MergeTopkToResultSet(output_ids, output_distance, spec_k, nq, topk, ascending_reduce,
-                                                      search_job->GetResultIds(), search_job->GetResultDistances());
+                                                      search_job->GetResultIds(), search_job->GetResultDistances(),
+                                                      max_sim);
                 }
                 search_job->SearchDone(index_id_);
                 index_engine_ = nullptr;
                 return;
             }
+            server::QueryProfilePtr profile = context_ ? context_->GetQueryProfile() : nullptr;
+            if (profile) {
+                profile->AddSegment();
+            }
+            server::QueryProfileScope search_scope(profile, server::QueryStage::kSearch);
             if (!vectors.float_data_.empty()) {
                 s = index_engine_->Search(nq, vectors.float_data_.data(), topk, extra_params, output_distance.data(),
                                           output_ids.data(), hybrid);
@@ -307,6 +340,7 @@ XSearchTask::Execute() {
                 s = index_engine_->Search(nq, vectors.binary_data_.data(), topk, extra_params, output_distance.data(),
                                           output_ids.data(), hybrid);
             }
+            search_scope.Finish();
 
             fiu_do_on("XSearchTask.Execute.search_fail", s = Status(SERVER_UNEXPECTED_ERROR, ""));
 
@@ -327,6 +361,7 @@ XSearchTask::Execute() {
             }
 
             {
+                server::QueryProfileScope merge_scope(profile, server::QueryStage::kMerge);
                 std::unique_lock<std::mutex> lock(search_job->mutex());
 
                 if (search_job->GetResultIds().size() > spec_k) {
@@ -361,7 +396,7 @@ XSearchTask::Execute() {
 void
 XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
                                   size_t src_k, size_t nq, size_t topk, bool ascending, scheduler::ResultIds& tar_ids,
-                                  scheduler::ResultDistances& tar_distances) {
+                                  scheduler::ResultDistances& tar_distances, bool unique_ids) {
     if (src_ids.empty()) {
         LOG_ENGINE_DEBUG_ << LogOut("[%s][%d] Search result is empty.", "search", 0);
         return;
@@ -373,6 +408,44 @@ XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const sch
     scheduler::ResultIds buf_ids(nq * buf_k, -1);
     scheduler::ResultDistances buf_distances(nq * buf_k, 0.0);
 
+    if (unique_ids) {
+        // an entity split over segments has hits in both, the best one comes first. -1 pads the hits
+        for (uint64_t i = 0; i < nq; i++) {
+            std::unordered_set<int64_t> merged;
+            size_t buf_k_j = 0, src_k_j = 0, tar_k_j = 0;
+            while (buf_k_j < buf_k) {
+                size_t src_idx = topk * i + src_k_j;
+                size_t tar_idx = tar_k * i + tar_k_j;
+                bool src_valid = src_k_j < src_k && src_ids[src_idx] != -1;
+                bool tar_valid = tar_k_j < tar_k && tar_ids[tar_idx] != -1;
+                if (!src_valid && !tar_valid) {
+                    break;
+                }
+
+                int64_t id;
+                float distance;
+                if (!tar_valid || (src_valid && (ascending ? src_distances[src_idx] < tar_distances[tar_idx]
+                                                           : src_distances[src_idx] > tar_distances[tar_idx]))) {
+                    id = src_ids[src_idx];
+                    distance = src_distances[src_idx];
+                    src_k_j++;
+                } else {
+                    id = tar_ids[tar_idx];
+                    distance = tar_distances[tar_idx];
+                    tar_k_j++;
+                }
+                if (merged.insert(id).second) {
+                    buf_ids[buf_k * i + buf_k_j] = id;
+                    buf_distances[buf_k * i + buf_k_j] = distance;
+                    buf_k_j++;
+                }
+            }
+        }
+        tar_ids.swap(buf_ids);
+        tar_distances.swap(buf_distances);
+        return;
+    }
+
     for (uint64_t i = 0; i < nq; i++) {
         size_t buf_k_j = 0, src_k_j = 0, tar_k_j = 0;
         size_t buf_idx, src_idx, tar_idx;
@@ -426,6 +499,89 @@ XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const sch
     tar_distances.swap(buf_distances);
 }
 
+void
+XSearchTask::AggregateMaxSim(const query::VectorQuery& vector_query, bool ascending, uint64_t& nq, uint64_t& topk,
+                             scheduler::ResultIds& ids, scheduler::ResultDistances& distances) {
+    auto better = [ascending](float a, float b) { return ascending ? a < b : a > b; };
+    uint64_t k = vector_query.topk;
+
+    // the query vectors of each query, one by one for MAX
+    std::vector<std::pair<uint64_t, uint64_t>> queries;
+    if (vector_query.max_sim == query::MaxSimType::SUM_MAX) {
+        uint64_t begin = 0;
+        for (auto length : vector_query.query_lengths) {
+            uint64_t end = std::min<uint64_t>(begin + length, nq);
+            queries.emplace_back(begin, end - begin);
+            begin = end;
+        }
+    } else {
+        for (uint64_t i = 0; i < nq; ++i) {
+            queries.emplace_back(i, 1);
+        }
+    }
+
+    float worst = ascending ? std::numeric_limits<float>::max() : std::numeric_limits<float>::lowest();
+    scheduler::ResultIds result_ids(queries.size() * k, -1);
+    scheduler::ResultDistances result_distances(queries.size() * k, worst);
+    for (size_t q = 0; q < queries.size(); ++q) {
+        // the best hit of each entity for each query vector. an entity without hit for a query vector counts
+        // the farthest hit of it, which bounds its own. a query vector without any hit is left out
+        std::vector<std::unordered_map<int64_t, float>> best(queries[q].second);
+        std::vector<float> farthest(queries[q].second, ascending ? std::numeric_limits<float>::lowest()
+                                                                  : std::numeric_limits<float>::max());
+        std::unordered_set<int64_t> entities;
+        for (uint64_t t = 0; t < queries[q].second; ++t) {
+            uint64_t offset = (queries[q].first + t) * topk;
+            for (uint64_t j = 0; j < topk; ++j) {
+                int64_t id = ids[offset + j];
+                if (id == -1) {
+                    continue;
+                }
+                float distance = distances[offset + j];
+                auto it = best[t].find(id);
+                if (it == best[t].end()) {
+                    best[t].emplace(id, distance);
+                } else if (better(distance, it->second)) {
+                    it->second = distance;
+                }
+                if (better(farthest[t], distance)) {
+                    farthest[t] = distance;
+                }
+                entities.insert(id);
+            }
+        }
+
+        std::vector<std::pair<float, int64_t>> scores;
+        scores.reserve(entities.size());
+        for (auto id : entities) {
+            float score = 0;
+            for (uint64_t t = 0; t < queries[q].second; ++t) {
+                if (best[t].empty()) {
+                    continue;
+                }
+                auto it = best[t].find(id);
+                score += it != best[t].end() ? it->second : farthest[t];
+            }
+            scores.emplace_back(score, id);
+        }
+
+        size_t n = std::min<size_t>(k, scores.size());
+        std::partial_sort(scores.begin(), scores.begin() + n, scores.end(),
+                          [&better](const std::pair<float, int64_t>& a, const std::pair<float, int64_t>& b) {
+                              return better(a.first, b.first) || (a.first == b.first && a.second < b.second);
+                          });
+        for (size_t j = 0; j < n; ++j) {
+            result_ids[q * k + j] = scores[j].second;
+            result_distances[q * k + j] = scores[j].first;
+        }
+    }
+
+    nq = queries.size();
+    topk = k;
+    ids.swap(result_ids);
+    distances.swap(result_distances);
+}
+
 const std::string&
 XSearchTask::GetLocation() const {
     return file_->location_;
@@ -436,6 +592,27 @@ XSearchTask::GetIndexId() const {
     return file_->id_;
 }
 
+int64_t
+XSearchTask::EstimateMemory() {
+    int64_t bytes = 0;
+    // the index file is copied into memory unless it is cached already
+    if (!cache::CpuCacheMgr::GetInstance()->ItemExists(file_->location_)) {
+        bytes += static_cast<int64_t>(file_->file_size_);
+    }
+
+    // per file topk result buffers
+    if (auto job = job_.lock()) {
+        auto search_job = std::static_pointer_cast<scheduler::SearchJob>(job);
+        bytes += static_cast<int64_t>(search_job->nq() * search_job->topk() * (sizeof(int64_t) + sizeof(float)));
+    }
+    return bytes;
+}
+
+std::string
+XSearchTask::CollectionId() const {
+    return engine::utils::GetQuotaCollectionId(*file_);
+}
+
 // void
 // XSearchTask::MergeTopkArray(std::vector<int64_t>& tar_ids, std::vector<float>& tar_distance, uint64_t& tar_input_k,
 //                            const std::vector<int64_t>& src_ids, const std::vector<float>& src_distance,
@@ -33,11 +33,24 @@ class XSearchTask : public Task {
     void
     Execute() override;
 
+    int64_t
+    EstimateMemory() override;
+
+    std::string
+    CollectionId() const override;
+
  public:
+    // unique_ids: an id kept once for each query, for the entities of several vectors
     static void
     MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const scheduler::ResultDistances& src_distances,
                          size_t src_k, size_t nq, size_t topk, bool ascending, scheduler::ResultIds& tar_ids,
-                         scheduler::ResultDistances& tar_distances);
+                         scheduler::ResultDistances& tar_distances, bool unique_ids = false);
+
+    // group the nq x topk hits of the vectors of multi-vector entities by entity, see query::MaxSimType.
+    // nq becomes the number of queries and topk that of the vector query
+    static void
+    AggregateMaxSim(const query::VectorQuery& vector_query, bool ascending, uint64_t& nq, uint64_t& topk,
+                    scheduler::ResultIds& ids, scheduler::ResultDistances& distances);
 
     //    static void
     //    MergeTopkArray(std::vector<int64_t>& tar_ids, std::vector<float>& tar_distance, uint64_t& tar_input_k,
@@ -78,8 +78,25 @@ class Task {
     virtual void
     Execute() = 0;
 
+    /*
+     * Memory the task needs from being loaded until executed, reserved by the admission gate;
+     */
+    virtual int64_t
+    EstimateMemory() {
+        return 0;
+    }
+
+    // collection the reserved memory counts for, a partition counts for the collection owning it
+    virtual std::string
+    CollectionId() const {
+        return "";
+    }
+
  public:
     Path task_path_;
+    int64_t reserved_memory_ = 0;
+    // memory the task needs exceeds the budget, it fails in loading instead of waiting forever
+    bool over_budget_ = false;
     scheduler::JobWPtr job_;
     TaskType type_;
     TaskLabelPtr label_ = nullptr;
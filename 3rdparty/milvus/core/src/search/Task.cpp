@@ -37,8 +37,8 @@ Task::Task(const std::shared_ptr<server::Context>& context, SegmentSchemaPtr& fi
       hybrid_search_context_(hybrid_search_context) {
     if (file_) {
         // distance -- value 0 means two vectors equal, ascending reduce, L2/HAMMING/JACCARD/TONIMOTO ...
-        // similarity -- infinity value means two vectors equal, descending reduce, IP
-        if (file_->metric_type_ == static_cast<int>(engine::MetricType::IP) &&
+        // similarity -- infinity value means two vectors equal, descending reduce, IP/COSINE
+        if (engine::utils::IsSimilarityMetricType(file_->metric_type_) &&
             file_->engine_type_ != static_cast<int>(engine::EngineType::FAISS_PQ)) {
             ascending_reduce = false;
         }
@@ -0,0 +1,77 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/IdIndex.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace milvus {
+namespace segment {
+
+IdIndex::IdIndex(const std::vector<doc_id_t>& uids) : offsets_(uids.size()) {
+    std::iota(offsets_.begin(), offsets_.end(), 0);
+    std::stable_sort(offsets_.begin(), offsets_.end(), [&](offset_t a, offset_t b) { return uids[a] < uids[b]; });
+
+    uids_.resize(uids.size());
+    for (size_t i = 0; i < offsets_.size(); ++i) {
+        uids_[i] = uids[offsets_[i]];
+    }
+}
+
+IdIndex::IdIndex(std::vector<doc_id_t>&& sorted_uids, std::vector<offset_t>&& offsets)
+    : uids_(std::move(sorted_uids)), offsets_(std::move(offsets)) {
+}
+
+bool
+IdIndex::Lookup(doc_id_t uid, offset_t& offset) const {
+    auto it = std::lower_bound(uids_.begin(), uids_.end(), uid);
+    if (it == uids_.end() || *it != uid) {
+        return false;
+    }
+    offset = offsets_[it - uids_.begin()];
+    return true;
+}
+
+const std::vector<doc_id_t>&
+IdIndex::GetUids() const {
+    return uids_;
+}
+
+const std::vector<offset_t>&
+IdIndex::GetOffsets() const {
+    return offsets_;
+}
+
+size_t
+IdIndex::GetCount() const {
+    return uids_.size();
+}
+
+int64_t
+IdIndex::Size() {
+    return uids_.size() * sizeof(doc_id_t) + offsets_.size() * sizeof(offset_t);
+}
+
+std::string
+IdIndexCacheKey(const std::string& segment_dir) {
+    return segment_dir + "/uid_index";
+}
+
+}  // namespace segment
+}  // namespace milvus
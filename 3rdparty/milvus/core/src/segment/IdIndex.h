@@ -18,15 +18,62 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
-#include "AttrIndex.h"
+#include "cache/DataObj.h"
+#include "segment/DeletedDocs.h"
 
 namespace milvus {
 namespace segment {
 
-class IdIndex : public AttrIndex {};
+using doc_id_t = int64_t;
+
+// maps the uids of a segment to their offsets. the uids are kept sorted with their offsets alongside, so that
+// a lookup is a binary search instead of a scan of the uid file. the index of a segment never changes since
+// deletes only append to the deleted docs, it is kept in the cpu cache, see SegmentReader::LoadIdIndex
+class IdIndex : public cache::DataObj {
+ public:
+    // uids in the order of the segment, uids[i] is at offset i
+    explicit IdIndex(const std::vector<doc_id_t>& uids);
+
+    // uids sorted ascending, offsets[i] is the offset of uids[i]
+    IdIndex(std::vector<doc_id_t>&& sorted_uids, std::vector<offset_t>&& offsets);
+
+    bool
+    Lookup(doc_id_t uid, offset_t& offset) const;
+
+    const std::vector<doc_id_t>&
+    GetUids() const;
+
+    const std::vector<offset_t>&
+    GetOffsets() const;
+
+    size_t
+    GetCount() const;
+
+    int64_t
+    Size() override;
+
+    // No copy and move
+    IdIndex(const IdIndex&) = delete;
+    IdIndex(IdIndex&&) = delete;
+
+    IdIndex&
+    operator=(const IdIndex&) = delete;
+    IdIndex&
+    operator=(IdIndex&&) = delete;
+
+ private:
+    std::vector<doc_id_t> uids_;
+    std::vector<offset_t> offsets_;
+};
 
 using IdIndexPtr = std::shared_ptr<IdIndex>;
 
+// key of the id index of the segment in the cpu cache
+std::string
+IdIndexCacheKey(const std::string& segment_dir);
+
 }  // namespace segment
 }  // namespace milvus
@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "Vectors.h"
+#include "cache/CpuCacheMgr.h"
 #include "codecs/default/DefaultCodec.h"
 #include "storage/disk/DiskIOReader.h"
 #include "storage/disk/DiskIOWriter.h"
@@ -73,6 +74,21 @@ SegmentReader::LoadVectors(off_t offset, size_t num_bytes, std::vector<uint8_t>&
     return Status::OK();
 }
 
+Status
+SegmentReader::LoadVectors(const std::vector<offset_t>& offsets, size_t single_vector_bytes,
+                           std::vector<uint8_t>& raw_vectors) {
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetVectorsFormat()->read_vectors(fs_ptr_, offsets, single_vector_bytes, raw_vectors);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load raw vectors: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentReader::LoadUids(std::vector<doc_id_t>& uids) {
     codec::DefaultCodec default_codec;
@@ -121,6 +137,33 @@ SegmentReader::LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
     return Status::OK();
 }
 
+Status
+SegmentReader::LoadIdIndex(segment::IdIndexPtr& id_index_ptr, bool cache_only) {
+    auto cache_key = IdIndexCacheKey(fs_ptr_->operation_ptr_->GetDirectory());
+    id_index_ptr = std::static_pointer_cast<IdIndex>(cache::CpuCacheMgr::GetInstance()->GetItem(cache_key));
+    if (id_index_ptr != nullptr || cache_only) {
+        return Status::OK();
+    }
+
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetIdIndexFormat()->read(fs_ptr_, id_index_ptr);
+        if (id_index_ptr == nullptr) {
+            std::vector<doc_id_t> uids;
+            default_codec.GetVectorsFormat()->read_uids(fs_ptr_, uids);
+            id_index_ptr = std::make_shared<IdIndex>(uids);
+        }
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load id index: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+
+    cache::CpuCacheMgr::GetInstance()->InsertItem(cache_key, id_index_ptr);
+    return Status::OK();
+}
+
 Status
 SegmentReader::LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr) {
     codec::DefaultCodec default_codec;
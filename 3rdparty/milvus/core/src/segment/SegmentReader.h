@@ -42,6 +42,10 @@ class SegmentReader {
     Status
     LoadVectors(off_t offset, size_t num_bytes, std::vector<uint8_t>& raw_vectors);
 
+    // the vectors at the given ascending offsets, opening the raw vector file once
+    Status
+    LoadVectors(const std::vector<offset_t>& offsets, size_t single_vector_bytes, std::vector<uint8_t>& raw_vectors);
+
     Status
     LoadUids(std::vector<doc_id_t>& uids);
 
@@ -51,6 +55,11 @@ class SegmentReader {
     Status
     LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr);
 
+    // the id index is taken from the cpu cache, or read from its file and cached. for segments written without
+    // an id index it is built from the uids. with cache_only, id_index_ptr is null if the index is not cached
+    Status
+    LoadIdIndex(segment::IdIndexPtr& id_index_ptr, bool cache_only = false);
+
     Status
     LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr);
 
@@ -103,6 +103,13 @@ SegmentWriter::Serialize() {
 
     recorder.RecordSection("Writing vectors and uids done");
 
+    status = WriteIdIndex();
+    if (!status.ok()) {
+        return status;
+    }
+
+    recorder.RecordSection("Writing id index done");
+
     // Write an empty deleted doc
     status = WriteDeletedDocs();
 
@@ -195,6 +202,23 @@ SegmentWriter::WriteBloomFilter() {
     return Status::OK();
 }
 
+Status
+SegmentWriter::WriteIdIndex() {
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        segment_ptr_->id_index_ptr_ = std::make_shared<IdIndex>(segment_ptr_->vectors_ptr_->GetUids());
+        default_codec.GetIdIndexFormat()->write(fs_ptr_, segment_ptr_->id_index_ptr_);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to write id index: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+
+        engine::utils::SendExitSignal();
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentWriter::WriteDeletedDocs() {
     codec::DefaultCodec default_codec;
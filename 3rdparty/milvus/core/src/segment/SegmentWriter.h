@@ -80,6 +80,9 @@ class SegmentWriter {
     Status
     WriteBloomFilter();
 
+    Status
+    WriteIdIndex();
+
     Status
     WriteDeletedDocs();
 
@@ -22,6 +22,7 @@
 #include "segment/Attrs.h"
 #include "segment/DeletedDocs.h"
 #include "segment/IdBloomFilter.h"
+#include "segment/IdIndex.h"
 #include "segment/VectorIndex.h"
 #include "segment/Vectors.h"
 
@@ -36,6 +37,7 @@ struct Segment {
     VectorIndexPtr vector_index_ptr_ = std::make_shared<VectorIndex>();
     DeletedDocsPtr deleted_docs_ptr_ = nullptr;
     IdBloomFilterPtr id_bloom_filter_ptr_ = nullptr;
+    IdIndexPtr id_index_ptr_ = nullptr;
 };
 
 using SegmentPtr = std::shared_ptr<Segment>;
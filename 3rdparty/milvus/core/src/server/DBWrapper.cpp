@@ -18,6 +18,7 @@
 
 #include <faiss/utils/distances.h>
 
+#include "cache/ResultCacheMgr.h"
 #include "config/Config.h"
 #include "db/DBFactory.h"
 #include "utils/CommonUtil.h"
@@ -70,6 +71,20 @@ DBWrapper::StartService() {
         return s;
     }
 
+    float auto_compact_ratio = 0.0;
+    s = config.GetDBConfigAutoCompactRatio(auto_compact_ratio);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    opt.auto_compact_ratio_ = auto_compact_ratio;
+
+    s = config.GetDBConfigAutoCompactRate(opt.auto_compact_rate_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     // cache config
     s = config.GetCacheConfigCacheInsertData(opt.insert_cache_immediately_);
     if (!s.ok()) {
@@ -218,6 +233,9 @@ DBWrapper::StartService() {
 
     db_->Start();
 
+    // data versions start over with the new db, results cached against the previous one are unusable
+    cache::ResultCacheMgr::GetInstance()->ClearCache();
+
     // preload collection
     std::string preload_collections;
     s = config.GetDBConfigPreloadCollection(preload_collections);
@@ -29,14 +29,22 @@ Context::SetTraceContext(const std::shared_ptr<tracing::TraceContext>& trace_con
 std::shared_ptr<Context>
 Context::Child(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(request_id_);
-    new_context->SetTraceContext(trace_context_->Child(operation_name));
+    if (trace_context_) {
+        new_context->SetTraceContext(trace_context_->Child(operation_name));
+    }
+    new_context->SetQueryProfile(query_profile_);
+    new_context->SetDeadline(deadline_);
     return new_context;
 }
 
 std::shared_ptr<Context>
 Context::Follower(const std::string& operation_name) const {
     auto new_context = std::make_shared<Context>(request_id_);
-    new_context->SetTraceContext(trace_context_->Follower(operation_name));
+    if (trace_context_) {
+        new_context->SetTraceContext(trace_context_->Follower(operation_name));
+    }
+    new_context->SetQueryProfile(query_profile_);
+    new_context->SetDeadline(deadline_);
     return new_context;
 }
 
@@ -64,6 +72,26 @@ Context::SetRequestType(BaseRequest::RequestType type) {
     request_type_ = type;
 }
 
+void
+Context::SetQueryProfile(const QueryProfilePtr& profile) {
+    query_profile_ = profile;
+}
+
+const QueryProfilePtr&
+Context::GetQueryProfile() const {
+    return query_profile_;
+}
+
+void
+Context::SetDeadline(const BaseRequest::TimePoint& deadline) {
+    deadline_ = deadline;
+}
+
+const BaseRequest::TimePoint&
+Context::Deadline() const {
+    return deadline_;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 ContextChild::ContextChild(const ContextPtr& context, const std::string& operation_name) {
     if (context) {
@@ -78,7 +106,9 @@ ContextChild::~ContextChild() {
 void
 ContextChild::Finish() {
     if (context_) {
-        context_->GetTraceContext()->GetSpan()->Finish();
+        if (context_->GetTraceContext()) {
+            context_->GetTraceContext()->GetSpan()->Finish();
+        }
         context_ = nullptr;
     }
 }
@@ -91,7 +121,7 @@ ContextFollower::ContextFollower(const ContextPtr& context, const std::string& o
 }
 
 ContextFollower::~ContextFollower() {
-    if (context_) {
+    if (context_ && context_->GetTraceContext()) {
         context_->GetTraceContext()->GetSpan()->Finish();
     }
 }
@@ -99,7 +129,9 @@ ContextFollower::~ContextFollower() {
 void
 ContextFollower::Finish() {
     if (context_) {
-        context_->GetTraceContext()->GetSpan()->Finish();
+        if (context_->GetTraceContext()) {
+            context_->GetTraceContext()->GetSpan()->Finish();
+        }
         context_ = nullptr;
     }
 }
@@ -18,6 +18,7 @@
 #include <grpcpp/server_context.h>
 
 #include "server/context/ConnectionContext.h"
+#include "server/context/QueryProfile.h"
 #include "server/delivery/request/BaseRequest.h"
 #include "tracing/TraceContext.h"
 
@@ -57,11 +58,26 @@ class Context {
     void
     SetRequestType(BaseRequest::RequestType type);
 
+    void
+    SetQueryProfile(const QueryProfilePtr& profile);
+
+    const QueryProfilePtr&
+    GetQueryProfile() const;
+
+    // the request is useless to its caller past the deadline, TimePoint::max() if none
+    void
+    SetDeadline(const BaseRequest::TimePoint& deadline);
+
+    const BaseRequest::TimePoint&
+    Deadline() const;
+
  private:
     std::string request_id_;
     BaseRequest::RequestType request_type_;
     std::shared_ptr<tracing::TraceContext> trace_context_;
     ConnectionContextPtr context_;
+    QueryProfilePtr query_profile_;
+    BaseRequest::TimePoint deadline_ = BaseRequest::TimePoint::max();
 };
 
 using ContextPtr = std::shared_ptr<milvus::server::Context>;
@@ -0,0 +1,137 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/context/QueryProfile.h"
+#include "metrics/Metrics.h"
+
+#include <time.h>
+
+namespace milvus {
+namespace server {
+
+namespace {
+
+int64_t
+ThreadCpuTimeUs() {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+}  // namespace
+
+const char*
+QueryStageName(QueryStage stage) {
+    switch (stage) {
+        case QueryStage::kMeta:
+            return "meta";
+        case QueryStage::kInsertBuffer:
+            return "insert_buffer";
+        case QueryStage::kLoad:
+            return "load";
+        case QueryStage::kSearch:
+            return "search";
+        case QueryStage::kMerge:
+            return "merge";
+        case QueryStage::kResult:
+            return "result";
+        default:
+            return "unknown";
+    }
+}
+
+QueryProfile::QueryProfile() = default;
+
+void
+QueryProfile::AddStage(QueryStage stage, int64_t wall_us, int64_t thread_cpu_us) {
+    auto& counter = stages_[static_cast<int>(stage)];
+    counter.wall_us_.fetch_add(wall_us, std::memory_order_relaxed);
+    counter.thread_cpu_us_.fetch_add(thread_cpu_us, std::memory_order_relaxed);
+    counter.count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+int64_t
+QueryProfile::StageWallTime(QueryStage stage) const {
+    return stages_[static_cast<int>(stage)].wall_us_.load(std::memory_order_relaxed);
+}
+
+int64_t
+QueryProfile::TotalWallTime() const {
+    return total_wall_us_.load(std::memory_order_relaxed);
+}
+
+milvus::json
+QueryProfile::ToJson() const {
+    milvus::json stages = milvus::json::object();
+    for (int i = 0; i < static_cast<int>(QueryStage::kCount); ++i) {
+        auto& counter = stages_[i];
+        auto count = counter.count_.load(std::memory_order_relaxed);
+        if (count == 0) {
+            continue;
+        }
+        milvus::json stage;
+        stage["wall_us"] = counter.wall_us_.load(std::memory_order_relaxed);
+        stage["thread_cpu_us"] = counter.thread_cpu_us_.load(std::memory_order_relaxed);
+        stage["count"] = count;
+        stages[QueryStageName(static_cast<QueryStage>(i))] = stage;
+    }
+
+    milvus::json profile;
+    profile["total_us"] = TotalWallTime();
+    profile["stages"] = stages;
+    profile["bytes_loaded"] = BytesLoaded();
+    profile["segments"] = Segments();
+    profile["cache_hits"] = CacheHits();
+    profile["cache_misses"] = CacheMisses();
+    return profile;
+}
+
+void
+QueryProfile::Report() const {
+    for (int i = 0; i < static_cast<int>(QueryStage::kCount); ++i) {
+        auto& counter = stages_[i];
+        if (counter.count_.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        server::Metrics::GetInstance().QueryStageDurationHistogramObserve(
+            QueryStageName(static_cast<QueryStage>(i)), counter.wall_us_.load(std::memory_order_relaxed));
+    }
+    server::Metrics::GetInstance().QuerySegmentsHistogramObserve(Segments());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+QueryProfileScope::QueryProfileScope(const QueryProfilePtr& profile, QueryStage stage)
+    : profile_(profile), stage_(stage) {
+    if (profile_) {
+        wall_start_ = std::chrono::steady_clock::now();
+        cpu_start_us_ = ThreadCpuTimeUs();
+    }
+}
+
+QueryProfileScope::~QueryProfileScope() {
+    Finish();
+}
+
+void
+QueryProfileScope::Finish() {
+    if (profile_) {
+        auto wall_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wall_start_)
+                .count();
+        profile_->AddStage(stage_, wall_us, ThreadCpuTimeUs() - cpu_start_us_);
+        profile_ = nullptr;
+    }
+}
+
+}  // namespace server
+}  // namespace milvus
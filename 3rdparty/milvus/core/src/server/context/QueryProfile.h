@@ -0,0 +1,148 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "utils/Json.h"
+
+namespace milvus {
+namespace server {
+
+enum class QueryStage {
+    kMeta = 0,      // collect files from meta
+    kInsertBuffer,  // brute force search in unflushed insert buffer
+    kLoad,          // load index files into cpu/gpu memory
+    kSearch,        // search single index file
+    kMerge,         // reduce per file topk into job result
+    kResult,        // construct response
+    kCount,
+};
+
+const char*
+QueryStageName(QueryStage stage);
+
+/*
+ * Per-request profile carried by server::Context.
+ * Search tasks of one request run concurrently in scheduler executors, so every counter is an atomic
+ * and no lock is needed to record a stage.
+ */
+class QueryProfile {
+ public:
+    QueryProfile();
+
+    void
+    AddStage(QueryStage stage, int64_t wall_us, int64_t thread_cpu_us);
+
+    void
+    AddBytesLoaded(int64_t bytes) {
+        bytes_loaded_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void
+    AddSegment() {
+        segments_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void
+    AddCacheHit() {
+        cache_hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void
+    AddCacheMiss() {
+        cache_misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int64_t
+    StageWallTime(QueryStage stage) const;
+
+    int64_t
+    TotalWallTime() const;
+
+    void
+    SetTotalWallTime(int64_t wall_us) {
+        total_wall_us_.store(wall_us, std::memory_order_relaxed);
+    }
+
+    int64_t
+    BytesLoaded() const {
+        return bytes_loaded_.load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    Segments() const {
+        return segments_.load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    CacheHits() const {
+        return cache_hits_.load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    CacheMisses() const {
+        return cache_misses_.load(std::memory_order_relaxed);
+    }
+
+    milvus::json
+    ToJson() const;
+
+    // push stage durations into prometheus
+    void
+    Report() const;
+
+ private:
+    struct StageCounter {
+        std::atomic<int64_t> wall_us_{0};
+        std::atomic<int64_t> thread_cpu_us_{0};
+        std::atomic<int64_t> count_{0};
+    };
+
+    StageCounter stages_[static_cast<int>(QueryStage::kCount)];
+    std::atomic<int64_t> total_wall_us_{0};
+    std::atomic<int64_t> bytes_loaded_{0};
+    std::atomic<int64_t> segments_{0};
+    std::atomic<int64_t> cache_hits_{0};
+    std::atomic<int64_t> cache_misses_{0};
+};
+
+using QueryProfilePtr = std::shared_ptr<QueryProfile>;
+
+/*
+ * Record wall and thread cpu time of a stage into a profile when leaving scope.
+ * The cpu time is that of the thread which opened the scope only, work the stage hands to OpenMP workers
+ * (e.g. faiss searching a segment) is not counted. Process cpu time would include concurrent requests, so a
+ * parallel stage shows thread cpu time far below its wall time instead.
+ * A null profile turns the scope into a no-op so callers need not check whether profiling is enabled.
+ */
+class QueryProfileScope {
+ public:
+    QueryProfileScope(const QueryProfilePtr& profile, QueryStage stage);
+    ~QueryProfileScope();
+
+    void
+    Finish();
+
+ private:
+    QueryProfilePtr profile_;
+    QueryStage stage_;
+    std::chrono::steady_clock::time_point wall_start_;
+    int64_t cpu_start_us_ = 0;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -35,10 +35,12 @@
 #include "server/delivery/request/InsertRequest.h"
 #include "server/delivery/request/PreloadCollectionRequest.h"
 #include "server/delivery/request/SearchByIDRequest.h"
+#include "server/delivery/request/SearchCollectionsRequest.h"
 #include "server/delivery/request/SearchRequest.h"
 #include "server/delivery/request/ShowCollectionInfoRequest.h"
 #include "server/delivery/request/ShowCollectionsRequest.h"
 #include "server/delivery/request/ShowPartitionsRequest.h"
+#include "server/delivery/request/TuneSearchParamsRequest.h"
 
 #include "server/delivery/hybrid_request/CreateHybridCollectionRequest.h"
 #include "server/delivery/hybrid_request/DescribeHybridCollectionRequest.h"
@@ -140,6 +142,18 @@ RequestHandler::Search(const std::shared_ptr<Context>& context, const std::strin
     return request_ptr->status();
 }
 
+Status
+RequestHandler::SearchCollections(const std::shared_ptr<Context>& context,
+                                  const std::vector<std::string>& collection_names, const engine::VectorsData& vectors,
+                                  int64_t topk, const milvus::json& extra_params,
+                                  const std::vector<std::string>& partition_list, TopKQueryResult& result) {
+    BaseRequestPtr request_ptr =
+        SearchCollectionsRequest::Create(context, collection_names, vectors, topk, extra_params, partition_list, result);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
 Status
 RequestHandler::SearchByID(const std::shared_ptr<Context>& context, const std::string& collection_name,
                            const std::vector<int64_t>& id_array, int64_t topk, const milvus::json& extra_params,
@@ -264,6 +278,17 @@ RequestHandler::Compact(const std::shared_ptr<Context>& context, const std::stri
     return request_ptr->status();
 }
 
+Status
+RequestHandler::TuneSearchParams(const std::shared_ptr<Context>& context, const std::string& collection_name,
+                                 int64_t topk, double target_recall, const engine::VectorsData& vectors,
+                                 milvus::json& result) {
+    BaseRequestPtr request_ptr =
+        TuneSearchParamsRequest::Create(context, collection_name, topk, target_recall, vectors, result);
+    RequestScheduler::ExecRequest(request_ptr);
+
+    return request_ptr->status();
+}
+
 /*******************************************New Interface*********************************************/
 
 Status
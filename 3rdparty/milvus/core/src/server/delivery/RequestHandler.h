@@ -68,6 +68,11 @@ class RequestHandler {
            const std::vector<std::string>& partition_list, const std::vector<std::string>& file_id_list,
            TopKQueryResult& result);
 
+    Status
+    SearchCollections(const std::shared_ptr<Context>& context, const std::vector<std::string>& collection_names,
+                      const engine::VectorsData& vectors, int64_t topk, const milvus::json& extra_params,
+                      const std::vector<std::string>& partition_list, TopKQueryResult& result);
+
     Status
     SearchByID(const std::shared_ptr<Context>& context, const std::string& collection_name,
                const std::vector<int64_t>& id_array, int64_t topk, const milvus::json& extra_params,
@@ -117,6 +122,10 @@ class RequestHandler {
     Status
     Compact(const std::shared_ptr<Context>& context, const std::string& collection_name, double compact_threshold);
 
+    Status
+    TuneSearchParams(const std::shared_ptr<Context>& context, const std::string& collection_name, int64_t topk,
+                     double target_recall, const engine::VectorsData& vectors, milvus::json& result);
+
     /*******************************************New Interface*********************************************/
 
     Status
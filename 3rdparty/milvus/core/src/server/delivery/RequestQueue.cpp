@@ -10,13 +10,15 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/RequestQueue.h"
+#include "metrics/Metrics.h"
 #include "server/delivery/strategy/RequestStrategy.h"
 #include "server/delivery/strategy/SearchReqStrategy.h"
 #include "utils/Log.h"
 
 #include <fiu-local.h>
 #include <unistd.h>
-#include <queue>
+#include <chrono>
+#include <map>
 #include <utility>
 
 namespace milvus {
@@ -24,14 +26,14 @@ namespace server {
 
 namespace {
 Status
-ScheduleRequest(const BaseRequestPtr& request, std::queue<BaseRequestPtr>& queue) {
+ScheduleRequest(const BaseRequestPtr& request, std::deque<BaseRequestPtr>& queue) {
 #if 1
     if (request == nullptr) {
         return Status(SERVER_NULL_POINTER, "request schedule cannot handle null object");
     }
 
     if (queue.empty()) {
-        queue.push(request);
+        queue.push_back(request);
         return Status::OK();
     }
 
@@ -40,12 +42,12 @@ ScheduleRequest(const BaseRequestPtr& request, std::queue<BaseRequestPtr>& queue
 
     auto iter = s_schedulers.find(request->GetRequestType());
     if (iter == s_schedulers.end() || iter->second == nullptr) {
-        queue.push(request);
+        queue.push_back(request);
     } else {
         iter->second->ReScheduleQueue(request, queue);
     }
 #else
-    queue.push(request);
+    queue.push_back(request);
 #endif
 
     return Status::OK();
@@ -61,17 +63,106 @@ RequestQueue::~RequestQueue() {
 
 BaseRequestPtr
 RequestQueue::TakeRequest() {
-    return Take();
+    while (true) {
+        BaseRequestPtr request;
+        std::vector<BaseRequestPtr> expired;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            empty_.wait(lock, [this] { return stopped_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return nullptr;
+            }
+
+            size_t pos = PickRequest(expired);
+            if (pos < queue_.size()) {
+                request = queue_[pos];
+                queue_.erase(queue_.begin() + pos);
+            }
+            full_.notify_all();
+        }
+
+        for (auto& req : expired) {
+            auto priority = BaseRequest::PriorityName(req->GetPriority());
+            LOG_SERVER_WARNING_ << "Shed " << priority << " request of type " << req->GetRequestType()
+                                << ", deadline passed in queue";
+            server::Metrics::GetInstance().RequestShedTotalIncrement(priority);
+            req->set_status(Status(SERVER_REQUEST_TIMEOUT, "Request deadline exceeded before execution"));
+            req->Done();
+        }
+
+        if (request != nullptr) {
+            auto wait = std::chrono::system_clock::now() - request->QueueTime();
+            server::Metrics::GetInstance().RequestQueueDurationHistogramObserve(
+                BaseRequest::PriorityName(request->GetPriority()),
+                std::chrono::duration_cast<std::chrono::microseconds>(wait).count());
+            return request;
+        }
+    }
 }
 
 Status
 RequestQueue::PutRequest(const BaseRequestPtr& request_ptr) {
-    std::unique_lock<std::mutex> lock(mtx);
+    std::unique_lock<std::mutex> lock(mtx_);
     full_.wait(lock, [this] { return (queue_.size() < capacity_); });
+    if (request_ptr != nullptr) {
+        request_ptr->SetQueueTime(std::chrono::system_clock::now());
+    }
     auto status = ScheduleRequest(request_ptr, queue_);
     empty_.notify_all();
     return status;
 }
 
+void
+RequestQueue::Stop() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stopped_ = true;
+    empty_.notify_all();
+}
+
+size_t
+RequestQueue::Size() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return queue_.size();
+}
+
+void
+RequestQueue::SetCapacity(const size_t capacity) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    capacity_ = (capacity > 0 ? capacity : capacity_);
+}
+
+size_t
+RequestQueue::PickRequest(std::vector<BaseRequestPtr>& expired) {
+    auto now = std::chrono::system_clock::now();
+    for (auto iter = queue_.begin(); iter != queue_.end();) {
+        if ((*iter)->Expired(now)) {
+            expired.push_back(*iter);
+            iter = queue_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    // the queue holds a few tens of requests at most, a scan is cheaper than keeping a heap in order,
+    // requests which are not reorderable are not taken before an earlier one of them
+    size_t best = queue_.size();
+    BaseRequest::TimePoint best_due = BaseRequest::TimePoint::max();
+    bool ordered_seen = false;
+    for (size_t i = 0; i < queue_.size(); ++i) {
+        if (!queue_[i]->Reorderable()) {
+            if (ordered_seen) {
+                continue;
+            }
+            ordered_seen = true;
+        }
+        auto due = queue_[i]->DueTime();
+        if (best == queue_.size() || due < best_due) {
+            best = i;
+            best_due = due;
+        }
+    }
+    return best;
+}
+
 }  // namespace server
 }  // namespace milvus
@@ -12,30 +12,53 @@
 #pragma once
 
 #include "server/delivery/request/BaseRequest.h"
-#include "utils/BlockingQueue.h"
 #include "utils/Status.h"
 
-#include <map>
+#include <condition_variable>
+#include <deque>
 #include <memory>
-#include <string>
-#include <thread>
+#include <mutex>
 #include <vector>
 
 namespace milvus {
 namespace server {
 
-using BlockingRequestQueue = BlockingQueue<BaseRequestPtr>;
-
-class RequestQueue : public BlockingRequestQueue {
+// Requests waiting for the thread of one request group. Unlike a fifo, the request taken is the one due
+// first (see BaseRequest::Priority), and requests whose deadline passed in the queue are shed.
+// Requests which are not reorderable (writes and DDL) keep fifo order among themselves.
+class RequestQueue {
  public:
     RequestQueue();
     virtual ~RequestQueue();
 
+    // block until a request is queued, nullptr once stopped and drained
     BaseRequestPtr
     TakeRequest();
 
     Status
     PutRequest(const BaseRequestPtr& request_ptr);
+
+    void
+    Stop();
+
+    size_t
+    Size();
+
+    void
+    SetCapacity(const size_t capacity);
+
+ private:
+    // remove the requests past their deadline, return the position of the request due first
+    size_t
+    PickRequest(std::vector<BaseRequestPtr>& expired);
+
+ private:
+    mutable std::mutex mtx_;
+    std::condition_variable full_;
+    std::condition_variable empty_;
+    std::deque<BaseRequestPtr> queue_;
+    size_t capacity_ = 32;
+    bool stopped_ = false;
 };
 
 using RequestQueuePtr = std::shared_ptr<RequestQueue>;
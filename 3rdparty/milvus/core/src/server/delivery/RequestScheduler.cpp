@@ -58,7 +58,7 @@ RequestScheduler::Stop() {
         std::lock_guard<std::mutex> lock(queue_mtx_);
         for (auto& iter : request_groups_) {
             if (iter.second != nullptr) {
-                iter.second->Put(nullptr);
+                iter.second->Stop();
             }
         }
     }
@@ -11,6 +11,7 @@
 
 #include "server/delivery/hybrid_request/HybridSearchRequest.h"
 #include "db/Utils.h"
+#include "query/BinaryQuery.h"
 #include "server/DBWrapper.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
@@ -91,6 +92,17 @@ HybridSearchRequest::OnExecute() {
                                (engine::meta::hybrid::DataType)fields_schema.fields_schema_[i].field_type_));
         }
 
+        // step 3: check the late interaction params of the vector query
+        auto vector_query = query::FindVectorQuery(general_query_);
+        if (vector_query != nullptr) {
+            status = query::ParseMaxSim(*vector_query, collection_schema.dimension_);
+            if (!status.ok()) {
+                return status;
+            }
+            engine::utils::NormalizeVectors(collection_schema.metric_type_, collection_schema.dimension_,
+                                            vector_query->query_vector.float_data);
+        }
+
         engine::ResultIds result_ids;
         engine::ResultDistances result_distances;
         uint64_t nq;
@@ -134,6 +134,29 @@ InsertEntityRequest::OnExecute() {
         // step 5: insert entities
         auto vec_count = static_cast<uint64_t>(vector_datas_it->second.vector_count_);
 
+        // an entity of several vectors is searched by late interaction over its vectors
+        auto& vector_lengths = vector_datas_it->second.vector_lengths_;
+        if (!vector_lengths.empty()) {
+            if (vector_lengths.size() != row_num_) {
+                return Status(SERVER_INVALID_ROWRECORD_ARRAY,
+                              "The number of vector lengths must be equal to the number of entities.");
+            }
+            uint64_t sum = 0;
+            for (auto length : vector_lengths) {
+                if (length <= 0) {
+                    return Status(SERVER_INVALID_ROWRECORD_ARRAY, "An entity must have at least one vector.");
+                }
+                sum += length;
+            }
+            if (sum != vec_count) {
+                return Status(SERVER_INVALID_ROWRECORD_ARRAY,
+                              "The vector lengths must add up to the number of vectors.");
+            }
+        }
+
+        // vectors of a COSINE collection are stored normalized, searches compare them by inner product
+        engine::utils::NormalizeVectors(collection_schema.metric_type_, vector_datas_it->second);
+
         engine::Entity entity;
         entity.entity_count_ = row_num_;
 
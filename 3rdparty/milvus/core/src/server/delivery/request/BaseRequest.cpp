@@ -11,6 +11,7 @@
 
 #include "server/delivery/request/BaseRequest.h"
 
+#include <algorithm>
 #include <map>
 
 #include "server/context/Context.h"
@@ -62,12 +63,14 @@ RequestGroup(BaseRequest::RequestType type) {
         {BaseRequest::kCreateIndex, DDL_DML_REQUEST_GROUP},
         {BaseRequest::kDescribeIndex, INFO_REQUEST_GROUP},
         {BaseRequest::kDropIndex, DDL_DML_REQUEST_GROUP},
+        {BaseRequest::kTuneSearchParams, DQL_REQUEST_GROUP},
 
         // search operations
         {BaseRequest::kSearchByID, DQL_REQUEST_GROUP},
         {BaseRequest::kSearch, DQL_REQUEST_GROUP},
         {BaseRequest::kSearchCombine, DQL_REQUEST_GROUP},
         {BaseRequest::kHybridSearch, DQL_REQUEST_GROUP},
+        {BaseRequest::kSearchCollections, DQL_REQUEST_GROUP},
     };
 
     auto iter = s_map_type_group.find(type);
@@ -77,6 +80,46 @@ RequestGroup(BaseRequest::RequestType type) {
     }
     return iter->second;
 }
+
+BaseRequest::Priority
+RequestPriority(BaseRequest::RequestType type) {
+    switch (type) {
+        case BaseRequest::kInsert:
+        case BaseRequest::kDeleteByID:
+        case BaseRequest::kInsertEntity:
+            return BaseRequest::kPriorityInsert;
+        case BaseRequest::kCompact:
+        case BaseRequest::kFlush:
+        case BaseRequest::kCreateCollection:
+        case BaseRequest::kDropCollection:
+        case BaseRequest::kCreateHybridCollection:
+        case BaseRequest::kCreatePartition:
+        case BaseRequest::kDropPartition:
+        case BaseRequest::kCreateIndex:
+        case BaseRequest::kDropIndex:
+            return BaseRequest::kPriorityAdmin;
+        case BaseRequest::kPreloadCollection:
+        case BaseRequest::kTuneSearchParams:
+            return BaseRequest::kPriorityBatchSearch;
+        default:
+            return BaseRequest::kPriorityInteractive;
+    }
+}
+
+// how long after being queued a request of each priority class is due
+std::chrono::milliseconds
+PrioritySlack(BaseRequest::Priority priority) {
+    switch (priority) {
+        case BaseRequest::kPriorityInteractive:
+            return std::chrono::milliseconds(0);
+        case BaseRequest::kPriorityBatchSearch:
+            return std::chrono::milliseconds(1000);
+        case BaseRequest::kPriorityInsert:
+            return std::chrono::milliseconds(2000);
+        default:
+            return std::chrono::milliseconds(10000);
+    }
+}
 }  // namespace
 
 BaseRequest::BaseRequest(const std::shared_ptr<milvus::server::Context>& context, BaseRequest::RequestType type,
@@ -92,6 +135,48 @@ BaseRequest::~BaseRequest() {
     WaitToFinish();
 }
 
+BaseRequest::Priority
+BaseRequest::GetPriority() const {
+    return RequestPriority(type_);
+}
+
+std::string
+BaseRequest::PriorityName(Priority priority) {
+    switch (priority) {
+        case kPriorityInteractive:
+            return "interactive";
+        case kPriorityBatchSearch:
+            return "batch_search";
+        case kPriorityInsert:
+            return "insert";
+        default:
+            return "admin";
+    }
+}
+
+BaseRequest::TimePoint
+BaseRequest::Deadline() const {
+    if (context_ == nullptr) {
+        return TimePoint::max();
+    }
+    return context_->Deadline();
+}
+
+BaseRequest::TimePoint
+BaseRequest::DueTime() const {
+    return std::min(Deadline(), queue_time_ + PrioritySlack(GetPriority()));
+}
+
+bool
+BaseRequest::Expired(const TimePoint& now) const {
+    return Deadline() < now;
+}
+
+bool
+BaseRequest::Reorderable() const {
+    return request_group_ != DDL_DML_REQUEST_GROUP;
+}
+
 Status
 BaseRequest::PreExecute() {
     status_ = OnPreExecute();
@@ -17,6 +17,7 @@
 #include "grpc/gen-status/status.grpc.pb.h"
 #include "grpc/gen-status/status.pb.h"
 #include "query/GeneralQuery.h"
+#include "server/context/QueryProfile.h"
 #include "utils/Json.h"
 #include "utils/Status.h"
 
@@ -56,6 +57,8 @@ struct TopKQueryResult {
     int64_t row_num_;
     engine::ResultIds id_list_;
     engine::ResultDistances distance_list_;
+    std::vector<std::string> collection_list_;  // collection of each hit, for searches of several collections
+    QueryProfilePtr profile_;  // per stage profile of the query, may be null
 
     TopKQueryResult() {
         row_num_ = 0;
@@ -141,14 +144,28 @@ class BaseRequest {
         kCreateIndex = 500,
         kDescribeIndex,
         kDropIndex,
+        kTuneSearchParams,
 
         // search operations
         kSearchByID = 600,
         kSearch,
         kSearchCombine,
         kHybridSearch,
+        kSearchCollections,
     };
 
+    // Requests of a queue are dispatched earliest due time first. A request is due at its deadline, or
+    // earlier when its priority class allows it to wait less, so low classes still run under load.
+    // Priorities only reorder reads, see Reorderable().
+    enum Priority {
+        kPriorityInteractive = 0,  // searches and cheap reads
+        kPriorityBatchSearch,      // searches of many vectors, preloading
+        kPriorityInsert,           // inserts and deletes
+        kPriorityAdmin,            // collection, partition and index management, flush, compact
+    };
+
+    using TimePoint = std::chrono::system_clock::time_point;
+
  protected:
     BaseRequest(const std::shared_ptr<milvus::server::Context>& context, BaseRequest::RequestType type,
                 bool async = false);
@@ -176,6 +193,38 @@ class BaseRequest {
         return type_;
     }
 
+    virtual Priority
+    GetPriority() const;
+
+    static std::string
+    PriorityName(Priority priority);
+
+    // deadline carried in the context, TimePoint::max() if none
+    TimePoint
+    Deadline() const;
+
+    // when the request should be dispatched at latest, see Priority
+    TimePoint
+    DueTime() const;
+
+    // whether the request is useless to its caller by now, the queue sheds it instead of executing it
+    virtual bool
+    Expired(const TimePoint& now) const;
+
+    // requests which change data or schema are dispatched in the order they were queued
+    bool
+    Reorderable() const;
+
+    void
+    SetQueueTime(const TimePoint& time) {
+        queue_time_ = time;
+    }
+
+    const TimePoint&
+    QueueTime() const {
+        return queue_time_;
+    }
+
     std::string
     RequestGroup() const {
         return request_group_;
@@ -218,6 +267,7 @@ class BaseRequest {
     bool async_;
     bool done_;
     Status status_;
+    TimePoint queue_time_;
 
  public:
     const std::shared_ptr<milvus::server::Context>&
@@ -13,6 +13,7 @@
 #include "config/Config.h"
 #include "metrics/SystemInfo.h"
 #include "scheduler/SchedInst.h"
+#include "server/DBWrapper.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
@@ -53,6 +54,12 @@ CmdRequest::OnExecute() {
     } else if (cmd_ == "get_system_info") {
         server::SystemInfo& sys_info_inst = server::SystemInfo::GetInstance();
         sys_info_inst.GetSysInfoJsonStr(result_);
+    } else if (cmd_ == "replication") {
+        milvus::json replication_status;
+        stat = DBWrapper::DB()->GetReplicationStatus(replication_status);
+        if (stat.ok()) {
+            result_ = replication_status.dump();
+        }
     } else if (cmd_ == "build_commit_id") {
         result_ = LAST_COMMIT_ID;
     } else if (cmd_.substr(0, 10) == "set_config" || cmd_.substr(0, 10) == "get_config") {
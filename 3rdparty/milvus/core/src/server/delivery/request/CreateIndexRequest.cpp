@@ -105,8 +105,8 @@ CreateIndexRequest::OnExecute() {
                   collection_info.metric_type_ = static_cast<int>(engine::MetricType::IP));
 
         if (s.ok() && adapter_index_type == (int)engine::EngineType::FAISS_PQ &&
-            collection_info.metric_type_ == (int)engine::MetricType::IP) {
-            return Status(SERVER_UNEXPECTED_ERROR, "PQ not support IP in GPU version!");
+            engine::utils::IsSimilarityMetricType(collection_info.metric_type_)) {
+            return Status(SERVER_UNEXPECTED_ERROR, "PQ not support IP/COSINE in GPU version!");
         }
 #endif
 
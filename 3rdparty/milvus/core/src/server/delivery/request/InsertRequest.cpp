@@ -142,6 +142,9 @@ InsertRequest::OnExecute() {
             return status;
         }
 
+        // vectors of a COSINE collection are stored normalized, searches compare them by inner product
+        engine::utils::NormalizeVectors(collection_schema.metric_type_, vectors_data_);
+
         // step 6: insert vectors
         auto vec_count = static_cast<uint64_t>(vector_count);
 
@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "config/Config.h"
+#include "db/Utils.h"
 #include "server/DBWrapper.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
@@ -98,7 +99,8 @@ SearchByIDRequest::OnExecute() {
             }
         }
 
-        // step 5: check search parameters
+        // step 5: check search parameters, those not given are taken from tuning
+        engine::utils::ApplyTunedSearchParams(collection_schema.index_params_, extra_params_, extra_params_);
         status = ValidationUtil::ValidateSearchParams(extra_params_, collection_schema, topk_);
         if (!status.ok()) {
             return status;
@@ -0,0 +1,163 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/request/SearchCollectionsRequest.h"
+
+#include <memory>
+#include <set>
+
+#include "db/Utils.h"
+#include "server/DBWrapper.h"
+#include "server/delivery/request/SearchRequest.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+namespace milvus {
+namespace server {
+
+SearchCollectionsRequest::SearchCollectionsRequest(const std::shared_ptr<milvus::server::Context>& context,
+                                                   const std::vector<std::string>& collection_names,
+                                                   const engine::VectorsData& vectors, int64_t topk,
+                                                   const milvus::json& extra_params,
+                                                   const std::vector<std::string>& partition_list,
+                                                   TopKQueryResult& result)
+    : BaseRequest(context, BaseRequest::kSearchCollections),
+      collection_names_(collection_names),
+      vectors_data_(vectors),
+      topk_(topk),
+      extra_params_(extra_params),
+      partition_list_(partition_list),
+      result_(result) {
+}
+
+BaseRequestPtr
+SearchCollectionsRequest::Create(const std::shared_ptr<milvus::server::Context>& context,
+                                 const std::vector<std::string>& collection_names,
+                                 const engine::VectorsData& vectors, int64_t topk, const milvus::json& extra_params,
+                                 const std::vector<std::string>& partition_list, TopKQueryResult& result) {
+    return std::shared_ptr<BaseRequest>(
+        new SearchCollectionsRequest(context, collection_names, vectors, topk, extra_params, partition_list, result));
+}
+
+BaseRequest::Priority
+SearchCollectionsRequest::GetPriority() const {
+    return vectors_data_.vector_count_ >= BATCH_SEARCH_NQ ? kPriorityBatchSearch : kPriorityInteractive;
+}
+
+Status
+SearchCollectionsRequest::OnPreExecute() {
+    if (collection_names_.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, "No collection to search");
+    }
+
+    std::set<std::string> unique_names;
+    for (auto& collection_name : collection_names_) {
+        auto status = ValidationUtil::ValidateCollectionName(collection_name);
+        if (!status.ok()) {
+            return status;
+        }
+        if (!unique_names.insert(collection_name).second) {
+            return Status(SERVER_INVALID_ARGUMENT, "Collection " + collection_name + " is listed more than once");
+        }
+    }
+
+    auto status = ValidationUtil::ValidateSearchTopk(topk_);
+    if (!status.ok()) {
+        return status;
+    }
+
+    return ValidationUtil::ValidatePartitionTags(partition_list_);
+}
+
+Status
+SearchCollectionsRequest::OnExecute() {
+    try {
+        std::string hdr = "SearchCollectionsRequest execute(collections=" + std::to_string(collection_names_.size()) +
+                          ", nq=" + std::to_string(vectors_data_.vector_count_) + ", k=" + std::to_string(topk_) + ")";
+        TimeRecorderAuto rc(LogOut("[%s][%ld] %s", "search", 0, hdr.c_str()));
+
+        // every collection must exist and accept the query vectors and parameters, parameters not given are
+        // taken from tuning
+        milvus::json user_params = extra_params_;
+        engine::meta::CollectionSchema first_schema;
+        for (size_t i = 0; i < collection_names_.size(); ++i) {
+            engine::meta::CollectionSchema collection_schema;
+            collection_schema.collection_id_ = collection_names_[i];
+            auto status = DBWrapper::DB()->DescribeCollection(collection_schema);
+            if (!status.ok()) {
+                if (status.code() == DB_NOT_FOUND) {
+                    return Status(SERVER_COLLECTION_NOT_EXIST, CollectionNotExistMsg(collection_names_[i]));
+                }
+                return status;
+            }
+            if (!collection_schema.owner_collection_.empty()) {
+                return Status(SERVER_INVALID_COLLECTION_NAME, CollectionNotExistMsg(collection_names_[i]));
+            }
+
+            engine::utils::ApplyTunedSearchParams(collection_schema.index_params_, user_params, extra_params_);
+            status = ValidationUtil::ValidateSearchParams(extra_params_, collection_schema, topk_);
+            if (!status.ok()) {
+                return status;
+            }
+            status = ValidationUtil::ValidateVectorData(vectors_data_, collection_schema);
+            if (!status.ok()) {
+                return status;
+            }
+
+            if (i == 0) {
+                first_schema = collection_schema;
+            } else if (collection_schema.dimension_ != first_schema.dimension_ ||
+                       collection_schema.metric_type_ != first_schema.metric_type_) {
+                return Status(SERVER_INVALID_ARGUMENT, "Collection " + collection_names_[i] +
+                                                           " differs from " + collection_names_[0] +
+                                                           " in dimension or metric type");
+            }
+        }
+        engine::utils::NormalizeVectors(first_schema.metric_type_, vectors_data_);
+        rc.RecordSection("check validation");
+
+        engine::ResultIds result_ids;
+        engine::ResultDistances result_distances;
+        std::vector<int64_t> result_collections;
+        milvus::server::ContextChild tracer_query(context_, "Query collections");
+        auto status = DBWrapper::DB()->QueryCollections(tracer_query.Context(), collection_names_, partition_list_,
+                                                        (size_t)topk_, extra_params_, vectors_data_, result_ids,
+                                                        result_distances, result_collections);
+        tracer_query.Finish();
+        rc.RecordSection("query vectors from engine");
+        if (!status.ok()) {
+            LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Query fail: %s", "search", 0, status.message().c_str());
+            return status;
+        }
+        if (result_ids.empty()) {
+            return Status::OK();  // empty collections
+        }
+
+        result_.row_num_ = vectors_data_.vector_count_;
+        result_.id_list_.swap(result_ids);
+        result_.distance_list_.swap(result_distances);
+        result_.collection_list_.resize(result_collections.size());
+        for (size_t i = 0; i < result_collections.size(); ++i) {
+            if (result_collections[i] >= 0) {
+                result_.collection_list_[i] = collection_names_[result_collections[i]];
+            }
+        }
+    } catch (std::exception& ex) {
+        LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Encounter exception: %s", "search", 0, ex.what());
+        return Status(SERVER_UNEXPECTED_ERROR, ex.what());
+    }
+
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
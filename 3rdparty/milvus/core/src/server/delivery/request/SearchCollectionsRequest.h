@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace server {
+
+// Search several collections in one request. The collections must share dimension and metric type, their
+// segments are searched together and the hits reduced to one top k, see DB::QueryCollections.
+class SearchCollectionsRequest : public BaseRequest {
+ public:
+    static BaseRequestPtr
+    Create(const std::shared_ptr<milvus::server::Context>& context, const std::vector<std::string>& collection_names,
+           const engine::VectorsData& vectors, int64_t topk, const milvus::json& extra_params,
+           const std::vector<std::string>& partition_list, TopKQueryResult& result);
+
+    Priority
+    GetPriority() const override;
+
+ protected:
+    SearchCollectionsRequest(const std::shared_ptr<milvus::server::Context>& context,
+                             const std::vector<std::string>& collection_names, const engine::VectorsData& vectors,
+                             int64_t topk, const milvus::json& extra_params,
+                             const std::vector<std::string>& partition_list, TopKQueryResult& result);
+
+    Status
+    OnPreExecute() override;
+
+    Status
+    OnExecute() override;
+
+ private:
+    const std::vector<std::string> collection_names_;
+    engine::VectorsData vectors_data_;
+    int64_t topk_;
+    milvus::json extra_params_;
+    const std::vector<std::string> partition_list_;
+
+    TopKQueryResult& result_;
+};
+
+}  // namespace server
+}  // namespace milvus
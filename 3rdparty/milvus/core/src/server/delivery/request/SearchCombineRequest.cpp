@@ -11,6 +11,7 @@
 
 #include "server/delivery/request/SearchCombineRequest.h"
 #include "db/Utils.h"
+#include "metrics/Metrics.h"
 #include "server/DBWrapper.h"
 #include "server/context/Context.h"
 #include "utils/CommonUtil.h"
@@ -18,6 +19,7 @@
 #include "utils/TimeRecorder.h"
 #include "utils/ValidationUtil.h"
 
+#include <chrono>
 #include <memory>
 #include <set>
 
@@ -93,7 +95,8 @@ class TracingContextList {
 
 }  // namespace
 
-SearchCombineRequest::SearchCombineRequest() : BaseRequest(nullptr, BaseRequest::kSearchCombine) {
+SearchCombineRequest::SearchCombineRequest()
+    : BaseRequest(std::make_shared<milvus::server::Context>("combined_search"), BaseRequest::kSearchCombine) {
 }
 
 Status
@@ -133,9 +136,19 @@ SearchCombineRequest::Combine(const SearchRequestPtr& request) {
     }
 
     request_list_.push_back(request);
+
+    // the combined request is due as early as its most urgent member
+    if (request->Deadline() < context_->Deadline()) {
+        context_->SetDeadline(request->Deadline());
+    }
     return Status::OK();
 }
 
+bool
+SearchCombineRequest::Expired(const TimePoint& now) const {
+    return false;
+}
+
 bool
 SearchCombineRequest::CanCombine(const SearchRequestPtr& request) {
     if (collection_name_ != request->CollectionName()) {
@@ -262,11 +275,21 @@ SearchCombineRequest::OnExecute() {
             }
         }
 
-        // step 2: check input
+        // step 2: check input, search parameters not given are taken from tuning
+        engine::utils::ApplyTunedSearchParams(collection_schema.index_params_, extra_params_, extra_params_);
         size_t run_request = 0;
+        auto now = std::chrono::system_clock::now();
         std::vector<SearchRequestPtr>::iterator iter = request_list_.begin();
         for (; iter != request_list_.end();) {
             SearchRequestPtr& request = *iter;
+            if (request->Expired(now)) {
+                // deadline passed while the combined request was queued
+                server::Metrics::GetInstance().RequestShedTotalIncrement(PriorityName(request->GetPriority()));
+                FreeRequest(request, Status(SERVER_REQUEST_TIMEOUT, "Request deadline exceeded before execution"));
+                iter = request_list_.erase(iter);
+                continue;
+            }
+
             status = ValidationUtil::ValidateSearchTopk(request->TopK());
             if (!status.ok()) {
                 // check failed, erase request and let it return error status
@@ -348,6 +371,8 @@ SearchCombineRequest::OnExecute() {
             }
         }
 
+        engine::utils::NormalizeVectors(collection_schema.metric_type_, vectors_data_);
+
         LOG_SERVER_DEBUG_ << total_count << " query vectors combined";
         rc.RecordSection("combined query vectors");
 
@@ -357,15 +382,20 @@ SearchCombineRequest::OnExecute() {
 
         engine::ResultIds result_ids;
         engine::ResultDistances result_distances;
+
+        // one profile for the combined query, shared by the results of all combined requests
+        auto profile = std::make_shared<QueryProfile>();
+        context_->SetQueryProfile(profile);
+        SearchRequest::FinishProfileScope finish_profile(profile, std::chrono::steady_clock::now(), hdr);
         {
             TracingContextList context_list;
             context_list.CreateChild(request_list_, "Combine Query");
 
             if (file_id_list_.empty()) {
-                status = DBWrapper::DB()->Query(nullptr, collection_name_, partition_list, (size_t)search_topk_,
+                status = DBWrapper::DB()->Query(context_, collection_name_, partition_list, (size_t)search_topk_,
                                                 extra_params_, vectors_data_, result_ids, result_distances);
             } else {
-                status = DBWrapper::DB()->QueryByFileID(nullptr, file_id_list, (size_t)search_topk_, extra_params_,
+                status = DBWrapper::DB()->QueryByFileID(context_, file_id_list, (size_t)search_topk_, extra_params_,
                                                         vectors_data_, result_ids, result_distances);
             }
         }
@@ -401,6 +431,7 @@ SearchCombineRequest::OnExecute() {
         }
 
         // step 5: construct result array
+        QueryProfileScope result_scope(profile, QueryStage::kResult);
         offset = 0;
         for (auto& request : request_list_) {
             uint64_t count = request->VectorsData().vector_count_;
@@ -412,9 +443,13 @@ SearchCombineRequest::OnExecute() {
             result.distance_list_.resize(element_cnt);
             memcpy(result.id_list_.data(), result_ids.data() + offset, element_cnt * sizeof(int64_t));
             memcpy(result.distance_list_.data(), result_distances.data() + offset, element_cnt * sizeof(float));
+            result.profile_ = profile;
             offset += (count * search_topk_);
+        }
+        result_scope.Finish();
 
-            // let request return
+        // let requests return
+        for (auto& request : request_list_) {
             FreeRequest(request, Status::OK());
         }
 
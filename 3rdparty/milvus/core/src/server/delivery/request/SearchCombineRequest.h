@@ -35,6 +35,10 @@ class SearchCombineRequest : public BaseRequest {
     static bool
     CanCombine(const SearchRequestPtr& left, const SearchRequestPtr& right);
 
+    // never shed as a whole, the combined requests expired before execution are freed one by one
+    bool
+    Expired(const TimePoint& now) const override;
+
  protected:
     Status
     OnExecute() override;
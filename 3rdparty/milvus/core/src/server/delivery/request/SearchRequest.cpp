@@ -11,10 +11,13 @@
 
 #include "server/delivery/request/SearchRequest.h"
 
+#include <chrono>
 #include <memory>
 
 #include <fiu-local.h>
 
+#include "cache/ResultCacheMgr.h"
+#include "config/Config.h"
 #include "db/Utils.h"
 #include "server/DBWrapper.h"
 #include "utils/CommonUtil.h"
@@ -52,6 +55,11 @@ SearchRequest::Create(const std::shared_ptr<milvus::server::Context>& context, c
         new SearchRequest(context, collection_name, vectors, topk, extra_params, partition_list, file_id_list, result));
 }
 
+BaseRequest::Priority
+SearchRequest::GetPriority() const {
+    return vectors_data_.vector_count_ >= BATCH_SEARCH_NQ ? kPriorityBatchSearch : kPriorityInteractive;
+}
+
 Status
 SearchRequest::OnPreExecute() {
     LOG_SERVER_INFO_ << LogOut("[%s][%ld] ", "search", 0) << "Search pre-execute. Check search parameters";
@@ -119,7 +127,8 @@ SearchRequest::OnExecute() {
             }
         }
 
-        // step 5: check search parameters
+        // step 5: check search parameters, those not given are taken from tuning
+        engine::utils::ApplyTunedSearchParams(collection_schema_.index_params_, extra_params_, extra_params_);
         status = ValidationUtil::ValidateSearchParams(extra_params_, collection_schema_, topk_);
         if (!status.ok()) {
             LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Invalid search params: %s", "search", 0, status.message().c_str());
@@ -132,9 +141,37 @@ SearchRequest::OnExecute() {
             LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Invalid vector data: %s", "search", 0, status.message().c_str());
             return status;
         }
+        engine::utils::NormalizeVectors(collection_schema_.metric_type_, vectors_data_);
 
         rc.RecordSection("check validation");
 
+        // repeated searches of a collection are answered from the result cache while its data doesn't change
+        auto result_cache = cache::ResultCacheMgr::GetInstance();
+        std::string cache_key, cache_query;
+        if (file_id_list_.empty() && result_cache->Enabled()) {
+            uint64_t version = 0;
+            status = DBWrapper::DB()->GetCollectionVersion(collection_name_, version);
+            if (status.ok()) {
+                if (vectors_data_.float_data_.empty()) {
+                    cache_query.assign(reinterpret_cast<const char*>(vectors_data_.binary_data_.data()),
+                                       vectors_data_.binary_data_.size());
+                } else {
+                    cache_query.assign(reinterpret_cast<const char*>(vectors_data_.float_data_.data()),
+                                       vectors_data_.float_data_.size() * sizeof(float));
+                }
+                cache_key = cache::ResultCacheMgr::MakeKey(collection_name_, version, partition_list_,
+                                                           extra_params_.dump(), topk_, cache_query);
+                auto cached = result_cache->GetResult(cache_key, cache_query);
+                if (cached != nullptr) {
+                    result_.row_num_ = cached->RowNum();
+                    result_.id_list_ = cached->Ids();
+                    result_.distance_list_ = cached->Distances();
+                    rc.RecordSection("hit result cache");
+                    return Status::OK();
+                }
+            }
+        }
+
         // step 7: search vectors
 #ifdef ENABLE_CPU_PROFILING
         std::string fname = "/tmp/search_" + CommonUtil::GetCurrentTimeStr() + ".profiling";
@@ -144,13 +181,23 @@ SearchRequest::OnExecute() {
         engine::ResultIds result_ids;
         engine::ResultDistances result_distances;
 
+        // the profile rides on a child context so that concurrent requests sharing context_ don't mix up
+        auto profile = std::make_shared<QueryProfile>();
+        result_.profile_ = profile;
+        FinishProfileScope finish_profile(profile, std::chrono::steady_clock::now(), hdr);
+        milvus::server::ContextChild tracer_query(context_, "Query vectors");
+        if (tracer_query.Context()) {
+            tracer_query.Context()->SetQueryProfile(profile);
+        }
+
         if (file_id_list_.empty()) {
-            status = DBWrapper::DB()->Query(context_, collection_name_, partition_list_, (size_t)topk_, extra_params_,
-                                            vectors_data_, result_ids, result_distances);
+            status = DBWrapper::DB()->Query(tracer_query.Context(), collection_name_, partition_list_, (size_t)topk_,
+                                            extra_params_, vectors_data_, result_ids, result_distances);
         } else {
-            status = DBWrapper::DB()->QueryByFileID(context_, file_id_list_, (size_t)topk_, extra_params_,
-                                                    vectors_data_, result_ids, result_distances);
+            status = DBWrapper::DB()->QueryByFileID(tracer_query.Context(), file_id_list_, (size_t)topk_,
+                                                    extra_params_, vectors_data_, result_ids, result_distances);
         }
+        tracer_query.Finish();
 
         rc.RecordSection("query vectors from engine");
 
@@ -167,11 +214,20 @@ SearchRequest::OnExecute() {
             return Status::OK();  // empty collection
         }
 
+        if (!cache_key.empty()) {
+            auto cached = std::make_shared<cache::SearchResultObj>(std::move(cache_query), vector_count, result_ids,
+                                                                   result_distances);
+            result_cache->InsertResult(cache_key, cached);
+        }
+
         // step 8: construct result array
-        milvus::server::ContextChild tracer(context_, "Constructing result");
-        result_.row_num_ = vectors_data_.vector_count_;
-        result_.id_list_.swap(result_ids);
-        result_.distance_list_.swap(result_distances);
+        {
+            QueryProfileScope result_scope(profile, QueryStage::kResult);
+            milvus::server::ContextChild tracer(context_, "Constructing result");
+            result_.row_num_ = vectors_data_.vector_count_;
+            result_.id_list_.swap(result_ids);
+            result_.distance_list_.swap(result_distances);
+        }
         rc.RecordSection("construct result");
     } catch (std::exception& ex) {
         LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Encounter exception: %s", "search", 0, ex.what());
@@ -180,5 +236,30 @@ SearchRequest::OnExecute() {
 
     return Status::OK();
 }
+
+void
+SearchRequest::FinishProfile(const QueryProfilePtr& profile, std::chrono::steady_clock::time_point start,
+                             const std::string& hdr) {
+    auto total_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    profile->SetTotalWallTime(total_us);
+    profile->Report();
+
+    int64_t slow_query_threshold = 0;
+    Config::GetInstance().GetEngineConfigSlowQueryThreshold(slow_query_threshold);
+    if (slow_query_threshold > 0 && total_us >= slow_query_threshold * 1000) {
+        LOG_SERVER_WARNING_ << LogOut("[%s][%ld] Slow query %s: %s", "search", 0, hdr.c_str(),
+                                      profile->ToJson().dump().c_str());
+    }
+}
+
+SearchRequest::FinishProfileScope::~FinishProfileScope() {
+    try {
+        FinishProfile(profile_, start_, hdr_);
+    } catch (std::exception& ex) {
+        LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Fail to finish query profile: %s", "search", 0, ex.what());
+    }
+}
+
 }  // namespace server
 }  // namespace milvus
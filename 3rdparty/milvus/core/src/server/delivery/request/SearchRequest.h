@@ -13,13 +13,18 @@
 
 #include "server/delivery/request/BaseRequest.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace milvus {
 namespace server {
 
+// searches of at least this many vectors are batch searches, see BaseRequest::Priority
+constexpr uint64_t BATCH_SEARCH_NQ = 100;
+
 class SearchRequest : public BaseRequest {
  public:
     static BaseRequestPtr
@@ -68,6 +73,29 @@ class SearchRequest : public BaseRequest {
         return collection_schema_;
     }
 
+    Priority
+    GetPriority() const override;
+
+    // record total time, push stage metrics and emit slow query log
+    static void
+    FinishProfile(const QueryProfilePtr& profile, std::chrono::steady_clock::time_point start,
+                  const std::string& hdr);
+
+    // calls FinishProfile once when it goes out of scope, so failed and aborted queries are profiled too
+    class FinishProfileScope {
+     public:
+        FinishProfileScope(QueryProfilePtr profile, std::chrono::steady_clock::time_point start, std::string hdr)
+            : profile_(std::move(profile)), start_(start), hdr_(std::move(hdr)) {
+        }
+
+        ~FinishProfileScope();
+
+     private:
+        QueryProfilePtr profile_;
+        std::chrono::steady_clock::time_point start_;
+        std::string hdr_;
+    };
+
  protected:
     SearchRequest(const std::shared_ptr<milvus::server::Context>& context, const std::string& collection_name,
                   const engine::VectorsData& vectors, int64_t topk, const milvus::json& extra_params,
@@ -82,7 +110,7 @@ class SearchRequest : public BaseRequest {
 
  private:
     const std::string collection_name_;
-    const engine::VectorsData vectors_data_;
+    engine::VectorsData vectors_data_;
     int64_t topk_;
     milvus::json extra_params_;
     const std::vector<std::string> partition_list_;
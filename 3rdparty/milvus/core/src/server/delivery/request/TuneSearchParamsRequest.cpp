@@ -0,0 +1,106 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#include "server/delivery/request/TuneSearchParamsRequest.h"
+#include "db/Utils.h"
+#include "server/DBWrapper.h"
+#include "utils/Log.h"
+#include "utils/TimeRecorder.h"
+#include "utils/ValidationUtil.h"
+
+#include <memory>
+
+namespace milvus {
+namespace server {
+
+TuneSearchParamsRequest::TuneSearchParamsRequest(const std::shared_ptr<milvus::server::Context>& context,
+                                                 const std::string& collection_name, int64_t topk,
+                                                 double target_recall, const engine::VectorsData& vectors,
+                                                 milvus::json& result)
+    : BaseRequest(context, BaseRequest::kTuneSearchParams),
+      collection_name_(collection_name),
+      topk_(topk),
+      target_recall_(target_recall),
+      vectors_data_(vectors),
+      result_(result) {
+}
+
+BaseRequestPtr
+TuneSearchParamsRequest::Create(const std::shared_ptr<milvus::server::Context>& context,
+                                const std::string& collection_name, int64_t topk, double target_recall,
+                                const engine::VectorsData& vectors, milvus::json& result) {
+    return std::shared_ptr<BaseRequest>(
+        new TuneSearchParamsRequest(context, collection_name, topk, target_recall, vectors, result));
+}
+
+Status
+TuneSearchParamsRequest::OnExecute() {
+    try {
+        std::string hdr = "TuneSearchParamsRequest(collection=" + collection_name_ + ", k=" + std::to_string(topk_) +
+                          ", recall=" + std::to_string(target_recall_) + ")";
+        TimeRecorderAuto rc(hdr);
+
+        // step 1: check arguments
+        auto status = ValidationUtil::ValidateCollectionName(collection_name_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        status = ValidationUtil::ValidateSearchTopk(topk_);
+        if (!status.ok()) {
+            return status;
+        }
+
+        if (target_recall_ <= 0.0 || target_recall_ > 1.0) {
+            return Status(SERVER_INVALID_ARGUMENT, "Target recall must be in range (0, 1]");
+        }
+
+        // only process root collection, ignore partition collection
+        engine::meta::CollectionSchema collection_schema;
+        collection_schema.collection_id_ = collection_name_;
+        status = DBWrapper::DB()->DescribeCollection(collection_schema);
+        if (!status.ok()) {
+            if (status.code() == DB_NOT_FOUND) {
+                return Status(SERVER_COLLECTION_NOT_EXIST, CollectionNotExistMsg(collection_name_));
+            } else {
+                return status;
+            }
+        } else {
+            if (!collection_schema.owner_collection_.empty()) {
+                return Status(SERVER_INVALID_COLLECTION_NAME, CollectionNotExistMsg(collection_name_));
+            }
+        }
+
+        if (vectors_data_.vector_count_ > 0) {
+            status = ValidationUtil::ValidateVectorData(vectors_data_, collection_schema);
+            if (!status.ok()) {
+                return status;
+            }
+            engine::utils::NormalizeVectors(collection_schema.metric_type_, vectors_data_);
+        }
+
+        rc.RecordSection("check validation");
+
+        // step 2: measure and keep the params
+        status = DBWrapper::DB()->TuneSearchParams(collection_name_, topk_, target_recall_, vectors_data_, result_);
+        if (!status.ok()) {
+            return status;
+        }
+    } catch (std::exception& ex) {
+        return Status(SERVER_UNEXPECTED_ERROR, ex.what());
+    }
+
+    return Status::OK();
+}
+
+}  // namespace server
+}  // namespace milvus
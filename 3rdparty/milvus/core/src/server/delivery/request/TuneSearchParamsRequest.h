@@ -0,0 +1,50 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+
+#pragma once
+
+#include "server/delivery/request/BaseRequest.h"
+
+#include <memory>
+#include <string>
+
+namespace milvus {
+namespace server {
+
+// Measure recall against the exact top k for increasing nprobe / ef and keep the cheapest value reaching
+// target_recall with the collection index, see DB::TuneSearchParams. result receives the chosen params and the
+// recall and latency of every value tried.
+class TuneSearchParamsRequest : public BaseRequest {
+ public:
+    static BaseRequestPtr
+    Create(const std::shared_ptr<milvus::server::Context>& context, const std::string& collection_name, int64_t topk,
+           double target_recall, const engine::VectorsData& vectors, milvus::json& result);
+
+ protected:
+    TuneSearchParamsRequest(const std::shared_ptr<milvus::server::Context>& context,
+                            const std::string& collection_name, int64_t topk, double target_recall,
+                            const engine::VectorsData& vectors, milvus::json& result);
+
+    Status
+    OnExecute() override;
+
+ private:
+    const std::string collection_name_;
+    int64_t topk_;
+    double target_recall_;
+    engine::VectorsData vectors_data_;
+
+    milvus::json& result_;
+};
+
+}  // namespace server
+}  // namespace milvus
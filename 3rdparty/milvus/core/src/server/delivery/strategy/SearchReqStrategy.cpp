@@ -17,7 +17,7 @@
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
-#include <queue>
+#include <deque>
 #include <string>
 
 namespace milvus {
@@ -27,7 +27,7 @@ SearchReqStrategy::SearchReqStrategy() {
 }
 
 Status
-SearchReqStrategy::ReScheduleQueue(const BaseRequestPtr& request, std::queue<BaseRequestPtr>& queue) {
+SearchReqStrategy::ReScheduleQueue(const BaseRequestPtr& request, std::deque<BaseRequestPtr>& queue) {
     if (request->GetRequestType() != BaseRequest::kSearch) {
         std::string msg = "search strategy can only handle search request";
         LOG_SERVER_ERROR_ << msg;
@@ -45,11 +45,12 @@ SearchReqStrategy::ReScheduleQueue(const BaseRequestPtr& request, std::queue<Bas
             SearchCombineRequestPtr combine_request = std::make_shared<SearchCombineRequest>();
             combine_request->Combine(last_search_req);
             combine_request->Combine(new_search_req);
+            combine_request->SetQueueTime(last_search_req->QueueTime());
             queue.back() = combine_request;  // replace the last request to combine request
             LOG_SERVER_DEBUG_ << "Combine 2 search request";
         } else {
             // directly put to queue
-            queue.push(request);
+            queue.push_back(request);
         }
     } else if (last_req->GetRequestType() == BaseRequest::kSearchCombine) {
         SearchCombineRequestPtr combine_req = std::static_pointer_cast<SearchCombineRequest>(last_req);
@@ -59,12 +60,11 @@ SearchReqStrategy::ReScheduleQueue(const BaseRequestPtr& request, std::queue<Bas
             LOG_SERVER_DEBUG_ << "Combine more search request";
         } else {
             // directly put to queue
-            queue.push(request);
+            queue.push_back(request);
         }
     } else {
-        std::string msg = "unsupported request type for search strategy";
-        LOG_SERVER_ERROR_ << msg;
-        return Status(SERVER_UNSUPPORTED_ERROR, msg);
+        // behind a request which is not a search, eg. preload, nothing to combine with
+        queue.push_back(request);
     }
 
     return Status::OK();
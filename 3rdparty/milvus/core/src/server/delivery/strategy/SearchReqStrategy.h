@@ -15,7 +15,7 @@
 #include "utils/Status.h"
 
 #include <memory>
-#include <queue>
+#include <deque>
 
 namespace milvus {
 namespace server {
@@ -25,7 +25,7 @@ class SearchReqStrategy : public RequestStrategy {
     SearchReqStrategy();
 
     Status
-    ReScheduleQueue(const BaseRequestPtr& request, std::queue<BaseRequestPtr>& queue) override;
+    ReScheduleQueue(const BaseRequestPtr& request, std::deque<BaseRequestPtr>& queue) override;
 };
 
 using RequestStrategyPtr = std::shared_ptr<RequestStrategy>;
@@ -281,6 +281,8 @@ GrpcRequestHandler::OnPostRecvInitialMetaData(
     auto trace_context = std::make_shared<tracing::TraceContext>(span);
     auto context = std::make_shared<Context>(request_id);
     context->SetTraceContext(trace_context);
+    // a client deadline lets the request scheduler order and shed the request, no deadline is TimePoint::max()
+    context->SetDeadline(server_rpc_info->server_context()->deadline());
     SetContext(server_rpc_info->server_context(), context);
 }
 
@@ -956,11 +958,24 @@ GrpcRequestHandler::InsertEntity(::grpc::ServerContext* context, const ::milvus:
         field_names[i] = request->entities().field_names(i);
     }
 
+    // entities of several vectors give the number of vectors of each entity
+    std::vector<int64_t> vector_lengths;
+    for (int i = 0; i < request->extra_params_size(); i++) {
+        const ::milvus::grpc::KeyValuePair& extra = request->extra_params(i);
+        if (extra.key() == EXTRA_PARAM_KEY) {
+            auto json_params = json::parse(extra.value());
+            if (json_params.contains("vector_lengths")) {
+                vector_lengths = json_params["vector_lengths"].get<std::vector<int64_t>>();
+            }
+        }
+    }
+
     auto vector_size = request->entities().result_values_size();
     for (uint64_t i = 0; i < vector_size; ++i) {
         engine::VectorsData vectors;
         CopyRowRecords(request->entities().result_values(i).vector_value().value(), request->entity_id_array(),
                        vectors);
+        vectors.vector_lengths_ = vector_lengths;
         vector_datas.insert(std::make_pair(request->entities().field_names(field_size - 1), vectors));
     }
 
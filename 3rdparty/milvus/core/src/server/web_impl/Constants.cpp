@@ -23,6 +23,7 @@ const char* NAME_ENGINE_TYPE_RNSG = "RNSG";
 const char* NAME_ENGINE_TYPE_IVFPQ = "IVFPQ";
 const char* NAME_ENGINE_TYPE_HNSW = "HNSW";
 const char* NAME_ENGINE_TYPE_ANNOY = "ANNOY";
+const char* NAME_ENGINE_TYPE_IVFPQFASTSCAN = "IVFPQFASTSCAN";
 
 const char* NAME_METRIC_TYPE_L2 = "L2";
 const char* NAME_METRIC_TYPE_IP = "IP";
@@ -31,6 +32,7 @@ const char* NAME_METRIC_TYPE_JACCARD = "JACCARD";
 const char* NAME_METRIC_TYPE_TANIMOTO = "TANIMOTO";
 const char* NAME_METRIC_TYPE_SUBSTRUCTURE = "SUBSTRUCTURE";
 const char* NAME_METRIC_TYPE_SUPERSTRUCTURE = "SUPERSTRUCTURE";
+const char* NAME_METRIC_TYPE_COSINE = "COSINE";
 
 ////////////////////////////////////////////////////
 const int64_t VALUE_COLLECTION_INDEX_FILE_SIZE_DEFAULT = 1024;
@@ -54,6 +56,7 @@ const std::unordered_map<engine::EngineType, std::string> IndexMap = {
     {engine::EngineType::FAISS_PQ, NAME_ENGINE_TYPE_IVFPQ},
     {engine::EngineType::HNSW, NAME_ENGINE_TYPE_HNSW},
     {engine::EngineType::ANNOY, NAME_ENGINE_TYPE_ANNOY},
+    {engine::EngineType::FAISS_PQ_FASTSCAN, NAME_ENGINE_TYPE_IVFPQFASTSCAN},
 };
 
 const std::unordered_map<std::string, engine::EngineType> IndexNameMap = {
@@ -65,6 +68,7 @@ const std::unordered_map<std::string, engine::EngineType> IndexNameMap = {
     {NAME_ENGINE_TYPE_IVFPQ, engine::EngineType::FAISS_PQ},
     {NAME_ENGINE_TYPE_HNSW, engine::EngineType::HNSW},
     {NAME_ENGINE_TYPE_ANNOY, engine::EngineType::ANNOY},
+    {NAME_ENGINE_TYPE_IVFPQFASTSCAN, engine::EngineType::FAISS_PQ_FASTSCAN},
 };
 
 const std::unordered_map<engine::MetricType, std::string> MetricMap = {
@@ -75,6 +79,7 @@ const std::unordered_map<engine::MetricType, std::string> MetricMap = {
     {engine::MetricType::TANIMOTO, NAME_METRIC_TYPE_TANIMOTO},
     {engine::MetricType::SUBSTRUCTURE, NAME_METRIC_TYPE_SUBSTRUCTURE},
     {engine::MetricType::SUPERSTRUCTURE, NAME_METRIC_TYPE_SUPERSTRUCTURE},
+    {engine::MetricType::COSINE, NAME_METRIC_TYPE_COSINE},
 };
 
 const std::unordered_map<std::string, engine::MetricType> MetricNameMap = {
@@ -85,6 +90,7 @@ const std::unordered_map<std::string, engine::MetricType> MetricNameMap = {
     {NAME_METRIC_TYPE_TANIMOTO, engine::MetricType::TANIMOTO},
     {NAME_METRIC_TYPE_SUBSTRUCTURE, engine::MetricType::SUBSTRUCTURE},
     {NAME_METRIC_TYPE_SUPERSTRUCTURE, engine::MetricType::SUPERSTRUCTURE},
+    {NAME_METRIC_TYPE_COSINE, engine::MetricType::COSINE},
 };
 }  // namespace web
 }  // namespace server
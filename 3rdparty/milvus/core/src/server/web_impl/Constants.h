@@ -28,6 +28,7 @@ extern const char* NAME_ENGINE_TYPE_RNSG;
 extern const char* NAME_ENGINE_TYPE_IVFPQ;
 extern const char* NAME_ENGINE_TYPE_HNSW;
 extern const char* NAME_ENGINE_TYPE_ANNOY;
+extern const char* NAME_ENGINE_TYPE_IVFPQFASTSCAN;
 
 extern const char* NAME_METRIC_TYPE_L2;
 extern const char* NAME_METRIC_TYPE_IP;
@@ -36,6 +37,7 @@ extern const char* NAME_METRIC_TYPE_JACCARD;
 extern const char* NAME_METRIC_TYPE_TANIMOTO;
 extern const char* NAME_METRIC_TYPE_SUBSTRUCTURE;
 extern const char* NAME_METRIC_TYPE_SUPERSTRUCTURE;
+extern const char* NAME_METRIC_TYPE_COSINE;
 
 ////////////////////////////////////////////////////
 extern const int64_t VALUE_COLLECTION_INDEX_FILE_SIZE_DEFAULT;
@@ -100,6 +100,10 @@ WebRequestHandler::IsBinaryCollection(const std::string& collection_name, bool&
 
 Status
 WebRequestHandler::CopyRecordsFromJson(const nlohmann::json& json, engine::VectorsData& vectors, bool bin) {
+    if (json.is_object()) {
+        return CopyRecordsFromBase64(json, vectors, bin);
+    }
+
     if (!json.is_array()) {
         return Status(ILLEGAL_BODY, "field \"vectors\" must be a array");
     }
@@ -129,6 +133,39 @@ WebRequestHandler::CopyRecordsFromJson(const nlohmann::json& json, engine::Vecto
     return Status::OK();
 }
 
+Status
+WebRequestHandler::CopyRecordsFromBase64(const nlohmann::json& json, engine::VectorsData& vectors, bool bin) {
+    if (!json.contains("dim") || !json["dim"].is_number_integer() || !json.contains("data") ||
+        !json["data"].is_string()) {
+        return Status(ILLEGAL_BODY, "Packed \"vectors\" must contain integer \"dim\" and base64 string \"data\"");
+    }
+
+    // float vectors are packed as little-endian float32, binary vectors as dim / 8 bytes each
+    auto dim = json["dim"].get<int64_t>();
+    int64_t vector_bytes = bin ? dim / 8 : dim * static_cast<int64_t>(sizeof(float));
+    if (dim <= 0 || vector_bytes <= 0) {
+        return Status(ILLEGAL_BODY, "Field \"dim\" of packed \"vectors\" is illegal");
+    }
+
+    auto& encoded = json["data"].get_ref<const std::string&>();
+    auto bytes = Base64DecodedSize(encoded);
+    if (bytes < 0 || bytes % vector_bytes != 0) {
+        return Status(ILLEGAL_BODY, "Size of packed \"vectors\" does not match \"dim\"");
+    }
+
+    vectors.vector_count_ = bytes / vector_bytes;
+    uint8_t* buffer = nullptr;
+    if (bin) {
+        vectors.binary_data_.resize(bytes);
+        buffer = vectors.binary_data_.data();
+    } else {
+        vectors.float_data_.resize(bytes / sizeof(float));
+        buffer = reinterpret_cast<uint8_t*>(vectors.float_data_.data());
+    }
+
+    return Base64Decode(encoded, buffer);
+}
+
 ///////////////////////// WebRequestHandler methods ///////////////////////////////////////
 Status
 WebRequestHandler::GetCollectionMetaInfo(const std::string& collection_name, nlohmann::json& json_out) {
@@ -317,6 +354,49 @@ WebRequestHandler::Compact(const nlohmann::json& json, std::string& result_str)
     return status;
 }
 
+Status
+WebRequestHandler::TuneSearchParams(const nlohmann::json& json, std::string& result_str) {
+    if (!json.contains("collection_name") || !json["collection_name"].is_string()) {
+        return Status(BODY_FIELD_LOSS, "Field \"tune\" must contain string collection_name");
+    }
+    auto name = json["collection_name"].get<std::string>();
+
+    int64_t topk = 10;
+    if (json.contains("topk")) {
+        if (!json["topk"].is_number_integer()) {
+            return Status(BODY_PARSE_FAIL, "Field \"topk\" must be an integer");
+        }
+        topk = json["topk"].get<int64_t>();
+    }
+
+    double recall = 0.95;
+    if (json.contains("recall")) {
+        if (!json["recall"].is_number()) {
+            return Status(BODY_PARSE_FAIL, "Field \"recall\" must be a number");
+        }
+        recall = json["recall"].get<double>();
+    }
+
+    // queries to measure with, sampled from the collection if none
+    engine::VectorsData vectors;
+    if (json.contains("vectors")) {
+        auto status = CopyRecordsFromJson(json["vectors"], vectors, false);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    milvus::json tune_result;
+    auto status = request_handler_.TuneSearchParams(context_ptr_, name, topk, recall, vectors, tune_result);
+    if (status.ok()) {
+        nlohmann::json result = tune_result;
+        AddStatusToJson(result, status.code(), status.message());
+        result_str = result.dump();
+    }
+
+    return status;
+}
+
 Status
 WebRequestHandler::GetConfig(std::string& result_str) {
     std::string cmd = "get_config *";
@@ -427,6 +507,24 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
         }
     }
 
+    // other collections to search together with this one
+    std::vector<std::string> collection_names;
+    if (json.contains("collections")) {
+        auto collections = json["collections"];
+        if (!collections.is_null() && !collections.is_array()) {
+            return Status(BODY_PARSE_FAIL, "Field \"collections\" must be a array");
+        }
+        if (!collections.empty()) {
+            if (json.contains("ids") || json.contains("file_ids")) {
+                return Status(ILLEGAL_BODY, "Field \"collections\" can not be used with \"ids\" or \"file_ids\"");
+            }
+            collection_names.emplace_back(collection_name);
+            for (auto& name : collections) {
+                collection_names.emplace_back(name.get<std::string>());
+            }
+        }
+    }
+
     TopKQueryResult result;
     Status status;
     if (json.contains("ids")) {
@@ -470,8 +568,13 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
             return status;
         }
 
-        status = request_handler_.Search(context_ptr_, collection_name, vectors_data, topk, json["params"],
-                                         partition_tags, file_id_vec, result);
+        if (collection_names.empty()) {
+            status = request_handler_.Search(context_ptr_, collection_name, vectors_data, topk, json["params"],
+                                             partition_tags, file_id_vec, result);
+        } else {
+            status = request_handler_.SearchCollections(context_ptr_, collection_names, vectors_data, topk,
+                                                        json["params"], partition_tags, result);
+        }
     }
     if (!status.ok()) {
         return status;
@@ -479,6 +582,26 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
 
     nlohmann::json result_json;
     result_json["num"] = result.row_num_;
+    if (json.contains("profile") && json["profile"].is_boolean() && json["profile"].get<bool>() &&
+        result.profile_ != nullptr) {
+        result_json["profile"] = result.profile_->ToJson();
+    }
+    if (json.contains("result_encoding") && json["result_encoding"] == "base64") {
+        // ids as little-endian int64 and distances as little-endian float32, row major in nq * topk
+        std::string ids_str, distances_str;
+        Base64Encode(reinterpret_cast<const uint8_t*>(result.id_list_.data()),
+                     result.id_list_.size() * sizeof(int64_t), ids_str);
+        Base64Encode(reinterpret_cast<const uint8_t*>(result.distance_list_.data()),
+                     result.distance_list_.size() * sizeof(float), distances_str);
+        result_json["topk"] = (result.row_num_ == 0) ? 0 : result.id_list_.size() / result.row_num_;
+        result_json["ids"] = std::move(ids_str);
+        result_json["distances"] = std::move(distances_str);
+        if (!collection_names.empty()) {
+            result_json["collections"] = result.collection_list_;
+        }
+        result_str = result_json.dump();
+        return Status::OK();
+    }
     if (result.row_num_ == 0) {
         result_json["result"] = std::vector<int64_t>();
         result_str = result_json.dump();
@@ -493,6 +616,9 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
             nlohmann::json one_result_json;
             one_result_json["id"] = std::to_string(result.id_list_.at(i * step + j));
             one_result_json["distance"] = std::to_string(result.distance_list_.at(i * step + j));
+            if (!result.collection_list_.empty()) {
+                one_result_json["collection"] = result.collection_list_.at(i * step + j);
+            }
             raw_result_json.emplace_back(one_result_json);
         }
         search_result_json.emplace_back(raw_result_json);
@@ -1550,7 +1676,7 @@ WebRequestHandler::Insert(const OString& collection_name, const OString& body, V
         RETURN_STATUS_DTO(BODY_FIELD_LOSS, "Field \'vectors\' is required");
     }
     engine::VectorsData vectors;
-    CopyRecordsFromJson(body_json["vectors"], vectors, bin_flag);
+    status = CopyRecordsFromJson(body_json["vectors"], vectors, bin_flag);
     if (!status.ok()) {
         ASSIGN_RETURN_STATUS_DTO(status)
     }
@@ -1558,19 +1684,32 @@ WebRequestHandler::Insert(const OString& collection_name, const OString& body, V
     // step 2: copy id array
     if (body_json.contains("ids")) {
         auto& ids_json = body_json["ids"];
-        if (!ids_json.is_array()) {
-            RETURN_STATUS_DTO(ILLEGAL_BODY, "Field \"ids\" must be a array");
-        }
-        auto& id_array = vectors.id_array_;
-        id_array.clear();
-        try {
-            for (auto& id_str : ids_json) {
-                int64_t id = std::stol(id_str.get<std::string>());
-                id_array.emplace_back(id);
+        if (ids_json.is_string()) {
+            // base64 packed little-endian int64
+            auto& encoded = ids_json.get_ref<const std::string&>();
+            auto bytes = Base64DecodedSize(encoded);
+            if (bytes < 0 || bytes % sizeof(int64_t) != 0) {
+                RETURN_STATUS_DTO(ILLEGAL_BODY, "Size of packed \"ids\" is illegal");
             }
-        } catch (std::exception& e) {
-            std::string err_msg = std::string("Cannot convert vectors id. details: ") + e.what();
-            RETURN_STATUS_DTO(SERVER_UNEXPECTED_ERROR, err_msg.c_str());
+            vectors.id_array_.resize(bytes / sizeof(int64_t));
+            status = Base64Decode(encoded, reinterpret_cast<uint8_t*>(vectors.id_array_.data()));
+            if (!status.ok()) {
+                ASSIGN_RETURN_STATUS_DTO(status)
+            }
+        } else if (ids_json.is_array()) {
+            auto& id_array = vectors.id_array_;
+            id_array.clear();
+            try {
+                for (auto& id_str : ids_json) {
+                    int64_t id = std::stol(id_str.get<std::string>());
+                    id_array.emplace_back(id);
+                }
+            } catch (std::exception& e) {
+                std::string err_msg = std::string("Cannot convert vectors id. details: ") + e.what();
+                RETURN_STATUS_DTO(SERVER_UNEXPECTED_ERROR, err_msg.c_str());
+            }
+        } else {
+            RETURN_STATUS_DTO(ILLEGAL_BODY, "Field \"ids\" must be a array");
         }
     }
 
@@ -1666,6 +1805,9 @@ WebRequestHandler::InsertEntity(const OString& collection_name, const milvus::se
 
                 engine::VectorsData vectors;
                 CopyRecordsFromJson(field_value, vectors, bin_flag);
+                if (entity.contains("vector_lengths")) {
+                    vectors.vector_lengths_ = entity["vector_lengths"].get<std::vector<int64_t>>();
+                }
                 vector_datas.insert(std::make_pair(field_name, vectors));
             }
             default: {}
@@ -1817,6 +1959,9 @@ WebRequestHandler::SystemOp(const OString& op, const OString& body_str, OString&
             if (j.contains("compact")) {
                 status = Compact(j["compact"], result_str);
             }
+            if (j.contains("tune")) {
+                status = TuneSearchParams(j["tune"], result_str);
+            }
         } else if (op->equals("config")) {
             status = SetConfig(j, result_str);
         } else {
@@ -87,6 +87,9 @@ class WebRequestHandler {
     Status
     CopyRecordsFromJson(const nlohmann::json& json, engine::VectorsData& vectors, bool bin);
 
+    Status
+    CopyRecordsFromBase64(const nlohmann::json& json, engine::VectorsData& vectors, bool bin);
+
  protected:
     Status
     GetCollectionMetaInfo(const std::string& collection_name, nlohmann::json& json_out);
@@ -117,6 +120,9 @@ class WebRequestHandler {
     Status
     Compact(const nlohmann::json& json, std::string& result_str);
 
+    Status
+    TuneSearchParams(const nlohmann::json& json, std::string& result_str);
+
     Status
     GetConfig(std::string& result_str);
 
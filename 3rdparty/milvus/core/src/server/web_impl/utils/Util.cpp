@@ -13,10 +13,31 @@
 
 #include "utils/ValidationUtil.h"
 
+#include <algorithm>
+
 namespace milvus {
 namespace server {
 namespace web {
 
+namespace {
+
+const char BASE64_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+struct Base64Table {
+    int8_t value_[256];
+
+    Base64Table() {
+        std::fill(value_, value_ + 256, -1);
+        for (int i = 0; i < 64; i++) {
+            value_[static_cast<uint8_t>(BASE64_CHARS[i])] = i;
+        }
+    }
+};
+
+const Base64Table BASE64_TABLE;
+
+}  // namespace
+
 Status
 ParseQueryInteger(const OQueryParams& query_params, const std::string& key, int64_t& value, bool nullable) {
     auto query = query_params.get(key.c_str());
@@ -66,6 +87,77 @@ ParseQueryBool(const OQueryParams& query_params, const std::string& key, bool& v
     return Status::OK();
 }
 
+int64_t
+Base64DecodedSize(const std::string& encoded) {
+    auto size = encoded.size();
+    if (size % 4 != 0) {
+        return -1;
+    }
+    int64_t padding = 0;
+    if (size > 0 && encoded[size - 1] == '=') {
+        padding++;
+        if (encoded[size - 2] == '=') {
+            padding++;
+        }
+    }
+    return size / 4 * 3 - padding;
+}
+
+Status
+Base64Decode(const std::string& encoded, uint8_t* out) {
+    auto decoded_size = Base64DecodedSize(encoded);
+    if (decoded_size < 0) {
+        return Status(ILLEGAL_BODY, "Length of base64 string must be a multiple of 4");
+    }
+
+    // padding is only allowed as the trailing one or two characters of the last quad
+    size_t padding = encoded.size() / 4 * 3 - decoded_size;
+
+    const auto* in = reinterpret_cast<const uint8_t*>(encoded.data());
+    int64_t pos = 0;
+    for (size_t i = 0; i < encoded.size(); i += 4) {
+        int32_t quad[4];
+        for (size_t j = 0; j < 4; j++) {
+            if (in[i + j] == '=') {
+                if (i + j < encoded.size() - padding) {
+                    return Status(ILLEGAL_BODY, "Misplaced padding in base64 string");
+                }
+                quad[j] = 0;
+                continue;
+            }
+            quad[j] = BASE64_TABLE.value_[in[i + j]];
+            if (quad[j] < 0) {
+                return Status(ILLEGAL_BODY, "Illegal character in base64 string");
+            }
+        }
+        uint32_t triple = (quad[0] << 18) | (quad[1] << 12) | (quad[2] << 6) | quad[3];
+        for (int32_t shift = 16; shift >= 0 && pos < decoded_size; shift -= 8) {
+            out[pos++] = static_cast<uint8_t>(triple >> shift);
+        }
+    }
+
+    return Status::OK();
+}
+
+void
+Base64Encode(const uint8_t* data, size_t size, std::string& encoded) {
+    encoded.resize((size + 2) / 3 * 4);
+    size_t pos = 0;
+    for (size_t i = 0; i < size; i += 3) {
+        uint32_t triple = data[i] << 16;
+        if (i + 1 < size) {
+            triple |= data[i + 1] << 8;
+        }
+        if (i + 2 < size) {
+            triple |= data[i + 2];
+        }
+        encoded[pos++] = BASE64_CHARS[(triple >> 18) & 0x3F];
+        encoded[pos++] = BASE64_CHARS[(triple >> 12) & 0x3F];
+        encoded[pos++] = (i + 1 < size) ? BASE64_CHARS[(triple >> 6) & 0x3F] : '=';
+        encoded[pos++] = (i + 2 < size) ? BASE64_CHARS[triple & 0x3F] : '=';
+    }
+}
+
 }  // namespace web
 }  // namespace server
 }  // namespace milvus
@@ -31,6 +31,17 @@ ParseQueryStr(const OQueryParams& query_params, const std::string& key, std::str
 Status
 ParseQueryBool(const OQueryParams& query_params, const std::string& key, bool& value, bool nullable = true);
 
+// Size in bytes of the data encoded by a padded base64 string, -1 if the length is illegal
+int64_t
+Base64DecodedSize(const std::string& encoded);
+
+// Decode into a caller allocated buffer of Base64DecodedSize() bytes
+Status
+Base64Decode(const std::string& encoded, uint8_t* out);
+
+void
+Base64Encode(const uint8_t* data, size_t size, std::string& encoded);
+
 }  // namespace web
 }  // namespace server
 }  // namespace milvus
@@ -100,6 +100,52 @@ CheckParameterExistence(const milvus::json& json_params, const std::string& para
     return Status::OK();
 }
 
+/*
+ * The optional pre-transform of the float IVF indexes built on cpu: PCA for all of them, OPQ for the PQ ones.
+ * dimension is set to the dimension of the vectors seen by the index.
+ */
+Status
+CheckPreTransform(const milvus::json& index_params, const engine::meta::CollectionSchema& collection_schema,
+                  int32_t index_type, int64_t& dimension) {
+    dimension = collection_schema.dimension_;
+    if (index_params.find(knowhere::IndexParams::pre_transform) == index_params.end()) {
+        return Status::OK();
+    }
+
+    bool is_pq = index_type == (int32_t)engine::EngineType::FAISS_PQ ||
+                 index_type == (int32_t)engine::EngineType::FAISS_PQ_FASTSCAN;
+    bool is_supported = is_pq || index_type == (int32_t)engine::EngineType::FAISS_IVFFLAT ||
+                        index_type == (int32_t)engine::EngineType::FAISS_IVFSQ8;
+    std::string transform;
+    if (index_params[knowhere::IndexParams::pre_transform].is_string()) {
+        transform = index_params[knowhere::IndexParams::pre_transform].get<std::string>();
+    }
+
+    std::string msg;
+    if (!is_supported) {
+        msg = "Pre-transform is only supported by IVF_FLAT, IVF_SQ8, IVF_PQ and IVF_PQ_FASTSCAN";
+    } else if (transform != knowhere::PreTransform::PCA && !(is_pq && transform == knowhere::PreTransform::OPQ)) {
+        msg = "Invalid " + std::string(knowhere::IndexParams::pre_transform) + ", must be PCA, or OPQ for PQ indexes";
+    } else if (transform == knowhere::PreTransform::PCA &&
+               collection_schema.metric_type_ != (int32_t)engine::MetricType::L2) {
+        msg = "PCA pre-transform only supports L2 metric";
+    }
+    if (!msg.empty()) {
+        LOG_SERVER_ERROR_ << msg;
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    if (index_params.find(knowhere::IndexParams::pre_transform_dim) != index_params.end()) {
+        int64_t max_dim = collection_schema.dimension_;
+        auto status = CheckParameterRange(index_params, knowhere::IndexParams::pre_transform_dim, 1, max_dim);
+        if (!status.ok()) {
+            return status;
+        }
+        dimension = index_params[knowhere::IndexParams::pre_transform_dim];
+    }
+    return Status::OK();
+}
+
 }  // namespace
 
 Status
@@ -200,6 +246,12 @@ ValidationUtil::ValidateIndexParams(const milvus::json& index_params,
             if (!status.ok()) {
                 return status;
             }
+
+            int64_t dimension;
+            status = CheckPreTransform(index_params, collection_schema, index_type, dimension);
+            if (!status.ok()) {
+                return status;
+            }
             break;
         }
         case (int32_t)engine::EngineType::FAISS_PQ: {
@@ -213,9 +265,15 @@ ValidationUtil::ValidateIndexParams(const milvus::json& index_params,
                 return status;
             }
 
+            int64_t dimension;
+            status = CheckPreTransform(index_params, collection_schema, index_type, dimension);
+            if (!status.ok()) {
+                return status;
+            }
+
             // special check for 'm' parameter
             std::vector<int64_t> resset;
-            milvus::knowhere::IVFPQConfAdapter::GetValidMList(collection_schema.dimension_, resset);
+            milvus::knowhere::IVFPQConfAdapter::GetValidMList(dimension, resset);
             int64_t m_value = index_params[index_params, knowhere::IndexParams::m];
             if (resset.empty()) {
                 std::string msg = "Invalid collection dimension, unable to get reasonable values for 'm'";
@@ -240,6 +298,33 @@ ValidationUtil::ValidateIndexParams(const milvus::json& index_params,
 
             break;
         }
+        case (int32_t)engine::EngineType::FAISS_PQ_FASTSCAN: {
+            auto status = CheckParameterRange(index_params, knowhere::IndexParams::nlist, 1, 999999);
+            if (!status.ok()) {
+                return status;
+            }
+
+            status = CheckParameterExistence(index_params, knowhere::IndexParams::m);
+            if (!status.ok()) {
+                return status;
+            }
+
+            int64_t dimension;
+            status = CheckPreTransform(index_params, collection_schema, index_type, dimension);
+            if (!status.ok()) {
+                return status;
+            }
+
+            // every sub-quantizer takes the same number of dimensions
+            int64_t m_value = index_params[knowhere::IndexParams::m];
+            if (m_value <= 0 || dimension % m_value != 0) {
+                std::string msg = "Invalid " + std::string(knowhere::IndexParams::m) +
+                                  ", must be a divisor of the collection dimension or of pre_transform_dim";
+                LOG_SERVER_ERROR_ << msg;
+                return Status(SERVER_INVALID_ARGUMENT, msg);
+            }
+            break;
+        }
         case (int32_t)engine::EngineType::NSG_MIX: {
             auto status = CheckParameterRange(index_params, knowhere::IndexParams::search_length, 10, 300);
             if (!status.ok()) {
@@ -293,7 +378,8 @@ ValidationUtil::ValidateSearchParams(const milvus::json& search_params,
         case (int32_t)engine::EngineType::FAISS_IVFSQ8:
         case (int32_t)engine::EngineType::FAISS_IVFSQ8H:
         case (int32_t)engine::EngineType::FAISS_BIN_IVFFLAT:
-        case (int32_t)engine::EngineType::FAISS_PQ: {
+        case (int32_t)engine::EngineType::FAISS_PQ:
+        case (int32_t)engine::EngineType::FAISS_PQ_FASTSCAN: {
             auto status = CheckParameterRange(search_params, knowhere::IndexParams::nprobe, 1, 999999);
             if (!status.ok()) {
                 return status;
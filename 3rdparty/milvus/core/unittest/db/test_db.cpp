@@ -902,6 +902,185 @@ TEST_F(DBTest, PARTITION_TEST) {
     ASSERT_TRUE(stat.ok());
 }
 
+TEST_F(DBTest, QUERY_COLLECTIONS_TEST) {
+    // two collections with the same ids but different vectors
+    std::vector<std::string> collection_ids = {COLLECTION_NAME, std::string(COLLECTION_NAME) + "_other"};
+    const int64_t INSERT_BATCH = 2000;
+    std::vector<milvus::engine::VectorsData> xbs(collection_ids.size());
+    for (size_t i = 0; i < collection_ids.size(); i++) {
+        milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+        collection_info.collection_id_ = collection_ids[i];
+        auto stat = db_->CreateCollection(collection_info);
+        ASSERT_TRUE(stat.ok());
+
+        BuildVectors(INSERT_BATCH, 0, xbs[i]);
+        milvus::engine::VectorsData xb = xbs[i];
+        stat = db_->InsertVectors(collection_ids[i], "", xb);
+        ASSERT_TRUE(stat.ok());
+    }
+    auto stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    const int64_t nq = 5;
+    const int64_t topk = 10;
+    milvus::json json_params = {{"nprobe", 10}};
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    std::vector<int64_t> result_collections;
+
+    // query vectors taken from the second collection must be found there
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = nq;
+    xq.float_data_.assign(xbs[1].float_data_.begin(), xbs[1].float_data_.begin() + nq * COLLECTION_DIM);
+    stat = db_->QueryCollections(dummy_context_, collection_ids, tags, topk, json_params, xq, result_ids,
+                                 result_distances, result_collections);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids.size(), nq * topk);
+    ASSERT_EQ(result_collections.size(), nq * topk);
+    for (int64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(result_ids[i * topk], i);
+        ASSERT_EQ(result_collections[i * topk], 1);
+        ASSERT_LT(result_distances[i * topk], 1e-4);
+        for (int64_t j = 1; j < topk; j++) {
+            ASSERT_LE(result_distances[i * topk + j - 1], result_distances[i * topk + j]);
+            ASSERT_GE(result_collections[i * topk + j], 0);
+        }
+    }
+
+    // collections with different metric types can not be searched together
+    milvus::engine::meta::CollectionSchema ip_info = BuildCollectionSchema();
+    ip_info.collection_id_ = std::string(COLLECTION_NAME) + "_ip";
+    ip_info.metric_type_ = (int32_t)milvus::engine::MetricType::IP;
+    stat = db_->CreateCollection(ip_info);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->QueryCollections(dummy_context_, {COLLECTION_NAME, ip_info.collection_id_}, tags, topk, json_params,
+                                 xq, result_ids, result_distances, result_collections);
+    ASSERT_FALSE(stat.ok());
+
+    // not existing collection
+    stat = db_->QueryCollections(dummy_context_, {COLLECTION_NAME, "not_exist"}, tags, topk, json_params, xq,
+                                 result_ids, result_distances, result_collections);
+    ASSERT_FALSE(stat.ok());
+}
+
+TEST_F(DBTest, COLLECTION_VERSION_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->CreatePartition(COLLECTION_NAME, "", "tag");
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t version = 0, last_version = 0;
+    stat = db_->GetCollectionVersion(COLLECTION_NAME, last_version);
+    ASSERT_TRUE(stat.ok());
+
+    // inserts, also into a partition, deletes and flushes change the version of the collection
+    milvus::engine::VectorsData xb;
+    BuildVectors(100, 0, xb);
+    stat = db_->InsertVectors(COLLECTION_NAME, "tag", xb);
+    ASSERT_TRUE(stat.ok());
+    db_->GetCollectionVersion(COLLECTION_NAME, version);
+    ASSERT_GT(version, last_version);
+    last_version = version;
+
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+    db_->GetCollectionVersion(COLLECTION_NAME, version);
+    ASSERT_GT(version, last_version);
+    last_version = version;
+
+    stat = db_->DeleteVectors(COLLECTION_NAME, {0, 1});
+    ASSERT_TRUE(stat.ok());
+    db_->GetCollectionVersion(COLLECTION_NAME, version);
+    ASSERT_GT(version, last_version);
+    last_version = version;
+
+    // a search doesn't
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    milvus::json json_params = {{"nprobe", 10}};
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, {}, 10, json_params, xb, result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    db_->GetCollectionVersion(COLLECTION_NAME, version);
+    ASSERT_EQ(version, last_version);
+
+    // a recreated collection doesn't get an old version back
+    stat = db_->DropCollection(COLLECTION_NAME);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+    db_->GetCollectionVersion(COLLECTION_NAME, version);
+    ASSERT_GT(version, last_version);
+}
+
+TEST_F(DBTest, TUNE_SEARCH_PARAMS_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    milvus::engine::VectorsData xb;
+    BuildVectors(VECTOR_COUNT, 0, xb);
+    stat = db_->InsertVectors(COLLECTION_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    // nothing to tune without an index
+    milvus::engine::VectorsData queries;
+    milvus::json tune_result;
+    stat = db_->TuneSearchParams(COLLECTION_NAME, 10, 0.9, queries, tune_result);
+    ASSERT_FALSE(stat.ok());
+
+    milvus::engine::CollectionIndex index;
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFFLAT;
+    index.metric_type_ = (int)milvus::engine::MetricType::L2;
+    index.extra_params_ = {{"nlist", 16}};
+    stat = db_->CreateIndex(dummy_context_, COLLECTION_NAME, index);
+    ASSERT_TRUE(stat.ok());
+
+    // nprobe equal to nlist is exact for IVF_FLAT, the target is always reached
+    stat = db_->TuneSearchParams(COLLECTION_NAME, 10, 0.9, queries, tune_result);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_TRUE(tune_result["target_reached"].get<bool>());
+    ASSERT_GE(tune_result["recall"].get<double>(), 0.9);
+    int64_t nprobe = tune_result["search_params"]["nprobe"];
+    ASSERT_GE(nprobe, 1);
+    ASSERT_LE(nprobe, 16);
+
+    // the params are kept with the index, creating the same index again keeps them
+    milvus::engine::CollectionIndex index_out;
+    stat = db_->DescribeIndex(COLLECTION_NAME, index_out);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(index_out.extra_params_["search_params"]["nprobe"], nprobe);
+    stat = db_->CreateIndex(dummy_context_, COLLECTION_NAME, index);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->DescribeIndex(COLLECTION_NAME, index_out);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(index_out.extra_params_["search_params"]["nprobe"], nprobe);
+
+    // sampled queries are held out, nprobe 1 would always find a query itself as its nearest neighbour
+    stat = db_->TuneSearchParams(COLLECTION_NAME, 1, 1.0, queries, tune_result);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(tune_result["candidates"][0]["nprobe"], 1);
+    ASSERT_LT(tune_result["candidates"][0]["recall"].get<double>(), 1.0);
+
+    // given queries are used as they are
+    milvus::engine::VectorsData qb;
+    BuildVectors(10, 0, qb);
+    stat = db_->TuneSearchParams(COLLECTION_NAME, 5, 1.0, qb, tune_result);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(tune_result["recall"].get<double>(), 1.0);
+
+    // another index drops them
+    index.extra_params_ = {{"nlist", 32}};
+    stat = db_->CreateIndex(dummy_context_, COLLECTION_NAME, index);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->DescribeIndex(COLLECTION_NAME, index_out);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_FALSE(index_out.extra_params_.contains("search_params"));
+}
+
 TEST_F(DBTest2, ARHIVE_DISK_CHECK) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
     auto stat = db_->CreateCollection(collection_info);
@@ -867,3 +867,63 @@ TEST_F(CompactTest, compact_non_existing_table) {
     auto status = db_->Compact("non_existing_table");
     ASSERT_FALSE(status.ok());
 }
+
+TEST_F(AutoCompactTest, compact_by_delete_ratio) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 100;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    stat = db_->InsertVectors(collection_info.collection_id_, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    auto get_segment = [&](std::string& name, int64_t& row_count) {
+        std::string info;
+        ASSERT_TRUE(db_->GetCollectionInfo(collection_info.collection_id_, info).ok());
+        auto json = nlohmann::json::parse(info);
+        auto& segments = json["partitions"].at(0)["segments"];
+        ASSERT_EQ(segments.size(), 1);
+        name = segments.at(0)["name"];
+        row_count = segments.at(0)["row_count"];
+    };
+    std::string segment_name;
+    int64_t row_count = 0;
+    get_segment(segment_name, row_count);
+    ASSERT_EQ(row_count, nb);
+
+    // 2 deleted of 100 stays under the ratio of 0.1
+    std::vector<milvus::engine::IDNumber> ids_to_delete{xb.id_array_[0], xb.id_array_[1]};
+    stat = db_->DeleteVectors(collection_info.collection_id_, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    std::this_thread::sleep_for(std::chrono::seconds(4));
+    std::string name;
+    get_segment(name, row_count);
+    ASSERT_EQ(name, segment_name);
+    ASSERT_EQ(row_count, nb);
+
+    // 20 deleted of 100 is rewritten without the deleted rows
+    ids_to_delete.assign(xb.id_array_.begin() + 2, xb.id_array_.begin() + 20);
+    stat = db_->DeleteVectors(collection_info.collection_id_, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    for (int i = 0; i < 10 && name == segment_name; i++) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        get_segment(name, row_count);
+    }
+    ASSERT_NE(name, segment_name);
+    ASSERT_EQ(row_count, nb - 20);
+
+    uint64_t collection_rows = 0;
+    stat = db_->GetCollectionRowCount(collection_info.collection_id_, collection_rows);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(collection_rows, nb - 20);
+}
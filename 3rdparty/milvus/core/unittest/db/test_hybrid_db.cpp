@@ -15,6 +15,7 @@
 
 #include <boost/filesystem.hpp>
 #include <random>
+#include <set>
 #include <thread>
 
 #include "cache/CpuCacheMgr.h"
@@ -26,6 +27,7 @@
 #include "db/IDGenerator.h"
 #include "db/meta/MetaConsts.h"
 #include "db/utils.h"
+#include "query/BinaryQuery.h"
 #include "utils/CommonUtil.h"
 
 namespace {
@@ -246,6 +248,93 @@ TEST_F(DBTest, HYBRID_SEARCH_TEST) {
     //#endif
 }
 
+TEST_F(DBTest, HYBRID_MULTI_VECTOR_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info;
+    milvus::engine::meta::hybrid::FieldsSchema fields_info;
+    std::unordered_map<std::string, milvus::engine::meta::hybrid::DataType> attr_type;
+    BuildTableSchema(collection_info, fields_info, attr_type);
+
+    auto stat = db_->CreateHybridCollection(collection_info, fields_info);
+    ASSERT_TRUE(stat.ok());
+
+    // entities of 1 to 3 vectors
+    uint64_t qb = 300;
+    milvus::engine::Entity entity;
+    BuildEntity(qb, 0, entity);
+    auto& vectors = entity.vector_data_.begin()->second;
+    vectors.id_array_.clear();
+    std::vector<int64_t> offsets;
+    int64_t vector_count = 0;
+    for (uint64_t i = 0; i < qb; ++i) {
+        offsets.push_back(vector_count);
+        vectors.vector_lengths_.push_back(i % 3 + 1);
+        vector_count += i % 3 + 1;
+    }
+    vectors.vector_count_ = vector_count;
+    vectors.float_data_.resize(vector_count * TABLE_DIM);
+    for (auto& value : vectors.float_data_) {
+        value = drand48();
+    }
+
+    std::vector<std::string> field_names = {"field_0", "field_1", "field_2"};
+    stat = db_->InsertEntities(TABLE_NAME, "", field_names, entity, attr_type);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(entity.id_array_.size(), qb);
+
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    // query with the vectors of an entity
+    const int64_t target = 50;
+    const int64_t target_length = target % 3 + 1;
+    auto vector_query = std::make_shared<milvus::query::VectorQuery>();
+    vector_query->field_name = "field_3";
+    vector_query->topk = 5;
+    vector_query->boost = 1;
+    vector_query->query_vector.float_data.assign(
+        vectors.float_data_.begin() + offsets[target] * TABLE_DIM,
+        vectors.float_data_.begin() + (offsets[target] + target_length) * TABLE_DIM);
+
+    milvus::query::GeneralQueryPtr general_query = std::make_shared<milvus::query::GeneralQuery>();
+    general_query->leaf = std::make_shared<milvus::query::LeafQuery>();
+    general_query->leaf->vector_query = vector_query;
+
+    std::vector<std::string> tags;
+    milvus::context::HybridSearchContextPtr hybrid_context = std::make_shared<milvus::context::HybridSearchContext>();
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    uint64_t nq;
+
+    // the entities closest to each query vector, an entity at most once
+    vector_query->extra_params = {{"max_sim", "max"}};
+    stat = milvus::query::ParseMaxSim(*vector_query, TABLE_DIM);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->HybridQuery(dummy_context_, TABLE_NAME, tags, hybrid_context, general_query, attr_type, nq, result_ids,
+                            result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(nq, (uint64_t)target_length);
+    ASSERT_EQ(result_ids.size(), nq * vector_query->topk);
+    for (uint64_t i = 0; i < nq; ++i) {
+        ASSERT_EQ(result_ids[i * vector_query->topk], entity.id_array_[target]);
+        std::set<int64_t> unique_ids(result_ids.begin() + i * vector_query->topk,
+                                     result_ids.begin() + (i + 1) * vector_query->topk);
+        ASSERT_EQ(unique_ids.size(), (size_t)vector_query->topk);
+    }
+
+    // all the query vectors as one query
+    vector_query->extra_params = {{"max_sim", "sum_max"}};
+    stat = milvus::query::ParseMaxSim(*vector_query, TABLE_DIM);
+    ASSERT_TRUE(stat.ok());
+    result_ids.clear();
+    result_distances.clear();
+    stat = db_->HybridQuery(dummy_context_, TABLE_NAME, tags, hybrid_context, general_query, attr_type, nq, result_ids,
+                            result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(nq, (uint64_t)1);
+    ASSERT_EQ(result_ids[0], entity.id_array_[target]);
+    ASSERT_NEAR(result_distances[0], 0, 1e-3);
+}
+
 TEST_F(DBTest, COMPACT_TEST) {
     milvus::engine::meta::CollectionSchema collection_info;
     milvus::engine::meta::hybrid::FieldsSchema fields_info;
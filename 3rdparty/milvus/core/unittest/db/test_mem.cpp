@@ -15,6 +15,7 @@
 #include <fstream>
 #include <iostream>
 #include <random>
+#include <set>
 #include <thread>
 #include <fiu-control.h>
 #include <fiu-local.h>
@@ -173,6 +174,44 @@ TEST_F(MemManagerTest, MEM_TABLE_FILE_TEST) {
     }
 }
 
+TEST_F(MemManagerTest, MEM_TABLE_FILE_REPLICA_TEST) {
+    auto options = GetOptions();
+    options.mode_ = milvus::engine::DBOptions::MODE::CLUSTER_READONLY;
+
+    milvus::engine::meta::CollectionSchema collection_schema = BuildCollectionSchema();
+    auto status = impl_->CreateCollection(collection_schema);
+    ASSERT_TRUE(status.ok());
+
+    // the insert buffer of a read replica is searchable, but it adds no file to the meta
+    milvus::engine::MemTableFile mem_table_file(GetCollectionName(), impl_, options);
+    int64_t n_100 = 100;
+    milvus::engine::VectorsData vectors_100;
+    BuildVectors(n_100, vectors_100);
+    milvus::engine::VectorSourcePtr source = std::make_shared<milvus::engine::VectorSource>(vectors_100);
+    status = mem_table_file.Add(source);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(mem_table_file.GetCurrentMem(), n_100 * sizeof(float) * COLLECTION_DIM);
+
+    milvus::engine::VectorsData search;
+    search.vector_count_ = 1;
+    search.float_data_.insert(search.float_data_.begin(), vectors_100.float_data_.begin(),
+                              vectors_100.float_data_.begin() + COLLECTION_DIM);
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    status = mem_table_file.Search(10, search, {}, result_ids, result_distances);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(result_ids[0], source->GetVectorIds()[0]);
+
+    milvus::engine::meta::FilesHolder files_holder;
+    std::vector<int> file_types = {(int)milvus::engine::meta::SegmentSchema::NEW};
+    status = impl_->FilesByType(GetCollectionName(), file_types, files_holder);
+    ASSERT_TRUE(status.ok());
+    ASSERT_TRUE(files_holder.HoldFiles().empty());
+
+    status = mem_table_file.Serialize(0);
+    ASSERT_FALSE(status.ok());
+}
+
 TEST_F(MemManagerTest, MEM_TABLE_TEST) {
     auto options = GetOptions();
 
@@ -516,3 +555,104 @@ TEST_F(MemManagerTest2, VECTOR_IDS_TEST) {
         ASSERT_EQ(xb.id_array_[i], i + nb);
     }
 }
+
+TEST_F(MemManagerTest2, SEARCH_INSERT_BUFFER_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 1000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    for (int64_t i = 0; i < nb; i++) {
+        xb.id_array_.push_back(i);
+    }
+
+    // vectors stay in the insert buffer, no flush
+    stat = db_->InsertVectors(GetCollectionName(), "", xb);
+    ASSERT_TRUE(stat.ok());
+
+    const int64_t query_id = 10;
+    milvus::engine::VectorsData search;
+    search.vector_count_ = 1;
+    search.float_data_.insert(search.float_data_.begin(), xb.float_data_.begin() + query_id * COLLECTION_DIM,
+                              xb.float_data_.begin() + (query_id + 1) * COLLECTION_DIM);
+
+    const int topk = 10;
+    milvus::json json_params = {{"nprobe", 10}};
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, GetCollectionName(), tags, topk, json_params, search, result_ids,
+                      result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids.size(), topk);
+    ASSERT_EQ(result_ids[0], query_id);
+    ASSERT_LT(result_distances[0], 1e-4);
+
+    // deleted vectors are not returned from the buffer
+    stat = db_->DeleteVectors(GetCollectionName(), {query_id});
+    ASSERT_TRUE(stat.ok());
+    result_ids.clear();
+    result_distances.clear();
+    stat = db_->Query(dummy_context_, GetCollectionName(), tags, topk, json_params, search, result_ids,
+                      result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_NE(result_ids[0], query_id);
+
+    // flushed data is found exactly once
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+    result_ids.clear();
+    result_distances.clear();
+    stat = db_->Query(dummy_context_, GetCollectionName(), tags, topk, json_params, search, result_ids,
+                      result_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(result_ids.size(), topk);
+    std::set<int64_t> unique_ids(result_ids.begin(), result_ids.end());
+    ASSERT_EQ(unique_ids.size(), result_ids.size());
+}
+
+TEST_F(MemManagerTest2, SEARCH_FLUSH_BETWEEN_BUFFER_AND_SEGMENTS_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 1000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    for (int64_t i = 0; i < nb; i++) {
+        xb.id_array_.push_back(i);
+    }
+    stat = db_->InsertVectors(GetCollectionName(), "", xb);
+    ASSERT_TRUE(stat.ok());
+
+    const int64_t query_id = 10;
+    milvus::engine::VectorsData search;
+    search.vector_count_ = 1;
+    search.float_data_.insert(search.float_data_.begin(), xb.float_data_.begin() + query_id * COLLECTION_DIM,
+                              xb.float_data_.begin() + (query_id + 1) * COLLECTION_DIM);
+
+    // the buffer is flushed after it was searched and before the segments are listed
+    FIU_ENABLE_FIU("DBImpl.Query.flush_after_buffer_search");
+    const int topk = 10;
+    milvus::json json_params = {{"nprobe", 10}};
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->Query(dummy_context_, GetCollectionName(), tags, topk, json_params, search, result_ids,
+                      result_distances);
+    fiu_disable("DBImpl.Query.flush_after_buffer_search");
+    ASSERT_TRUE(stat.ok());
+
+    // the rows are in both the buffer hits and the new segment, they are returned once
+    ASSERT_EQ(result_ids.size(), topk);
+    ASSERT_EQ(result_ids[0], query_id);
+    std::set<int64_t> unique_ids(result_ids.begin(), result_ids.end());
+    ASSERT_EQ(unique_ids.size(), result_ids.size());
+
+    uint64_t row_count = 0;
+    stat = db_->GetCollectionRowCount(GetCollectionName(), row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, (uint64_t)nb);
+}
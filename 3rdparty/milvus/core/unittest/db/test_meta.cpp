@@ -378,6 +378,19 @@ TEST_F(MetaTest, COLLECTION_FILE_TEST) {
     status = impl_->UpdateCollectionFile(table_file);
     ASSERT_TRUE(status.ok());
     ASSERT_EQ(table_file.file_type_, new_file_type);
+    ASSERT_EQ(collection_id, milvus::engine::utils::GetQuotaCollectionId(table_file));
+
+    // files of a partition count for the memory quota of the collection
+    std::string partition = "meta_test_partition";
+    std::string partition_tag = "tag0";
+    status = impl_->CreatePartition(collection_id, partition, partition_tag, 0);
+    ASSERT_TRUE(status.ok());
+    milvus::engine::meta::SegmentSchema partition_file;
+    partition_file.collection_id_ = partition;
+    status = impl_->CreateCollectionFile(partition_file);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(collection_id, partition_file.owner_collection_);
+    ASSERT_EQ(collection_id, milvus::engine::utils::GetQuotaCollectionId(partition_file));
 }
 
 TEST_F(MetaTest, HYBRID_COLLECTION_TEST) {
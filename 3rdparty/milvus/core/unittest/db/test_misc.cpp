@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 
 #include <boost/filesystem.hpp>
+#include <cmath>
 #include <thread>
 #include <vector>
 
@@ -159,6 +160,50 @@ TEST(DBMiscTest, UTILS_TEST) {
     ASSERT_TRUE(status.ok());
 
     status = milvus::engine::utils::DeleteSegment(options, file);
+
+    // tuned search params fill those not given, the largest value wins over several collections
+    milvus::json user_params = {{"nprobe", 4}};
+    milvus::json extra_params = user_params;
+    milvus::engine::utils::ApplyTunedSearchParams("{\"nlist\": 16, \"search_params\": {\"nprobe\": 8, \"ef\": 64}}",
+                                                  user_params, extra_params);
+    ASSERT_EQ(extra_params["nprobe"], 4);
+    ASSERT_EQ(extra_params["ef"], 64);
+    milvus::engine::utils::ApplyTunedSearchParams("{\"search_params\": {\"ef\": 32}}", user_params, extra_params);
+    ASSERT_EQ(extra_params["ef"], 64);
+    milvus::engine::utils::ApplyTunedSearchParams("{\"search_params\": {\"ef\": 128}}", user_params, extra_params);
+    ASSERT_EQ(extra_params["ef"], 128);
+    milvus::engine::utils::ApplyTunedSearchParams("", user_params, extra_params);
+    ASSERT_EQ(extra_params.size(), 2);
+
+    ASSERT_TRUE(milvus::engine::utils::IsPreTransformedIndex("{\"nlist\": 16, \"pre_transform\": \"OPQ\"}"));
+    ASSERT_FALSE(milvus::engine::utils::IsPreTransformedIndex("{\"nlist\": 16}"));
+    ASSERT_FALSE(milvus::engine::utils::IsPreTransformedIndex(""));
+
+    milvus::engine::CollectionIndex index1, index2;
+    index1.extra_params_ = {{"nlist", 16}};
+    index2.extra_params_ = {{"nlist", 16}, {"search_params", {{"nprobe", 8}}}};
+    ASSERT_TRUE(milvus::engine::utils::IsSameIndex(index1, index2));
+    index2.extra_params_["nlist"] = 32;
+    ASSERT_FALSE(milvus::engine::utils::IsSameIndex(index1, index2));
+
+    // only the vectors of a COSINE collection are normalized, zero vectors are left as is
+    milvus::engine::VectorsData vectors;
+    vectors.vector_count_ = 3;
+    vectors.float_data_ = {3.0, 4.0, 0.0, 0.0, 1.0, 1.0};
+    milvus::engine::utils::NormalizeVectors((int32_t)milvus::engine::MetricType::IP, vectors);
+    ASSERT_FLOAT_EQ(vectors.float_data_[0], 3.0);
+    milvus::engine::utils::NormalizeVectors((int32_t)milvus::engine::MetricType::COSINE, vectors);
+    ASSERT_FLOAT_EQ(vectors.float_data_[0], 0.6);
+    ASSERT_FLOAT_EQ(vectors.float_data_[1], 0.8);
+    ASSERT_FLOAT_EQ(vectors.float_data_[2], 0.0);
+    ASSERT_FLOAT_EQ(vectors.float_data_[3], 0.0);
+    ASSERT_FLOAT_EQ(vectors.float_data_[4], 1.0 / std::sqrt(2.0));
+    std::vector<float> query_vectors = {0.0, 2.0, 6.0, 8.0};
+    milvus::engine::utils::NormalizeVectors((int32_t)milvus::engine::MetricType::COSINE, 2, query_vectors);
+    ASSERT_FLOAT_EQ(query_vectors[1], 1.0);
+    ASSERT_FLOAT_EQ(query_vectors[2], 0.6);
+    ASSERT_TRUE(milvus::engine::utils::IsSimilarityMetricType((int32_t)milvus::engine::MetricType::COSINE));
+    ASSERT_FALSE(milvus::engine::utils::IsSimilarityMetricType((int32_t)milvus::engine::MetricType::L2));
 }
 
 TEST(DBMiscTest, SAFE_ID_GENERATOR_TEST) {
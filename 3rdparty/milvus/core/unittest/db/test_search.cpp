@@ -162,6 +162,56 @@ TEST(DBSearchTest, MERGE_RESULT_SET_TEST) {
     MergeTopkToResultSetTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, false);
 }
 
+TEST(DBSearchTest, MAX_SIM_TEST) {
+    // the hits of two query vectors over the vectors of entities, -1 pads them
+    const ms::ResultIds hit_ids = {7, 7, 3, 5, 3, 9, 7, -1};
+    const ms::ResultDistances hit_distances = {0.1, 0.2, 0.3, 0.4, 0.05, 0.15, 0.5, 0};
+
+    milvus::query::VectorQuery vector_query;
+    vector_query.topk = 2;
+
+    // the best hit of each entity for each query vector
+    vector_query.max_sim = milvus::query::MaxSimType::MAX;
+    uint64_t nq = 2, topk = 4;
+    auto ids = hit_ids;
+    auto distances = hit_distances;
+    ms::XSearchTask::AggregateMaxSim(vector_query, true, nq, topk, ids, distances);
+    ASSERT_EQ(nq, (uint64_t)2);
+    ASSERT_EQ(topk, (uint64_t)2);
+    ASSERT_EQ(ids, ms::ResultIds({7, 3, 3, 9}));
+    ASSERT_FLOAT_EQ(distances[0], 0.1);
+    ASSERT_FLOAT_EQ(distances[1], 0.3);
+    ASSERT_FLOAT_EQ(distances[2], 0.05);
+    ASSERT_FLOAT_EQ(distances[3], 0.15);
+
+    // the sum over the query vectors, an entity missing from the hits of one counts its farthest hit
+    vector_query.max_sim = milvus::query::MaxSimType::SUM_MAX;
+    vector_query.query_lengths = {2};
+    nq = 2, topk = 4;
+    ids = hit_ids;
+    distances = hit_distances;
+    ms::XSearchTask::AggregateMaxSim(vector_query, true, nq, topk, ids, distances);
+    ASSERT_EQ(nq, (uint64_t)1);
+    ASSERT_EQ(ids, ms::ResultIds({3, 9}));
+    ASSERT_FLOAT_EQ(distances[0], 0.3 + 0.05);
+    ASSERT_FLOAT_EQ(distances[1], 0.4 + 0.15);
+
+    // an entity with hits in two segments is merged once
+    ms::ResultIds result_ids = {9, 4, -1};
+    ms::ResultDistances result_distances = {0.5, 0.6, 0};
+    ms::XSearchTask::MergeTopkToResultSet(ids, distances, 2, 1, 3, true, result_ids, result_distances, true);
+    ASSERT_EQ(result_ids, ms::ResultIds({3, 9, 4}));
+    ASSERT_FLOAT_EQ(result_distances[1], 0.5);
+
+    // insert buffer hits already flushed into a segment are merged once, for each query
+    ms::ResultIds mem_ids = {7, 5, -1, 2, -1, -1};
+    ms::ResultDistances mem_distances = {0.1, 0.2, 0, 0.3, 0, 0};
+    result_ids = {5, 6, 8, 2, 1, -1};
+    result_distances = {0.2, 0.4, 0.5, 0.3, 0.6, 0};
+    ms::XSearchTask::MergeTopkToResultSet(mem_ids, mem_distances, 3, 2, 3, true, result_ids, result_distances, true);
+    ASSERT_EQ(result_ids, ms::ResultIds({7, 5, 6, 2, 1, -1}));
+}
+
 //void MergeTopkArrayTest(size_t topk_1, size_t topk_2, size_t nq, size_t topk, bool ascending) {
 //    std::vector<int64_t> ids1, ids2;
 //    std::vector<float> dist1, dist2;
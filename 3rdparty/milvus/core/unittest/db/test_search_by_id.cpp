@@ -16,6 +16,7 @@
 #include <iostream>
 #include <limits>
 #include <random>
+#include <set>
 #include <thread>
 
 #include "db/Constants.h"
@@ -476,6 +477,65 @@ TEST_F(GetVectorByIdTest, WITH_DELETE_TEST) {
     }
 }
 
+TEST_F(GetVectorByIdTest, BATCH_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 10000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    for (int64_t i = 0; i < nb; i++) {
+        xb.id_array_.push_back(nb - i);  // ids in a different order than the offsets
+    }
+
+    stat = db_->InsertVectors(collection_info.collection_id_, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    // runs of consecutive offsets, scattered offsets, a duplicated id and an id not in the collection
+    std::vector<int64_t> ids_to_search;
+    for (int64_t i = 0; i < 1000; ++i) {
+        ids_to_search.emplace_back(i < 500 ? i + 1 : (i * 7) % nb + 1);
+    }
+    ids_to_search.emplace_back(ids_to_search[0]);
+    ids_to_search.emplace_back(nb + 1);
+
+    auto check_vectors = [&](const std::vector<milvus::engine::VectorsData>& vectors,
+                             const std::set<int64_t>& deleted_ids) {
+        ASSERT_EQ(vectors.size(), ids_to_search.size());
+        for (size_t i = 0; i < ids_to_search.size(); ++i) {
+            int64_t id = ids_to_search[i];
+            if (id > nb || deleted_ids.find(id) != deleted_ids.end()) {
+                ASSERT_EQ(vectors[i].vector_count_, 0);
+                continue;
+            }
+            ASSERT_EQ(vectors[i].vector_count_, 1);
+            const float* expected = xb.float_data_.data() + (nb - id) * COLLECTION_DIM;
+            for (int64_t j = 0; j < COLLECTION_DIM; ++j) {
+                ASSERT_EQ(vectors[i].float_data_[j], expected[j]);
+            }
+        }
+    };
+
+    std::vector<milvus::engine::VectorsData> vectors;
+    stat = db_->GetVectorsByID(collection_info.collection_id_, ids_to_search, vectors);
+    ASSERT_TRUE(stat.ok());
+    check_vectors(vectors, {});
+
+    // the id index is cached by now, deleted ids must not be returned
+    milvus::engine::IDNumbers ids_to_delete = {ids_to_search[1], ids_to_search[2], ids_to_search[500]};
+    stat = db_->DeleteVectors(collection_info.collection_id_, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    stat = db_->GetVectorsByID(collection_info.collection_id_, ids_to_search, vectors);
+    ASSERT_TRUE(stat.ok());
+    check_vectors(vectors, std::set<int64_t>(ids_to_delete.begin(), ids_to_delete.end()));
+}
+
 TEST_F(SearchByIdTest, BINARY_TEST) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
     collection_info.engine_type_ = (int)milvus::engine::EngineType::FAISS_BIN_IDMAP;
@@ -25,6 +25,7 @@
 #include "db/wal/WalFileHandler.h"
 #include "db/wal/WalManager.h"
 #include "db/wal/WalMetaHandler.h"
+#include "db/wal/WalTailer.h"
 #include "utils/Error.h"
 
 namespace {
@@ -414,6 +415,81 @@ TEST(WalTest, BUFFER_TEST) {
     }
 }
 
+TEST(WalTest, TAILER_TEST) {
+    MakeEmptyTestPath();
+
+    milvus::engine::wal::MXLogBuffer buffer(WAL_GTEST_PATH, 2048);
+    buffer.mxlog_buffer_size_ = 1000;
+    buffer.Reset(0);
+
+    milvus::engine::wal::MXLogTailer tailer(WAL_GTEST_PATH);
+    tailer.Seek(0);
+    milvus::engine::wal::MXLogRecord read_rst;
+    ASSERT_EQ(tailer.Next(read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::None);
+
+    std::vector<milvus::engine::IDNumber> ids(50);
+    std::vector<float> data(50);
+    for (size_t i = 0; i < ids.size(); i++) {
+        ids[i] = i;
+        data[i] = i * 0.5f;
+    }
+    milvus::engine::wal::MXLogRecord record;
+    record.type = milvus::engine::wal::MXLogType::InsertVector;
+    record.collection_id = "insert_table";
+    record.partition_tag = "parti1";
+    record.length = ids.size();
+    record.ids = ids.data();
+    record.data_size = data.size() * sizeof(float);
+    record.data = data.data();
+
+    // the records are spread over several files
+    std::vector<uint64_t> lsns;
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(buffer.Append(record), milvus::WAL_SUCCESS);
+        lsns.push_back(record.lsn);
+    }
+    ASSERT_GT(lsns.back() >> 32, lsns.front() >> 32);
+    ASSERT_EQ(tailer.GetWriteLsn(), lsns.back());
+
+    for (auto lsn : lsns) {
+        ASSERT_EQ(tailer.Next(read_rst), milvus::WAL_SUCCESS);
+        ASSERT_EQ(read_rst.type, record.type);
+        ASSERT_EQ(read_rst.lsn, lsn);
+        ASSERT_EQ(read_rst.collection_id, record.collection_id);
+        ASSERT_EQ(read_rst.partition_tag, record.partition_tag);
+        ASSERT_EQ(read_rst.length, record.length);
+        ASSERT_EQ(memcmp(read_rst.ids, record.ids, read_rst.length * sizeof(milvus::engine::IDNumber)), 0);
+        ASSERT_EQ(read_rst.data_size, record.data_size);
+        ASSERT_EQ(memcmp(read_rst.data, record.data, read_rst.data_size), 0);
+    }
+    ASSERT_EQ(tailer.Next(read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::None);
+    ASSERT_EQ(tailer.GetReadLsn(), lsns.back());
+
+    // read again from a record
+    tailer.Seek(lsns[2]);
+    ASSERT_EQ(tailer.Next(read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.lsn, lsns[3]);
+
+    // the files removed after a flush are skipped
+    buffer.RemoveOldFiles(lsns[3]);
+    milvus::engine::wal::MXLogTailer new_tailer(WAL_GTEST_PATH);
+    new_tailer.Seek(0);
+    ASSERT_EQ(new_tailer.Next(read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.lsn >> 32, lsns[3] >> 32);
+
+    // a record being written is not returned
+    std::string last_file = WAL_GTEST_PATH + std::to_string(lsns.back() >> 32) + ".wal";
+    FILE* fi = fopen(last_file.c_str(), "a");
+    fwrite(&lsns[0], 1, sizeof(uint64_t), fi);
+    fclose(fi);
+    ASSERT_EQ(tailer.Next(read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.lsn, lsns[4]);
+    ASSERT_EQ(tailer.Next(read_rst), milvus::WAL_SUCCESS);
+    ASSERT_EQ(read_rst.type, milvus::engine::wal::MXLogType::None);
+}
+
 TEST(WalTest, HYBRID_BUFFFER_TEST) {
     MakeEmptyTestPath();
 
@@ -260,6 +260,16 @@ DBTestWALRecovery::GetOptions() {
     return options;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+milvus::engine::DBOptions
+AutoCompactTest::GetOptions() {
+    auto options = DBTest::GetOptions();
+    options.auto_flush_interval_ = 1;
+    options.auto_compact_ratio_ = 0.1;
+    options.auto_compact_interval_ = 1;
+    return options;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 milvus::engine::DBOptions
 DBTestWALRecovery_Error::GetOptions() {
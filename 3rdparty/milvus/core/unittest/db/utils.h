@@ -151,6 +151,13 @@ class DeleteTest : public DBTest {};
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class CompactTest : public DBTest {};
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class AutoCompactTest : public DBTest {
+ protected:
+    milvus::engine::DBOptions
+    GetOptions() override;
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class SearchByIdTest : public DBTest {};
 
@@ -0,0 +1,92 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "scheduler/MemMgr.h"
+
+namespace milvus {
+namespace scheduler {
+
+TEST(MemMgrTest, BUDGET) {
+    MemMgr mgr(100, 0);
+    ASSERT_TRUE(mgr.Reserve("a", 60));
+    ASSERT_TRUE(mgr.Reserve("b", 40));
+    ASSERT_FALSE(mgr.Reserve("b", 1));
+    ASSERT_EQ(mgr.Reserved(), 100);
+
+    mgr.Release("a", 60);
+    ASSERT_EQ(mgr.Reserved("a"), 0);
+    ASSERT_TRUE(mgr.Reserve("b", 50));
+    ASSERT_EQ(mgr.Reserved("b"), 90);
+
+    mgr.Release("b", 90);
+    ASSERT_EQ(mgr.Reserved(), 0);
+
+    // a request bigger than budget is never admitted
+    ASSERT_FALSE(mgr.Fits("a", 1000));
+    ASSERT_FALSE(mgr.Reserve("a", 1000));
+    ASSERT_EQ(mgr.Reserved(), 0);
+    ASSERT_TRUE(mgr.Fits("a", 100));
+
+    // 0 means unlimited
+    mgr.SetBudget(0);
+    ASSERT_TRUE(mgr.Fits("a", 1000));
+    ASSERT_TRUE(mgr.Reserve("a", 1000));
+    ASSERT_TRUE(mgr.Reserve("b", 1000));
+    mgr.Release("a", 1000);
+    mgr.Release("b", 1000);
+}
+
+TEST(MemMgrTest, COLLECTION_QUOTA) {
+    MemMgr mgr(100, 30);
+    ASSERT_TRUE(mgr.Reserve("a", 30));
+    ASSERT_FALSE(mgr.Reserve("a", 10));
+    ASSERT_TRUE(mgr.Reserve("b", 10));
+
+    ASSERT_FALSE(mgr.Fits("a", 40));
+    ASSERT_FALSE(mgr.Reserve("c", 40));
+    ASSERT_EQ(mgr.Reserved("c"), 0);
+
+    mgr.SetCollectionQuota("a", 50);
+    ASSERT_TRUE(mgr.Fits("a", 40));
+    ASSERT_TRUE(mgr.Reserve("a", 10));
+    ASSERT_EQ(mgr.Reserved("a"), 40);
+
+    mgr.SetCollectionQuotas({{"b", 15}});
+    ASSERT_FALSE(mgr.Reserve("a", 1));
+    ASSERT_FALSE(mgr.Reserve("b", 10));
+    ASSERT_TRUE(mgr.Reserve("b", 5));
+    mgr.Release("b", 5);
+
+    mgr.SetDefaultCollectionQuota(0);
+    ASSERT_TRUE(mgr.Reserve("b", 50));
+    ASSERT_FALSE(mgr.Reserve("b", 20));
+}
+
+TEST(MemMgrTest, RESERVATION) {
+    auto mgr = std::make_shared<MemMgr>(100, 0);
+    {
+        MemReservation reservation(mgr, "a", 80);
+        ASSERT_TRUE(reservation.Ok());
+        ASSERT_EQ(mgr->Reserved(), 80);
+
+        MemReservation rejected(mgr, "b", 30);
+        ASSERT_FALSE(rejected.Ok());
+    }
+    ASSERT_EQ(mgr->Reserved(), 0);
+
+    MemReservation no_mgr(nullptr, "a", 80);
+    ASSERT_TRUE(no_mgr.Ok());
+}
+
+}  // namespace scheduler
+}  // namespace milvus
@@ -213,6 +213,61 @@ TEST_F(ResourceAdvanceTest, CPU_RESOURCE_TEST) {
     out << *std::static_pointer_cast<TestResource>(test_resource_);
 }
 
+TEST(ResourceWorkerTest, CPU_RESOURCE_MULTI_WORKER_TEST) {
+    const uint64_t NUM = 32;
+    auto cpu_resource = ResourceFactory::Create("cpu", "CPU", 0);
+    cpu_resource->SetWorkerNum(2, 4, 1);
+    ASSERT_EQ(cpu_resource->NumOfExecutor(), 4);
+
+    // play the scheduler: executors are waked up by loaded tasks, loaders by finished ones
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t exec_count = 0;
+    uint64_t startup_count = 0;
+    cpu_resource->RegisterSubscriber([&](EventPtr event) {
+        if (event->Type() == EventType::START_UP) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++startup_count;
+        } else if (event->Type() == EventType::LOAD_COMPLETED) {
+            cpu_resource->WakeupExecutor();
+        } else if (event->Type() == EventType::FINISH_TASK) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++exec_count;
+            }
+            cv.notify_one();
+            cpu_resource->WakeupLoader();
+        }
+    });
+    cpu_resource->Start();
+
+    std::vector<std::shared_ptr<TestTask>> tasks;
+    SegmentSchemaPtr dummy = nullptr;
+    for (uint64_t i = 0; i < NUM; ++i) {
+        auto label = std::make_shared<SpecResLabel>(cpu_resource);
+        auto task = std::make_shared<TestTask>(std::make_shared<server::Context>("dummy_request_id"), dummy, label);
+        std::vector<std::string> path{cpu_resource->name()};
+        task->path() = Path(path, 0);
+        tasks.push_back(task);
+        cpu_resource->task_table().Put(task);
+    }
+    cpu_resource->WakeupLoader();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return exec_count == NUM; });
+        ASSERT_EQ(startup_count, 1);
+    }
+    cpu_resource->Stop();
+
+    for (uint64_t i = 0; i < NUM; ++i) {
+        ASSERT_EQ(tasks[i]->load_count_, 1);
+        ASSERT_EQ(tasks[i]->exec_count_, 1);
+    }
+    ASSERT_EQ(cpu_resource->TotalTasks(), NUM);
+    ASSERT_EQ(cpu_resource->Dump()["executor_num"], 4);
+}
+
 TEST_F(ResourceAdvanceTest, GPU_RESOURCE_TEST) {
     const uint64_t NUM = max_once_load;
     std::vector<std::shared_ptr<TestTask>> tasks;
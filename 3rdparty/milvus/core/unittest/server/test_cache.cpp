@@ -15,6 +15,8 @@
 
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
+#include "cache/ResultCacheMgr.h"
+#include "config/Config.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 #include "utils/Error.h"
 
@@ -170,6 +172,48 @@ TEST(CacheTest, CPU_CACHE_TEST) {
 //    delete cpu_cache_mgr;
 }
 
+TEST(CacheTest, RESULT_CACHE_TEST) {
+    auto& config = milvus::server::Config::GetInstance();
+    auto result_mgr = milvus::cache::ResultCacheMgr::GetInstance();
+    ASSERT_TRUE(config.SetCacheConfigResultCacheCapacity("1").ok());
+    ASSERT_TRUE(result_mgr->Enabled());
+    ASSERT_EQ(result_mgr->CacheCapacity(), 1024 * 1024);
+
+    std::vector<float> query = {1.0, 2.0, 3.0, 4.0};
+    std::string query_str(reinterpret_cast<const char*>(query.data()), query.size() * sizeof(float));
+    std::vector<std::string> tags = {"b", "a"};
+    std::vector<std::string> reordered_tags = {"a", "b"};
+    auto key = milvus::cache::ResultCacheMgr::MakeKey("collection", 1, tags, "{}", 2, query_str);
+    ASSERT_EQ(key, milvus::cache::ResultCacheMgr::MakeKey("collection", 1, reordered_tags, "{}", 2, query_str));
+    ASSERT_NE(key, milvus::cache::ResultCacheMgr::MakeKey("collection", 2, tags, "{}", 2, query_str));
+    ASSERT_NE(key, milvus::cache::ResultCacheMgr::MakeKey("collection", 1, tags, "{}", 3, query_str));
+
+    ASSERT_TRUE(result_mgr->GetResult(key, query_str) == nullptr);
+    auto result = std::make_shared<milvus::cache::SearchResultObj>(query_str, 1, std::vector<int64_t>{7, 9},
+                                                                   std::vector<float>{0.5, 1.5});
+    result_mgr->InsertResult(key, result);
+    auto cached = result_mgr->GetResult(key, query_str);
+    ASSERT_TRUE(cached != nullptr);
+    ASSERT_EQ(cached->RowNum(), 1);
+    ASSERT_EQ(cached->Ids(), result->Ids());
+    ASSERT_EQ(cached->Distances(), result->Distances());
+
+    // same key but another query is a miss
+    query[0] = 0.0;
+    std::string other_query(reinterpret_cast<const char*>(query.data()), query.size() * sizeof(float));
+    ASSERT_TRUE(result_mgr->GetResult(key, other_query) == nullptr);
+
+    // results larger than the cache are not kept
+    auto big_result = std::make_shared<milvus::cache::SearchResultObj>(query_str, 1, std::vector<int64_t>(200000),
+                                                                       std::vector<float>(200000));
+    result_mgr->InsertResult("big", big_result);
+    ASSERT_FALSE(result_mgr->ItemExists("big"));
+
+    ASSERT_TRUE(config.SetCacheConfigResultCacheCapacity("0").ok());
+    ASSERT_FALSE(result_mgr->Enabled());
+    ASSERT_EQ(result_mgr->ItemCount(), 0);
+}
+
 #ifdef MILVUS_GPU_VERSION
 TEST(CacheTest, GPU_CACHE_TEST) {
     auto gpu_mgr = milvus::cache::GpuCacheMgr::GetInstance(0);
@@ -188,6 +188,16 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetDBConfigAutoFlushInterval(int64_val).ok());
     ASSERT_TRUE(int64_val == db_auto_flush_interval);
 
+    float db_auto_compact_ratio = 0.5;
+    ASSERT_TRUE(config.SetDBConfigAutoCompactRatio(std::to_string(db_auto_compact_ratio)).ok());
+    ASSERT_TRUE(config.GetDBConfigAutoCompactRatio(float_val).ok());
+    ASSERT_TRUE(float_val == db_auto_compact_ratio);
+
+    int64_t db_auto_compact_rate = 256;
+    ASSERT_TRUE(config.SetDBConfigAutoCompactRate(std::to_string(db_auto_compact_rate)).ok());
+    ASSERT_TRUE(config.GetDBConfigAutoCompactRate(int64_val).ok());
+    ASSERT_TRUE(int64_val == db_auto_compact_rate);
+
     /* storage config */
     std::string storage_primary_path = "/home/zilliz";
     ASSERT_TRUE(config.SetStorageConfigPrimaryPath(storage_primary_path).ok());
@@ -276,6 +286,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetCacheConfigCacheInsertData(bool_val).ok());
     ASSERT_TRUE(bool_val == cache_insert_data);
 
+    int64_t cache_result_cache_capacity = 64;
+    ASSERT_TRUE(config.SetCacheConfigResultCacheCapacity(std::to_string(cache_result_cache_capacity)).ok());
+    ASSERT_TRUE(config.GetCacheConfigResultCacheCapacity(int64_val).ok());
+    ASSERT_TRUE(int64_val == cache_result_cache_capacity);
+
     /* engine config */
     int64_t engine_use_blas_threshold = 50;
     ASSERT_TRUE(config.SetEngineConfigUseBlasThreshold(std::to_string(engine_use_blas_threshold)).ok());
@@ -292,6 +307,46 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetEngineConfigSimdType(str_val).ok());
     ASSERT_TRUE(str_val == engine_simd_type);
 
+    int64_t engine_slow_query_threshold = 500;
+    ASSERT_TRUE(config.SetEngineConfigSlowQueryThreshold(std::to_string(engine_slow_query_threshold)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSlowQueryThreshold(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_slow_query_threshold);
+
+    int64_t engine_memory_budget = 1;
+    ASSERT_TRUE(config.SetEngineConfigMemoryBudget(std::to_string(engine_memory_budget)).ok());
+    ASSERT_TRUE(config.GetEngineConfigMemoryBudget(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_memory_budget);
+
+    int64_t engine_collection_memory_quota = 1;
+    ASSERT_TRUE(config.SetEngineConfigCollectionMemoryQuota(std::to_string(engine_collection_memory_quota)).ok());
+    ASSERT_TRUE(config.GetEngineConfigCollectionMemoryQuota(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_collection_memory_quota);
+
+    std::unordered_map<std::string, int64_t> engine_collection_memory_quotas;
+    ASSERT_TRUE(config.SetEngineConfigCollectionMemoryQuotas("collection_a:2, collection_b:4").ok());
+    ASSERT_TRUE(config.GetEngineConfigCollectionMemoryQuotas(engine_collection_memory_quotas).ok());
+    ASSERT_EQ(engine_collection_memory_quotas.size(), 2);
+    ASSERT_EQ(engine_collection_memory_quotas["collection_a"], 2);
+    ASSERT_EQ(engine_collection_memory_quotas["collection_b"], 4);
+    ASSERT_TRUE(config.SetEngineConfigCollectionMemoryQuotas("").ok());
+    ASSERT_TRUE(config.GetEngineConfigCollectionMemoryQuotas(engine_collection_memory_quotas).ok());
+    ASSERT_TRUE(engine_collection_memory_quotas.empty());
+
+    bool engine_ivf_lists_on_disk = true;
+    ASSERT_TRUE(config.SetEngineConfigIvfListsOnDisk(std::to_string(engine_ivf_lists_on_disk)).ok());
+    ASSERT_TRUE(config.GetEngineConfigIvfListsOnDisk(bool_val).ok());
+    ASSERT_TRUE(bool_val == engine_ivf_lists_on_disk);
+
+    int64_t engine_search_executor_num = 1;
+    ASSERT_TRUE(config.SetEngineConfigSearchExecutorNum(std::to_string(engine_search_executor_num)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchExecutorNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_executor_num);
+
+    int64_t engine_search_loader_num = 1;
+    ASSERT_TRUE(config.SetEngineConfigSearchLoaderNum(std::to_string(engine_search_loader_num)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchLoaderNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_loader_num);
+
 #ifdef MILVUS_GPU_VERSION
     int64_t engine_gpu_search_threshold = 800;
     ASSERT_TRUE(config.SetEngineConfigGpuSearchThreshold(std::to_string(engine_gpu_search_threshold)).ok());
@@ -589,6 +644,13 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetDBConfigAutoFlushInterval("0.1").ok());
 
+    ASSERT_FALSE(config.SetDBConfigAutoCompactRatio("a").ok());
+    ASSERT_FALSE(config.SetDBConfigAutoCompactRatio("-0.1").ok());
+    ASSERT_FALSE(config.SetDBConfigAutoCompactRatio("1.0").ok());
+
+    ASSERT_FALSE(config.SetDBConfigAutoCompactRate("0").ok());
+    ASSERT_FALSE(config.SetDBConfigAutoCompactRate("1.5").ok());
+
     /* storage config */
     ASSERT_FALSE(config.SetStorageConfigPrimaryPath("").ok());
     ASSERT_FALSE(config.SetStorageConfigPrimaryPath("./milvus").ok());
@@ -624,6 +686,7 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetCacheConfigCpuCacheCapacity("0").ok());
     ASSERT_FALSE(config.SetCacheConfigCpuCacheCapacity("2048").ok());
     ASSERT_FALSE(config.SetCacheConfigCpuCacheCapacity("-1").ok());
+    ASSERT_FALSE(config.SetCacheConfigCpuCacheCapacity("9000000000000").ok());
 
     ASSERT_FALSE(config.SetCacheConfigCpuCacheThreshold("a").ok());
     ASSERT_FALSE(config.SetCacheConfigCpuCacheThreshold("1.0").ok());
@@ -633,9 +696,13 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetCacheConfigInsertBufferSize("0").ok());
     ASSERT_FALSE(config.SetCacheConfigInsertBufferSize("2048").ok());
     ASSERT_FALSE(config.SetCacheConfigInsertBufferSize("-1").ok());
+    ASSERT_FALSE(config.SetCacheConfigInsertBufferSize("9000000000000").ok());
 
     ASSERT_FALSE(config.SetCacheConfigCacheInsertData("N").ok());
 
+    ASSERT_FALSE(config.SetCacheConfigResultCacheCapacity("a").ok());
+    ASSERT_FALSE(config.SetCacheConfigResultCacheCapacity("-1").ok());
+
     /* engine config */
     ASSERT_FALSE(config.SetEngineConfigUseBlasThreshold("0xff").ok());
 
@@ -645,6 +712,25 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetEngineConfigSimdType("None").ok());
 
+    ASSERT_FALSE(config.SetEngineConfigSlowQueryThreshold("-1").ok());
+    ASSERT_FALSE(config.SetEngineConfigSlowQueryThreshold("1s").ok());
+
+    ASSERT_FALSE(config.SetEngineConfigMemoryBudget("-1").ok());
+    ASSERT_FALSE(config.SetEngineConfigMemoryBudget("1000000000").ok());
+    ASSERT_FALSE(config.SetEngineConfigMemoryBudget("9000000000000").ok());
+    ASSERT_FALSE(config.SetEngineConfigCollectionMemoryQuota("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigCollectionMemoryQuota("9000000000000").ok());
+    ASSERT_FALSE(config.SetEngineConfigCollectionMemoryQuotas("collection_a").ok());
+    ASSERT_FALSE(config.SetEngineConfigCollectionMemoryQuotas("collection_a:-1").ok());
+    ASSERT_FALSE(config.SetEngineConfigCollectionMemoryQuotas("collection_a:9000000000000").ok());
+    ASSERT_FALSE(config.SetEngineConfigCollectionMemoryQuotas("1collection:1").ok());
+    ASSERT_FALSE(config.SetEngineConfigCollectionMemoryQuotas("collection_a:1,collection_a:2").ok());
+    ASSERT_FALSE(config.SetEngineConfigIvfListsOnDisk("10").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchExecutorNum("0").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchExecutorNum("10000").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchLoaderNum("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchLoaderNum("-1").ok());
+
 #ifdef MILVUS_GPU_VERSION
     ASSERT_FALSE(config.SetEngineConfigGpuSearchThreshold("-1").ok());
 #endif
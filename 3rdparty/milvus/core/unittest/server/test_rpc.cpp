@@ -13,13 +13,19 @@
 #include <opentracing/mocktracer/tracer.h>
 
 #include <boost/filesystem.hpp>
+#include <chrono>
 #include <thread>
+#include <vector>
 
 #include "config/Config.h"
+#include "db/engine/ExecutionEngine.h"
 #include "server/Server.h"
 #include "server/delivery/RequestHandler.h"
+#include "server/delivery/RequestQueue.h"
 #include "server/delivery/RequestScheduler.h"
 #include "server/delivery/request/BaseRequest.h"
+#include "server/delivery/request/SearchCombineRequest.h"
+#include "server/delivery/request/SearchRequest.h"
 #include "server/grpc_impl/GrpcRequestHandler.h"
 #include "src/version.h"
 
@@ -1066,6 +1072,73 @@ TEST_F(RpcHandlerTest, HYBRID_TEST) {
     handler->HybridSearch(&context, &search_param, &topk_query_result);
 }
 
+TEST_F(RpcHandlerTest, HYBRID_COSINE_TEST) {
+    ::grpc::ServerContext context;
+    milvus::grpc::Mapping mapping;
+    milvus::grpc::Status response;
+
+    uint64_t row_num = 100;
+    uint64_t dimension = 16;
+    std::string collection_name = "test_hybrid_cosine";
+
+    mapping.set_collection_name(collection_name);
+    auto field_0 = mapping.add_fields();
+    field_0->set_name("field_0");
+    field_0->mutable_type()->set_data_type(::milvus::grpc::DataType::INT64);
+
+    auto field_1 = mapping.add_fields();
+    field_1->mutable_type()->mutable_vector_param()->set_dimension(dimension);
+    field_1->set_name("field_1");
+    auto field_param = field_1->add_extra_params();
+    field_param->set_key("params");
+    milvus::json metric_param = {{"metric_type", (int32_t)milvus::engine::MetricType::COSINE}};
+    field_param->set_value(metric_param.dump());
+
+    handler->CreateHybridCollection(&context, &mapping, &response);
+    ASSERT_EQ(response.error_code(), ::grpc::Status::OK.error_code());
+
+    milvus::grpc::HInsertParam insert_param;
+    milvus::grpc::HEntityIDs entity_ids;
+    insert_param.set_collection_name(collection_name);
+
+    auto entity = insert_param.mutable_entities();
+    *entity->add_field_names() = "field_0";
+    *entity->add_field_names() = "field_1";
+    entity->set_row_num(row_num);
+    std::vector<int64_t> field_value(row_num, 0);
+    for (uint64_t i = 0; i < row_num; i++) {
+        field_value[i] = i;
+    }
+    entity->set_attr_records(field_value.data(), row_num * sizeof(int64_t));
+
+    // vectors far from unit length
+    auto vector_record = entity->add_result_values();
+    for (uint64_t i = 0; i < row_num; ++i) {
+        auto vector_data = vector_record->mutable_vector_value()->add_value()->mutable_float_data();
+        for (uint64_t j = 0; j < dimension; ++j) {
+            vector_data->Add((float)(i + 1) * (j + 1));
+        }
+    }
+    handler->InsertEntity(&context, &insert_param, &entity_ids);
+    ASSERT_EQ(entity_ids.entity_id_array_size(), row_num);
+
+    // stored normalized, like the vectors of a COSINE collection inserted by InsertRequest
+    auto db = milvus::server::DBWrapper::DB();
+    ASSERT_TRUE(db->Flush(collection_name).ok());
+    milvus::engine::IDNumbers ids = {entity_ids.entity_id_array(0), entity_ids.entity_id_array(row_num - 1)};
+    std::vector<milvus::engine::VectorsData> vectors;
+    ASSERT_TRUE(db->GetVectorsByID(collection_name, ids, vectors).ok());
+    ASSERT_EQ(vectors.size(), ids.size());
+    for (auto& vector : vectors) {
+        ASSERT_EQ(vector.float_data_.size(), dimension);
+        float norm = 0;
+        for (auto value : vector.float_data_) {
+            norm += value * value;
+        }
+        ASSERT_NEAR(norm, 1.0, 1e-4);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////
 namespace {
 class DummyRequest : public milvus::server::BaseRequest {
@@ -1115,8 +1188,93 @@ class AsyncDummyRequest : public milvus::server::BaseRequest {
                       true) {
     }
 };
+
+class TypedDummyRequest : public milvus::server::BaseRequest {
+ public:
+    milvus::Status
+    OnExecute() override {
+        return milvus::Status::OK();
+    }
+
+ public:
+    TypedDummyRequest(milvus::server::BaseRequest::RequestType type,
+                      const milvus::server::BaseRequest::TimePoint& deadline)
+        : BaseRequest(std::make_shared<milvus::server::Context>("dummy_request_id3"), type) {
+        context_->SetDeadline(deadline);
+    }
+};
 }  // namespace
 
+TEST_F(RpcSchedulerTest, PRIORITY_QUEUE_TEST) {
+    using BaseRequest = milvus::server::BaseRequest;
+    auto no_deadline = BaseRequest::TimePoint::max();
+    auto now = std::chrono::system_clock::now();
+
+    milvus::server::RequestQueue queue;
+    auto admin = std::make_shared<TypedDummyRequest>(BaseRequest::kCreateIndex, no_deadline);
+    auto insert = std::make_shared<TypedDummyRequest>(BaseRequest::kInsert, no_deadline);
+    auto batch = std::make_shared<TypedDummyRequest>(BaseRequest::kPreloadCollection, no_deadline);
+    auto interactive = std::make_shared<TypedDummyRequest>(BaseRequest::kCmd, no_deadline);
+    auto urgent_admin = std::make_shared<TypedDummyRequest>(BaseRequest::kFlush, now + std::chrono::seconds(5));
+    auto expired = std::make_shared<TypedDummyRequest>(BaseRequest::kCmd, now - std::chrono::seconds(1));
+    ASSERT_EQ(admin->GetPriority(), BaseRequest::kPriorityAdmin);
+    ASSERT_EQ(insert->GetPriority(), BaseRequest::kPriorityInsert);
+    ASSERT_EQ(batch->GetPriority(), BaseRequest::kPriorityBatchSearch);
+    ASSERT_EQ(interactive->GetPriority(), BaseRequest::kPriorityInteractive);
+    ASSERT_FALSE(admin->Reorderable());
+    ASSERT_TRUE(batch->Reorderable());
+
+    // queued in the worst order, reads are taken by due time, writes keep their order whatever their deadline,
+    // the expired request is shed on the way
+    for (auto& request : {admin, urgent_admin, batch, insert, expired, interactive}) {
+        ASSERT_TRUE(queue.PutRequest(request).ok());
+    }
+    std::vector<milvus::server::BaseRequestPtr> expected = {interactive, batch, admin, urgent_admin, insert};
+    for (auto& request : expected) {
+        auto taken = queue.TakeRequest();
+        ASSERT_EQ(taken, request);
+        taken->Execute();
+    }
+    ASSERT_EQ(queue.Size(), 0u);
+    ASSERT_EQ(expired->WaitToFinish().code(), milvus::SERVER_REQUEST_TIMEOUT);
+
+    queue.Stop();
+    ASSERT_EQ(queue.TakeRequest(), nullptr);
+}
+
+TEST_F(RpcSchedulerTest, COMBINE_DEADLINE_TEST) {
+    using BaseRequest = milvus::server::BaseRequest;
+    auto now = std::chrono::system_clock::now();
+
+    milvus::engine::VectorsData vectors;
+    vectors.vector_count_ = 1;
+    vectors.float_data_.resize(16);
+    milvus::server::TopKQueryResult results[2];
+    std::vector<std::shared_ptr<milvus::server::SearchRequest>> requests;
+    for (auto& deadline : {now + std::chrono::seconds(10), now + std::chrono::seconds(5)}) {
+        auto context = std::make_shared<milvus::server::Context>("dummy_request_id4");
+        context->SetDeadline(deadline);
+        auto request = milvus::server::SearchRequest::Create(context, "combine_collection", vectors, 10,
+                                                             milvus::json(), {}, {}, results[requests.size()]);
+        requests.push_back(std::static_pointer_cast<milvus::server::SearchRequest>(request));
+    }
+
+    // the combined request is due at the earliest deadline, but isn't shed as a whole
+    auto combine_request = std::make_shared<milvus::server::SearchCombineRequest>();
+    ASSERT_EQ(combine_request->Deadline(), BaseRequest::TimePoint::max());
+    for (auto& request : requests) {
+        ASSERT_TRUE(combine_request->Combine(request).ok());
+    }
+    ASSERT_EQ(combine_request->Deadline(), now + std::chrono::seconds(5));
+    ASSERT_FALSE(combine_request->Expired(now + std::chrono::seconds(20)));
+    ASSERT_TRUE(requests[1]->Expired(now + std::chrono::seconds(6)));
+
+    for (auto& request : requests) {
+        request->Done();
+    }
+    combine_request->Done();
+}
+
 TEST_F(RpcSchedulerTest, BASE_TASK_TEST) {
     auto status = request_ptr->Execute();
     ASSERT_TRUE(status.ok());
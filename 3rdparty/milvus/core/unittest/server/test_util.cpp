@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "db/engine/ExecutionEngine.h"
+#include "server/context/QueryProfile.h"
 #include "utils/BlockingQueue.h"
 #include "utils/CommonUtil.h"
 #include "utils/Error.h"
@@ -271,6 +272,46 @@ TEST(UtilTest, TIMERECOREDRAUTO_TEST) {
     rc.RecordSection("end");
 }
 
+TEST(UtilTest, QUERY_PROFILE_TEST) {
+    auto profile = std::make_shared<milvus::server::QueryProfile>();
+    {
+        milvus::server::QueryProfileScope scope(profile, milvus::server::QueryStage::kSearch);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&profile]() {
+            milvus::server::QueryProfileScope scope(profile, milvus::server::QueryStage::kLoad);
+            profile->AddSegment();
+            profile->AddBytesLoaded(100);
+            profile->AddCacheMiss();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    profile->AddCacheHit();
+
+    ASSERT_GE(profile->StageWallTime(milvus::server::QueryStage::kSearch), 2000);
+    ASSERT_EQ(profile->StageWallTime(milvus::server::QueryStage::kMerge), 0);
+    ASSERT_EQ(profile->Segments(), 4);
+    ASSERT_EQ(profile->BytesLoaded(), 400);
+    ASSERT_EQ(profile->CacheHits(), 1);
+    ASSERT_EQ(profile->CacheMisses(), 4);
+
+    auto json = profile->ToJson();
+    ASSERT_TRUE(json["stages"].contains("search"));
+    // sleeping costs no cpu of the thread
+    ASSERT_LT(json["stages"]["search"]["thread_cpu_us"].get<int64_t>(),
+              json["stages"]["search"]["wall_us"].get<int64_t>());
+    ASSERT_EQ(json["stages"]["load"]["count"].get<int64_t>(), 4);
+    ASSERT_FALSE(json["stages"].contains("merge"));
+
+    // null profile makes the scope a no-op
+    milvus::server::QueryProfileScope empty_scope(nullptr, milvus::server::QueryStage::kMeta);
+    empty_scope.Finish();
+}
+
 TEST(UtilTest, STATUS_TEST) {
     auto status = milvus::Status::OK();
     std::string str = status.ToString();
@@ -359,7 +400,8 @@ TEST(ValidationUtilTest, VALIDATE_COLLECTION_NAME_TEST) {
 
 TEST(ValidationUtilTest, VALIDATE_DIMENSION_TEST) {
     std::vector<int64_t>
-        float_metric_types = {(int64_t)milvus::engine::MetricType::L2, (int64_t)milvus::engine::MetricType::IP};
+        float_metric_types = {(int64_t)milvus::engine::MetricType::L2, (int64_t)milvus::engine::MetricType::IP,
+                              (int64_t)milvus::engine::MetricType::COSINE};
 
     std::vector<int64_t>
         binary_metric_types = {
@@ -574,6 +616,49 @@ TEST(ValidationUtilTest, VALIDATE_INDEX_PARAMS_TEST) {
                                                             collection_schema,
                                                             (int32_t)milvus::engine::EngineType::FAISS_PQ);
     ASSERT_FALSE(status.ok());
+
+    // PQ fast scan 'm' must divide the dimension
+    status =
+        milvus::server::ValidationUtil::ValidateIndexParams(json_params,
+                                                            collection_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_PQ_FASTSCAN);
+    ASSERT_FALSE(status.ok());
+
+    json_params = {{"nlist", 32}, {"m", 9}};
+    status =
+        milvus::server::ValidationUtil::ValidateIndexParams(json_params,
+                                                            collection_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_PQ_FASTSCAN);
+    ASSERT_TRUE(status.ok());
+
+    // pre-transforms, 'm' must divide the transformed dimension
+    json_params = {{"nlist", 32}, {"m", 8}, {"pre_transform", "OPQ"}, {"pre_transform_dim", 64}};
+    status =
+        milvus::server::ValidationUtil::ValidateIndexParams(json_params,
+                                                            collection_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_PQ);
+    ASSERT_TRUE(status.ok());
+
+    json_params = {{"nlist", 32}, {"pre_transform", "OPQ"}};
+    status =
+        milvus::server::ValidationUtil::ValidateIndexParams(json_params,
+                                                            collection_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_IVFFLAT);
+    ASSERT_FALSE(status.ok());
+
+    json_params = {{"nlist", 32}, {"pre_transform", "PCA"}, {"pre_transform_dim", 128}};
+    status =
+        milvus::server::ValidationUtil::ValidateIndexParams(json_params,
+                                                            collection_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_IVFSQ8);
+    ASSERT_FALSE(status.ok());
+
+    json_params = {{"nlist", 32}, {"pre_transform", "PCA"}, {"pre_transform_dim", 33}};
+    status =
+        milvus::server::ValidationUtil::ValidateIndexParams(json_params,
+                                                            collection_schema,
+                                                            (int32_t)milvus::engine::EngineType::FAISS_IVFSQ8);
+    ASSERT_TRUE(status.ok());
 }
 
 TEST(ValidationUtilTest, VALIDATE_SEARCH_PARAMS_TEST) {
@@ -31,6 +31,7 @@
 #include "server/web_impl/dto/StatusDto.hpp"
 #include "server/web_impl/dto/VectorDto.hpp"
 #include "server/web_impl/handler/WebRequestHandler.h"
+#include "server/web_impl/utils/Util.h"
 #include "src/version.h"
 #include "utils/CommonUtil.h"
 
@@ -1237,6 +1238,91 @@ TEST_F(WebControllerTest, SEARCH_BIN) {
     ASSERT_EQ(OStatus::CODE_200.code, response->getStatusCode());
 }
 
+TEST_F(WebControllerTest, SEARCH_PACKED) {
+    const OString collection_name = "test_search_packed_collection_test" + OString(RandomName().c_str());
+    const int64_t dim = 64, nb = 100;
+    GenCollection(client_ptr, conncetion_ptr, collection_name, dim, 100, "L2");
+
+    std::vector<float> vectors(nb * dim);
+    std::default_random_engine e;
+    std::uniform_real_distribution<float> u(0, 1);
+    for (auto& v : vectors) {
+        v = u(e);
+    }
+    std::vector<int64_t> ids(nb);
+    for (int64_t i = 0; i < nb; i++) {
+        ids[i] = 1000 + i;
+    }
+
+    std::string vectors_str, ids_str;
+    milvus::server::web::Base64Encode(reinterpret_cast<const uint8_t*>(vectors.data()),
+                                      vectors.size() * sizeof(float), vectors_str);
+    milvus::server::web::Base64Encode(reinterpret_cast<const uint8_t*>(ids.data()), ids.size() * sizeof(int64_t),
+                                      ids_str);
+
+    nlohmann::json insert_json;
+    insert_json["vectors"]["dim"] = dim;
+    insert_json["vectors"]["data"] = vectors_str;
+    insert_json["ids"] = ids_str;
+    auto response = client_ptr->insert(collection_name, insert_json.dump().c_str(), conncetion_ptr);
+    ASSERT_EQ(OStatus::CODE_201.code, response->getStatusCode()) << response->readBodyToString()->std_str();
+    auto result_dto = response->readBodyToDto<milvus::server::web::VectorIdsDto>(object_mapper.get());
+    ASSERT_EQ(nb, result_dto->ids->count());
+    auto status = FlushCollection(client_ptr, conncetion_ptr, collection_name);
+    ASSERT_TRUE(status.ok()) << status.message();
+
+    // size of data does not match dim
+    insert_json["vectors"]["dim"] = dim + 1;
+    response = client_ptr->insert(collection_name, insert_json.dump().c_str(), conncetion_ptr);
+    ASSERT_NE(OStatus::CODE_201.code, response->getStatusCode());
+
+    // search the first 10 inserted vectors, each should hit itself
+    const int64_t nq = 10, topk = 2;
+    std::string query_str;
+    milvus::server::web::Base64Encode(reinterpret_cast<const uint8_t*>(vectors.data()), nq * dim * sizeof(float),
+                                      query_str);
+    nlohmann::json search_json;
+    search_json["search"]["topk"] = topk;
+    search_json["search"]["params"]["nprobe"] = 1;
+    search_json["search"]["vectors"]["dim"] = dim;
+    search_json["search"]["vectors"]["data"] = query_str;
+    search_json["search"]["result_encoding"] = "base64";
+    response = client_ptr->vectorsOp(collection_name, search_json.dump().c_str(), conncetion_ptr);
+    ASSERT_EQ(OStatus::CODE_200.code, response->getStatusCode()) << response->readBodyToString()->std_str();
+
+    auto result_json = nlohmann::json::parse(response->readBodyToString()->std_str());
+    ASSERT_EQ(nq, result_json["num"].get<int64_t>());
+    ASSERT_EQ(topk, result_json["topk"].get<int64_t>());
+    std::string result_ids_str = result_json["ids"];
+    std::string result_distances_str = result_json["distances"];
+    ASSERT_EQ(nq * topk * static_cast<int64_t>(sizeof(int64_t)), milvus::server::web::Base64DecodedSize(result_ids_str));
+    ASSERT_EQ(nq * topk * static_cast<int64_t>(sizeof(float)), milvus::server::web::Base64DecodedSize(result_distances_str));
+
+    std::vector<int64_t> result_ids(nq * topk);
+    std::vector<float> result_distances(nq * topk);
+    ASSERT_TRUE(milvus::server::web::Base64Decode(result_ids_str, reinterpret_cast<uint8_t*>(result_ids.data())).ok());
+    ASSERT_TRUE(milvus::server::web::Base64Decode(result_distances_str,
+                                                  reinterpret_cast<uint8_t*>(result_distances.data()))
+                    .ok());
+    for (int64_t i = 0; i < nq; i++) {
+        ASSERT_EQ(ids[i], result_ids[i * topk]);
+        ASSERT_NEAR(0.0, result_distances[i * topk], 1e-4);
+    }
+
+    // padding only ends the last quad, other characters must be in the alphabet
+    uint8_t decoded[6];
+    ASSERT_TRUE(milvus::server::web::Base64Decode("QUJD", decoded).ok());
+    ASSERT_TRUE(milvus::server::web::Base64Decode("QUI=", decoded).ok());
+    ASSERT_TRUE(milvus::server::web::Base64Decode("QQ==", decoded).ok());
+    ASSERT_FALSE(milvus::server::web::Base64Decode("Q===", decoded).ok());
+    ASSERT_FALSE(milvus::server::web::Base64Decode("QU=D", decoded).ok());
+    ASSERT_FALSE(milvus::server::web::Base64Decode("QQ==QUJD", decoded).ok());
+    ASSERT_FALSE(milvus::server::web::Base64Decode("QU*D", decoded).ok());
+
+    response = client_ptr->dropCollection(collection_name, conncetion_ptr);
+    ASSERT_EQ(OStatus::CODE_204.code, response->getStatusCode());
+}
+
 TEST_F(WebControllerTest, SEARCH_BY_IDS) {
 #ifdef MILVUS_GPU_VERSION
     auto &config  = milvus::server::Config::GetInstance();